@@ -0,0 +1,251 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__KALMAN_FILTER__FIXED_SIZE_TIME_DELAY_KALMAN_FILTER_HPP_
+#define AUTOWARE__KALMAN_FILTER__FIXED_SIZE_TIME_DELAY_KALMAN_FILTER_HPP_
+
+#include <Eigen/Core>
+#include <Eigen/LU>
+
+#include <iostream>
+
+namespace autoware::kalman_filter
+{
+/**
+ * @file fixed_size_time_delay_kalman_filter.hpp
+ * @brief kalman filter with delayed measurement, whose state dimension is known at compile time
+ *
+ * This class computes the same estimation as TimeDelayKalmanFilter, but it exploits the block
+ * structure of the extended model instead of shifting the whole extended state and covariance:
+ * - The extended state and covariance are stored as ring buffers of DimX blocks. A prediction
+ *   overwrites the block row and column of the oldest state, which costs
+ *   O(max_delay_step * DimX^3) instead of copying the whole (DimX * max_delay_step)^2 covariance.
+ * - An update only reads the block column of the delayed state instead of multiplying the whole
+ *   covariance with a dense extended measurement matrix.
+ * - The latest state, its covariance, the measurements and the innovation covariance are
+ *   fixed-size Eigen types, so that only the extended state and covariance, whose size depends
+ *   on max_delay_step, are allocated on the heap. They are allocated in init(), and
+ *   predictWithDelay and updateWithDelay never allocate memory.
+ *
+ * @tparam DimX dimension of the latest state
+ */
+template <int DimX>
+class FixedSizeTimeDelayKalmanFilter
+{
+  static_assert(DimX > 0, "the state dimension must be known at compile time");
+
+public:
+  using StateVector = Eigen::Matrix<double, DimX, 1>;
+  using StateMatrix = Eigen::Matrix<double, DimX, DimX>;
+  template <int DimY>
+  using MeasurementVector = Eigen::Matrix<double, DimY, 1>;
+  template <int DimY>
+  using MeasurementMatrix = Eigen::Matrix<double, DimY, DimX>;
+  template <int DimY>
+  using MeasurementCovariance = Eigen::Matrix<double, DimY, DimY>;
+
+  FixedSizeTimeDelayKalmanFilter() = default;
+
+  /**
+   * @brief initialization of kalman filter
+   * @param x initial state
+   * @param P0 initial covariance of estimated state
+   * @param max_delay_step Maximum number of delay steps, which determines the dimension of the
+   * extended kalman filter
+   */
+  void init(const StateVector & x, const StateMatrix & P0, const int max_delay_step)
+  {
+    max_delay_step_ = max_delay_step;
+    dim_x_ex_ = DimX * max_delay_step;
+    head_ = 0;
+
+    x_ = Eigen::VectorXd::Zero(dim_x_ex_);
+    P_ = Eigen::MatrixXd::Zero(dim_x_ex_, dim_x_ex_);
+    PCT_ = Eigen::MatrixXd::Zero(dim_x_ex_, DimX);
+    K_ = Eigen::MatrixXd::Zero(dim_x_ex_, DimX);
+    CP_ = Eigen::MatrixXd::Zero(DimX, dim_x_ex_);
+
+    for (int i = 0; i < max_delay_step_; ++i) {
+      x_.template segment<DimX>(i * DimX) = x;
+      P_.template block<DimX, DimX>(i * DimX, i * DimX) = P0;
+    }
+  }
+
+  /**
+   * @brief get latest time estimated state
+   */
+  StateVector getLatestX() const { return x_.template segment<DimX>(blockOffset(0)); }
+
+  /**
+   * @brief get latest time estimation covariance
+   */
+  StateMatrix getLatestP() const
+  {
+    const int offset = blockOffset(0);
+    return P_.template block<DimX, DimX>(offset, offset);
+  }
+
+  /**
+   * @brief get the i-th element of the extended state, ordered from the latest state to the
+   * oldest one as in TimeDelayKalmanFilter
+   * @param i index of the element
+   */
+  double getXelement(unsigned int i) const
+  {
+    const int delay_step = static_cast<int>(i) / DimX;
+    return x_(blockOffset(delay_step) + static_cast<int>(i) % DimX);
+  }
+
+  /**
+   * @brief get the extended state, ordered from the latest state to the oldest one
+   * @param x extended state
+   */
+  void getX(Eigen::MatrixXd & x) const
+  {
+    x.resize(dim_x_ex_, 1);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      x.template block<DimX, 1>(i * DimX, 0) = x_.template segment<DimX>(blockOffset(i));
+    }
+  }
+
+  /**
+   * @brief get the extended covariance, ordered from the latest state to the oldest one
+   * @param P extended covariance
+   */
+  void getP(Eigen::MatrixXd & P) const
+  {
+    P.resize(dim_x_ex_, dim_x_ex_);
+    for (int i = 0; i < max_delay_step_; ++i) {
+      for (int j = 0; j < max_delay_step_; ++j) {
+        P.template block<DimX, DimX>(i * DimX, j * DimX) =
+          P_.template block<DimX, DimX>(blockOffset(i), blockOffset(j));
+      }
+    }
+  }
+
+  /**
+   * @brief calculate kalman filter covariance by precision model with time delay. This is mainly
+   * for EKF of nonlinear process model.
+   * @param x_next predicted state by prediction model
+   * @param A coefficient matrix of x for process model
+   * @param Q covariance matrix for process model
+   * @return bool to check matrix operations are being performed properly
+   */
+  bool predictWithDelay(const StateVector & x_next, const StateMatrix & A, const StateMatrix & Q)
+  {
+    /*
+     * The prediction of the extended model shifts all delayed states by one step:
+     *
+     *     [A*P11*A'*+Q  A*P11  A*P12]
+     * P = [     P11*A'    P11    P12]
+     *     [     P21*A'    P21    P22]
+     *
+     * Since the blocks except for the first block row and column are only shifted, they are kept
+     * in place and the head of the ring buffer is moved to the block of the oldest state, which is
+     * no longer needed. Only that block row and column are computed here. Each of their blocks is
+     * a product with A, so the cost is O(max_delay_step * DimX^3).
+     */
+    const int latest = blockOffset(0);
+    head_ = (head_ + max_delay_step_ - 1) % max_delay_step_;
+    const int next = blockOffset(0);
+
+    x_.template segment<DimX>(next) = x_next;
+
+    const StateMatrix AP = A * P_.template block<DimX, DimX>(latest, latest);
+    P_.template block<DimX, DimX>(next, next).noalias() = AP * A.transpose();
+    P_.template block<DimX, DimX>(next, next) += Q;
+
+    // The previous states are now delayed by one step
+    for (int i = 1; i < max_delay_step_; ++i) {
+      const int offset = blockOffset(i);
+      P_.template block<DimX, DimX>(next, offset).noalias() =
+        A * P_.template block<DimX, DimX>(latest, offset);
+      P_.template block<DimX, DimX>(offset, next).noalias() =
+        P_.template block<DimX, DimX>(offset, latest) * A.transpose();
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief calculate kalman filter covariance by measurement model with time delay. This is mainly
+   * for EKF of nonlinear process model.
+   * @param y measured values
+   * @param C coefficient matrix of x for measurement model
+   * @param R covariance matrix for measurement model
+   * @param delay_step measurement delay
+   * @return bool to check matrix operations are being performed properly
+   */
+  template <int DimY>
+  bool updateWithDelay(
+    const MeasurementVector<DimY> & y, const MeasurementMatrix<DimY> & C,
+    const MeasurementCovariance<DimY> & R, const int delay_step)
+  {
+    static_assert(DimY <= DimX, "the measurement dimension must not exceed the state dimension");
+
+    if (delay_step >= max_delay_step_) {
+      std::cerr << "delay step is larger than max_delay_step. ignore update." << std::endl;
+      return false;
+    }
+
+    /*
+     * The extended measurement matrix C_ex only has C in the block column of the delayed state, so
+     * P * C_ex^T and C_ex * P are the block column and row of that state multiplied by C.
+     */
+    const int offset = blockOffset(delay_step);
+    auto PCT = PCT_.template leftCols<DimY>();
+    auto K = K_.template leftCols<DimY>();
+    auto CP = CP_.template topRows<DimY>();
+
+    PCT.noalias() = P_.template middleCols<DimX>(offset) * C.transpose();
+    MeasurementCovariance<DimY> S = R;
+    S.noalias() += C * PCT.template middleRows<DimX>(offset);
+    const MeasurementCovariance<DimY> S_inv = S.inverse();
+    K.noalias() = PCT * S_inv;
+
+    if (K.array().isNaN().any() || K.array().isInf().any()) {
+      return false;
+    }
+
+    MeasurementVector<DimY> innovation = y;
+    innovation.noalias() -= C * x_.template segment<DimX>(offset);
+    CP.noalias() = C * P_.template middleRows<DimX>(offset);
+
+    x_.noalias() += K * innovation;
+    P_.noalias() -= K * CP;
+
+    return true;
+  }
+
+private:
+  /**
+   * @brief get the offset of the block of the state delayed by delay_step in x_ and P_
+   */
+  int blockOffset(const int delay_step) const
+  {
+    return ((head_ + delay_step) % max_delay_step_) * DimX;
+  }
+
+  Eigen::VectorXd x_;    //!< @brief extended state, stored as a ring buffer of DimX blocks
+  Eigen::MatrixXd P_;    //!< @brief extended covariance, stored with the same block order as x_
+  Eigen::MatrixXd PCT_;  //!< @brief buffer for P * C_ex^T, whose first DimY columns are used
+  Eigen::MatrixXd K_;    //!< @brief buffer for kalman gain, whose first DimY columns are used
+  Eigen::MatrixXd CP_;   //!< @brief buffer for C_ex * P, whose first DimY rows are used
+
+  int max_delay_step_{0};  //!< @brief maximum number of delay steps
+  int dim_x_ex_{0};        //!< @brief dimension of extended state with dime delay
+  int head_{0};            //!< @brief index of the block of the latest state
+};
+}  // namespace autoware::kalman_filter
+#endif  // AUTOWARE__KALMAN_FILTER__FIXED_SIZE_TIME_DELAY_KALMAN_FILTER_HPP_
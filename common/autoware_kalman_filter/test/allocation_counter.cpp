@@ -0,0 +1,81 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+
+// Eigen allocates with malloc instead of operator new, so the allocation functions of glibc are
+// replaced in this executable to count all heap allocations including the ones in the library.
+// Every operator new of libstdc++ ends up in one of them, the aligned ones in aligned_alloc.
+extern "C" {
+void * __libc_malloc(size_t size);                      // NOLINT
+void * __libc_calloc(size_t n, size_t size);            // NOLINT
+void * __libc_realloc(void * ptr, size_t size);         // NOLINT
+void * __libc_memalign(size_t alignment, size_t size);  // NOLINT
+void __libc_free(void * ptr);                           // NOLINT
+}
+
+namespace
+{
+std::atomic<size_t> count{0};
+}  // namespace
+
+extern "C" {
+void * malloc(size_t size)  // NOLINT
+{
+  ++count;
+  return __libc_malloc(size);
+}
+
+void * calloc(size_t n, size_t size)  // NOLINT
+{
+  ++count;
+  return __libc_calloc(n, size);
+}
+
+void * realloc(void * ptr, size_t size)  // NOLINT
+{
+  ++count;
+  return __libc_realloc(ptr, size);
+}
+
+void * aligned_alloc(size_t alignment, size_t size)  // NOLINT
+{
+  ++count;
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void ** ptr, size_t alignment, size_t size)  // NOLINT
+{
+  ++count;
+  *ptr = __libc_memalign(alignment, size);
+  return *ptr == nullptr && size != 0 ? ENOMEM : 0;
+}
+
+void free(void * ptr)  // NOLINT
+{
+  __libc_free(ptr);
+}
+}
+
+namespace autoware::kalman_filter::test
+{
+size_t allocation_count()
+{
+  return count.load();
+}
+}  // namespace autoware::kalman_filter::test
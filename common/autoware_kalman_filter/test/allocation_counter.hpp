@@ -0,0 +1,29 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ALLOCATION_COUNTER_HPP_
+#define ALLOCATION_COUNTER_HPP_
+
+#include <cstddef>
+
+namespace autoware::kalman_filter::test
+{
+/**
+ * @brief number of calls to malloc, calloc, realloc, aligned_alloc and posix_memalign in the test
+ * executable
+ */
+size_t allocation_count();
+}  // namespace autoware::kalman_filter::test
+
+#endif  // ALLOCATION_COUNTER_HPP_
@@ -0,0 +1,208 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "allocation_counter.hpp"
+#include "autoware/kalman_filter/fixed_size_time_delay_kalman_filter.hpp"
+#include "autoware/kalman_filter/time_delay_kalman_filter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+using autoware::kalman_filter::FixedSizeTimeDelayKalmanFilter;
+using autoware::kalman_filter::TimeDelayKalmanFilter;
+using autoware::kalman_filter::test::allocation_count;
+
+namespace
+{
+constexpr int dim_x = 6;
+using Filter = FixedSizeTimeDelayKalmanFilter<dim_x>;
+
+template <int Rows, int Cols>
+Eigen::Matrix<double, Rows, Cols> random_matrix(std::mt19937 & engine)
+{
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  Eigen::Matrix<double, Rows, Cols> m;
+  for (int i = 0; i < Rows; ++i) {
+    for (int j = 0; j < Cols; ++j) {
+      m(i, j) = dist(engine);
+    }
+  }
+  return m;
+}
+
+template <int Dim>
+Eigen::Matrix<double, Dim, Dim> random_covariance(std::mt19937 & engine)
+{
+  const Eigen::Matrix<double, Dim, Dim> m = random_matrix<Dim, Dim>(engine);
+  return m * m.transpose() + Eigen::Matrix<double, Dim, Dim>::Identity() * 0.1;
+}
+
+Eigen::Matrix<double, 3, dim_x> pose_matrix()
+{
+  Eigen::Matrix<double, 3, dim_x> c = Eigen::Matrix<double, 3, dim_x>::Zero();
+  c(0, 0) = c(1, 1) = c(2, 2) = 1.0;
+  return c;
+}
+
+Eigen::Matrix<double, 2, dim_x> twist_matrix()
+{
+  Eigen::Matrix<double, 2, dim_x> c = Eigen::Matrix<double, 2, dim_x>::Zero();
+  c(0, 4) = c(1, 5) = 1.0;
+  return c;
+}
+}  // namespace
+
+TEST(fixed_size_time_delay_kalman_filter, same_as_time_delay_kalman_filter)
+{
+  std::mt19937 engine(0);
+  const int max_delay_step = 10;
+
+  const Filter::StateVector x0 = random_matrix<dim_x, 1>(engine);
+  const Filter::StateMatrix p0 = random_covariance<dim_x>(engine);
+
+  TimeDelayKalmanFilter expected;
+  Filter actual;
+  expected.init(x0, p0, max_delay_step);
+  actual.init(x0, p0, max_delay_step);
+
+  std::uniform_int_distribution<int> delay_dist(0, max_delay_step - 1);
+
+  for (int step = 0; step < 100; ++step) {
+    const Filter::StateVector x_next = random_matrix<dim_x, 1>(engine);
+    const Filter::StateMatrix a =
+      Filter::StateMatrix::Identity() + 0.1 * random_matrix<dim_x, dim_x>(engine);
+    const Filter::StateMatrix q = 0.01 * random_covariance<dim_x>(engine);
+    EXPECT_TRUE(expected.predictWithDelay(x_next, a, q));
+    EXPECT_TRUE(actual.predictWithDelay(x_next, a, q));
+
+    const int delay_step = delay_dist(engine);
+    if (step % 2 == 0) {
+      const Eigen::Vector3d y = random_matrix<3, 1>(engine);
+      const Eigen::Matrix3d r = random_covariance<3>(engine);
+      EXPECT_EQ(
+        expected.updateWithDelay(y, pose_matrix(), r, delay_step),
+        actual.updateWithDelay(y, pose_matrix(), r, delay_step));
+    } else {
+      const Eigen::Vector2d y = random_matrix<2, 1>(engine);
+      const Eigen::Matrix2d r = random_covariance<2>(engine);
+      EXPECT_EQ(
+        expected.updateWithDelay(y, twist_matrix(), r, delay_step),
+        actual.updateWithDelay(y, twist_matrix(), r, delay_step));
+    }
+
+    Eigen::MatrixXd x_expected;
+    Eigen::MatrixXd p_expected;
+    Eigen::MatrixXd x_actual;
+    Eigen::MatrixXd p_actual;
+    expected.getX(x_expected);
+    expected.getP(p_expected);
+    actual.getX(x_actual);
+    actual.getP(p_actual);
+
+    ASSERT_TRUE(x_actual.isApprox(x_expected, 1e-10)) << "step: " << step;
+    ASSERT_TRUE(p_actual.isApprox(p_expected, 1e-10)) << "step: " << step;
+    for (int i = 0; i < dim_x * max_delay_step; ++i) {
+      EXPECT_NEAR(actual.getXelement(i), expected.getXelement(i), 1e-10);
+    }
+  }
+}
+
+TEST(fixed_size_time_delay_kalman_filter, ignore_invalid_update)
+{
+  Filter kf;
+  kf.init(Filter::StateVector::Zero(), Filter::StateMatrix::Identity(), 5);
+
+  // delay step exceeds the buffer
+  EXPECT_FALSE(kf.updateWithDelay(
+    Eigen::Vector2d::Ones().eval(), twist_matrix(), Eigen::Matrix2d::Identity().eval(), 5));
+  // singular innovation covariance
+  EXPECT_FALSE(kf.updateWithDelay(
+    Eigen::Vector2d::Ones().eval(), Eigen::Matrix<double, 2, dim_x>::Zero().eval(),
+    Eigen::Matrix2d::Zero().eval(), 0));
+
+  EXPECT_TRUE(kf.getLatestX().isZero());
+}
+
+TEST(fixed_size_time_delay_kalman_filter, no_allocation_after_init)
+{
+  std::mt19937 engine(0);
+  Filter kf;
+  kf.init(random_matrix<dim_x, 1>(engine), random_covariance<dim_x>(engine), 50);
+
+  const Filter::StateVector x_next = random_matrix<dim_x, 1>(engine);
+  const Filter::StateMatrix a = Filter::StateMatrix::Identity();
+  const Filter::StateMatrix q = 0.01 * random_covariance<dim_x>(engine);
+  const Eigen::Matrix<double, 3, dim_x> c_pose = pose_matrix();
+  const Eigen::Matrix<double, 2, dim_x> c_twist = twist_matrix();
+  const Eigen::Vector3d y_pose = random_matrix<3, 1>(engine);
+  const Eigen::Vector2d y_twist = random_matrix<2, 1>(engine);
+  const Eigen::Matrix3d r_pose = random_covariance<3>(engine);
+  const Eigen::Matrix2d r_twist = random_covariance<2>(engine);
+
+  const size_t count_before = allocation_count();
+  double sum = 0.0;
+  for (int i = 0; i < 10; ++i) {
+    kf.predictWithDelay(x_next, a, q);
+    kf.updateWithDelay(y_pose, c_pose, r_pose, 3);
+    kf.updateWithDelay(y_twist, c_twist, r_twist, 1);
+    sum += kf.getLatestX().sum() + kf.getLatestP().sum() + kf.getXelement(3 * dim_x);
+  }
+  EXPECT_EQ(allocation_count() - count_before, 0u);
+  EXPECT_TRUE(std::isfinite(sum));
+}
+
+TEST(fixed_size_time_delay_kalman_filter, DISABLED_benchmark)
+{
+  std::mt19937 engine(0);
+  const Filter::StateVector x0 = random_matrix<dim_x, 1>(engine);
+  const Filter::StateMatrix p0 = random_covariance<dim_x>(engine);
+  const Filter::StateVector x_next = random_matrix<dim_x, 1>(engine);
+  const Filter::StateMatrix a =
+    Filter::StateMatrix::Identity() + 0.01 * random_matrix<dim_x, dim_x>(engine);
+  const Filter::StateMatrix q = 0.01 * random_covariance<dim_x>(engine);
+  const Eigen::Matrix<double, 3, dim_x> c_pose = pose_matrix();
+  const Eigen::Matrix<double, 2, dim_x> c_twist = twist_matrix();
+  const Eigen::Vector3d y_pose = random_matrix<3, 1>(engine);
+  const Eigen::Vector2d y_twist = random_matrix<2, 1>(engine);
+  const Eigen::Matrix3d r_pose = random_covariance<3>(engine);
+  const Eigen::Matrix2d r_twist = random_covariance<2>(engine);
+
+  // One cycle corresponds to an EKF timer tick with a pose and a twist measurement
+  const auto run = [&](auto & kf, const int max_delay_step) {
+    constexpr int nb_iteration = 1000;
+    kf.init(x0, p0, max_delay_step);
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nb_iteration; ++i) {
+      kf.predictWithDelay(x_next, a, q);
+      kf.updateWithDelay(y_pose, c_pose, r_pose, max_delay_step / 2);
+      kf.updateWithDelay(y_twist, c_twist, r_twist, 1);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / nb_iteration;
+  };
+
+  for (const int max_delay_step : {10, 25, 50, 100}) {
+    TimeDelayKalmanFilter dense;
+    Filter fixed_size;
+    const double dense_time = run(dense, max_delay_step);
+    const double fixed_size_time = run(fixed_size, max_delay_step);
+    std::cout << "max_delay_step: " << max_delay_step << ", TimeDelayKalmanFilter: " << dense_time
+              << " [us/cycle], FixedSizeTimeDelayKalmanFilter: " << fixed_size_time
+              << " [us/cycle]" << std::endl;
+  }
+}
@@ -0,0 +1,71 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__WORKER_POOL__WORKER_POOL_HPP_
+#define AUTOWARE__WORKER_POOL__WORKER_POOL_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace autoware::worker_pool
+{
+/** \brief Threads which are kept alive across the messages, so that the per-message work is not
+ * delayed by the thread creation. The calling thread also takes the tasks, so thread_num - 1
+ * threads are started. */
+class WorkerPool
+{
+public:
+  explicit WorkerPool(const size_t thread_num);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  size_t getThreadNum() const { return workers_.size() + 1; }
+
+  /** \brief Call task(i) for each i in [0, task_num) on the threads and return after all of them
+   * are done. The tasks are taken in any order, so each of them must write to its own output.
+   * If a task throws, the tasks not started yet are skipped and the first exception is rethrown
+   * on the calling thread. */
+  void run(const size_t task_num, const std::function<void(size_t)> & task);
+
+private:
+  void work();
+  void runTasks();
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_cv_;
+  std::condition_variable done_cv_;
+
+  // the current run, which is set under mutex_ before the workers are woken up
+  const std::function<void(size_t)> * task_{nullptr};
+  size_t task_num_{0};
+  std::atomic<size_t> next_task_{0};
+  size_t generation_{0};
+  size_t running_worker_num_{0};
+  bool stop_{false};
+
+  // the first exception thrown by a task of the current run, which is set under mutex_
+  std::exception_ptr exception_{nullptr};
+};
+}  // namespace autoware::worker_pool
+
+#endif  // AUTOWARE__WORKER_POOL__WORKER_POOL_HPP_
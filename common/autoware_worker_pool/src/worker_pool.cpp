@@ -0,0 +1,109 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/worker_pool/worker_pool.hpp"
+
+#include <utility>
+
+namespace autoware::worker_pool
+{
+WorkerPool::WorkerPool(const size_t thread_num)
+{
+  for (size_t i = 1; i < thread_num; ++i) {
+    workers_.emplace_back(&WorkerPool::work, this);
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  start_cv_.notify_all();
+  for (auto & worker : workers_) {
+    worker.join();
+  }
+}
+
+void WorkerPool::run(const size_t task_num, const std::function<void(size_t)> & task)
+{
+  if (workers_.empty() || task_num <= 1) {
+    for (size_t i = 0; i < task_num; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  {
+    std::scoped_lock lock(mutex_);
+    task_ = &task;
+    task_num_ = task_num;
+    next_task_.store(0);
+    running_worker_num_ = workers_.size();
+    exception_ = nullptr;
+    ++generation_;
+  }
+  start_cv_.notify_all();
+
+  runTasks();
+
+  // every worker reports even if it took no task, so that none of them sees this run afterwards
+  std::unique_lock lock(mutex_);
+  done_cv_.wait(lock, [this]() { return running_worker_num_ == 0; });
+  task_ = nullptr;
+  if (exception_) {
+    std::rethrow_exception(std::exchange(exception_, nullptr));
+  }
+}
+
+void WorkerPool::work()
+{
+  size_t seen_generation = 0;
+  while (true) {
+    {
+      std::unique_lock lock(mutex_);
+      start_cv_.wait(lock, [&]() { return stop_ || generation_ != seen_generation; });
+      if (stop_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+
+    runTasks();
+
+    {
+      std::scoped_lock lock(mutex_);
+      --running_worker_num_;
+    }
+    done_cv_.notify_one();
+  }
+}
+
+void WorkerPool::runTasks()
+{
+  try {
+    for (size_t i = next_task_.fetch_add(1); i < task_num_; i = next_task_.fetch_add(1)) {
+      (*task_)(i);
+    }
+  } catch (...) {
+    // the other threads finish their current task and take no more
+    next_task_.store(task_num_);
+    std::scoped_lock lock(mutex_);
+    if (!exception_) {
+      exception_ = std::current_exception();
+    }
+  }
+}
+}  // namespace autoware::worker_pool
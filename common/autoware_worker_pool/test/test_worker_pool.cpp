@@ -0,0 +1,60 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/worker_pool/worker_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using autoware::worker_pool::WorkerPool;
+
+TEST(WorkerPool, RunsEveryTaskOnce)
+{
+  for (const size_t thread_num : {1, 2, 4}) {
+    WorkerPool worker_pool(thread_num);
+    EXPECT_EQ(worker_pool.getThreadNum(), thread_num);
+
+    // the pool is reused across the runs
+    for (const size_t task_num : {0, 1, 3, 1000}) {
+      std::vector<int> counts(task_num, 0);
+      worker_pool.run(task_num, [&](const size_t i) { ++counts[i]; });
+      EXPECT_EQ(counts, std::vector<int>(task_num, 1)) << "thread_num: " << thread_num;
+    }
+  }
+}
+
+TEST(WorkerPool, RethrowsTheExceptionOfATask)
+{
+  for (const size_t thread_num : {1, 4}) {
+    WorkerPool worker_pool(thread_num);
+    EXPECT_THROW(
+      worker_pool.run(
+        100,
+        [](const size_t i) {
+          if (i == 42) {
+            throw std::runtime_error("task failed");
+          }
+        }),
+      std::runtime_error);
+
+    // the pool is still usable after the failed run
+    std::atomic<size_t> count{0};
+    worker_pool.run(100, [&](const size_t) { ++count; });
+    EXPECT_EQ(count.load(), 100u) << "thread_num: " << thread_num;
+  }
+}
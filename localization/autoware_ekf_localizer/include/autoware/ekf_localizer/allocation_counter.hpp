@@ -0,0 +1,39 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__EKF_LOCALIZER__ALLOCATION_COUNTER_HPP_
+#define AUTOWARE__EKF_LOCALIZER__ALLOCATION_COUNTER_HPP_
+
+#include <cstddef>
+
+namespace autoware::ekf_localizer
+{
+
+/**
+ * @brief whether heap allocations are counted
+ *
+ * The allocation functions called from this package are wrapped at link time, which is only
+ * available with the GNU linker. Allocations made inside other libraries (rclcpp, DDS, ...) are
+ * not counted.
+ */
+bool is_allocation_counter_enabled();
+
+/**
+ * @brief number of heap allocations made by the code of this package in the calling thread
+ */
+size_t thread_allocation_count();
+
+}  // namespace autoware::ekf_localizer
+
+#endif  // AUTOWARE__EKF_LOCALIZER__ALLOCATION_COUNTER_HPP_
@@ -19,6 +19,7 @@
 #include "autoware/ekf_localizer/state_index.hpp"
 #include "autoware/ekf_localizer/warning.hpp"
 
+#include <autoware/kalman_filter/fixed_size_time_delay_kalman_filter.hpp>
 #include <autoware/kalman_filter/kalman_filter.hpp>
 #include <autoware/kalman_filter/time_delay_kalman_filter.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -35,6 +36,7 @@
 
 namespace autoware::ekf_localizer
 {
+using autoware::kalman_filter::FixedSizeTimeDelayKalmanFilter;
 using autoware::kalman_filter::TimeDelayKalmanFilter;
 
 struct EKFDiagnosticInfo
@@ -131,7 +133,7 @@ private:
   void update_simple_1d_filters(
     const geometry_msgs::msg::PoseWithCovarianceStamped & pose, const size_t smoothing_step);
 
-  TimeDelayKalmanFilter kalman_filter_;
+  FixedSizeTimeDelayKalmanFilter<6> kalman_filter_;  // x, y, yaw, yaw_bias, vx, wz
 
   std::shared_ptr<Warning> warning_;
   const int dim_x_;
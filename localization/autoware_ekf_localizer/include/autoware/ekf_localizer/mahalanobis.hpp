@@ -26,6 +26,15 @@ double squared_mahalanobis(
 
 double mahalanobis(const Eigen::VectorXd & x, const Eigen::VectorXd & y, const Eigen::MatrixXd & C);
 
+// Fixed-size overloads for the pose and twist measurements, which do not allocate memory
+double squared_mahalanobis(
+  const Eigen::Vector2d & x, const Eigen::Vector2d & y, const Eigen::Matrix2d & C);
+double squared_mahalanobis(
+  const Eigen::Vector3d & x, const Eigen::Vector3d & y, const Eigen::Matrix3d & C);
+
+double mahalanobis(const Eigen::Vector2d & x, const Eigen::Vector2d & y, const Eigen::Matrix2d & C);
+double mahalanobis(const Eigen::Vector3d & x, const Eigen::Vector3d & y, const Eigen::Matrix3d & C);
+
 }  // namespace autoware::ekf_localizer
 
 #endif  // AUTOWARE__EKF_LOCALIZER__MAHALANOBIS_HPP_
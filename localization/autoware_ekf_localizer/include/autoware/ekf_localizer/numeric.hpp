@@ -22,12 +22,14 @@
 namespace autoware::ekf_localizer
 {
 
-inline bool has_inf(const Eigen::MatrixXd & v)
+template <typename Derived>
+bool has_inf(const Eigen::MatrixBase<Derived> & v)
 {
   return v.array().isInf().any();
 }
 
-inline bool has_nan(const Eigen::MatrixXd & v)
+template <typename Derived>
+bool has_nan(const Eigen::MatrixBase<Derived> & v)
 {
   return v.array().isNaN().any();
 }
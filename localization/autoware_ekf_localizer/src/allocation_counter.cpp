@@ -0,0 +1,154 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/ekf_localizer/allocation_counter.hpp"
+
+#include <cstddef>
+
+namespace
+{
+thread_local size_t allocation_count = 0;
+}  // namespace
+
+#ifdef EKF_LOCALIZER_COUNT_ALLOCATIONS
+// The library is linked with --wrap for these symbols (see CMakeLists.txt), so that the calls from
+// this package go through the functions below and the original ones are called as __real_*.
+// Every replaceable operator new is wrapped, including the aligned ones which Eigen uses for
+// over-aligned types, and the nothrow ones. The std::align_val_t and std::nothrow_t arguments are
+// passed as size_t and as a pointer in the C calling convention.
+extern "C" {
+void * __real_malloc(size_t size);                                      // NOLINT
+void * __real_calloc(size_t n, size_t size);                            // NOLINT
+void * __real_realloc(void * ptr, size_t size);                         // NOLINT
+void * __real_aligned_alloc(size_t alignment, size_t size);             // NOLINT
+int __real_posix_memalign(void ** ptr, size_t alignment, size_t size);  // NOLINT
+void * __real__Znwm(size_t size);                                       // NOLINT
+void * __real__Znam(size_t size);                                       // NOLINT
+void * __real__ZnwmRKSt9nothrow_t(size_t size, const void * tag);       // NOLINT
+void * __real__ZnamRKSt9nothrow_t(size_t size, const void * tag);       // NOLINT
+void * __real__ZnwmSt11align_val_t(size_t size, size_t alignment);      // NOLINT
+void * __real__ZnamSt11align_val_t(size_t size, size_t alignment);      // NOLINT
+void * __real__ZnwmSt11align_val_tRKSt9nothrow_t(  // NOLINT
+  size_t size, size_t alignment, const void * tag);
+void * __real__ZnamSt11align_val_tRKSt9nothrow_t(  // NOLINT
+  size_t size, size_t alignment, const void * tag);
+
+void * __wrap_malloc(size_t size)  // NOLINT
+{
+  ++allocation_count;
+  return __real_malloc(size);
+}
+
+void * __wrap_calloc(size_t n, size_t size)  // NOLINT
+{
+  ++allocation_count;
+  return __real_calloc(n, size);
+}
+
+void * __wrap_realloc(void * ptr, size_t size)  // NOLINT
+{
+  ++allocation_count;
+  return __real_realloc(ptr, size);
+}
+
+void * __wrap_aligned_alloc(size_t alignment, size_t size)  // NOLINT
+{
+  ++allocation_count;
+  return __real_aligned_alloc(alignment, size);
+}
+
+int __wrap_posix_memalign(void ** ptr, size_t alignment, size_t size)  // NOLINT
+{
+  ++allocation_count;
+  return __real_posix_memalign(ptr, alignment, size);
+}
+
+// operator new(size_t)
+void * __wrap__Znwm(size_t size)  // NOLINT
+{
+  ++allocation_count;
+  return __real__Znwm(size);
+}
+
+// operator new[](size_t)
+void * __wrap__Znam(size_t size)  // NOLINT
+{
+  ++allocation_count;
+  return __real__Znam(size);
+}
+
+// operator new(size_t, const std::nothrow_t &)
+void * __wrap__ZnwmRKSt9nothrow_t(size_t size, const void * tag)  // NOLINT
+{
+  ++allocation_count;
+  return __real__ZnwmRKSt9nothrow_t(size, tag);
+}
+
+// operator new[](size_t, const std::nothrow_t &)
+void * __wrap__ZnamRKSt9nothrow_t(size_t size, const void * tag)  // NOLINT
+{
+  ++allocation_count;
+  return __real__ZnamRKSt9nothrow_t(size, tag);
+}
+
+// operator new(size_t, std::align_val_t)
+void * __wrap__ZnwmSt11align_val_t(size_t size, size_t alignment)  // NOLINT
+{
+  ++allocation_count;
+  return __real__ZnwmSt11align_val_t(size, alignment);
+}
+
+// operator new[](size_t, std::align_val_t)
+void * __wrap__ZnamSt11align_val_t(size_t size, size_t alignment)  // NOLINT
+{
+  ++allocation_count;
+  return __real__ZnamSt11align_val_t(size, alignment);
+}
+
+// operator new(size_t, std::align_val_t, const std::nothrow_t &)
+void * __wrap__ZnwmSt11align_val_tRKSt9nothrow_t(  // NOLINT
+  size_t size, size_t alignment, const void * tag)
+{
+  ++allocation_count;
+  return __real__ZnwmSt11align_val_tRKSt9nothrow_t(size, alignment, tag);
+}
+
+// operator new[](size_t, std::align_val_t, const std::nothrow_t &)
+void * __wrap__ZnamSt11align_val_tRKSt9nothrow_t(  // NOLINT
+  size_t size, size_t alignment, const void * tag)
+{
+  ++allocation_count;
+  return __real__ZnamSt11align_val_tRKSt9nothrow_t(size, alignment, tag);
+}
+}
+#endif
+
+namespace autoware::ekf_localizer
+{
+
+bool is_allocation_counter_enabled()
+{
+#ifdef EKF_LOCALIZER_COUNT_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+size_t thread_allocation_count()
+{
+  return allocation_count;
+}
+
+}  // namespace autoware::ekf_localizer
@@ -14,6 +14,7 @@
 
 #include "autoware/ekf_localizer/ekf_localizer.hpp"
 
+#include "autoware/ekf_localizer/allocation_counter.hpp"
 #include "autoware/ekf_localizer/diagnostics.hpp"
 #include "autoware/ekf_localizer/string.hpp"
 #include "autoware/ekf_localizer/warning_message.hpp"
@@ -77,6 +78,8 @@ EKFLocalizer::EKFLocalizer(const rclcpp::NodeOptions & node_options)
   pub_diag_ = this->create_publisher<diagnostic_msgs::msg::DiagnosticArray>("/diagnostics", 10);
   pub_processing_time_ = create_publisher<autoware_internal_debug_msgs::msg::Float64Stamped>(
     "debug/processing_time_ms", 1);
+  pub_allocation_count_ = create_publisher<autoware_internal_debug_msgs::msg::Int32Stamped>(
+    "debug/allocation_count", 1);
   sub_initialpose_ = create_subscription<geometry_msgs::msg::PoseWithCovarianceStamped>(
     "initialpose", 1, std::bind(&EKFLocalizer::callback_initial_pose, this, _1));
   sub_pose_with_cov_ = create_subscription<geometry_msgs::msg::PoseWithCovarianceStamped>(
@@ -162,7 +165,11 @@ void EKFLocalizer::timer_callback()
   /* predict model in EKF */
   stop_watch_.tic();
   DEBUG_INFO(get_logger(), "------------------------- start prediction -------------------------");
+  // count the heap allocations only in the EKF computation, excluding the queues and publishers
+  size_t allocation_count = 0;
+  size_t allocation_count_start = thread_allocation_count();
   ekf_module_->predict_with_delay(ekf_dt_);
+  allocation_count += thread_allocation_count() - allocation_count_start;
   DEBUG_INFO(get_logger(), "[EKF] predictKinematicsModel calc time = %f [ms]", stop_watch_.toc());
   DEBUG_INFO(get_logger(), "------------------------- end prediction -------------------------\n");
 
@@ -184,7 +191,9 @@ void EKFLocalizer::timer_callback()
     const size_t n = pose_queue_.size();
     for (size_t i = 0; i < n; ++i) {
       const auto pose = pose_queue_.pop_increment_age();
+      allocation_count_start = thread_allocation_count();
       bool is_updated = ekf_module_->measurement_update_pose(*pose, current_time, pose_diag_info_);
+      allocation_count += thread_allocation_count() - allocation_count_start;
       if (is_updated) {
         pose_is_updated = true;
       }
@@ -213,8 +222,10 @@ void EKFLocalizer::timer_callback()
     const size_t n = twist_queue_.size();
     for (size_t i = 0; i < n; ++i) {
       const auto twist = twist_queue_.pop_increment_age();
+      allocation_count_start = thread_allocation_count();
       bool is_updated =
         ekf_module_->measurement_update_twist(*twist, current_time, twist_diag_info_);
+      allocation_count += thread_allocation_count() - allocation_count_start;
       if (is_updated) {
         twist_is_updated = true;
       }
@@ -242,6 +253,12 @@ void EKFLocalizer::timer_callback()
     autoware_internal_debug_msgs::build<autoware_internal_debug_msgs::msg::Float64Stamped>()
       .stamp(current_time)
       .data(elapsed_time));
+  if (is_allocation_counter_enabled()) {
+    pub_allocation_count_->publish(
+      autoware_internal_debug_msgs::build<autoware_internal_debug_msgs::msg::Int32Stamped>()
+        .stamp(current_time)
+        .data(static_cast<int32_t>(allocation_count)));
+  }
 }
 
 /*
@@ -46,9 +46,9 @@ EKFModule::EKFModule(std::shared_ptr<Warning> warning, const HyperParameters & p
   params_(params),
   last_angular_velocity_(0.0, 0.0, 0.0)
 {
-  Eigen::MatrixXd x = Eigen::MatrixXd::Zero(dim_x_, 1);
-  Eigen::MatrixXd p = Eigen::MatrixXd::Identity(dim_x_, dim_x_) * 1.0E15;  // for x & y
-  p(IDX::YAW, IDX::YAW) = 50.0;                                            // for yaw
+  Vector6d x = Vector6d::Zero();
+  Matrix6d p = Matrix6d::Identity() * 1.0E15;  // for x & y
+  p(IDX::YAW, IDX::YAW) = 50.0;                // for yaw
   if (params_.enable_yaw_bias_estimation) {
     p(IDX::YAWB, IDX::YAWB) = 50.0;  // for yaw bias
   }
@@ -64,8 +64,8 @@ EKFModule::EKFModule(std::shared_ptr<Warning> warning, const HyperParameters & p
 void EKFModule::initialize(
   const PoseWithCovariance & initial_pose, const geometry_msgs::msg::TransformStamped & transform)
 {
-  Eigen::MatrixXd x(dim_x_, 1);
-  Eigen::MatrixXd p = Eigen::MatrixXd::Zero(dim_x_, dim_x_);
+  Vector6d x;
+  Matrix6d p = Matrix6d::Zero();
 
   x(IDX::X) = initial_pose.pose.pose.position.x + transform.transform.translation.x;
   x(IDX::Y) = initial_pose.pose.pose.position.y + transform.transform.translation.y;
@@ -214,8 +214,7 @@ void EKFModule::accumulate_delay_time(const double dt)
 
 void EKFModule::predict_with_delay(const double dt)
 {
-  const Eigen::MatrixXd x_curr = kalman_filter_.getLatestX();
-  const Eigen::MatrixXd p_curr = kalman_filter_.getLatestP();
+  const Vector6d x_curr = kalman_filter_.getLatestX();
 
   const double proc_cov_vx_d = std::pow(params_.proc_stddev_vx_c * dt, 2.0);
   const double proc_cov_wz_d = std::pow(params_.proc_stddev_wz_c * dt, 2.0);
@@ -238,7 +237,7 @@ bool EKFModule::measurement_update_pose(
         pose.header.frame_id.c_str(), params_.pose_frame_id.c_str()),
       2000);
   }
-  const Eigen::MatrixXd x_curr = kalman_filter_.getLatestX();
+  const Vector6d x_curr = kalman_filter_.getLatestX();
   DEBUG_PRINT_MAT(x_curr.transpose());
 
   constexpr int dim_y = 3;  // pos_x, pos_y, yaw, depending on Pose output
@@ -273,8 +272,7 @@ bool EKFModule::measurement_update_pose(
   yaw = yaw_error + ekf_yaw;
 
   /* Set measurement matrix */
-  Eigen::MatrixXd y(dim_y, 1);
-  y << pose.pose.pose.position.x, pose.pose.pose.position.y, yaw;
+  const Eigen::Vector3d y(pose.pose.pose.position.x, pose.pose.pose.position.y, yaw);
 
   if (has_nan(y) || has_inf(y)) {
     warning_->warn(
@@ -286,8 +284,8 @@ bool EKFModule::measurement_update_pose(
   const Eigen::Vector3d y_ekf(
     kalman_filter_.getXelement(delay_step * dim_x_ + IDX::X),
     kalman_filter_.getXelement(delay_step * dim_x_ + IDX::Y), ekf_yaw);
-  const Eigen::MatrixXd p_curr = kalman_filter_.getLatestP();
-  const Eigen::MatrixXd p_y = p_curr.block(0, 0, dim_y, dim_y);
+  const Matrix6d p_curr = kalman_filter_.getLatestP();
+  const Eigen::Matrix3d p_y = p_curr.block<dim_y, dim_y>(0, 0);
 
   const double distance = mahalanobis(y_ekf, y, p_y);
   pose_diag_info.mahalanobis_distance = std::max(distance, pose_diag_info.mahalanobis_distance);
@@ -315,7 +313,7 @@ bool EKFModule::measurement_update_pose(
   update_simple_1d_filters(pose_with_rph_delay_compensation, params_.pose_smoothing_steps);
 
   // debug
-  const Eigen::MatrixXd x_result = kalman_filter_.getLatestX();
+  const Vector6d x_result = kalman_filter_.getLatestX();
   DEBUG_PRINT_MAT(x_result.transpose());
   DEBUG_PRINT_MAT((x_result - x_curr).transpose());
 
@@ -367,7 +365,7 @@ bool EKFModule::measurement_update_twist(
 
   last_angular_velocity_ = tf2::Vector3(0.0, 0.0, 0.0);
 
-  const Eigen::MatrixXd x_curr = kalman_filter_.getLatestX();
+  const Vector6d x_curr = kalman_filter_.getLatestX();
   DEBUG_PRINT_MAT(x_curr.transpose());
 
   constexpr int dim_y = 2;  // vx, wz
@@ -393,8 +391,7 @@ bool EKFModule::measurement_update_twist(
   }
 
   /* Set measurement matrix */
-  Eigen::MatrixXd y(dim_y, 1);
-  y << twist.twist.twist.linear.x, twist.twist.twist.angular.z;
+  const Eigen::Vector2d y(twist.twist.twist.linear.x, twist.twist.twist.angular.z);
 
   if (has_nan(y) || has_inf(y)) {
     warning_->warn(
@@ -405,8 +402,8 @@ bool EKFModule::measurement_update_twist(
   const Eigen::Vector2d y_ekf(
     kalman_filter_.getXelement(delay_step * dim_x_ + IDX::VX),
     kalman_filter_.getXelement(delay_step * dim_x_ + IDX::WZ));
-  const Eigen::MatrixXd p_curr = kalman_filter_.getLatestP();
-  const Eigen::MatrixXd p_y = p_curr.block(4, 4, dim_y, dim_y);
+  const Matrix6d p_curr = kalman_filter_.getLatestP();
+  const Eigen::Matrix2d p_y = p_curr.block<dim_y, dim_y>(IDX::VX, IDX::VX);
 
   const double distance = mahalanobis(y_ekf, y, p_y);
   twist_diag_info.mahalanobis_distance = std::max(distance, twist_diag_info.mahalanobis_distance);
@@ -431,7 +428,7 @@ bool EKFModule::measurement_update_twist(
     twist.twist.twist.angular.x, twist.twist.twist.angular.y, twist.twist.twist.angular.z);
 
   // debug
-  const Eigen::MatrixXd x_result = kalman_filter_.getLatestX();
+  const Vector6d x_result = kalman_filter_.getLatestX();
   DEBUG_PRINT_MAT(x_result.transpose());
   DEBUG_PRINT_MAT((x_result - x_curr).transpose());
 
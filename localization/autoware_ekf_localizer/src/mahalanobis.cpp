@@ -17,11 +17,32 @@
 namespace autoware::ekf_localizer
 {
 
+namespace
+{
+template <typename Vector, typename Matrix>
+double squared_mahalanobis_impl(const Vector & x, const Vector & y, const Matrix & C)
+{
+  const Vector d = x - y;
+  return d.dot(C.inverse() * d);
+}
+}  // namespace
+
 double squared_mahalanobis(
   const Eigen::VectorXd & x, const Eigen::VectorXd & y, const Eigen::MatrixXd & C)
 {
-  const Eigen::VectorXd d = x - y;
-  return d.dot(C.inverse() * d);
+  return squared_mahalanobis_impl(x, y, C);
+}
+
+double squared_mahalanobis(
+  const Eigen::Vector2d & x, const Eigen::Vector2d & y, const Eigen::Matrix2d & C)
+{
+  return squared_mahalanobis_impl(x, y, C);
+}
+
+double squared_mahalanobis(
+  const Eigen::Vector3d & x, const Eigen::Vector3d & y, const Eigen::Matrix3d & C)
+{
+  return squared_mahalanobis_impl(x, y, C);
 }
 
 double mahalanobis(const Eigen::VectorXd & x, const Eigen::VectorXd & y, const Eigen::MatrixXd & C)
@@ -29,4 +50,14 @@ double mahalanobis(const Eigen::VectorXd & x, const Eigen::VectorXd & y, const E
   return std::sqrt(squared_mahalanobis(x, y, C));
 }
 
+double mahalanobis(const Eigen::Vector2d & x, const Eigen::Vector2d & y, const Eigen::Matrix2d & C)
+{
+  return std::sqrt(squared_mahalanobis(x, y, C));
+}
+
+double mahalanobis(const Eigen::Vector3d & x, const Eigen::Vector3d & y, const Eigen::Matrix3d & C)
+{
+  return std::sqrt(squared_mahalanobis(x, y, C));
+}
+
 }  // namespace autoware::ekf_localizer
@@ -0,0 +1,67 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/ekf_localizer/allocation_counter.hpp"
+#include "autoware/ekf_localizer/mahalanobis.hpp"
+#include "autoware/ekf_localizer/measurement.hpp"
+#include "autoware/ekf_localizer/state_transition.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace autoware::ekf_localizer
+{
+
+TEST(AllocationCounter, CountDynamicSizeMatrix)
+{
+  if (!is_allocation_counter_enabled()) {
+    GTEST_SKIP() << "allocation counter is not available";
+  }
+
+  const Eigen::VectorXd x = Eigen::VectorXd::Ones(3);
+  const Eigen::VectorXd y = Eigen::VectorXd::Zero(3);
+  const Eigen::MatrixXd c = Eigen::MatrixXd::Identity(3, 3);
+
+  const size_t count_before = thread_allocation_count();
+  EXPECT_NEAR(squared_mahalanobis(x, y, c), 3.0, 1e-8);
+  EXPECT_GT(thread_allocation_count(), count_before);
+}
+
+TEST(AllocationCounter, NoAllocationInFixedSizeModel)
+{
+  if (!is_allocation_counter_enabled()) {
+    GTEST_SKIP() << "allocation counter is not available";
+  }
+
+  Vector6d x = Vector6d::Zero();
+  x(4) = 1.0;
+  std::array<double, 36ul> covariance{};
+  covariance.fill(0.1);
+
+  const size_t count_before = thread_allocation_count();
+  const Vector6d x_next = predict_next_state(x, 0.1);
+  const Matrix6d a = create_state_transition_matrix(x, 0.1);
+  const Matrix6d q = process_noise_covariance(0.1, 0.1, 0.1);
+  const Eigen::Matrix<double, 3, 6> c = pose_measurement_matrix();
+  const Eigen::Matrix3d r = pose_measurement_covariance(covariance, 1);
+  const Eigen::Vector3d y = c * x_next;
+  const Eigen::Vector3d y_ekf = c * a * x;
+  const Eigen::Matrix3d s = r + c * q * c.transpose() + Eigen::Matrix3d::Identity();
+  const double distance = mahalanobis(y, y_ekf, s);
+  EXPECT_EQ(thread_allocation_count(), count_before);
+  EXPECT_GE(distance, 0.0);
+}
+
+}  // namespace autoware::ekf_localizer
@@ -63,4 +63,19 @@ TEST(mahalanobis, SmokeTest)
   }
 }
 
+TEST(squared_mahalanobis, FixedSizeMatchesDynamicSize)
+{
+  const Eigen::Vector3d x(1, 2, 0.5);
+  const Eigen::Vector3d y(-1, 3, 0.1);
+  Eigen::Matrix3d c;
+  c << 4, 1, 0.1, 1, 3, 0.2, 0.1, 0.2, 0.5;
+
+  const Eigen::VectorXd x_dynamic = x;
+  const Eigen::VectorXd y_dynamic = y;
+  const Eigen::MatrixXd c_dynamic = c;
+
+  EXPECT_NEAR(
+    squared_mahalanobis(x, y, c), squared_mahalanobis(x_dynamic, y_dynamic, c_dynamic), tolerance);
+}
+
 }  // namespace autoware::ekf_localizer
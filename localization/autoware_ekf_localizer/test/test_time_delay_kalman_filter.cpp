@@ -0,0 +1,122 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/ekf_localizer/matrix_types.hpp"
+#include "autoware/ekf_localizer/measurement.hpp"
+#include "autoware/ekf_localizer/state_index.hpp"
+#include "autoware/ekf_localizer/state_transition.hpp"
+
+#include <autoware/kalman_filter/fixed_size_time_delay_kalman_filter.hpp>
+#include <autoware/kalman_filter/time_delay_kalman_filter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace autoware::ekf_localizer
+{
+using autoware::kalman_filter::FixedSizeTimeDelayKalmanFilter;
+using autoware::kalman_filter::TimeDelayKalmanFilter;
+
+namespace
+{
+// Check the latest state and covariance, and all the delayed states
+template <typename Filter>
+void expect_same_estimation(
+  const TimeDelayKalmanFilter & expected, const Filter & actual, const int dim_x,
+  const int extend_state_step)
+{
+  const Eigen::MatrixXd x_expected = expected.getLatestX();
+  const Eigen::MatrixXd p_expected = expected.getLatestP();
+  const Eigen::MatrixXd x_actual = actual.getLatestX();
+  const Eigen::MatrixXd p_actual = actual.getLatestP();
+  for (int i = 0; i < dim_x; ++i) {
+    ASSERT_NEAR(x_actual(i), x_expected(i), 1e-9 * std::max(1.0, std::abs(x_expected(i))));
+    for (int j = 0; j < dim_x; ++j) {
+      ASSERT_NEAR(
+        p_actual(i, j), p_expected(i, j), 1e-9 * std::max(1.0, std::abs(p_expected(i, j))));
+    }
+  }
+  for (int i = 0; i < dim_x * extend_state_step; ++i) {
+    ASSERT_NEAR(
+      actual.getXelement(i), expected.getXelement(i),
+      1e-9 * std::max(1.0, std::abs(expected.getXelement(i))));
+  }
+}
+}  // namespace
+
+// Run the same sequence as EKFModule with both filters and check that the estimations match
+TEST(TimeDelayKalmanFilter, same_estimation_as_time_delay_kalman_filter)
+{
+  constexpr int dim_x = 6;
+  constexpr int extend_state_step = 50;
+  constexpr double dt = 0.02;
+
+  Vector6d x = Vector6d::Zero();
+  x(IDX::VX) = 5.0;
+  x(IDX::WZ) = 0.1;
+  // same as EKFModule::initialize with an initial pose covariance
+  Matrix6d p = Matrix6d::Zero();
+  p(IDX::X, IDX::X) = 1.0;
+  p(IDX::Y, IDX::Y) = 1.0;
+  p(IDX::YAW, IDX::YAW) = 0.01;
+  p(IDX::YAWB, IDX::YAWB) = 0.0001;
+  p(IDX::VX, IDX::VX) = 0.01;
+  p(IDX::WZ, IDX::WZ) = 0.01;
+
+  TimeDelayKalmanFilter expected;
+  FixedSizeTimeDelayKalmanFilter<dim_x> fixed_size;
+  expected.init(x, p, extend_state_step);
+  fixed_size.init(x, p, extend_state_step);
+
+  std::array<double, 36ul> covariance{};
+  covariance[0] = covariance[7] = covariance[14] = covariance[21] = covariance[28] = 0.01;
+  covariance[35] = 0.01;
+  const Eigen::Matrix<double, 3, 6> c_pose = pose_measurement_matrix();
+  const Eigen::Matrix<double, 2, 6> c_twist = twist_measurement_matrix();
+  const Eigen::Matrix3d r_pose = pose_measurement_covariance(covariance, 1);
+  const Eigen::Matrix2d r_twist = twist_measurement_covariance(covariance, 1);
+  const Matrix6d q = process_noise_covariance(1.0E-6 * dt, 1.0E-5 * dt, 1.0E-5 * dt);
+
+  for (int step = 0; step < 500; ++step) {
+    const Vector6d x_curr = expected.getLatestX();
+    const Vector6d x_next = predict_next_state(x_curr, dt);
+    const Matrix6d a = create_state_transition_matrix(x_curr, dt);
+    expected.predictWithDelay(x_next, a, q);
+    fixed_size.predictWithDelay(x_next, a, q);
+
+    // pose measurement delayed by 5 steps and twist measurement delayed by 1 step
+    if (step % 5 == 0) {
+      const int delay_step = 5;
+      const double t = (step - delay_step) * dt;
+      const Eigen::Vector3d y(5.0 * t + 0.1 * std::sin(t), 0.1 * std::cos(t), 0.1 * t);
+      expected.updateWithDelay(y, c_pose, r_pose, delay_step);
+      fixed_size.updateWithDelay(y, c_pose, r_pose, delay_step);
+    }
+    if (step % 2 == 0) {
+      const Eigen::Vector2d y(5.0 + 0.1 * std::sin(step * dt), 0.1);
+      expected.updateWithDelay(y, c_twist, r_twist, 1);
+      fixed_size.updateWithDelay(y, c_twist, r_twist, 1);
+    }
+
+    expect_same_estimation(expected, fixed_size, dim_x, extend_state_step);
+    if (HasFatalFailure()) {
+      FAIL() << "step: " << step;
+    }
+  }
+}
+
+}  // namespace autoware::ekf_localizer
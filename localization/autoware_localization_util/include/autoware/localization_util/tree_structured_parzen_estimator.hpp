@@ -69,11 +69,16 @@ private:
 
   static std::mt19937_64 engine;
 
-  [[nodiscard]] double compute_log_likelihood_ratio(const Input & input) const;
-  [[nodiscard]] static double log_gaussian_pdf(
-    const Input & input, const Input & mu, const Input & sigma);
+  // log_p is a buffer for the log densities of the input at all the trials
+  [[nodiscard]] double compute_log_likelihood_ratio(
+    const Input & input, std::vector<double> & log_p) const;
 
-  std::vector<Trial> trials_;
+  // The trials are kept sorted from the best score. Only the dimensions used by the KDE are
+  // stored, each in its own array, so that the densities are evaluated over contiguous memory.
+  std::vector<Score> scores_;
+  std::vector<double> trans_x_;
+  std::vector<double> trans_y_;
+  std::vector<double> angle_z_;
   int64_t above_num_;
   const Direction direction_;
   const int64_t n_startup_trials_;
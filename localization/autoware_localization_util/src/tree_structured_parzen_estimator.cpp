@@ -16,14 +16,39 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 #include <limits>
-#include <numeric>
 #include <utility>
 #include <vector>
 
 namespace autoware::localization_util
 {
+namespace
+{
+// Normalize the angle to [-pi, pi)
+double normalize_angle(double angle)
+{
+  while (angle >= M_PI) {
+    angle -= 2 * M_PI;
+  }
+  while (angle < -M_PI) {
+    angle += 2 * M_PI;
+  }
+  return angle;
+}
+
+double log_sum_exp(const double * log_values, const int64_t n)
+{
+  const double max = *std::max_element(log_values, log_values + n);
+  double sum = 0.0;
+  for (int64_t i = 0; i < n; i++) {
+    sum += std::exp(log_values[i] - max);
+  }
+  return max + std::log(sum);
+}
+}  // namespace
+
 // random number generator
 std::mt19937_64 TreeStructuredParzenEstimator::engine(0);
 
@@ -57,13 +82,26 @@ TreeStructuredParzenEstimator::TreeStructuredParzenEstimator(
 
 void TreeStructuredParzenEstimator::add_trial(const Trial & trial)
 {
-  trials_.push_back(trial);
-  std::sort(trials_.begin(), trials_.end(), [this](const Trial & lhs, const Trial & rhs) {
-    return (direction_ == Direction::MAXIMIZE ? lhs.score > rhs.score : lhs.score < rhs.score);
-  });
+  // Insert the trial after the ones with a better or equal score instead of sorting all the
+  // trials again
+  const auto is_better = [this](const Score lhs, const Score rhs) {
+    return (direction_ == Direction::MAXIMIZE ? lhs > rhs : lhs < rhs);
+  };
+  const auto it = std::upper_bound(scores_.begin(), scores_.end(), trial.score, is_better);
+  const auto index = std::distance(scores_.begin(), it);
+
+  // A trial without yaw is regarded as yaw 0
+  const double angle_z =
+    (static_cast<int64_t>(trial.input.size()) > ANGLE_Z) ? trial.input[ANGLE_Z] : 0.0;
+
+  scores_.insert(it, trial.score);
+  trans_x_.insert(trans_x_.begin() + index, trial.input[TRANS_X]);
+  trans_y_.insert(trans_y_.begin() + index, trial.input[TRANS_Y]);
+  angle_z_.insert(angle_z_.begin() + index, normalize_angle(angle_z));
+
   above_num_ = std::min(
     {static_cast<int64_t>(10),
-     static_cast<int64_t>(static_cast<double>(trials_.size()) * max_good_rate)});
+     static_cast<int64_t>(static_cast<double>(scores_.size()) * max_good_rate)});
 }
 
 TreeStructuredParzenEstimator::Input TreeStructuredParzenEstimator::get_next_input() const
@@ -80,7 +118,7 @@ TreeStructuredParzenEstimator::Input TreeStructuredParzenEstimator::get_next_inp
     sample_mean_[ANGLE_Y], sample_stddev_[ANGLE_Y]);
   std::uniform_real_distribution<double> dist_uniform_angle_z(-M_PI, M_PI);
 
-  if (static_cast<int64_t>(trials_.size()) < n_startup_trials_ || above_num_ == 0) {
+  if (static_cast<int64_t>(scores_.size()) < n_startup_trials_ || above_num_ == 0) {
     // Random sampling based on prior until the number of trials reaches `n_startup_trials_`.
     Input input(input_dimension_);
     input[TRANS_X] = dist_normal_trans_x(engine);
@@ -92,17 +130,18 @@ TreeStructuredParzenEstimator::Input TreeStructuredParzenEstimator::get_next_inp
     return input;
   }
 
+  Input input(input_dimension_);
   Input best_input;
   double best_log_likelihood_ratio = std::numeric_limits<double>::lowest();
+  std::vector<double> log_p(scores_.size());
   for (int64_t i = 0; i < n_ei_candidates; i++) {
-    Input input(input_dimension_);
     input[TRANS_X] = dist_normal_trans_x(engine);
     input[TRANS_Y] = dist_normal_trans_y(engine);
     input[TRANS_Z] = dist_normal_trans_z(engine);
     input[ANGLE_X] = dist_normal_angle_x(engine);
     input[ANGLE_Y] = dist_normal_angle_y(engine);
     input[ANGLE_Z] = dist_uniform_angle_z(engine);
-    const double log_likelihood_ratio = compute_log_likelihood_ratio(input);
+    const double log_likelihood_ratio = compute_log_likelihood_ratio(input, log_p);
     if (log_likelihood_ratio > best_log_likelihood_ratio) {
       best_log_likelihood_ratio = log_likelihood_ratio;
       best_input = input;
@@ -111,38 +150,44 @@ TreeStructuredParzenEstimator::Input TreeStructuredParzenEstimator::get_next_inp
   return best_input;
 }
 
-double TreeStructuredParzenEstimator::compute_log_likelihood_ratio(const Input & input) const
+double TreeStructuredParzenEstimator::compute_log_likelihood_ratio(
+  const Input & input, std::vector<double> & log_p) const
 {
-  const auto n = static_cast<int64_t>(trials_.size());
-
-  // The above KDE and the below KDE are calculated respectively, and the ratio is the criteria to
-  // select best sample.
-  std::vector<double> above_logs;
-  std::vector<double> below_logs;
+  const auto n = static_cast<int64_t>(scores_.size());
 
+  // Experimentally, it is better to consider only trans_xy and yaw, so ignore trans_z, angle_x,
+  // angle_y.
+  const double log_2pi = std::log(2.0 * M_PI);
+  const double log_normalizer = -1.5 * log_2pi - std::log(base_stddev_[TRANS_X]) -
+                                std::log(base_stddev_[TRANS_Y]) - std::log(base_stddev_[ANGLE_Z]);
+  const double inv_two_var_x = 1.0 / (2.0 * base_stddev_[TRANS_X] * base_stddev_[TRANS_X]);
+  const double inv_two_var_y = 1.0 / (2.0 * base_stddev_[TRANS_Y] * base_stddev_[TRANS_Y]);
+  const double inv_two_var_yaw = 1.0 / (2.0 * base_stddev_[ANGLE_Z] * base_stddev_[ANGLE_Z]);
+
+  // Both the input yaw and the stored yaws are in [-pi, pi), so that the distance on the circle
+  // is obtained without a loop. This loop has no branch and is vectorized by the compiler.
+  const double x = input[TRANS_X];
+  const double y = input[TRANS_Y];
+  const double yaw = input[ANGLE_Z];
+  const double * trans_x = trans_x_.data();
+  const double * trans_y = trans_y_.data();
+  const double * angle_z = angle_z_.data();
+  double * log_p_data = log_p.data();
   for (int64_t i = 0; i < n; i++) {
-    const double log_p = log_gaussian_pdf(input, trials_[i].input, base_stddev_);
-    if (i < above_num_) {
-      const double w = 1.0 / static_cast<double>(above_num_);
-      const double log_w = std::log(w);
-      above_logs.push_back(log_p + log_w);
-    } else {
-      const double w = 1.0 / static_cast<double>(n - above_num_);
-      const double log_w = std::log(w);
-      below_logs.push_back(log_p + log_w);
-    }
+    const double diff_x = x - trans_x[i];
+    const double diff_y = y - trans_y[i];
+    const double abs_diff_yaw = std::abs(yaw - angle_z[i]);
+    const double diff_yaw = std::min(abs_diff_yaw, 2.0 * M_PI - abs_diff_yaw);
+    log_p_data[i] = log_normalizer - diff_x * diff_x * inv_two_var_x -
+                    diff_y * diff_y * inv_two_var_y - diff_yaw * diff_yaw * inv_two_var_yaw;
   }
 
-  auto log_sum_exp = [](const std::vector<double> & log_vec) {
-    const double max = *std::max_element(log_vec.begin(), log_vec.end());
-    double sum = std::accumulate(
-      log_vec.begin(), log_vec.end(), 0.0,
-      [max](double total, double log_v) { return total + std::exp(log_v - max); });
-    return max + std::log(sum);
-  };
-
-  const double above = log_sum_exp(above_logs);
-  const double below = log_sum_exp(below_logs);
+  // The above KDE and the below KDE are calculated respectively, and the ratio is the criteria to
+  // select best sample. The trials of each KDE have the same weight.
+  const double above = log_sum_exp(log_p_data, above_num_) -
+                       std::log(static_cast<double>(above_num_));
+  const double below = log_sum_exp(log_p_data + above_num_, n - above_num_) -
+                       std::log(static_cast<double>(n - above_num_));
 
   // Multiply by a constant so that the score near the "below sample" becomes lower.
   // cspell:disable-line TODO(Shintaro Sakoda): It's theoretically incorrect, consider it again
@@ -150,36 +195,4 @@ double TreeStructuredParzenEstimator::compute_log_likelihood_ratio(const Input &
   const double r = above - below * 5.0;
   return r;
 }
-
-double TreeStructuredParzenEstimator::log_gaussian_pdf(
-  const Input & input, const Input & mu, const Input & sigma)
-{
-  const double log_2pi = std::log(2.0 * M_PI);
-  auto log_gaussian_pdf_1d = [&](const double diff, const double sigma) {
-    return -0.5 * log_2pi - std::log(sigma) - (diff * diff) / (2.0 * sigma * sigma);
-  };
-
-  const auto n = static_cast<int64_t>(input.size());
-
-  double result = 0.0;
-  for (int64_t i = 0; i < n; i++) {
-    double diff = input[i] - mu[i];
-    if (i == ANGLE_Z) {
-      // Normalize the loop variable to [-pi, pi)
-      while (diff >= M_PI) {
-        diff -= 2 * M_PI;
-      }
-      while (diff < -M_PI) {
-        diff += 2 * M_PI;
-      }
-    }
-    // Experimentally, it is better to consider only trans_xy and yaw, so ignore trans_z, angle_x,
-    // angle_y.
-    if (i == TRANS_Z || i == ANGLE_X || i == ANGLE_Y) {
-      continue;
-    }
-    result += log_gaussian_pdf_1d(diff, sigma[i]);
-  }
-  return result;
-}
 }  // namespace autoware::localization_util
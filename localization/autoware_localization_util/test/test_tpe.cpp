@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -251,3 +252,35 @@ TEST(TreeStructuredParzenEstimatorTest, AngleWrappingHandling)
     EXPECT_EQ(input.size(), 6);
   });
 }
+
+// Measure the time of the initial pose estimation loop of ndt_scan_matcher, which alternates
+// get_next_input and add_trial, for several numbers of particles
+TEST(TreeStructuredParzenEstimatorTest, DISABLED_benchmark)
+{
+  auto score_function = [](const TreeStructuredParzenEstimator::Input & input) {
+    const double dx = input[TreeStructuredParzenEstimator::TRANS_X] - 0.5;
+    const double dy = input[TreeStructuredParzenEstimator::TRANS_Y] + 0.3;
+    return -(dx * dx + dy * dy) + std::cos(input[TreeStructuredParzenEstimator::ANGLE_Z] - 3.0);
+  };
+
+  const std::vector<double> sample_mean(5, 0.0);
+  const std::vector<double> sample_stddev{2.0, 2.0, 0.1, 0.02, 0.02};
+
+  for (const int64_t particles_num : {100, 200, 500, 1000}) {
+    // Same ratio as the default parameters of ndt_scan_matcher
+    TreeStructuredParzenEstimator estimator(
+      TreeStructuredParzenEstimator::Direction::MAXIMIZE, particles_num / 2, sample_mean,
+      sample_stddev);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < particles_num; i++) {
+      const TreeStructuredParzenEstimator::Input input = estimator.get_next_input();
+      estimator.add_trial({input, score_function(input)});
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    std::cout << "particles_num: " << particles_num << ", total: "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " [ms]"
+              << std::endl;
+  }
+}
@@ -0,0 +1,54 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NDT_SCAN_MATCHER__EXECUTION_TIME_WINDOW_HPP_
+#define AUTOWARE__NDT_SCAN_MATCHER__EXECUTION_TIME_WINDOW_HPP_
+
+#include <cstddef>
+#include <deque>
+
+namespace autoware::ndt_scan_matcher
+{
+
+// The statistics of the latest execution times, which show the tail of the latency that a single
+// execution time does not
+class ExecutionTimeWindow
+{
+public:
+  struct Statistics
+  {
+    float min{0.0f};
+    float mean{0.0f};
+    float p95{0.0f};
+    float max{0.0f};
+  };
+
+  explicit ExecutionTimeWindow(const size_t window_size);
+
+  // The oldest execution time is dropped when the window is full
+  void add(const float exe_time_ms);
+
+  // The 95th percentile is the nearest rank one. All values are zero if the window is empty.
+  Statistics statistics() const;
+
+  size_t size() const { return exe_times_ms_.size(); }
+
+private:
+  size_t window_size_;
+  std::deque<float> exe_times_ms_;
+};
+
+}  // namespace autoware::ndt_scan_matcher
+
+#endif  // AUTOWARE__NDT_SCAN_MATCHER__EXECUTION_TIME_WINDOW_HPP_
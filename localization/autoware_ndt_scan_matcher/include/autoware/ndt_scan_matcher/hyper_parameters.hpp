@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -61,6 +62,7 @@ struct HyperParameters
   {
     int64_t particles_num{};
     int64_t n_startup_trials{};
+    int64_t batch_size{};
   } initial_pose_estimation{};
 
   struct Validation
@@ -103,6 +105,7 @@ struct HyperParameters
     double update_distance{};
     double map_radius{};
     double lidar_radius{};
+    double lookahead_time{};
   } dynamic_map_loading{};
 
 public:
@@ -122,6 +125,13 @@ public:
     ndt.max_iterations = static_cast<int>(node->declare_parameter<int64_t>("ndt.max_iterations"));
     ndt.num_threads = static_cast<int>(node->declare_parameter<int64_t>("ndt.num_threads"));
     ndt.num_threads = std::max(ndt.num_threads, 1);
+    const int64_t search_method_tmp = node->declare_parameter<int64_t>("ndt.search_method");
+    if (search_method_tmp < pclomp::KDTREE || search_method_tmp > pclomp::DIRECT1) {
+      throw std::invalid_argument(
+        "Invalid ndt.search_method: " + std::to_string(search_method_tmp) +
+        ". It must be 0 (KDTREE), 1 (DIRECT26), 2 (DIRECT7) or 3 (DIRECT1).");
+    }
+    ndt.search_method = static_cast<pclomp::NeighborSearchMethod>(search_method_tmp);
     ndt_regularization_enable = node->declare_parameter<bool>("ndt.regularization.enable");
     ndt.regularization_scale_factor =
       static_cast<float>(node->declare_parameter<float>("ndt.regularization.scale_factor"));
@@ -130,6 +140,8 @@ public:
       node->declare_parameter<int64_t>("initial_pose_estimation.particles_num");
     initial_pose_estimation.n_startup_trials =
       node->declare_parameter<int64_t>("initial_pose_estimation.n_startup_trials");
+    initial_pose_estimation.batch_size =
+      node->declare_parameter<int64_t>("initial_pose_estimation.batch_size");
 
     validation.initial_pose_timeout_sec =
       node->declare_parameter<double>("validation.initial_pose_timeout_sec");
@@ -191,6 +203,8 @@ public:
       node->declare_parameter<double>("dynamic_map_loading.map_radius");
     dynamic_map_loading.lidar_radius =
       node->declare_parameter<double>("dynamic_map_loading.lidar_radius");
+    dynamic_map_loading.lookahead_time =
+      node->declare_parameter<double>("dynamic_map_loading.lookahead_time");
   }
 };
 
@@ -27,6 +27,7 @@
 
 #include <autoware_map_msgs/srv/get_differential_point_cloud_map.hpp>
 #include <geometry_msgs/msg/pose_with_covariance_stamped.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 #include <visualization_msgs/msg/marker_array.hpp>
 
@@ -58,15 +59,24 @@ public:
 
   bool out_of_map_range(const geometry_msgs::msg::Point & position);
 
+  // The center of the map to load, which is ahead of the position along the velocity by
+  // lookahead_time. It is kept within (map_radius - lidar_radius - update_distance) from the
+  // position, so that the map loaded around it still covers the LiDAR range until the next update.
+  static geometry_msgs::msg::Point compute_map_center(
+    const geometry_msgs::msg::Point & position,
+    const std::optional<geometry_msgs::msg::Vector3> & velocity,
+    const HyperParameters::DynamicMapLoading & param);
+
 private:
   friend class NDTScanMatcher;
 
   void callback_timer(
     const bool is_activated, const std::optional<geometry_msgs::msg::Point> & position,
+    const std::optional<geometry_msgs::msg::Vector3> & velocity,
     std::unique_ptr<DiagnosticsInterface> & diagnostics_ptr);
 
   [[nodiscard]] bool should_update_map(
-    const geometry_msgs::msg::Point & position,
+    const geometry_msgs::msg::Point & position, const geometry_msgs::msg::Point & map_center,
     std::unique_ptr<DiagnosticsInterface> & diagnostics_ptr);
 
   void update_map(
@@ -97,6 +107,12 @@ private:
   bool need_rebuild_;
   // Keep the last_update_position_ unchanged while checking map range
   std::mutex last_update_position_mtx_;
+
+  // The number of the updates which were triggered by the lookahead before the vehicle travelled
+  // update_distance, and so were built on the secondary NDT ahead of time
+  size_t lookahead_update_count_{0};
+  // The number of the updates which locked and rebuilt ndt_ptr_
+  size_t blocking_rebuild_count_{0};
 };
 
 }  // namespace autoware::ndt_scan_matcher
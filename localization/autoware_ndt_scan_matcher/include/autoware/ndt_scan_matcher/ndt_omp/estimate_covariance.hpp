@@ -15,6 +15,7 @@
 #ifndef AUTOWARE__NDT_SCAN_MATCHER__NDT_OMP__ESTIMATE_COVARIANCE_HPP_
 #define AUTOWARE__NDT_SCAN_MATCHER__NDT_OMP__ESTIMATE_COVARIANCE_HPP_
 
+#include "multi_ndt_worker_pool.hpp"
 #include "multigrid_ndt_omp.h"
 
 #include <Eigen/Core>
@@ -48,6 +49,21 @@ ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt_score(
     pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
   const std::vector<Eigen::Matrix4f> & poses_to_search, const double temperature);
 
+/** \brief Estimate functions whose searches are run concurrently on the threads of worker_pool.
+ * They return the same results as the ones above without modifying ndt_ptr.
+ */
+ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt(
+  const NdtResult & ndt_result,
+  const std::shared_ptr<
+    pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
+  const std::vector<Eigen::Matrix4f> & poses_to_search, MultiNdtWorkerPool & worker_pool);
+ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt_score(
+  const NdtResult & ndt_result,
+  const std::shared_ptr<
+    pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
+  const std::vector<Eigen::Matrix4f> & poses_to_search, const double temperature,
+  MultiNdtWorkerPool & worker_pool);
+
 /** \brief Propose poses to search.
  * (1) Compute covariance by Laplace approximation
  * (2) Find rotation matrix aligning covariance to principal axes
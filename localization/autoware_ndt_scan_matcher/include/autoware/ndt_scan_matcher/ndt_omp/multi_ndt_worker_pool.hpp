@@ -0,0 +1,94 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NDT_SCAN_MATCHER__NDT_OMP__MULTI_NDT_WORKER_POOL_HPP_
+#define AUTOWARE__NDT_SCAN_MATCHER__NDT_OMP__MULTI_NDT_WORKER_POOL_HPP_
+
+#include "multigrid_ndt_omp.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace pclomp
+{
+
+/** \brief Persistent threads running the sub-searches of the multi NDT covariance estimation.
+ * Each thread owns an NDT and a point cloud buffer, which are reused across the calls of run().
+ * The NDT of a thread searches the same voxels as the NDT given to run(), but it is copied
+ * again only when the targets of the given NDT have been updated. The OpenMP threads of the
+ * given NDT are divided among the threads of the pool.
+ * \note run() must not be called concurrently.
+ */
+class MultiNdtWorkerPool
+{
+public:
+  using NdtType = MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>;
+  using PointCloud = pcl::PointCloud<pcl::PointXYZ>;
+  using Task = std::function<void(NdtType & ndt, PointCloud & cloud_buffer, size_t task_index)>;
+
+  explicit MultiNdtWorkerPool(int thread_num);
+  ~MultiNdtWorkerPool();
+
+  MultiNdtWorkerPool(const MultiNdtWorkerPool &) = delete;
+  MultiNdtWorkerPool & operator=(const MultiNdtWorkerPool &) = delete;
+
+  /** \brief Call task for each task index in [0, task_num) on the threads and wait for them.
+   * \param[in] ndt the NDT the sub-searches are based on, which must not be modified until
+   * this function returns
+   * \param[in] task_num the number of tasks
+   * \param[in] task the function called with the NDT and the buffer of the thread
+   */
+  void run(const NdtType & ndt, size_t task_num, const Task & task);
+
+  int get_thread_num() const { return static_cast<int>(threads_.size()); }
+
+private:
+  struct WorkerState
+  {
+    std::shared_ptr<NdtType> ndt_ptr;
+    PointCloud cloud_buffer;
+    bool is_initialized{false};
+  };
+
+  void worker_loop(size_t worker_index);
+  void sync_ndt(WorkerState & state, const NdtType & ndt) const;
+
+  std::vector<WorkerState> states_;
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable job_cv_;
+  std::condition_variable done_cv_;
+  bool is_stopped_{false};
+
+  // The current job, which is identified by job_id_ and shared by all the threads
+  uint64_t job_id_{0};
+  const NdtType * job_ndt_{nullptr};
+  const Task * job_task_{nullptr};
+  size_t job_task_num_{0};
+  std::atomic<size_t> next_task_index_{0};
+  size_t running_thread_num_{0};
+  std::exception_ptr job_exception_;
+};
+
+}  // namespace pclomp
+
+#endif  // AUTOWARE__NDT_SCAN_MATCHER__NDT_OMP__MULTI_NDT_WORKER_POOL_HPP_
@@ -54,6 +54,8 @@
 
 // cspell:ignore Magnusson, Okorn, evecs, evals, covar, eigvalue, futs
 
+#include "ndt_struct.hpp"
+
 #include <Eigen/Cholesky>
 #include <Eigen/Dense>
 
@@ -66,6 +68,7 @@
 #include <pcl/kdtree/kdtree_flann.h>
 #include <pcl/point_types.h>
 
+#include <atomic>
 #include <future>
 #include <map>
 #include <memory>
@@ -130,12 +133,17 @@ public:
       mean_(Eigen::Vector3d::Zero()),
       centroid_(),
       cov_(Eigen::Matrix3d::Identity()),
-      icov_(Eigen::Matrix3d::Zero())
+      icov_(Eigen::Matrix3d::Zero()),
+      voxel_idx_(Eigen::Vector3i::Zero())
     {
     }
 
     Leaf(const Leaf & other)
-    : mean_(other.mean_), centroid_(other.centroid_), cov_(other.cov_), icov_(other.icov_)
+    : mean_(other.mean_),
+      centroid_(other.centroid_),
+      cov_(other.cov_),
+      icov_(other.icov_),
+      voxel_idx_(other.voxel_idx_)
     {
       nr_points_ = other.nr_points_;
     }
@@ -144,7 +152,8 @@ public:
     : mean_(std::move(other.mean_)),
       centroid_(std::move(other.centroid_)),
       cov_(std::move(other.cov_)),
-      icov_(std::move(other.icov_))
+      icov_(std::move(other.icov_)),
+      voxel_idx_(std::move(other.voxel_idx_))
     {
       nr_points_ = other.nr_points_;
     }
@@ -155,6 +164,7 @@ public:
       centroid_ = other.centroid_;
       cov_ = other.cov_;
       icov_ = other.icov_;
+      voxel_idx_ = other.voxel_idx_;
       nr_points_ = other.nr_points_;
 
       return *this;
@@ -166,6 +176,7 @@ public:
       centroid_ = std::move(other.centroid_);
       cov_ = std::move(other.cov_);
       icov_ = std::move(other.icov_);
+      voxel_idx_ = std::move(other.voxel_idx_);
       nr_points_ = other.nr_points_;
 
       return *this;
@@ -201,6 +212,9 @@ public:
 
     /** \brief Inverse of voxel covariance matrix */
     Eigen::Matrix3d icov_;
+
+    /** \brief Global (map frame) integer coordinates of the voxel */
+    Eigen::Vector3i voxel_idx_;
   };
 
   /** \brief Pointer to MultiVoxelGridCovariance leaf structure */
@@ -224,7 +238,8 @@ public:
   /** \brief Constructor.
    * Sets \ref leaf_size_ to 0
    */
-  MultiVoxelGridCovariance() : min_points_per_voxel_(6), min_covar_eigvalue_mult_(0.01)
+  MultiVoxelGridCovariance()
+  : min_points_per_voxel_(6), min_covar_eigvalue_mult_(0.01), search_method_(KDTREE), revision_(0)
   {
     leaf_size_.setZero();
     min_b_.setZero();
@@ -249,10 +264,32 @@ public:
    */
   void removeCloud(const std::string & grid_id);
 
-  /** \brief Build KdTrees from the NDT voxel for later radius search
+  /** \brief Make the set of grids identical to the one of other.
+   * Grids that other does not have are removed, and grids that only other has are shared with
+   * other instead of being filtered again. Call createKdtree() afterwards to update the index.
+   * \note other must have been indexed by createKdtree() and must use the same leaf size.
+   */
+  void syncGrids(const MultiVoxelGridCovariance & other);
+
+  /** \brief Build the neighbor search index from the NDT voxels for later radius search.
+   * \note Only the structure required by the current search method is built: a kdtree for
+   * KDTREE, or a hash table from voxel coordinates to leaves for DIRECT26/DIRECT7/DIRECT1.
+   * The kdtree is rebuilt from all leaves, while the hash table is updated incrementally with
+   * the grids added and removed since the last call.
    */
   void createKdtree();
 
+  /** \brief Set the method used by radiusSearch to find neighboring leaves.
+   * \note KDTREE searches all leaf centroids. DIRECT26 checks the 27 voxels around the query
+   * point in constant time and returns the same leaves as KDTREE as long as the search radius
+   * does not exceed the leaf size. DIRECT7 (the query voxel and its 6 face neighbors) and DIRECT1
+   * (the query voxel only) are cheaper approximations.
+   * \param[in] search_method the neighbor search method
+   */
+  void setSearchMethod(NeighborSearchMethod search_method);
+
+  NeighborSearchMethod getSearchMethod() const { return search_method_; }
+
   /** \brief Search for all the nearest occupied voxels of the query point in a given radius.
    * \note Only voxels containing a sufficient number of points are used.
    * \param[in] point the given query point
@@ -278,12 +315,18 @@ public:
     const PointCloud & cloud, int index, double radius, std::vector<LeafConstPtr> & k_leaves,
     unsigned int max_nn = 0) const;
 
-  // Return a pointer to avoid multiple deep copies
+  // Return the centroids of all leaves of the currently loaded grids
   PointCloud getVoxelPCD() const;
 
   // Return the string indices of currently loaded map pieces
   std::vector<std::string> getCurrentMapIDs() const;
 
+  /** \brief Return the revision of the indexed grids, which is renewed by every createKdtree().
+   * Two instances with the same revision search the same leaves, as a copy keeps the revision of
+   * the instance it was copied from until it is indexed again.
+   */
+  uint64_t getRevision() const { return revision_; }
+
   void setThreadNum(int thread_num)
   {
     sync();
@@ -364,6 +407,30 @@ protected:
 
   int64_t getLeafID(const PointT & point, const BoundingBox & bbox) const;
 
+  /** \brief Compute the global integer coordinates of the voxel containing the point */
+  Eigen::Vector3i getVoxelIndex(const PointT & point) const;
+
+  /** \brief Hash of global voxel coordinates, the key of voxel_leaf_map_.
+   * \note The full coordinates are kept as the key, so voxels far apart never share a key.
+   */
+  struct VoxelIndexHash
+  {
+    size_t operator()(const Eigen::Vector3i & voxel_idx) const
+    {
+      return (static_cast<size_t>(static_cast<uint32_t>(voxel_idx[0])) * 73856093u) ^
+             (static_cast<size_t>(static_cast<uint32_t>(voxel_idx[1])) * 19349663u) ^
+             (static_cast<size_t>(static_cast<uint32_t>(voxel_idx[2])) * 83492791u);
+    }
+  };
+
+  /** \brief Erase the leaves of the grid from voxel_leaf_map_ */
+  void eraseGridFromIndex(const GridNodeType & grid);
+
+  /** \brief Search neighboring leaves by looking up the voxels around the query point */
+  int directRadiusSearch(
+    const PointT & point, double radius, std::vector<LeafConstPtr> & k_leaves,
+    unsigned int max_nn) const;
+
   /** \brief Minimum points contained with in a voxel to allow it to be usable. */
   int min_points_per_voxel_;
 
@@ -388,6 +455,18 @@ protected:
   pcl::KdTreeFLANN<PointT> kdtree_;
   // To access leaf by the search results by kdtree
   std::vector<LeafConstPtr> leaf_ptrs_;
+
+  // The method used by radiusSearch
+  NeighborSearchMethod search_method_;
+  // Leaves of all grids keyed by their voxel coordinates, used by the DIRECT* search methods.
+  // Neighboring map pieces may overlap, so a voxel may hold more than one leaf.
+  std::unordered_map<Eigen::Vector3i, std::vector<LeafConstPtr>, VoxelIndexHash> voxel_leaf_map_;
+  // Grids added since the last createKdtree, whose leaves are not indexed yet
+  std::vector<GridNodePtr> pending_grids_;
+
+  // Revision of the indexed grids, unique among all the instances
+  uint64_t revision_;
+  inline static std::atomic<uint64_t> next_revision_{1};
 };
 }  // namespace pclomp
 
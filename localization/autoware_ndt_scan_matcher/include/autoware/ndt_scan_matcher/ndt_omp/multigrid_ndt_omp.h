@@ -164,6 +164,14 @@ public:
 
   inline void removeTarget(const std::string & target_id) { target_cells_.removeCloud(target_id); }
 
+  /** \brief Make the targets identical to the ones of other by sharing its voxel grids.
+   * \note The change takes effect after createVoxelKdtree().
+   */
+  inline void syncTargets(const MultiGridNormalDistributionsTransform & other)
+  {
+    target_cells_.syncGrids(other.target_cells_);
+  }
+
   inline void createVoxelKdtree()
   {
     target_cells_.createKdtree();
@@ -233,6 +241,11 @@ public:
 
   inline void unsetRegularizationPose() { regularization_pose_ = boost::none; }
 
+  inline boost::optional<Eigen::Matrix4f> getRegularizationPose() const
+  {
+    return regularization_pose_;
+  }
+
   NdtResult getResult()
   {
     NdtResult ndt_result;
@@ -254,6 +267,7 @@ public:
     max_iterations_ = params_.max_iterations;
 
     target_cells_.setThreadNum(params_.num_threads);
+    target_cells_.setSearchMethod(params_.search_method);
   }
 
   NdtParams getParams() const { return params_; }
@@ -262,6 +276,11 @@ public:
 
   std::vector<std::string> getCurrentMapIDs() const { return target_cells_.getCurrentMapIDs(); }
 
+  /** \brief Return the revision of the targets. NDTs with the same revision align against the
+   * same voxels. See MultiVoxelGridCovariance::getRevision().
+   */
+  uint64_t getTargetRevision() const { return target_cells_.getRevision(); }
+
 protected:
   using BaseRegType::converged_;
   using BaseRegType::final_transformation_;
@@ -294,6 +313,17 @@ protected:
   /** \brief Initiate covariance voxel structure. */
   void inline init() {}
 
+  /** \brief Stop sharing the fake indices of the input source with the NDT this one was copied
+   * from. They are resized by PCLBase::initCompute() on every alignment, so sharing them would
+   * prevent the copies from aligning concurrently.
+   */
+  inline void unshareFakeIndices()
+  {
+    if (this->fake_indices_) {
+      this->indices_.reset();
+    }
+  }
+
   /** \brief Compute derivatives of probability function w.r.t. the transformation vector.
    * \note Equation 6.10, 6.12 and 6.13 [Magnusson 2009].
    * \param[out] score_gradient the gradient vector of the probability function w.r.t. the
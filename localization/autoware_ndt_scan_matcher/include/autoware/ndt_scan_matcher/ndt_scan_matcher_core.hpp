@@ -17,8 +17,10 @@
 
 #define FMT_HEADER_ONLY
 
+#include "execution_time_window.hpp"
 #include "hyper_parameters.hpp"
 #include "map_update_module.hpp"
+#include "ndt_omp/multi_ndt_worker_pool.hpp"
 #include "ndt_omp/multigrid_ndt_omp.h"
 
 #include <autoware/localization_util/smart_pose_buffer.hpp>
@@ -114,10 +116,8 @@ private:
   std::tuple<geometry_msgs::msg::PoseWithCovarianceStamped, double> align_pose(
     const geometry_msgs::msg::PoseWithCovarianceStamped & initial_pose_with_cov);
 
-  void transform_sensor_measurement(
-    const std::string & source_frame, const std::string & target_frame,
-    const pcl::shared_ptr<pcl::PointCloud<PointSource>> & sensor_points_input_ptr,
-    pcl::shared_ptr<pcl::PointCloud<PointSource>> & sensor_points_output_ptr);
+  Eigen::Matrix4f lookup_sensor_transform(
+    const std::string & source_frame, const std::string & target_frame);
 
   void publish_tf(
     const rclcpp::Time & sensor_ros_time, const geometry_msgs::msg::Pose & result_pose_msg);
@@ -163,6 +163,8 @@ private:
   rclcpp::Publisher<geometry_msgs::msg::PoseArray>::SharedPtr multi_ndt_pose_pub_;
   rclcpp::Publisher<geometry_msgs::msg::PoseArray>::SharedPtr multi_initial_pose_pub_;
   rclcpp::Publisher<autoware_internal_debug_msgs::msg::Float32Stamped>::SharedPtr exe_time_pub_;
+  rclcpp::Publisher<autoware_internal_debug_msgs::msg::Float32Stamped>::SharedPtr
+    covariance_estimation_exe_time_pub_;
   rclcpp::Publisher<autoware_internal_debug_msgs::msg::Float32Stamped>::SharedPtr
     transform_probability_pub_;
   rclcpp::Publisher<autoware_internal_debug_msgs::msg::Float32Stamped>::SharedPtr
@@ -197,14 +199,33 @@ private:
 
   std::shared_ptr<NormalDistributionsTransform> ndt_ptr_;
 
+  // Runs the sub-searches of the multi NDT covariance estimation. Only used in those modes.
+  std::unique_ptr<pclomp::MultiNdtWorkerPool> multi_ndt_worker_pool_;
+  // Aligns the particles of a batch of the initial pose estimation. Only used with batch_size > 1.
+  std::unique_ptr<pclomp::MultiNdtWorkerPool> initial_pose_worker_pool_;
+
   Eigen::Matrix4f base_to_sensor_matrix_;
 
+  // Reused by the sensor callbacks so that the clouds are not allocated for every scan.
+  // The NDT is given one of the two buffers in baselink frame, while the other one is filled.
+  std::array<pcl::shared_ptr<pcl::PointCloud<PointSource>>, 2>
+    sensor_points_in_baselink_frame_buffers_;
+  size_t sensor_points_buffer_index_{0};
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_in_sensor_frame_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_in_map_;
+  pcl::shared_ptr<pcl::PointCloud<PointSource>> no_ground_points_in_map_;
+
   std::mutex ndt_ptr_mtx_;
   std::unique_ptr<autoware::localization_util::SmartPoseBuffer> initial_pose_buffer_;
 
   // Keep latest position for dynamic map loading
   std::mutex latest_ekf_position_mtx_;
   std::optional<geometry_msgs::msg::Point> latest_ekf_position_ = std::nullopt;
+  // The velocity is the difference of the EKF positions over at least ekf_velocity_min_dt, which
+  // smooths the noise of the consecutive poses
+  std::optional<geometry_msgs::msg::Vector3> latest_ekf_velocity_ = std::nullopt;
+  std::optional<geometry_msgs::msg::PoseWithCovarianceStamped> ekf_velocity_reference_pose_ =
+    std::nullopt;
 
   std::unique_ptr<autoware::localization_util::SmartPoseBuffer> regularization_pose_buffer_;
 
@@ -215,6 +236,12 @@ private:
   std::unique_ptr<DiagnosticsInterface> diagnostics_map_update_;
   std::unique_ptr<DiagnosticsInterface> diagnostics_ndt_align_;
   std::unique_ptr<DiagnosticsInterface> diagnostics_trigger_node_;
+
+  // The covariance estimation times of the latest scans
+  static constexpr size_t covariance_estimation_exe_time_window_size = 100;
+  ExecutionTimeWindow covariance_estimation_exe_time_window_{
+    covariance_estimation_exe_time_window_size};
+
   std::unique_ptr<MapUpdateModule> map_update_module_;
   std::unique_ptr<autoware_utils_logging::LoggerLevelConfigure> logger_configure_;
 
@@ -0,0 +1,38 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__NDT_SCAN_MATCHER__SENSOR_POINTS_CONVERSION_HPP_
+#define AUTOWARE__NDT_SCAN_MATCHER__SENSOR_POINTS_CONVERSION_HPP_
+
+#include <Eigen/Core>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+namespace autoware::ndt_scan_matcher
+{
+
+// Read the xyz of the points straight from the buffer of msg, transform them and write them to
+// output, whose memory is reused. The other fields of the points are skipped.
+// Return false without modifying output if x, y and z are not little-endian FLOAT32 fields,
+// in which case the message has to be converted by pcl::fromROSMsg instead.
+bool transform_xyz_from_msg(
+  const sensor_msgs::msg::PointCloud2 & msg, const Eigen::Matrix4f & transform,
+  pcl::PointCloud<pcl::PointXYZ> & output);
+
+}  // namespace autoware::ndt_scan_matcher
+
+#endif  // AUTOWARE__NDT_SCAN_MATCHER__SENSOR_POINTS_CONVERSION_HPP_
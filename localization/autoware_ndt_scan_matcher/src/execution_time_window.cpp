@@ -0,0 +1,57 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/ndt_scan_matcher/execution_time_window.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+namespace autoware::ndt_scan_matcher
+{
+
+ExecutionTimeWindow::ExecutionTimeWindow(const size_t window_size)
+: window_size_(std::max<size_t>(window_size, 1))
+{
+}
+
+void ExecutionTimeWindow::add(const float exe_time_ms)
+{
+  if (exe_times_ms_.size() == window_size_) {
+    exe_times_ms_.pop_front();
+  }
+  exe_times_ms_.push_back(exe_time_ms);
+}
+
+ExecutionTimeWindow::Statistics ExecutionTimeWindow::statistics() const
+{
+  Statistics statistics;
+  if (exe_times_ms_.empty()) {
+    return statistics;
+  }
+
+  std::vector<float> sorted(exe_times_ms_.begin(), exe_times_ms_.end());
+  std::sort(sorted.begin(), sorted.end());
+  const auto n = sorted.size();
+  const auto p95_rank = static_cast<size_t>(std::ceil(0.95 * static_cast<double>(n)));
+  statistics.min = sorted.front();
+  statistics.mean =
+    static_cast<float>(std::accumulate(sorted.begin(), sorted.end(), 0.0) / static_cast<double>(n));
+  statistics.p95 = sorted.at(std::max<size_t>(p95_rank, 1) - 1);
+  statistics.max = sorted.back();
+  return statistics;
+}
+
+}  // namespace autoware::ndt_scan_matcher
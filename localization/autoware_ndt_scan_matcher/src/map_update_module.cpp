@@ -14,6 +14,8 @@
 
 #include <autoware/ndt_scan_matcher/map_update_module.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 
@@ -54,8 +56,39 @@ MapUpdateModule::MapUpdateModule(
   need_rebuild_ = true;
 }
 
+geometry_msgs::msg::Point MapUpdateModule::compute_map_center(
+  const geometry_msgs::msg::Point & position,
+  const std::optional<geometry_msgs::msg::Vector3> & velocity,
+  const HyperParameters::DynamicMapLoading & param)
+{
+  if (!velocity || param.lookahead_time <= 0.0) {
+    return position;
+  }
+
+  double dx = velocity->x * param.lookahead_time;
+  double dy = velocity->y * param.lookahead_time;
+  const double lookahead_distance = std::hypot(dx, dy);
+  if (!std::isfinite(lookahead_distance) || lookahead_distance == 0.0) {
+    return position;
+  }
+  // The map is updated only after the center moves update_distance away from the loaded one, so
+  // the vehicle may be up to (update_distance + lookahead) away from the loaded center
+  const double max_lookahead_distance =
+    std::max(param.map_radius - param.lidar_radius - param.update_distance, 0.0);
+  if (lookahead_distance > max_lookahead_distance) {
+    dx *= max_lookahead_distance / lookahead_distance;
+    dy *= max_lookahead_distance / lookahead_distance;
+  }
+
+  geometry_msgs::msg::Point map_center = position;
+  map_center.x += dx;
+  map_center.y += dy;
+  return map_center;
+}
+
 void MapUpdateModule::callback_timer(
   const bool is_activated, const std::optional<geometry_msgs::msg::Point> & position,
+  const std::optional<geometry_msgs::msg::Vector3> & velocity,
   std::unique_ptr<DiagnosticsInterface> & diagnostics_ptr)
 {
   // check is_activated
@@ -80,13 +113,22 @@ void MapUpdateModule::callback_timer(
     return;
   }
 
-  if (should_update_map(position.value(), diagnostics_ptr)) {
-    update_map(position.value(), diagnostics_ptr);
+  const geometry_msgs::msg::Point map_center =
+    compute_map_center(position.value(), velocity, param_);
+  diagnostics_ptr->add_key_value(
+    "lookahead_distance",
+    std::hypot(map_center.x - position.value().x, map_center.y - position.value().y));
+
+  if (should_update_map(position.value(), map_center, diagnostics_ptr)) {
+    update_map(map_center, diagnostics_ptr);
   }
+
+  diagnostics_ptr->add_key_value("lookahead_update_count", lookahead_update_count_);
+  diagnostics_ptr->add_key_value("blocking_rebuild_count", blocking_rebuild_count_);
 }
 
 bool MapUpdateModule::should_update_map(
-  const geometry_msgs::msg::Point & position,
+  const geometry_msgs::msg::Point & position, const geometry_msgs::msg::Point & map_center,
   std::unique_ptr<DiagnosticsInterface> & diagnostics_ptr)
 {
   last_update_position_mtx_.lock();
@@ -101,6 +143,8 @@ bool MapUpdateModule::should_update_map(
   const double dx = position.x - last_update_position_.value().x;
   const double dy = position.y - last_update_position_.value().y;
   const double distance = std::hypot(dx, dy);
+  const double map_center_distance = std::hypot(
+    map_center.x - last_update_position_.value().x, map_center.y - last_update_position_.value().y);
 
   last_update_position_mtx_.unlock();
 
@@ -117,7 +161,13 @@ bool MapUpdateModule::should_update_map(
     need_rebuild_ = true;
   }
 
-  return distance > param_.update_distance;
+  // The map follows the lookahead center, which moves away from the last center earlier than the
+  // vehicle does
+  const bool should_update = map_center_distance > param_.update_distance;
+  if (should_update && !need_rebuild_ && distance <= param_.update_distance) {
+    ++lookahead_update_count_;
+  }
+  return should_update;
 }
 
 bool MapUpdateModule::out_of_map_range(const geometry_msgs::msg::Point & position)
@@ -147,9 +197,13 @@ void MapUpdateModule::update_map(
 {
   diagnostics_ptr->add_key_value("is_need_rebuild", need_rebuild_);
 
+  // Whether secondary_ndt_ptr_ already holds the same maps as ndt_ptr_
+  bool is_secondary_synced = false;
+
   // If the current position is super far from the previous loading position,
   // lock and rebuild ndt_ptr_
   if (need_rebuild_) {
+    ++blocking_rebuild_count_;
     ndt_ptr_mutex_->lock();
 
     auto param = ndt_ptr_->getParams();
@@ -214,11 +268,33 @@ void MapUpdateModule::update_map(
     }
     ndt_ptr_mutex_->unlock();
 
+    if (ndt_ptr_->getParams().search_method != pclomp::KDTREE) {
+      // The previous NDT is no longer used by the alignment, so reuse it as the next
+      // secondary NDT. Applying the same map difference to it only costs the added and
+      // removed grids, while copying the whole NDT costs all loaded leaves.
+      const auto sync_start_time = std::chrono::system_clock::now();
+      dummy_ptr->syncTargets(*ndt_ptr_);
+      dummy_ptr->createVoxelKdtree();
+      secondary_ndt_ptr_ = dummy_ptr;
+      is_secondary_synced = true;
+
+      const auto sync_end_time = std::chrono::system_clock::now();
+      const auto sync_duration_micro_sec =
+        std::chrono::duration_cast<std::chrono::microseconds>(sync_end_time - sync_start_time)
+          .count();
+      diagnostics_ptr->add_key_value(
+        "secondary_ndt_sync_execution_time", static_cast<double>(sync_duration_micro_sec) / 1000.0);
+    }
+
     dummy_ptr.reset();
   }
 
-  secondary_ndt_ptr_.reset(new NdtType);
-  *secondary_ndt_ptr_ = *ndt_ptr_;
+  // After a full rebuild, or with the kdtree which cannot be updated incrementally,
+  // the secondary NDT is made by copying the whole primary NDT
+  if (!is_secondary_synced) {
+    secondary_ndt_ptr_.reset(new NdtType);
+    *secondary_ndt_ptr_ = *ndt_ptr_;
+  }
 
   // Memorize the position of the last update
   last_update_position_mtx_.lock();
@@ -32,24 +32,18 @@ Eigen::Matrix2d estimate_xy_covariance_by_laplace_approximation(
   return covariance_xy;
 }
 
-ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt(
-  const NdtResult & ndt_result,
-  const std::shared_ptr<
-    pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
-  const std::vector<Eigen::Matrix4f> & poses_to_search)
+namespace
+{
+// Calculate the covariance of the main result and the results of the sub-alignments
+ResultOfMultiNdtCovarianceEstimation calculate_multi_ndt_covariance(
+  const NdtResult & ndt_result, const std::vector<Eigen::Matrix4f> & poses_to_search,
+  const std::vector<NdtResult> & ndt_results)
 {
   // initialize by the main result
   const Eigen::Vector2d ndt_pose_2d(ndt_result.pose(0, 3), ndt_result.pose(1, 3));
   std::vector<Eigen::Vector2d> ndt_pose_2d_vec{ndt_pose_2d};
 
-  // multiple searches
-  std::vector<NdtResult> ndt_results;
-  for (const Eigen::Matrix4f & curr_pose : poses_to_search) {
-    auto sub_output_cloud = std::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
-    ndt_ptr->align(*sub_output_cloud, curr_pose);
-    const NdtResult sub_ndt_result = ndt_ptr->getResult();
-    ndt_results.push_back(sub_ndt_result);
-
+  for (const NdtResult & sub_ndt_result : ndt_results) {
     const Eigen::Matrix4f sub_ndt_pose = sub_ndt_result.pose;
     const Eigen::Vector2d sub_ndt_pose_2d = sub_ndt_pose.topRightCorner<2, 1>().cast<double>();
     ndt_pose_2d_vec.emplace_back(sub_ndt_pose_2d);
@@ -68,34 +62,27 @@ ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt(
   return {mean, covariance, poses_to_search, ndt_results};
 }
 
-ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt_score(
-  const NdtResult & ndt_result,
-  const std::shared_ptr<
-    pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
-  const std::vector<Eigen::Matrix4f> & poses_to_search, const double temperature)
+// Calculate the covariance of the main result and the searched poses weighted by their scores
+ResultOfMultiNdtCovarianceEstimation calculate_multi_ndt_score_covariance(
+  const NdtResult & ndt_result, const std::vector<Eigen::Matrix4f> & poses_to_search,
+  const std::vector<double> & nvtl_vec, const double temperature)
 {
   // initialize by the main result
   const Eigen::Vector2d ndt_pose_2d(ndt_result.pose(0, 3), ndt_result.pose(1, 3));
   std::vector<Eigen::Vector2d> ndt_pose_2d_vec{ndt_pose_2d};
   std::vector<double> score_vec{ndt_result.nearest_voxel_transformation_likelihood};
 
-  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr input_cloud = ndt_ptr->getInputCloud();
-  pcl::PointCloud<pcl::PointXYZ> trans_cloud;
-
-  // multiple searches
   std::vector<NdtResult> ndt_results;
-  for (const Eigen::Matrix4f & curr_pose : poses_to_search) {
+  for (size_t i = 0; i < poses_to_search.size(); i++) {
+    const Eigen::Matrix4f & curr_pose = poses_to_search[i];
     const Eigen::Vector2d sub_ndt_pose_2d = curr_pose.topRightCorner<2, 1>().cast<double>();
     ndt_pose_2d_vec.emplace_back(sub_ndt_pose_2d);
-
-    transformPointCloud(*input_cloud, trans_cloud, curr_pose);
-    const double nvtl = ndt_ptr->calculateNearestVoxelTransformationLikelihood(trans_cloud);
-    score_vec.emplace_back(nvtl);
+    score_vec.emplace_back(nvtl_vec[i]);
 
     NdtResult sub_ndt_result{};
     sub_ndt_result.pose = curr_pose;
     sub_ndt_result.iteration_num = 0;
-    sub_ndt_result.nearest_voxel_transformation_likelihood = static_cast<float>(nvtl);
+    sub_ndt_result.nearest_voxel_transformation_likelihood = static_cast<float>(nvtl_vec[i]);
     ndt_results.push_back(sub_ndt_result);
   }
 
@@ -106,6 +93,86 @@ ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt_score(
   const auto [mean, covariance] = calculate_weighted_mean_and_cov(ndt_pose_2d_vec, weight_vec);
   return {mean, covariance, poses_to_search, ndt_results};
 }
+}  // namespace
+
+ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt(
+  const NdtResult & ndt_result,
+  const std::shared_ptr<
+    pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
+  const std::vector<Eigen::Matrix4f> & poses_to_search)
+{
+  // multiple searches
+  std::vector<NdtResult> ndt_results;
+  for (const Eigen::Matrix4f & curr_pose : poses_to_search) {
+    auto sub_output_cloud = std::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
+    ndt_ptr->align(*sub_output_cloud, curr_pose);
+    ndt_results.push_back(ndt_ptr->getResult());
+  }
+
+  return calculate_multi_ndt_covariance(ndt_result, poses_to_search, ndt_results);
+}
+
+ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt(
+  const NdtResult & ndt_result,
+  const std::shared_ptr<
+    pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
+  const std::vector<Eigen::Matrix4f> & poses_to_search, MultiNdtWorkerPool & worker_pool)
+{
+  // multiple searches, each of which is done by the NDT of a thread
+  std::vector<NdtResult> ndt_results(poses_to_search.size());
+  worker_pool.run(
+    *ndt_ptr, poses_to_search.size(),
+    [&](
+      MultiNdtWorkerPool::NdtType & ndt, MultiNdtWorkerPool::PointCloud & cloud_buffer,
+      const size_t i) {
+      ndt.align(cloud_buffer, poses_to_search[i]);
+      ndt_results[i] = ndt.getResult();
+    });
+
+  return calculate_multi_ndt_covariance(ndt_result, poses_to_search, ndt_results);
+}
+
+ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt_score(
+  const NdtResult & ndt_result,
+  const std::shared_ptr<
+    pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
+  const std::vector<Eigen::Matrix4f> & poses_to_search, const double temperature)
+{
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr input_cloud = ndt_ptr->getInputCloud();
+  pcl::PointCloud<pcl::PointXYZ> trans_cloud;
+
+  // multiple searches
+  std::vector<double> nvtl_vec;
+  for (const Eigen::Matrix4f & curr_pose : poses_to_search) {
+    transformPointCloud(*input_cloud, trans_cloud, curr_pose);
+    nvtl_vec.emplace_back(ndt_ptr->calculateNearestVoxelTransformationLikelihood(trans_cloud));
+  }
+
+  return calculate_multi_ndt_score_covariance(ndt_result, poses_to_search, nvtl_vec, temperature);
+}
+
+ResultOfMultiNdtCovarianceEstimation estimate_xy_covariance_by_multi_ndt_score(
+  const NdtResult & ndt_result,
+  const std::shared_ptr<
+    pclomp::MultiGridNormalDistributionsTransform<pcl::PointXYZ, pcl::PointXYZ>> & ndt_ptr,
+  const std::vector<Eigen::Matrix4f> & poses_to_search, const double temperature,
+  MultiNdtWorkerPool & worker_pool)
+{
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr input_cloud = ndt_ptr->getInputCloud();
+
+  // multiple searches, each of which is done by the NDT of a thread
+  std::vector<double> nvtl_vec(poses_to_search.size());
+  worker_pool.run(
+    *ndt_ptr, poses_to_search.size(),
+    [&](
+      MultiNdtWorkerPool::NdtType & ndt, MultiNdtWorkerPool::PointCloud & cloud_buffer,
+      const size_t i) {
+      transformPointCloud(*input_cloud, cloud_buffer, poses_to_search[i]);
+      nvtl_vec[i] = ndt.calculateNearestVoxelTransformationLikelihood(cloud_buffer);
+    });
+
+  return calculate_multi_ndt_score_covariance(ndt_result, poses_to_search, nvtl_vec, temperature);
+}
 
 std::vector<Eigen::Matrix4f> propose_poses_to_search(
   const NdtResult & ndt_result, const std::vector<double> & offset_x,
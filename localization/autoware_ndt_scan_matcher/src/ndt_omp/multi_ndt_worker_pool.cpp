@@ -0,0 +1,139 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/ndt_scan_matcher/ndt_omp/multi_ndt_worker_pool.hpp>
+
+#include <algorithm>
+#include <memory>
+
+namespace pclomp
+{
+
+MultiNdtWorkerPool::MultiNdtWorkerPool(const int thread_num)
+: states_(static_cast<size_t>(std::max(thread_num, 1)))
+{
+  for (auto & state : states_) {
+    state.ndt_ptr = std::make_shared<NdtType>();
+  }
+
+  for (size_t i = 0; i < states_.size(); ++i) {
+    threads_.emplace_back(&MultiNdtWorkerPool::worker_loop, this, i);
+  }
+}
+
+MultiNdtWorkerPool::~MultiNdtWorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopped_ = true;
+  }
+  job_cv_.notify_all();
+
+  for (auto & thread : threads_) {
+    thread.join();
+  }
+}
+
+void MultiNdtWorkerPool::run(const NdtType & ndt, const size_t task_num, const Task & task)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_ndt_ = &ndt;
+    job_task_ = &task;
+    job_task_num_ = task_num;
+    next_task_index_ = 0;
+    running_thread_num_ = threads_.size();
+    job_exception_ = nullptr;
+    ++job_id_;
+  }
+  job_cv_.notify_all();
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_cv_.wait(lock, [this] { return running_thread_num_ == 0; });
+
+  job_ndt_ = nullptr;
+  job_task_ = nullptr;
+
+  if (job_exception_) {
+    std::rethrow_exception(job_exception_);
+  }
+}
+
+void MultiNdtWorkerPool::worker_loop(const size_t worker_index)
+{
+  WorkerState & state = states_[worker_index];
+  uint64_t last_job_id = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      job_cv_.wait(lock, [&] { return is_stopped_ || job_id_ != last_job_id; });
+
+      if (is_stopped_) {
+        return;
+      }
+
+      last_job_id = job_id_;
+    }
+
+    // Every thread takes part in every job, so that all the NDTs are kept in sync
+    try {
+      sync_ndt(state, *job_ndt_);
+
+      for (size_t i = next_task_index_++; i < job_task_num_; i = next_task_index_++) {
+        (*job_task_)(*state.ndt_ptr, state.cloud_buffer, i);
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (!job_exception_) {
+        job_exception_ = std::current_exception();
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_thread_num_;
+    }
+    done_cv_.notify_one();
+  }
+}
+
+void MultiNdtWorkerPool::sync_ndt(WorkerState & state, const NdtType & ndt) const
+{
+  NdtType & worker_ndt = *state.ndt_ptr;
+
+  // Copying the NDT shares its voxel grids, while the search index is copied
+  if (!state.is_initialized || worker_ndt.getTargetRevision() != ndt.getTargetRevision()) {
+    worker_ndt = ndt;
+
+    NdtParams params = ndt.getParams();
+    params.num_threads = std::max(params.num_threads / static_cast<int>(states_.size()), 1);
+    worker_ndt.setParams(params);
+
+    state.is_initialized = true;
+  }
+
+  worker_ndt.setInputSource(ndt.getInputCloud());
+
+  const auto regularization_pose = ndt.getRegularizationPose();
+
+  if (regularization_pose) {
+    worker_ndt.setRegularizationPose(*regularization_pose);
+  } else {
+    worker_ndt.unsetRegularizationPose();
+  }
+}
+
+}  // namespace pclomp
@@ -58,6 +58,7 @@
 #include <pcl/common/common.h>
 #include <pcl/filters/boost.h>
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <string>
@@ -73,7 +74,11 @@ MultiVoxelGridCovariance<PointT>::MultiVoxelGridCovariance(const MultiVoxelGridC
   sid_to_iid_(other.sid_to_iid_),
   grid_list_(other.grid_list_),
   kdtree_(other.kdtree_),
-  leaf_ptrs_(other.leaf_ptrs_)
+  leaf_ptrs_(other.leaf_ptrs_),
+  search_method_(other.search_method_),
+  voxel_leaf_map_(other.voxel_leaf_map_),
+  pending_grids_(other.pending_grids_),
+  revision_(other.revision_)
 {
   min_points_per_voxel_ = other.min_points_per_voxel_;
   min_covar_eigvalue_mult_ = other.min_covar_eigvalue_mult_;
@@ -97,7 +102,11 @@ MultiVoxelGridCovariance<PointT>::MultiVoxelGridCovariance(
   sid_to_iid_(std::move(other.sid_to_iid_)),
   grid_list_(std::move(other.grid_list_)),
   kdtree_(std::move(other.kdtree_)),
-  leaf_ptrs_(std::move(other.leaf_ptrs_))
+  leaf_ptrs_(std::move(other.leaf_ptrs_)),
+  search_method_(other.search_method_),
+  voxel_leaf_map_(std::move(other.voxel_leaf_map_)),
+  pending_grids_(std::move(other.pending_grids_)),
+  revision_(other.revision_)
 {
   min_points_per_voxel_ = other.min_points_per_voxel_;
   min_covar_eigvalue_mult_ = other.min_covar_eigvalue_mult_;
@@ -116,6 +125,10 @@ MultiVoxelGridCovariance<PointT> & pclomp::MultiVoxelGridCovariance<PointT>::ope
   grid_list_ = other.grid_list_;
   kdtree_ = other.kdtree_;
   leaf_ptrs_ = other.leaf_ptrs_;
+  search_method_ = other.search_method_;
+  voxel_leaf_map_ = other.voxel_leaf_map_;
+  pending_grids_ = other.pending_grids_;
+  revision_ = other.revision_;
   min_points_per_voxel_ = other.min_points_per_voxel_;
   min_covar_eigvalue_mult_ = other.min_covar_eigvalue_mult_;
 
@@ -141,6 +154,10 @@ MultiVoxelGridCovariance<PointT> & pclomp::MultiVoxelGridCovariance<PointT>::ope
   grid_list_ = std::move(other.grid_list_);
   kdtree_ = std::move(other.kdtree_);
   leaf_ptrs_ = std::move(other.leaf_ptrs_);
+  search_method_ = other.search_method_;
+  voxel_leaf_map_ = std::move(other.voxel_leaf_map_);
+  pending_grids_ = std::move(other.pending_grids_);
+  revision_ = other.revision_;
 
   min_points_per_voxel_ = other.min_points_per_voxel_;
   min_covar_eigvalue_mult_ = other.min_covar_eigvalue_mult_;
@@ -157,6 +174,12 @@ template <typename PointT>
 void MultiVoxelGridCovariance<PointT>::setInputCloudAndFilter(
   const PointCloudConstPtr & cloud, const std::string & grid_id)
 {
+  // A grid added again with the same id replaces the old one, whose leaves must leave the index
+  // before the old grid is freed at the next createKdtree()
+  if (sid_to_iid_.count(grid_id) != 0) {
+    removeCloud(grid_id);
+  }
+
   // Creat a new grid and push it to the back of the vector grid_list_
   // The vector grid_list_ will be rebuilt after we remove obsolete grids
   GridNodePtr new_grid(new GridNodeType);
@@ -165,6 +188,9 @@ void MultiVoxelGridCovariance<PointT>::setInputCloudAndFilter(
 
   sid_to_iid_[grid_id] = grid_list_.size() - 1;
 
+  // The leaves of the new grid are indexed at the next createKdtree()
+  pending_grids_.push_back(new_grid);
+
   // If single thread, no parallel processing
   if (thread_num_ == 1) {
     apply_filter(cloud, *new_grid);
@@ -187,12 +213,53 @@ void MultiVoxelGridCovariance<PointT>::removeCloud(const std::string & grid_id)
     return;
   }
 
+  GridNodePtr & grid_ptr = grid_list_[iid->second];
+
+  // Grids that are still pending have not been added to the index yet, and
+  // they are kept alive by pending_grids_ until their filtering finishes
+  const bool is_pending =
+    std::find(pending_grids_.begin(), pending_grids_.end(), grid_ptr) != pending_grids_.end();
+
+  if (search_method_ != KDTREE && !is_pending) {
+    eraseGridFromIndex(*grid_ptr);
+  }
+
   // Set the pointer corresponding to the specified grid to null
-  grid_list_[iid->second].reset();
+  grid_ptr.reset();
   // Remove the specified grid from the conversion map
   sid_to_iid_.erase(iid);
 }
 
+template <typename PointT>
+void MultiVoxelGridCovariance<PointT>::syncGrids(const MultiVoxelGridCovariance & other)
+{
+  // Remove the grids that other no longer has
+  std::vector<std::string> ids_to_remove;
+
+  for (const auto & it : sid_to_iid_) {
+    if (other.sid_to_iid_.count(it.first) == 0) {
+      ids_to_remove.push_back(it.first);
+    }
+  }
+
+  for (const auto & id : ids_to_remove) {
+    removeCloud(id);
+  }
+
+  // Share the grids that only other has. Their leaves are never modified after filtering.
+  for (const auto & it : other.sid_to_iid_) {
+    if (sid_to_iid_.count(it.first) != 0) {
+      continue;
+    }
+
+    const GridNodePtr & grid_ptr = other.grid_list_[it.second];
+
+    grid_list_.push_back(grid_ptr);
+    sid_to_iid_[it.first] = grid_list_.size() - 1;
+    pending_grids_.push_back(grid_ptr);
+  }
+}
+
 template <typename PointT>
 void MultiVoxelGridCovariance<PointT>::createKdtree()
 {
@@ -212,33 +279,106 @@ void MultiVoxelGridCovariance<PointT>::createKdtree()
     new_grid_list[new_pos] = grid_ptr;
     old_pos = new_pos;
     ++new_pos;
-    total_leaf_num = grid_ptr->size();
+    total_leaf_num += grid_ptr->size();
   }
 
   grid_list_ = std::move(new_grid_list);
 
-  // Rebuild the voxel_centroids_ptr_
-  voxel_centroids_ptr_.reset(new PointCloud);
-  voxel_centroids_ptr_->reserve(total_leaf_num);
-  leaf_ptrs_.clear();
-  leaf_ptrs_.reserve(total_leaf_num);
-
-  for (const auto & grid_ptr : grid_list_) {
-    for (const auto & leaf : *grid_ptr) {
-      PointT new_leaf;
-
-      new_leaf.x = leaf.centroid_[0];
-      new_leaf.y = leaf.centroid_[1];
-      new_leaf.z = leaf.centroid_[2];
-      voxel_centroids_ptr_->push_back(new_leaf);
-      leaf_ptrs_.push_back(&leaf);
+  if (search_method_ == KDTREE) {
+    // Rebuild the voxel_centroids_ptr_
+    voxel_centroids_ptr_.reset(new PointCloud);
+    voxel_centroids_ptr_->reserve(total_leaf_num);
+    leaf_ptrs_.clear();
+    leaf_ptrs_.reserve(total_leaf_num);
+
+    for (const auto & grid_ptr : grid_list_) {
+      for (const auto & leaf : *grid_ptr) {
+        PointT new_leaf;
+
+        new_leaf.x = leaf.centroid_[0];
+        new_leaf.y = leaf.centroid_[1];
+        new_leaf.z = leaf.centroid_[2];
+        voxel_centroids_ptr_->push_back(new_leaf);
+        leaf_ptrs_.push_back(&leaf);
+      }
+    }
+
+    // Rebuild the kdtree_ of leaves
+    if (voxel_centroids_ptr_->size() > 0) {
+      kdtree_.setInputCloud(voxel_centroids_ptr_);
+    }
+
+    voxel_leaf_map_.clear();
+  } else {
+    // The hash table is updated incrementally, only the leaves of the grids
+    // added since the last call are inserted. The leaves of removed grids
+    // have already been erased by removeCloud.
+    for (const auto & grid_ptr : pending_grids_) {
+      // Skip the grids that were removed before being indexed
+      if (std::find(grid_list_.begin(), grid_list_.end(), grid_ptr) == grid_list_.end()) {
+        continue;
+      }
+
+      for (const auto & leaf : *grid_ptr) {
+        voxel_leaf_map_[leaf.voxel_idx_].push_back(&leaf);
+      }
     }
+
+    // The kdtree structures are not used by the DIRECT* search methods
+    voxel_centroids_ptr_.reset(new PointCloud);
+    leaf_ptrs_.clear();
+  }
+
+  pending_grids_.clear();
+  revision_ = next_revision_++;
+}
+
+template <typename PointT>
+void MultiVoxelGridCovariance<PointT>::eraseGridFromIndex(const GridNodeType & grid)
+{
+  for (const auto & leaf : grid) {
+    auto it = voxel_leaf_map_.find(leaf.voxel_idx_);
+
+    if (it == voxel_leaf_map_.end()) {
+      continue;
+    }
+
+    auto & leaves = it->second;
+
+    leaves.erase(std::remove(leaves.begin(), leaves.end(), &leaf), leaves.end());
+
+    if (leaves.empty()) {
+      voxel_leaf_map_.erase(it);
+    }
+  }
+}
+
+template <typename PointT>
+void MultiVoxelGridCovariance<PointT>::setSearchMethod(NeighborSearchMethod search_method)
+{
+  if (search_method == search_method_) {
+    return;
   }
 
-  // Rebuild the kdtree_ of leaves
-  if (voxel_centroids_ptr_->size() > 0) {
-    kdtree_.setInputCloud(voxel_centroids_ptr_);
+  const bool need_rebuild = (search_method == KDTREE || search_method_ == KDTREE);
+
+  search_method_ = search_method;
+
+  if (!need_rebuild || grid_list_.empty()) {
+    return;
+  }
+
+  // Switching between the kdtree and the hash table requires the other structure to be built
+  if (search_method_ != KDTREE) {
+    voxel_leaf_map_.clear();
+    pending_grids_.clear();
+
+    for (const auto & it : sid_to_iid_) {
+      pending_grids_.push_back(grid_list_[it.second]);
+    }
   }
+
+  createKdtree();
 }
 
 template <typename PointT>
@@ -248,6 +388,10 @@ int MultiVoxelGridCovariance<PointT>::radiusSearch(
 {
   k_leaves.clear();
 
+  if (search_method_ != KDTREE) {
+    return directRadiusSearch(point, radius, k_leaves, max_nn);
+  }
+
   // Search from the kdtree to find neighbors of @point
   std::vector<float> k_sqr_distances;
   std::vector<int> k_indices;
@@ -278,11 +422,82 @@ int MultiVoxelGridCovariance<PointT>::radiusSearch(
   return (radiusSearch(cloud[index], radius, k_leaves, max_nn));
 }
 
+template <typename PointT>
+int MultiVoxelGridCovariance<PointT>::directRadiusSearch(
+  const PointT & point, double radius, std::vector<LeafConstPtr> & k_leaves,
+  unsigned int max_nn) const
+{
+  // Offsets of the voxels to be checked, the query voxel always comes first
+  static const std::vector<Eigen::Vector3i> offsets_26 = []() {
+    std::vector<Eigen::Vector3i> offsets{Eigen::Vector3i::Zero()};
+    for (int x = -1; x <= 1; ++x) {
+      for (int y = -1; y <= 1; ++y) {
+        for (int z = -1; z <= 1; ++z) {
+          if (x != 0 || y != 0 || z != 0) {
+            offsets.emplace_back(x, y, z);
+          }
+        }
+      }
+    }
+    return offsets;
+  }();
+  static const std::vector<Eigen::Vector3i> offsets_7 = {
+    Eigen::Vector3i(0, 0, 0),  Eigen::Vector3i(-1, 0, 0), Eigen::Vector3i(1, 0, 0),
+    Eigen::Vector3i(0, -1, 0), Eigen::Vector3i(0, 1, 0),  Eigen::Vector3i(0, 0, -1),
+    Eigen::Vector3i(0, 0, 1)};
+
+  const std::vector<Eigen::Vector3i> & offsets =
+    (search_method_ == DIRECT26) ? offsets_26 : offsets_7;
+  const size_t offset_num = (search_method_ == DIRECT1) ? 1 : offsets.size();
+  const Eigen::Vector3i voxel_idx = getVoxelIndex(point);
+  const Eigen::Vector3d query(point.x, point.y, point.z);
+  const double sqr_radius = radius * radius;
+
+  for (size_t i = 0; i < offset_num; ++i) {
+    const auto it = voxel_leaf_map_.find(Eigen::Vector3i(voxel_idx + offsets[i]));
+
+    if (it == voxel_leaf_map_.end()) {
+      continue;
+    }
+
+    for (const auto & leaf_ptr : it->second) {
+      // Keep the same acceptance criterion as the kdtree search
+      const Eigen::Vector3d centroid(
+        leaf_ptr->centroid_[0], leaf_ptr->centroid_[1], leaf_ptr->centroid_[2]);
+
+      if ((centroid - query).squaredNorm() > sqr_radius) {
+        continue;
+      }
+
+      k_leaves.push_back(leaf_ptr);
+
+      if (max_nn > 0 && k_leaves.size() >= max_nn) {
+        return k_leaves.size();
+      }
+    }
+  }
+
+  return k_leaves.size();
+}
+
 template <typename PointT>
 typename MultiVoxelGridCovariance<PointT>::PointCloud
 MultiVoxelGridCovariance<PointT>::getVoxelPCD() const
 {
-  return *voxel_centroids_ptr_;
+  PointCloud output;
+
+  for (const auto & it : sid_to_iid_) {
+    for (const auto & leaf : *grid_list_[it.second]) {
+      PointT centroid;
+
+      centroid.x = leaf.centroid_[0];
+      centroid.y = leaf.centroid_[1];
+      centroid.z = leaf.centroid_[2];
+      output.push_back(centroid);
+    }
+  }
+
+  return output;
 }
 
 template <typename PointT>
@@ -357,6 +572,9 @@ void MultiVoxelGridCovariance<PointT>::apply_filter(
     }
     int64_t lid = getLeafID(p, bbox);
     Leaf & leaf = map_leaves[lid];
+    if (leaf.nr_points_ == 0) {
+      leaf.voxel_idx_ = getVoxelIndex(p);
+    }
     updateLeaf(p, centroid_size, leaf);
   }
 
@@ -407,6 +625,16 @@ int64_t pclomp::MultiVoxelGridCovariance<PointT>::getLeafID(
   return ijk0 * bbox.div_mul[0] + ijk1 * bbox.div_mul[1] + ijk2 * bbox.div_mul[2];
 }
 
+template <typename PointT>
+Eigen::Vector3i pclomp::MultiVoxelGridCovariance<PointT>::getVoxelIndex(const PointT & point) const
+{
+  // Use the same arithmetic as getLeafID so that a point always falls into its own leaf
+  return Eigen::Vector3i(
+    static_cast<int>(floor(point.x * inverse_leaf_size_[0])),
+    static_cast<int>(floor(point.y * inverse_leaf_size_[1])),
+    static_cast<int>(floor(point.z * inverse_leaf_size_[2])));
+}
+
 template <typename PointT>
 void pclomp::MultiVoxelGridCovariance<PointT>::updateLeaf(
   const PointT & point, const int & centroid_size, Leaf & leaf) const
@@ -89,6 +89,8 @@ MultiGridNormalDistributionsTransform<PointSource, PointTarget>::
 
   regularization_pose_ = other.regularization_pose_;
   regularization_pose_translation_ = other.regularization_pose_translation_;
+
+  unshareFakeIndices();
 }
 
 template <typename PointSource, typename PointTarget>
@@ -140,6 +142,7 @@ MultiGridNormalDistributionsTransform<PointSource, PointTarget>::operator=(
   regularization_pose_translation_ = other.regularization_pose_translation_;
 
   BaseRegType::operator=(other);
+  unshareFakeIndices();
 
   return *this;
 }
@@ -191,7 +194,7 @@ MultiGridNormalDistributionsTransform<
   params_.step_size = 0.1;
   params_.resolution = 1.0f;
   params_.max_iterations = 35;
-  params_.search_method = KDTREE;  // Only KDTREE is supported in multigrid_ndt_omp
+  params_.search_method = KDTREE;
   params_.num_threads = omp_get_max_threads();
   params_.regularization_scale_factor = 0.0f;
   params_.use_line_search = false;
@@ -389,7 +392,7 @@ double MultiGridNormalDistributionsTransform<PointSource, PointTarget>::computeD
     auto & x_trans_pt = trans_cloud[idx];
     std::vector<TargetGridLeafConstPtr> neighborhood;
 
-    // Neighborhood search method other than kdtree is disabled in multigrid_ndt_omp
+    // Search neighbors with the method given by params_.search_method
     target_cells_.radiusSearch(x_trans_pt, params_.resolution, neighborhood);
 
     if (neighborhood.empty()) {
@@ -712,7 +715,7 @@ void MultiGridNormalDistributionsTransform<PointSource, PointTarget>::computeHes
     // Find neighbors (Radius search has been experimentally faster than direct neighbor checking.
     std::vector<TargetGridLeafConstPtr> neighborhood;
 
-    // Neighborhood search method other than kdtree is disabled in multigrid_ndt_omp
+    // Search neighbors with the method given by params_.search_method
     target_cells_.radiusSearch(x_trans_pt, params_.resolution, neighborhood);
 
     if (neighborhood.empty()) {
@@ -1077,7 +1080,7 @@ MultiGridNormalDistributionsTransform<PointSource, PointTarget>::calculateTransf
     // Find neighbors (Radius search has been experimentally faster than direct neighbor checking.
     std::vector<TargetGridLeafConstPtr> neighborhood;
 
-    // Neighborhood search method other than kdtree is disabled in multigrid_ndt_omp
+    // Search neighbors with the method given by params_.search_method
     target_cells_.radiusSearch(x_trans_pt, params_.resolution, neighborhood);
 
     if (neighborhood.empty()) {
@@ -1136,7 +1139,7 @@ double MultiGridNormalDistributionsTransform<PointSource, PointTarget>::
     // Find neighbors (Radius search has been experimentally faster than direct neighbor checking.
     std::vector<TargetGridLeafConstPtr> neighborhood;
 
-    // Neighborhood search method other than kdtree is disabled in multigrid_ndt_omp
+    // Search neighbors with the method given by params_.search_method
     target_cells_.radiusSearch(x_trans_pt, params_.resolution, neighborhood);
 
     if (neighborhood.empty()) {
@@ -1195,7 +1198,7 @@ pcl::PointCloud<pcl::PointXYZI> MultiGridNormalDistributionsTransform<PointSourc
     // Find neighbors (Radius search has been experimentally faster than direct neighbor checking.
     std::vector<TargetGridLeafConstPtr> neighborhood;
 
-    // Neighborhood search method other than kdtree is disabled in multigrid_ndt_omp
+    // Search neighbors with the method given by params_.search_method
     target_cells_.radiusSearch(x_trans_pt, params_.resolution, neighborhood);
 
     if (neighborhood.empty()) {
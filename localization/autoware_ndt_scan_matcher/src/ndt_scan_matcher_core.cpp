@@ -18,6 +18,7 @@
 #include <autoware/ndt_scan_matcher/ndt_omp/estimate_covariance.hpp>
 #include <autoware/ndt_scan_matcher/ndt_scan_matcher_core.hpp>
 #include <autoware/ndt_scan_matcher/particle.hpp>
+#include <autoware/ndt_scan_matcher/sensor_points_conversion.hpp>
 #include <autoware_utils_geometry/geometry.hpp>
 #include <autoware_utils_pcl/transforms.hpp>
 
@@ -58,6 +59,21 @@ autoware_internal_debug_msgs::msg::Float32Stamped make_float32_stamped(
   return autoware_internal_debug_msgs::build<T>().stamp(stamp).data(data);
 }
 
+std::string to_string(const CovarianceEstimationType type)
+{
+  switch (type) {
+    case CovarianceEstimationType::FIXED_VALUE:
+      return "fixed_value";
+    case CovarianceEstimationType::LAPLACE_APPROXIMATION:
+      return "laplace_approximation";
+    case CovarianceEstimationType::MULTI_NDT:
+      return "multi_ndt";
+    case CovarianceEstimationType::MULTI_NDT_SCORE:
+      return "multi_ndt_score";
+  }
+  return "unknown";
+}
+
 autoware_internal_debug_msgs::msg::Int32Stamped make_int32_stamped(
   const builtin_interfaces::msg::Time & stamp, const int32_t data)
 {
@@ -158,6 +174,9 @@ NDTScanMatcher::NDTScanMatcher(const rclcpp::NodeOptions & options)
     this->create_publisher<geometry_msgs::msg::PoseArray>("multi_initial_pose", 10);
   exe_time_pub_ =
     this->create_publisher<autoware_internal_debug_msgs::msg::Float32Stamped>("exe_time_ms", 10);
+  covariance_estimation_exe_time_pub_ =
+    this->create_publisher<autoware_internal_debug_msgs::msg::Float32Stamped>(
+      "covariance_estimation_exe_time_ms", 10);
   transform_probability_pub_ =
     this->create_publisher<autoware_internal_debug_msgs::msg::Float32Stamped>(
       "transform_probability", 10);
@@ -204,6 +223,33 @@ NDTScanMatcher::NDTScanMatcher(const rclcpp::NodeOptions & options)
 
   ndt_ptr_->setParams(param_.ndt);
 
+  for (auto & buffer : sensor_points_in_baselink_frame_buffers_) {
+    buffer = pcl::make_shared<pcl::PointCloud<PointSource>>();
+  }
+  sensor_points_in_sensor_frame_ = pcl::make_shared<pcl::PointCloud<PointSource>>();
+  sensor_points_in_map_ = pcl::make_shared<pcl::PointCloud<PointSource>>();
+  no_ground_points_in_map_ = pcl::make_shared<pcl::PointCloud<PointSource>>();
+
+  const CovarianceEstimationType covariance_estimation_type =
+    param_.covariance.covariance_estimation.covariance_estimation_type;
+  if (
+    covariance_estimation_type == CovarianceEstimationType::MULTI_NDT ||
+    covariance_estimation_type == CovarianceEstimationType::MULTI_NDT_SCORE) {
+    // No more threads than the poses searched at once are needed
+    const auto pose_num = static_cast<int>(
+      param_.covariance.covariance_estimation.initial_pose_offset_model_x.size());
+    multi_ndt_worker_pool_ = std::make_unique<pclomp::MultiNdtWorkerPool>(
+      std::max(std::min(param_.ndt.num_threads, pose_num), 1));
+  }
+
+  // No more threads than the particles aligned at once are needed
+  const int64_t initial_pose_batch_size = std::min(
+    param_.initial_pose_estimation.batch_size, param_.initial_pose_estimation.particles_num);
+  if (initial_pose_batch_size > 1) {
+    initial_pose_worker_pool_ =
+      std::make_unique<pclomp::MultiNdtWorkerPool>(static_cast<int>(initial_pose_batch_size));
+  }
+
   initial_pose_buffer_ = std::make_unique<SmartPoseBuffer>(
     this->get_logger(), param_.validation.initial_pose_timeout_sec,
     param_.validation.initial_pose_distance_tolerance_m);
@@ -230,7 +276,15 @@ void NDTScanMatcher::callback_timer()
 
   diagnostics_map_update_->add_key_value("timer_callback_time_stamp", ros_time_now.nanoseconds());
 
-  map_update_module_->callback_timer(is_activated_, latest_ekf_position_, diagnostics_map_update_);
+  std::optional<geometry_msgs::msg::Point> latest_ekf_position;
+  std::optional<geometry_msgs::msg::Vector3> latest_ekf_velocity;
+  {
+    std::lock_guard<std::mutex> lock(latest_ekf_position_mtx_);
+    latest_ekf_position = latest_ekf_position_;
+    latest_ekf_velocity = latest_ekf_velocity_;
+  }
+  map_update_module_->callback_timer(
+    is_activated_, latest_ekf_position, latest_ekf_velocity, diagnostics_map_update_);
 
   diagnostics_map_update_->publish(ros_time_now);
 }
@@ -282,6 +336,28 @@ void NDTScanMatcher::callback_initial_pose_main(
     // latest_ekf_position_ is also used by callback_timer, so it is necessary to acquire the lock
     std::lock_guard<std::mutex> lock(latest_ekf_position_mtx_);
     latest_ekf_position_ = initial_pose_msg_ptr->pose.pose.position;
+
+    // estimate the velocity for the lookahead of dynamic map loading
+    constexpr double ekf_velocity_min_dt = 0.1;
+    constexpr double ekf_velocity_max_dt = 1.0;
+    const double dt = ekf_velocity_reference_pose_
+                        ? (rclcpp::Time(initial_pose_msg_ptr->header.stamp) -
+                           rclcpp::Time(ekf_velocity_reference_pose_->header.stamp))
+                            .seconds()
+                        : -1.0;
+    if (dt < 0.0 || dt > ekf_velocity_max_dt) {
+      // the first pose, a jump back in time, or a gap in the poses
+      latest_ekf_velocity_ = std::nullopt;
+      ekf_velocity_reference_pose_ = *initial_pose_msg_ptr;
+    } else if (dt >= ekf_velocity_min_dt) {
+      const auto & reference_position = ekf_velocity_reference_pose_->pose.pose.position;
+      geometry_msgs::msg::Vector3 velocity;
+      velocity.x = (latest_ekf_position_->x - reference_position.x) / dt;
+      velocity.y = (latest_ekf_position_->y - reference_position.y) / dt;
+      velocity.z = (latest_ekf_position_->z - reference_position.z) / dt;
+      latest_ekf_velocity_ = velocity;
+      ekf_velocity_reference_pose_ = *initial_pose_msg_ptr;
+    }
   }
 }
 
@@ -365,19 +441,11 @@ bool NDTScanMatcher::callback_sensor_points_main(
   }
 
   // preprocess input pointcloud
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_in_sensor_frame(
-    new pcl::PointCloud<PointSource>);
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_in_baselink_frame(
-    new pcl::PointCloud<PointSource>);
   const std::string & sensor_frame = sensor_points_msg_in_sensor_frame->header.frame_id;
 
-  pcl::fromROSMsg(*sensor_points_msg_in_sensor_frame, *sensor_points_in_sensor_frame);
-
-  // transform sensor points from sensor-frame to base_link
+  Eigen::Matrix4f base_to_sensor_matrix;
   try {
-    transform_sensor_measurement(
-      sensor_frame, param_.frame.base_frame, sensor_points_in_sensor_frame,
-      sensor_points_in_baselink_frame);
+    base_to_sensor_matrix = lookup_sensor_transform(sensor_frame, param_.frame.base_frame);
   } catch (const std::exception & ex) {
     std::stringstream message;
     message << ex.what() << ". Please publish TF " << sensor_frame << " to "
@@ -388,6 +456,20 @@ bool NDTScanMatcher::callback_sensor_points_main(
     diagnostics_scan_points_->add_key_value("is_succeed_transform_sensor_points", false);
     return false;
   }
+
+  // The points are written to the buffer which is not the input of the NDT, so that the NDT keeps
+  // the last accepted points until the new ones are set below
+  const pcl::shared_ptr<pcl::PointCloud<PointSource>> & sensor_points_in_baselink_frame =
+    sensor_points_in_baselink_frame_buffers_[sensor_points_buffer_index_];
+
+  // transform sensor points from sensor-frame to base_link while reading them from the message
+  if (!transform_xyz_from_msg(
+        *sensor_points_msg_in_sensor_frame, base_to_sensor_matrix,
+        *sensor_points_in_baselink_frame)) {
+    pcl::fromROSMsg(*sensor_points_msg_in_sensor_frame, *sensor_points_in_sensor_frame_);
+    autoware_utils_pcl::transform_pointcloud(
+      *sensor_points_in_sensor_frame_, *sensor_points_in_baselink_frame, base_to_sensor_matrix);
+  }
   diagnostics_scan_points_->add_key_value("is_succeed_transform_sensor_points", true);
 
   // check sensor_points_max_distance
@@ -412,6 +494,7 @@ bool NDTScanMatcher::callback_sensor_points_main(
 
   // set sensor points to ndt class
   ndt_ptr_->setInputSource(sensor_points_in_baselink_frame);
+  sensor_points_buffer_index_ = 1 - sensor_points_buffer_index_;
 
   // check is_activated
   diagnostics_scan_points_->add_key_value("is_activated", static_cast<bool>(is_activated_));
@@ -593,8 +676,29 @@ bool NDTScanMatcher::callback_sensor_points_main(
   if (
     param_.covariance.covariance_estimation.covariance_estimation_type !=
     CovarianceEstimationType::FIXED_VALUE) {
+    const auto covariance_start_time = std::chrono::system_clock::now();
     const Eigen::Matrix2d estimated_covariance_2d =
       estimate_covariance(ndt_result, initial_pose_matrix, sensor_ros_time);
+    const auto covariance_duration_micro_sec =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now() - covariance_start_time)
+        .count();
+    const auto covariance_exe_time = static_cast<float>(covariance_duration_micro_sec) / 1000.0f;
+    diagnostics_scan_points_->add_key_value(
+      "covariance_estimation_execution_time", covariance_exe_time);
+    covariance_estimation_exe_time_pub_->publish(
+      make_float32_stamped(sensor_ros_time, covariance_exe_time));
+
+    // the statistics over the latest scans
+    covariance_estimation_exe_time_window_.add(covariance_exe_time);
+    const auto statistics = covariance_estimation_exe_time_window_.statistics();
+    const auto key_prefix =
+      "covariance_estimation_execution_time_" +
+      to_string(param_.covariance.covariance_estimation.covariance_estimation_type) + "_";
+    diagnostics_scan_points_->add_key_value(key_prefix + "min", statistics.min);
+    diagnostics_scan_points_->add_key_value(key_prefix + "mean", statistics.mean);
+    diagnostics_scan_points_->add_key_value(key_prefix + "p95", statistics.p95);
+    diagnostics_scan_points_->add_key_value(key_prefix + "max", statistics.max);
     const Eigen::Matrix2d estimated_covariance_2d_scaled =
       estimated_covariance_2d * param_.covariance.covariance_estimation.scale_factor;
     const double default_cov_xx = param_.covariance.output_pose_covariance[0];
@@ -647,11 +751,22 @@ bool NDTScanMatcher::callback_sensor_points_main(
     sensor_ros_time, result_pose_msg, interpolation_result.interpolated_pose,
     interpolation_result.old_pose, interpolation_result.new_pose);
 
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> sensor_points_in_map_ptr(
-    new pcl::PointCloud<PointSource>);
+  // The sensor points in the map frame are only used by the debug outputs
+  const bool is_sensor_points_in_map_needed =
+    sensor_aligned_pose_pub_->get_subscription_count() > 0 ||
+    voxel_score_points_pub_->get_subscription_count() > 0 ||
+    param_.score_estimation.no_ground_points.enable;
+  if (!is_sensor_points_in_map_needed) {
+    return is_converged;
+  }
+
+  const pcl::shared_ptr<pcl::PointCloud<PointSource>> & sensor_points_in_map_ptr =
+    sensor_points_in_map_;
   autoware_utils_pcl::transform_pointcloud(
     *sensor_points_in_baselink_frame, *sensor_points_in_map_ptr, ndt_result.pose);
-  publish_point_cloud(sensor_ros_time, param_.frame.map_frame, sensor_points_in_map_ptr);
+  if (sensor_aligned_pose_pub_->get_subscription_count() > 0) {
+    publish_point_cloud(sensor_ros_time, param_.frame.map_frame, sensor_points_in_map_ptr);
+  }
 
   // check each of point score
   const float lower_nvs = 1.0f;
@@ -671,27 +786,29 @@ bool NDTScanMatcher::callback_sensor_points_main(
   // whether use no ground points to calculate score
   if (param_.score_estimation.no_ground_points.enable) {
     // remove ground
-    pcl::shared_ptr<pcl::PointCloud<PointSource>> no_ground_points_in_map_ptr(
-      new pcl::PointCloud<PointSource>);
-    for (std::size_t i = 0; i < sensor_points_in_map_ptr->size(); i++) {
-      const float point_z = sensor_points_in_map_ptr->points[i].z;  // NOLINT
+    pcl::PointCloud<PointSource> & no_ground_points_in_map = *no_ground_points_in_map_;
+    no_ground_points_in_map.clear();
+    const double result_z = matrix4f_to_pose(ndt_result.pose).position.z;
+    for (const auto & point : sensor_points_in_map_ptr->points) {
       if (
-        point_z - matrix4f_to_pose(ndt_result.pose).position.z >
+        point.z - result_z >
         param_.score_estimation.no_ground_points.z_margin_for_ground_removal) {
-        no_ground_points_in_map_ptr->points.push_back(sensor_points_in_map_ptr->points[i]);
+        no_ground_points_in_map.push_back(point);
       }
     }
     // pub remove-ground points
-    sensor_msgs::msg::PointCloud2 no_ground_points_msg_in_map;
-    pcl::toROSMsg(*no_ground_points_in_map_ptr, no_ground_points_msg_in_map);
-    no_ground_points_msg_in_map.header.stamp = sensor_ros_time;
-    no_ground_points_msg_in_map.header.frame_id = param_.frame.map_frame;
-    no_ground_points_aligned_pose_pub_->publish(no_ground_points_msg_in_map);
+    if (no_ground_points_aligned_pose_pub_->get_subscription_count() > 0) {
+      sensor_msgs::msg::PointCloud2 no_ground_points_msg_in_map;
+      pcl::toROSMsg(no_ground_points_in_map, no_ground_points_msg_in_map);
+      no_ground_points_msg_in_map.header.stamp = sensor_ros_time;
+      no_ground_points_msg_in_map.header.frame_id = param_.frame.map_frame;
+      no_ground_points_aligned_pose_pub_->publish(no_ground_points_msg_in_map);
+    }
     // calculate score
     const auto no_ground_transform_probability = static_cast<float>(
-      ndt_ptr_->calculateTransformationProbability(*no_ground_points_in_map_ptr));
+      ndt_ptr_->calculateTransformationProbability(no_ground_points_in_map));
     const auto no_ground_nearest_voxel_transformation_likelihood = static_cast<float>(
-      ndt_ptr_->calculateNearestVoxelTransformationLikelihood(*no_ground_points_in_map_ptr));
+      ndt_ptr_->calculateNearestVoxelTransformationLikelihood(no_ground_points_in_map));
     // pub score
     no_ground_transform_probability_pub_->publish(
       make_float32_stamped(sensor_ros_time, no_ground_transform_probability));
@@ -702,14 +819,11 @@ bool NDTScanMatcher::callback_sensor_points_main(
   return is_converged;
 }
 
-void NDTScanMatcher::transform_sensor_measurement(
-  const std::string & source_frame, const std::string & target_frame,
-  const pcl::shared_ptr<pcl::PointCloud<PointSource>> & sensor_points_input_ptr,
-  pcl::shared_ptr<pcl::PointCloud<PointSource>> & sensor_points_output_ptr)
+Eigen::Matrix4f NDTScanMatcher::lookup_sensor_transform(
+  const std::string & source_frame, const std::string & target_frame)
 {
   if (source_frame == target_frame) {
-    sensor_points_output_ptr = sensor_points_input_ptr;
-    return;
+    return Eigen::Matrix4f::Identity();
   }
 
   geometry_msgs::msg::TransformStamped transform;
@@ -721,10 +835,7 @@ void NDTScanMatcher::transform_sensor_measurement(
 
   const geometry_msgs::msg::PoseStamped target_to_source_pose_stamped =
     autoware_utils_geometry::transform2pose(transform);
-  const Eigen::Matrix4f base_to_sensor_matrix =
-    pose_to_matrix4f(target_to_source_pose_stamped.pose);
-  autoware_utils_pcl::transform_pointcloud(
-    *sensor_points_input_ptr, *sensor_points_output_ptr, base_to_sensor_matrix);
+  return pose_to_matrix4f(target_to_source_pose_stamped.pose);
 }
 
 void NDTScanMatcher::publish_tf(
@@ -880,7 +991,8 @@ Eigen::Matrix2d NDTScanMatcher::estimate_covariance(
       ndt_result, param_.covariance.covariance_estimation.initial_pose_offset_model_x,
       param_.covariance.covariance_estimation.initial_pose_offset_model_y);
     const pclomp::ResultOfMultiNdtCovarianceEstimation result_of_multi_ndt_covariance_estimation =
-      estimate_xy_covariance_by_multi_ndt(ndt_result, ndt_ptr_, poses_to_search);
+      estimate_xy_covariance_by_multi_ndt(
+        ndt_result, ndt_ptr_, poses_to_search, *multi_ndt_worker_pool_);
     for (size_t i = 0; i < result_of_multi_ndt_covariance_estimation.ndt_initial_poses.size();
          i++) {
       multi_ndt_result_msg.poses.push_back(
@@ -899,7 +1011,8 @@ Eigen::Matrix2d NDTScanMatcher::estimate_covariance(
       param_.covariance.covariance_estimation.initial_pose_offset_model_y);
     const pclomp::ResultOfMultiNdtCovarianceEstimation
       result_of_multi_ndt_score_covariance_estimation = estimate_xy_covariance_by_multi_ndt_score(
-        ndt_result, ndt_ptr_, poses_to_search, param_.covariance.covariance_estimation.temperature);
+        ndt_result, ndt_ptr_, poses_to_search, param_.covariance.covariance_estimation.temperature,
+        *multi_ndt_worker_pool_);
     for (const auto & sub_initial_pose_matrix : poses_to_search) {
       multi_initial_pose_msg.poses.push_back(matrix4f_to_pose(sub_initial_pose_matrix));
     }
@@ -1106,60 +1219,87 @@ std::tuple<geometry_msgs::msg::PoseWithCovarianceStamped, double> NDTScanMatcher
     param_.initial_pose_estimation.n_startup_trials, sample_mean, sample_stddev);
 
   std::vector<Particle> particle_array;
-  auto output_cloud = std::make_shared<pcl::PointCloud<PointSource>>();
 
   // publish the estimated poses in 20 times to see the progress and to avoid dropping data
   visualization_msgs::msg::MarkerArray marker_array;
   constexpr int64_t publish_num = 20;
-  const int64_t publish_interval = param_.initial_pose_estimation.particles_num / publish_num;
-
-  for (int64_t i = 0; i < param_.initial_pose_estimation.particles_num; i++) {
-    const TreeStructuredParzenEstimator::Input input = tpe.get_next_input();
-
-    geometry_msgs::msg::Pose initial_pose;
-    initial_pose.position.x = input[0];
-    initial_pose.position.y = input[1];
-    initial_pose.position.z = input[2];
-    geometry_msgs::msg::Vector3 init_rpy;
-    init_rpy.x = input[3];
-    init_rpy.y = input[4];
-    init_rpy.z = input[5];
-    tf2::Quaternion tf_quaternion;
-    tf_quaternion.setRPY(init_rpy.x, init_rpy.y, init_rpy.z);
-    initial_pose.orientation = tf2::toMsg(tf_quaternion);
-
-    const Eigen::Matrix4f initial_pose_matrix = pose_to_matrix4f(initial_pose);
-    ndt_ptr_->align(*output_cloud, initial_pose_matrix);
-    const pclomp::NdtResult ndt_result = ndt_ptr_->getResult();
-
-    Particle particle(
-      initial_pose, matrix4f_to_pose(ndt_result.pose),
-      ndt_result.nearest_voxel_transformation_likelihood, ndt_result.iteration_num);
-    particle_array.push_back(particle);
-    push_debug_markers(marker_array, get_clock()->now(), param_.frame.map_frame, particle, i);
-    if (
-      (i + 1) % publish_interval == 0 || (i + 1) == param_.initial_pose_estimation.particles_num) {
-      ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
-      marker_array.markers.clear();
+  const int64_t particles_num = param_.initial_pose_estimation.particles_num;
+  const int64_t publish_interval = particles_num / publish_num;
+
+  // The particles of a batch are proposed by the TPE at once and aligned concurrently on the
+  // initial pose worker pool, whose threads hold copies of ndt_ptr_ sharing its voxel grids.
+  const int64_t batch_size =
+    std::clamp<int64_t>(param_.initial_pose_estimation.batch_size, 1, particles_num);
+
+  std::vector<geometry_msgs::msg::Pose> initial_poses(batch_size);
+  std::vector<pclomp::NdtResult> ndt_results(batch_size);
+  pcl::PointCloud<PointSource> output_cloud;
+  const pclomp::MultiNdtWorkerPool::Task align_particle =
+    [&](NormalDistributionsTransform & ndt, pcl::PointCloud<PointSource> & cloud_buffer,
+        const size_t j) {
+      ndt.align(cloud_buffer, pose_to_matrix4f(initial_poses[j]));
+      ndt_results[j] = ndt.getResult();
+    };
+
+  for (int64_t batch_begin = 0; batch_begin < particles_num; batch_begin += batch_size) {
+    const int64_t batch_num = std::min(batch_size, particles_num - batch_begin);
+
+    for (int64_t j = 0; j < batch_num; j++) {
+      const TreeStructuredParzenEstimator::Input input = tpe.get_next_input();
+
+      geometry_msgs::msg::Pose & initial_pose = initial_poses[j];
+      initial_pose.position.x = input[0];
+      initial_pose.position.y = input[1];
+      initial_pose.position.z = input[2];
+      geometry_msgs::msg::Vector3 init_rpy;
+      init_rpy.x = input[3];
+      init_rpy.y = input[4];
+      init_rpy.z = input[5];
+      tf2::Quaternion tf_quaternion;
+      tf_quaternion.setRPY(init_rpy.x, init_rpy.y, init_rpy.z);
+      initial_pose.orientation = tf2::toMsg(tf_quaternion);
     }
 
-    const geometry_msgs::msg::Pose pose = matrix4f_to_pose(ndt_result.pose);
-    const geometry_msgs::msg::Vector3 rpy = autoware::localization_util::get_rpy(pose);
+    if (batch_num == 1) {
+      align_particle(*ndt_ptr_, output_cloud, 0);
+    } else {
+      initial_pose_worker_pool_->run(*ndt_ptr_, static_cast<size_t>(batch_num), align_particle);
+    }
 
-    TreeStructuredParzenEstimator::Input result(6);
-    result[0] = pose.position.x;
-    result[1] = pose.position.y;
-    result[2] = pose.position.z;
-    result[3] = rpy.x;
-    result[4] = rpy.y;
-    result[5] = rpy.z;
-    tpe.add_trial(TreeStructuredParzenEstimator::Trial{result, ndt_result.transform_probability});
+    // The results are handled in the order of the proposals, so that the output does not
+    // depend on which alignment finishes first
+    for (int64_t j = 0; j < batch_num; j++) {
+      const int64_t i = batch_begin + j;
+      const pclomp::NdtResult & ndt_result = ndt_results[j];
+
+      Particle particle(
+        initial_poses[j], matrix4f_to_pose(ndt_result.pose),
+        ndt_result.nearest_voxel_transformation_likelihood, ndt_result.iteration_num);
+      particle_array.push_back(particle);
+      push_debug_markers(marker_array, get_clock()->now(), param_.frame.map_frame, particle, i);
+      if ((i + 1) % publish_interval == 0 || (i + 1) == particles_num) {
+        ndt_monte_carlo_initial_pose_marker_pub_->publish(marker_array);
+        marker_array.markers.clear();
+      }
 
-    auto sensor_points_in_map_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
-    autoware_utils_pcl::transform_pointcloud(
-      *ndt_ptr_->getInputSource(), *sensor_points_in_map_ptr, ndt_result.pose);
-    publish_point_cloud(
-      initial_pose_with_cov.header.stamp, param_.frame.map_frame, sensor_points_in_map_ptr);
+      const geometry_msgs::msg::Pose pose = matrix4f_to_pose(ndt_result.pose);
+      const geometry_msgs::msg::Vector3 rpy = autoware::localization_util::get_rpy(pose);
+
+      TreeStructuredParzenEstimator::Input result(6);
+      result[0] = pose.position.x;
+      result[1] = pose.position.y;
+      result[2] = pose.position.z;
+      result[3] = rpy.x;
+      result[4] = rpy.y;
+      result[5] = rpy.z;
+      tpe.add_trial(TreeStructuredParzenEstimator::Trial{result, ndt_result.transform_probability});
+
+      auto sensor_points_in_map_ptr = std::make_shared<pcl::PointCloud<PointSource>>();
+      autoware_utils_pcl::transform_pointcloud(
+        *ndt_ptr_->getInputSource(), *sensor_points_in_map_ptr, ndt_result.pose);
+      publish_point_cloud(
+        initial_pose_with_cov.header.stamp, param_.frame.map_frame, sensor_points_in_map_ptr);
+    }
   }
 
   auto best_particle_ptr = std::max_element(
@@ -0,0 +1,101 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/ndt_scan_matcher/sensor_points_conversion.hpp>
+
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+
+namespace autoware::ndt_scan_matcher
+{
+
+namespace
+{
+std::optional<uint32_t> find_float32_field_offset(
+  const sensor_msgs::msg::PointCloud2 & msg, const std::string & name)
+{
+  for (const auto & field : msg.fields) {
+    if (field.name != name) {
+      continue;
+    }
+    const bool is_float32 =
+      field.datatype == sensor_msgs::msg::PointField::FLOAT32 && field.count == 1;
+    if (!is_float32 || field.offset + sizeof(float) > msg.point_step) {
+      return std::nullopt;
+    }
+    return field.offset;
+  }
+  return std::nullopt;
+}
+}  // namespace
+
+bool transform_xyz_from_msg(
+  const sensor_msgs::msg::PointCloud2 & msg, const Eigen::Matrix4f & transform,
+  pcl::PointCloud<pcl::PointXYZ> & output)
+{
+  if (msg.is_bigendian) {
+    return false;
+  }
+
+  const std::optional<uint32_t> x_offset = find_float32_field_offset(msg, "x");
+  const std::optional<uint32_t> y_offset = find_float32_field_offset(msg, "y");
+  const std::optional<uint32_t> z_offset = find_float32_field_offset(msg, "z");
+  if (!x_offset || !y_offset || !z_offset) {
+    return false;
+  }
+
+  const size_t width = msg.width;
+  const size_t height = msg.height;
+  if (
+    width * msg.point_step > msg.row_step ||
+    static_cast<size_t>(msg.row_step) * height > msg.data.size()) {
+    return false;
+  }
+
+  // resize() keeps the capacity, so the points are not reallocated once the buffer is large enough
+  output.resize(width * height);
+  output.width = static_cast<uint32_t>(width);
+  output.height = static_cast<uint32_t>(height);
+  output.is_dense = msg.is_dense;
+  pcl_conversions::toPCL(msg.header, output.header);
+
+  const Eigen::Matrix3f rotation = transform.topLeftCorner<3, 3>();
+  const Eigen::Vector3f translation = transform.topRightCorner<3, 1>();
+
+  for (size_t row = 0; row < height; ++row) {
+    const uint8_t * row_data = msg.data.data() + row * msg.row_step;
+    pcl::PointXYZ * row_points = output.points.data() + row * width;
+
+    for (size_t col = 0; col < width; ++col) {
+      const uint8_t * point_data = row_data + col * msg.point_step;
+      Eigen::Vector3f point;
+      std::memcpy(&point.x(), point_data + *x_offset, sizeof(float));
+      std::memcpy(&point.y(), point_data + *y_offset, sizeof(float));
+      std::memcpy(&point.z(), point_data + *z_offset, sizeof(float));
+
+      const Eigen::Vector3f transformed_point = rotation * point + translation;
+      row_points[col].x = transformed_point.x();
+      row_points[col].y = transformed_point.y();
+      row_points[col].z = transformed_point.z();
+    }
+  }
+
+  return true;
+}
+
+}  // namespace autoware::ndt_scan_matcher
@@ -0,0 +1,75 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../include/autoware/ndt_scan_matcher/execution_time_window.hpp"
+
+#include <gtest/gtest.h>
+
+using autoware::ndt_scan_matcher::ExecutionTimeWindow;
+
+TEST(ExecutionTimeWindow, EmptyWindowIsZero)
+{
+  const ExecutionTimeWindow window(10);
+  const auto statistics = window.statistics();
+  EXPECT_EQ(window.size(), 0u);
+  EXPECT_FLOAT_EQ(statistics.min, 0.0f);
+  EXPECT_FLOAT_EQ(statistics.mean, 0.0f);
+  EXPECT_FLOAT_EQ(statistics.p95, 0.0f);
+  EXPECT_FLOAT_EQ(statistics.max, 0.0f);
+}
+
+TEST(ExecutionTimeWindow, StatisticsOfTheLatestTimes)
+{
+  ExecutionTimeWindow window(100);
+
+  // 1, 2, ..., 100 in a shuffled order
+  for (int i = 0; i < 100; ++i) {
+    window.add(static_cast<float>((i * 37) % 100 + 1));
+  }
+  auto statistics = window.statistics();
+  EXPECT_EQ(window.size(), 100u);
+  EXPECT_FLOAT_EQ(statistics.min, 1.0f);
+  EXPECT_FLOAT_EQ(statistics.mean, 50.5f);
+  EXPECT_FLOAT_EQ(statistics.p95, 95.0f);
+  EXPECT_FLOAT_EQ(statistics.max, 100.0f);
+
+  // a spike stays in the window until 100 more times are added
+  window.add(1000.0f);
+  statistics = window.statistics();
+  EXPECT_EQ(window.size(), 100u);
+  EXPECT_FLOAT_EQ(statistics.max, 1000.0f);
+  for (int i = 0; i < 99; ++i) {
+    window.add(10.0f);
+  }
+  EXPECT_FLOAT_EQ(window.statistics().max, 1000.0f);
+  window.add(10.0f);
+  statistics = window.statistics();
+  EXPECT_FLOAT_EQ(statistics.min, 10.0f);
+  EXPECT_FLOAT_EQ(statistics.mean, 10.0f);
+  EXPECT_FLOAT_EQ(statistics.p95, 10.0f);
+  EXPECT_FLOAT_EQ(statistics.max, 10.0f);
+}
+
+TEST(ExecutionTimeWindow, P95OfASmallWindow)
+{
+  ExecutionTimeWindow window(100);
+  window.add(3.0f);
+  EXPECT_FLOAT_EQ(window.statistics().p95, 3.0f);
+
+  // the nearest rank of 0.95 * 10 is the 10th value
+  for (int i = 1; i < 10; ++i) {
+    window.add(static_cast<float>(i));
+  }
+  EXPECT_FLOAT_EQ(window.statistics().p95, 9.0f);
+}
@@ -56,6 +56,9 @@ protected:
       }
     }
     node_options.parameter_overrides().emplace_back("initial_pose_estimation.particles_num", 100);
+    for (const auto & param : parameter_overrides_) {
+      node_options.parameter_overrides().push_back(param);
+    }
     node_ = std::make_shared<autoware::ndt_scan_matcher::NDTScanMatcher>(node_options);
     rcl_yaml_node_struct_fini(params_st);
 
@@ -82,6 +85,9 @@ protected:
     sensor_pcd_publisher_ = std::make_shared<StubSensorPcdPublisher>();
   }
 
+  // Parameters overridden by each test case in addition to the ones of the yaml file
+  std::vector<rclcpp::Parameter> parameter_overrides_;
+
   std::shared_ptr<autoware::ndt_scan_matcher::NDTScanMatcher> node_;
   std::shared_ptr<tf2_ros::StaticTransformBroadcaster> tf_broadcaster_;
   std::shared_ptr<StubPcdLoader> pcd_loader_;
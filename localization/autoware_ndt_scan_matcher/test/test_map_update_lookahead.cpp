@@ -0,0 +1,120 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../include/autoware/ndt_scan_matcher/map_update_module.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <optional>
+
+namespace
+{
+using autoware::ndt_scan_matcher::HyperParameters;
+using autoware::ndt_scan_matcher::MapUpdateModule;
+
+HyperParameters::DynamicMapLoading create_param(const double lookahead_time)
+{
+  HyperParameters::DynamicMapLoading param;
+  param.update_distance = 20.0;
+  param.map_radius = 150.0;
+  param.lidar_radius = 100.0;
+  param.lookahead_time = lookahead_time;
+  return param;
+}
+
+geometry_msgs::msg::Point create_point(const double x, const double y)
+{
+  geometry_msgs::msg::Point point;
+  point.x = x;
+  point.y = y;
+  point.z = 3.0;
+  return point;
+}
+
+geometry_msgs::msg::Vector3 create_velocity(const double x, const double y)
+{
+  geometry_msgs::msg::Vector3 velocity;
+  velocity.x = x;
+  velocity.y = y;
+  return velocity;
+}
+}  // namespace
+
+TEST(MapUpdateLookaheadTest, CenterIsAheadAlongTheVelocity)
+{
+  const auto center = MapUpdateModule::compute_map_center(
+    create_point(100.0, 200.0), create_velocity(10.0, -5.0), create_param(2.0));
+  EXPECT_DOUBLE_EQ(center.x, 120.0);
+  EXPECT_DOUBLE_EQ(center.y, 190.0);
+  EXPECT_DOUBLE_EQ(center.z, 3.0);
+}
+
+TEST(MapUpdateLookaheadTest, CenterKeepsTheLidarRangeInTheMap)
+{
+  // 30 m/s for 3 s is clamped to map_radius - lidar_radius - update_distance
+  const auto center = MapUpdateModule::compute_map_center(
+    create_point(0.0, 0.0), create_velocity(0.0, 30.0), create_param(3.0));
+  EXPECT_NEAR(center.x, 0.0, 1e-9);
+  EXPECT_NEAR(center.y, 30.0, 1e-9);
+}
+
+TEST(MapUpdateLookaheadTest, LidarRangeStaysInTheMapUntilTheNextUpdate)
+{
+  // wherever the vehicle is and however fast it drives, the map is not updated only while the
+  // LiDAR range is still in the loaded map
+  const auto param = create_param(3.0);
+  const auto loaded_center = MapUpdateModule::compute_map_center(
+    create_point(0.0, 0.0), create_velocity(0.0, 30.0), param);
+  for (double y = -200.0; y <= 200.0; y += 0.5) {
+    for (const double velocity_y : {-30.0, -5.0, 0.0, 5.0, 30.0}) {
+      const auto center = MapUpdateModule::compute_map_center(
+        create_point(0.0, y), create_velocity(0.0, velocity_y), param);
+      const double center_distance =
+        std::hypot(center.x - loaded_center.x, center.y - loaded_center.y);
+      if (center_distance <= param.update_distance) {
+        EXPECT_LE(std::abs(y - loaded_center.y) + param.lidar_radius, param.map_radius + 1e-9)
+          << "y: " << y << ", velocity_y: " << velocity_y;
+      }
+    }
+  }
+}
+
+TEST(MapUpdateLookaheadTest, CenterIsThePositionWithoutRoomForLookahead)
+{
+  auto param = create_param(3.0);
+  param.map_radius = param.lidar_radius + param.update_distance - 5.0;
+  const auto center = MapUpdateModule::compute_map_center(
+    create_point(10.0, 20.0), create_velocity(0.0, 30.0), param);
+  EXPECT_DOUBLE_EQ(center.x, 10.0);
+  EXPECT_DOUBLE_EQ(center.y, 20.0);
+}
+
+TEST(MapUpdateLookaheadTest, CenterIsThePositionWithoutLookahead)
+{
+  const auto position = create_point(10.0, 20.0);
+  for (const auto & [velocity, lookahead_time] :
+       {std::make_pair(std::optional<geometry_msgs::msg::Vector3>{}, 2.0),
+        std::make_pair(std::make_optional(create_velocity(10.0, 0.0)), 0.0),
+        std::make_pair(std::make_optional(create_velocity(0.0, 0.0)), 2.0),
+        std::make_pair(
+          std::make_optional(create_velocity(std::numeric_limits<double>::quiet_NaN(), 0.0)),
+          2.0)}) {
+    const auto center =
+      MapUpdateModule::compute_map_center(position, velocity, create_param(lookahead_time));
+    EXPECT_DOUBLE_EQ(center.x, position.x);
+    EXPECT_DOUBLE_EQ(center.y, position.y);
+  }
+}
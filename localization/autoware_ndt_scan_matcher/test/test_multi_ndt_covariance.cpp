@@ -0,0 +1,177 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../include/autoware/ndt_scan_matcher/ndt_omp/estimate_covariance.hpp"
+#include "test_util.hpp"
+
+#include <pcl/common/transforms.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+using PointType = pcl::PointXYZ;
+using NdtType = pclomp::MultiGridNormalDistributionsTransform<PointType, PointType>;
+
+const std::vector<double> offset_model_x{0.0, 0.0, 0.5, -0.5, 1.0, -1.0};
+const std::vector<double> offset_model_y{0.5, -0.5, 0.0, 0.0, 0.0, 0.0};
+constexpr double temperature = 0.1;
+
+pcl::PointCloud<PointType>::Ptr make_tile(const float x, const float y)
+{
+  const pcl::PointCloud<PointType> sample = make_sample_half_cubic_pcd();
+  auto tile = pcl::make_shared<pcl::PointCloud<PointType>>();
+  Eigen::Affine3f offset(Eigen::Translation3f(x, y, 0.0f));
+  pcl::transformPointCloud(sample, *tile, offset);
+  return tile;
+}
+
+std::shared_ptr<NdtType> make_ndt()
+{
+  pclomp::NdtParams params{};
+  params.trans_epsilon = 0.01;
+  params.step_size = 0.1;
+  params.resolution = 2.0f;
+  params.max_iterations = 30;
+  params.search_method = pclomp::KDTREE;
+  params.num_threads = 4;
+  params.regularization_scale_factor = 0.0f;
+
+  auto ndt_ptr = std::make_shared<NdtType>();
+  ndt_ptr->setParams(params);
+  ndt_ptr->addTarget(make_tile(0.0f, 0.0f), "0");
+  ndt_ptr->createVoxelKdtree();
+
+  const sensor_msgs::msg::PointCloud2 msg = make_default_sensor_pcd();
+  auto source = pcl::make_shared<pcl::PointCloud<PointType>>();
+  pcl::fromROSMsg(msg, *source);
+  ndt_ptr->setInputSource(source);
+  return ndt_ptr;
+}
+
+pclomp::NdtResult align(const std::shared_ptr<NdtType> & ndt_ptr)
+{
+  Eigen::Matrix4f guess = Eigen::Matrix4f::Identity();
+  guess(0, 3) = 0.3f;
+  guess(1, 3) = -0.3f;
+  pcl::PointCloud<PointType> output;
+  ndt_ptr->align(output, guess);
+  return ndt_ptr->getResult();
+}
+
+void expect_same_estimation(
+  const pclomp::ResultOfMultiNdtCovarianceEstimation & expected,
+  const pclomp::ResultOfMultiNdtCovarianceEstimation & actual)
+{
+  // The threads of the pool divide the OpenMP threads, which changes the order of the sums
+  EXPECT_TRUE(actual.mean.isApprox(expected.mean, 1e-4));
+  EXPECT_TRUE(actual.covariance.isApprox(expected.covariance, 1e-4));
+  ASSERT_EQ(actual.ndt_results.size(), expected.ndt_results.size());
+  for (size_t i = 0; i < expected.ndt_results.size(); ++i) {
+    EXPECT_TRUE(actual.ndt_results[i].pose.isApprox(expected.ndt_results[i].pose, 1e-4f));
+  }
+}
+}  // namespace
+
+TEST(MultiNdtCovariance, WorkerPoolMatchesSequential)  // NOLINT
+{
+  const auto ndt_ptr = make_ndt();
+  const pclomp::NdtResult ndt_result = align(ndt_ptr);
+  const std::vector<Eigen::Matrix4f> poses_to_search =
+    pclomp::propose_poses_to_search(ndt_result, offset_model_x, offset_model_y);
+
+  pclomp::MultiNdtWorkerPool worker_pool(3);
+
+  // Run twice so that the NDTs of the threads are reused
+  for (int i = 0; i < 2; ++i) {
+    expect_same_estimation(
+      pclomp::estimate_xy_covariance_by_multi_ndt(ndt_result, ndt_ptr, poses_to_search),
+      pclomp::estimate_xy_covariance_by_multi_ndt(
+        ndt_result, ndt_ptr, poses_to_search, worker_pool));
+    expect_same_estimation(
+      pclomp::estimate_xy_covariance_by_multi_ndt_score(
+        ndt_result, ndt_ptr, poses_to_search, temperature),
+      pclomp::estimate_xy_covariance_by_multi_ndt_score(
+        ndt_result, ndt_ptr, poses_to_search, temperature, worker_pool));
+  }
+}
+
+TEST(MultiNdtCovariance, WorkerPoolFollowsMapUpdate)  // NOLINT
+{
+  const auto ndt_ptr = make_ndt();
+  pclomp::MultiNdtWorkerPool worker_pool(3);
+
+  pclomp::NdtResult ndt_result = align(ndt_ptr);
+  std::vector<Eigen::Matrix4f> poses_to_search =
+    pclomp::propose_poses_to_search(ndt_result, offset_model_x, offset_model_y);
+  pclomp::estimate_xy_covariance_by_multi_ndt(ndt_result, ndt_ptr, poses_to_search, worker_pool);
+
+  // Replace the map with a shifted one, which the NDTs of the threads must pick up
+  const uint64_t revision = ndt_ptr->getTargetRevision();
+  ndt_ptr->removeTarget("0");
+  ndt_ptr->addTarget(make_tile(1.0f, 0.0f), "1");
+  ndt_ptr->createVoxelKdtree();
+  EXPECT_NE(ndt_ptr->getTargetRevision(), revision);
+
+  ndt_result = align(ndt_ptr);
+  poses_to_search = pclomp::propose_poses_to_search(ndt_result, offset_model_x, offset_model_y);
+  expect_same_estimation(
+    pclomp::estimate_xy_covariance_by_multi_ndt(ndt_result, ndt_ptr, poses_to_search),
+    pclomp::estimate_xy_covariance_by_multi_ndt(
+      ndt_result, ndt_ptr, poses_to_search, worker_pool));
+}
+
+TEST(MultiNdtCovariance, DISABLED_Benchmark)  // NOLINT
+{
+  const auto ndt_ptr = make_ndt();
+  const pclomp::NdtResult ndt_result = align(ndt_ptr);
+  const std::vector<Eigen::Matrix4f> poses_to_search =
+    pclomp::propose_poses_to_search(ndt_result, offset_model_x, offset_model_y);
+  constexpr int nb_iteration = 100;
+
+  const auto measure = [&](const std::string & name, const auto & estimate) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nb_iteration; ++i) {
+      estimate();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::milli>(end - start).count() / nb_iteration
+              << " [ms]" << std::endl;
+  };
+
+  pclomp::MultiNdtWorkerPool worker_pool(4);
+  measure("MULTI_NDT sequential", [&] {
+    pclomp::estimate_xy_covariance_by_multi_ndt(ndt_result, ndt_ptr, poses_to_search);
+  });
+  measure("MULTI_NDT worker pool", [&] {
+    pclomp::estimate_xy_covariance_by_multi_ndt(
+      ndt_result, ndt_ptr, poses_to_search, worker_pool);
+  });
+  measure("MULTI_NDT_SCORE sequential", [&] {
+    pclomp::estimate_xy_covariance_by_multi_ndt_score(
+      ndt_result, ndt_ptr, poses_to_search, temperature);
+  });
+  measure("MULTI_NDT_SCORE worker pool", [&] {
+    pclomp::estimate_xy_covariance_by_multi_ndt_score(
+      ndt_result, ndt_ptr, poses_to_search, temperature, worker_pool);
+  });
+}
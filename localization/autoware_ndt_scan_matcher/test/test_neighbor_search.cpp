@@ -0,0 +1,367 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../include/autoware/ndt_scan_matcher/ndt_omp/multigrid_ndt_omp.h"
+#include "test_util.hpp"
+
+#include <pcl/common/transforms.h>
+#include <pcl/io/pcd_io.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+using PointType = pcl::PointXYZ;
+using NdtType = pclomp::MultiGridNormalDistributionsTransform<PointType, PointType>;
+using GridType = pclomp::MultiVoxelGridCovariance<PointType>;
+
+double elapsed_ms(const std::chrono::steady_clock::time_point & start)
+{
+  const auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+pclomp::NdtParams make_params(const pclomp::NeighborSearchMethod search_method)
+{
+  pclomp::NdtParams params{};
+  params.trans_epsilon = 0.01;
+  params.step_size = 0.1;
+  params.resolution = 2.0f;
+  params.max_iterations = 30;
+  params.search_method = search_method;
+  params.num_threads = 4;
+  params.regularization_scale_factor = 0.0f;
+  return params;
+}
+
+// Map tiles given by the NDT_BENCHMARK_PCD_DIR environment variable,
+// or 20m-square copies of the sample cloud when it is not set
+std::vector<std::pair<std::string, pcl::PointCloud<PointType>::Ptr>> load_map_tiles()
+{
+  std::vector<std::pair<std::string, pcl::PointCloud<PointType>::Ptr>> tiles;
+
+  const char * pcd_dir = std::getenv("NDT_BENCHMARK_PCD_DIR");
+  if (pcd_dir != nullptr) {
+    for (const auto & entry : std::filesystem::directory_iterator(pcd_dir)) {
+      if (entry.path().extension() != ".pcd") {
+        continue;
+      }
+      auto cloud = pcl::make_shared<pcl::PointCloud<PointType>>();
+      if (pcl::io::loadPCDFile(entry.path().string(), *cloud) == 0) {
+        tiles.emplace_back(entry.path().filename().string(), cloud);
+      }
+    }
+    return tiles;
+  }
+
+  const pcl::PointCloud<PointType> sample = make_sample_half_cubic_pcd();
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      auto cloud = pcl::make_shared<pcl::PointCloud<PointType>>();
+      Eigen::Affine3f offset(Eigen::Translation3f(20.0f * i, 20.0f * j, 0.0f));
+      pcl::transformPointCloud(sample, *cloud, offset);
+      tiles.emplace_back(std::to_string(i) + "_" + std::to_string(j), cloud);
+    }
+  }
+  return tiles;
+}
+
+pcl::PointCloud<PointType>::Ptr make_source_cloud(const Eigen::Vector3f & center)
+{
+  const sensor_msgs::msg::PointCloud2 msg = make_default_sensor_pcd();
+  pcl::PointCloud<PointType> cloud;
+  pcl::fromROSMsg(msg, cloud);
+  auto source = pcl::make_shared<pcl::PointCloud<PointType>>();
+  Eigen::Affine3f offset(Eigen::Translation3f(center));
+  pcl::transformPointCloud(cloud, *source, offset);
+  return source;
+}
+}  // namespace
+
+TEST(NeighborSearch, Direct26MatchesKdtree)  // NOLINT
+{
+  const auto tiles = load_map_tiles();
+
+  GridType grid;
+  grid.setLeafSize(2.0f, 2.0f, 2.0f);
+  for (const auto & tile : tiles) {
+    grid.setInputCloudAndFilter(tile.second, tile.first);
+  }
+  grid.createKdtree();
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> dist(-5.0f, 105.0f);
+  std::vector<PointType> queries(2000);
+  for (auto & query : queries) {
+    query.x = dist(engine);
+    query.y = dist(engine);
+    query.z = dist(engine) * 0.2f;
+  }
+
+  std::vector<std::vector<GridType::LeafConstPtr>> kdtree_results;
+  for (const auto & query : queries) {
+    std::vector<GridType::LeafConstPtr> leaves;
+    grid.radiusSearch(query, 2.0, leaves);
+    std::sort(leaves.begin(), leaves.end());
+    kdtree_results.push_back(leaves);
+  }
+
+  grid.setSearchMethod(pclomp::DIRECT26);
+  for (size_t i = 0; i < queries.size(); ++i) {
+    std::vector<GridType::LeafConstPtr> leaves;
+    grid.radiusSearch(queries[i], 2.0, leaves);
+    std::sort(leaves.begin(), leaves.end());
+    EXPECT_EQ(leaves, kdtree_results[i]) << "query index: " << i;
+  }
+}
+
+TEST(NeighborSearch, Direct26MatchesKdtreeFarFromTheOrigin)  // NOLINT
+{
+  // The second tile is 2^21 voxels away from the first one along x, where packing each
+  // coordinate into 21 bits would make the keys of the two tiles collide
+  constexpr float leaf_size = 0.5f;
+  constexpr float far_offset = leaf_size * static_cast<float>(1 << 21);
+  const pcl::PointCloud<PointType> sample = make_sample_half_cubic_pcd();
+  auto far_cloud = pcl::make_shared<pcl::PointCloud<PointType>>();
+  pcl::transformPointCloud(
+    sample, *far_cloud, Eigen::Affine3f(Eigen::Translation3f(far_offset, 0.0f, 0.0f)));
+
+  GridType grid;
+  grid.setLeafSize(leaf_size, leaf_size, leaf_size);
+  grid.setInputCloudAndFilter(sample.makeShared(), "near");
+  grid.setInputCloudAndFilter(far_cloud, "far");
+  grid.createKdtree();
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> dist(-1.0f, 21.0f);
+  std::vector<PointType> queries(2000);
+  for (size_t i = 0; i < queries.size(); ++i) {
+    queries[i].x = dist(engine) + (i % 2 == 0 ? 0.0f : far_offset);
+    queries[i].y = dist(engine);
+    queries[i].z = dist(engine);
+  }
+
+  std::vector<std::vector<GridType::LeafConstPtr>> kdtree_results;
+  for (const auto & query : queries) {
+    std::vector<GridType::LeafConstPtr> leaves;
+    grid.radiusSearch(query, leaf_size, leaves);
+    std::sort(leaves.begin(), leaves.end());
+    kdtree_results.push_back(leaves);
+  }
+
+  grid.setSearchMethod(pclomp::DIRECT26);
+  for (size_t i = 0; i < queries.size(); ++i) {
+    std::vector<GridType::LeafConstPtr> leaves;
+    grid.radiusSearch(queries[i], leaf_size, leaves);
+    std::sort(leaves.begin(), leaves.end());
+    EXPECT_EQ(leaves, kdtree_results[i]) << "query index: " << i;
+  }
+}
+
+TEST(NeighborSearch, IncrementalUpdateMatchesFullRebuild)  // NOLINT
+{
+  const auto tiles = load_map_tiles();
+  ASSERT_GE(tiles.size(), 4u);
+
+  // Load all tiles except the last two, then replace the first two with the last two
+  GridType incremental_grid;
+  incremental_grid.setLeafSize(2.0f, 2.0f, 2.0f);
+  incremental_grid.setSearchMethod(pclomp::DIRECT26);
+  for (size_t i = 0; i + 2 < tiles.size(); ++i) {
+    incremental_grid.setInputCloudAndFilter(tiles[i].second, tiles[i].first);
+  }
+  incremental_grid.createKdtree();
+
+  // The secondary grid follows the primary one by sharing its grids
+  GridType secondary_grid(incremental_grid);
+
+  for (size_t i = tiles.size() - 2; i < tiles.size(); ++i) {
+    incremental_grid.setInputCloudAndFilter(tiles[i].second, tiles[i].first);
+  }
+  incremental_grid.removeCloud(tiles[0].first);
+  incremental_grid.removeCloud(tiles[1].first);
+  incremental_grid.createKdtree();
+
+  secondary_grid.syncGrids(incremental_grid);
+  secondary_grid.createKdtree();
+
+  GridType full_grid;
+  full_grid.setLeafSize(2.0f, 2.0f, 2.0f);
+  for (size_t i = 2; i < tiles.size(); ++i) {
+    full_grid.setInputCloudAndFilter(tiles[i].second, tiles[i].first);
+  }
+  full_grid.createKdtree();
+
+  EXPECT_EQ(incremental_grid.getCurrentMapIDs(), full_grid.getCurrentMapIDs());
+  EXPECT_EQ(secondary_grid.getCurrentMapIDs(), full_grid.getCurrentMapIDs());
+
+  const auto to_centroids = [](const std::vector<GridType::LeafConstPtr> & leaves) {
+    std::vector<std::array<double, 3>> centroids;
+    for (const auto & leaf : leaves) {
+      centroids.push_back({leaf->mean_.x(), leaf->mean_.y(), leaf->mean_.z()});
+    }
+    std::sort(centroids.begin(), centroids.end());
+    return centroids;
+  };
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> dist(-5.0f, 105.0f);
+  for (int i = 0; i < 2000; ++i) {
+    PointType query;
+    query.x = dist(engine);
+    query.y = dist(engine);
+    query.z = dist(engine) * 0.2f;
+
+    std::vector<GridType::LeafConstPtr> expected;
+    std::vector<GridType::LeafConstPtr> incremental;
+    std::vector<GridType::LeafConstPtr> secondary;
+    full_grid.radiusSearch(query, 2.0, expected);
+    incremental_grid.radiusSearch(query, 2.0, incremental);
+    secondary_grid.radiusSearch(query, 2.0, secondary);
+    EXPECT_EQ(to_centroids(incremental), to_centroids(expected)) << "query index: " << i;
+    EXPECT_EQ(to_centroids(secondary), to_centroids(expected)) << "query index: " << i;
+  }
+}
+
+TEST(NeighborSearch, ReAddedIdMatchesKdtree)  // NOLINT
+{
+  const auto tiles = load_map_tiles();
+  ASSERT_GE(tiles.size(), 3u);
+
+  // The grid of the first id is replaced by the cloud of the second tile after being indexed, and
+  // the grid of the last id is replaced again before being indexed
+  std::vector<GridType> grids(2);
+  grids[0].setSearchMethod(pclomp::KDTREE);
+  grids[1].setSearchMethod(pclomp::DIRECT26);
+  for (auto & grid : grids) {
+    grid.setLeafSize(2.0f, 2.0f, 2.0f);
+    for (const auto & tile : tiles) {
+      grid.setInputCloudAndFilter(tile.second, tile.first);
+    }
+    grid.createKdtree();
+
+    grid.setInputCloudAndFilter(tiles[1].second, tiles[0].first);
+    grid.setInputCloudAndFilter(tiles[0].second, tiles.back().first);
+    grid.setInputCloudAndFilter(tiles[2].second, tiles.back().first);
+    grid.createKdtree();
+  }
+
+  EXPECT_EQ(grids[1].getCurrentMapIDs(), grids[0].getCurrentMapIDs());
+
+  const auto to_centroids = [](const std::vector<GridType::LeafConstPtr> & leaves) {
+    std::vector<std::array<double, 3>> centroids;
+    for (const auto & leaf : leaves) {
+      centroids.push_back({leaf->mean_.x(), leaf->mean_.y(), leaf->mean_.z()});
+    }
+    std::sort(centroids.begin(), centroids.end());
+    return centroids;
+  };
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> dist(-5.0f, 105.0f);
+  for (int i = 0; i < 2000; ++i) {
+    PointType query;
+    query.x = dist(engine);
+    query.y = dist(engine);
+    query.z = dist(engine) * 0.2f;
+
+    std::vector<GridType::LeafConstPtr> expected;
+    std::vector<GridType::LeafConstPtr> actual;
+    grids[0].radiusSearch(query, 2.0, expected);
+    grids[1].radiusSearch(query, 2.0, actual);
+    EXPECT_EQ(to_centroids(actual), to_centroids(expected)) << "query index: " << i;
+  }
+}
+
+TEST(NeighborSearch, Direct26AlignMatchesKdtree)  // NOLINT
+{
+  const auto tiles = load_map_tiles();
+  const auto source = make_source_cloud(Eigen::Vector3f(40.0f, 40.0f, 0.0f));
+
+  Eigen::Matrix4f guess = Eigen::Matrix4f::Identity();
+  guess(0, 3) = 0.5f;
+  guess(1, 3) = -0.5f;
+
+  std::vector<pclomp::NdtResult> results;
+  for (const auto method : {pclomp::KDTREE, pclomp::DIRECT26}) {
+    NdtType ndt;
+    ndt.setParams(make_params(method));
+    for (const auto & tile : tiles) {
+      ndt.addTarget(tile.second, tile.first);
+    }
+    ndt.createVoxelKdtree();
+    ndt.setInputSource(source);
+
+    pcl::PointCloud<PointType> output;
+    ndt.align(output, guess);
+    results.push_back(ndt.getResult());
+  }
+
+  EXPECT_EQ(results[0].iteration_num, results[1].iteration_num);
+  EXPECT_TRUE(results[0].pose.isApprox(results[1].pose, 1e-4f));
+  EXPECT_NEAR(
+    results[0].nearest_voxel_transformation_likelihood,
+    results[1].nearest_voxel_transformation_likelihood, 1e-3);
+}
+
+TEST(NeighborSearch, DISABLED_Benchmark)  // NOLINT
+{
+  const auto tiles = load_map_tiles();
+  const auto source = make_source_cloud(Eigen::Vector3f(40.0f, 40.0f, 0.0f));
+  constexpr int nb_iteration = 100;
+
+  for (const auto method :
+       {pclomp::KDTREE, pclomp::DIRECT26, pclomp::DIRECT7, pclomp::DIRECT1}) {
+    NdtType ndt;
+    ndt.setParams(make_params(method));
+    for (const auto & tile : tiles) {
+      ndt.addTarget(tile.second, tile.first);
+    }
+
+    const auto build_start = std::chrono::steady_clock::now();
+    ndt.createVoxelKdtree();
+    const double build_time = elapsed_ms(build_start);
+
+    ndt.setInputSource(source);
+
+    double align_time = 0.0;
+    int iteration_num = 0;
+    for (int i = 0; i < nb_iteration; ++i) {
+      Eigen::Matrix4f guess = Eigen::Matrix4f::Identity();
+      guess(0, 3) = 0.5f;
+      pcl::PointCloud<PointType> output;
+
+      const auto align_start = std::chrono::steady_clock::now();
+      ndt.align(output, guess);
+      align_time += elapsed_ms(align_start);
+      iteration_num += ndt.getFinalNumIteration();
+    }
+
+    std::cout << "search_method: " << method << ", build index: " << build_time
+              << " [ms], align: " << align_time / nb_iteration
+              << " [ms], iterations: " << static_cast<double>(iteration_num) / nb_iteration
+              << std::endl;
+  }
+}
@@ -0,0 +1,134 @@
+// Copyright 2025 Autoware Foundation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../include/autoware/ndt_scan_matcher/sensor_points_conversion.hpp"
+#include "test_util.hpp"
+
+#include <Eigen/Geometry>
+#include <autoware_utils_pcl/transforms.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace
+{
+Eigen::Matrix4f make_transform()
+{
+  Eigen::Affine3f transform = Eigen::Translation3f(1.0f, -2.0f, 0.5f) *
+                              Eigen::AngleAxisf(0.3f, Eigen::Vector3f::UnitZ()) *
+                              Eigen::AngleAxisf(0.1f, Eigen::Vector3f::UnitX());
+  return transform.matrix();
+}
+
+void expect_same_points(
+  const pcl::PointCloud<pcl::PointXYZ> & expected, const pcl::PointCloud<pcl::PointXYZ> & actual)
+{
+  ASSERT_EQ(actual.size(), expected.size());
+  EXPECT_EQ(actual.width, expected.width);
+  EXPECT_EQ(actual.height, expected.height);
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(actual.points[i].x, expected.points[i].x, 1e-4f);
+    EXPECT_NEAR(actual.points[i].y, expected.points[i].y, 1e-4f);
+    EXPECT_NEAR(actual.points[i].z, expected.points[i].z, 1e-4f);
+  }
+}
+
+pcl::PointCloud<pcl::PointXYZ> convert_by_pcl(
+  const sensor_msgs::msg::PointCloud2 & msg, const Eigen::Matrix4f & transform)
+{
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  pcl::fromROSMsg(msg, cloud);
+  pcl::PointCloud<pcl::PointXYZ> transformed_cloud;
+  autoware_utils_pcl::transform_pointcloud(cloud, transformed_cloud, transform);
+  return transformed_cloud;
+}
+}  // namespace
+
+TEST(SensorPointsConversion, MatchesFromROSMsg)  // NOLINT
+{
+  const sensor_msgs::msg::PointCloud2 msg = make_default_sensor_pcd();
+  const Eigen::Matrix4f transform = make_transform();
+
+  pcl::PointCloud<pcl::PointXYZ> output;
+  ASSERT_TRUE(autoware::ndt_scan_matcher::transform_xyz_from_msg(msg, transform, output));
+  expect_same_points(convert_by_pcl(msg, transform), output);
+
+  // The buffer is reused by the next conversion
+  ASSERT_TRUE(autoware::ndt_scan_matcher::transform_xyz_from_msg(msg, transform, output));
+  expect_same_points(convert_by_pcl(msg, transform), output);
+}
+
+TEST(SensorPointsConversion, SkipsOtherFields)  // NOLINT
+{
+  pcl::PointCloud<pcl::PointXYZI> cloud;
+  pcl::PointCloud<pcl::PointXYZ> xyz_cloud = make_sample_half_cubic_pcd();
+  for (const auto & point : xyz_cloud.points) {
+    pcl::PointXYZI point_xyzi;
+    point_xyzi.x = point.x;
+    point_xyzi.y = point.y;
+    point_xyzi.z = point.z;
+    point_xyzi.intensity = 10.0f;
+    cloud.push_back(point_xyzi);
+  }
+  sensor_msgs::msg::PointCloud2 msg;
+  pcl::toROSMsg(cloud, msg);
+  const Eigen::Matrix4f transform = make_transform();
+
+  pcl::PointCloud<pcl::PointXYZ> output;
+  ASSERT_TRUE(autoware::ndt_scan_matcher::transform_xyz_from_msg(msg, transform, output));
+  expect_same_points(convert_by_pcl(msg, transform), output);
+}
+
+TEST(SensorPointsConversion, RejectsUnsupportedFields)  // NOLINT
+{
+  sensor_msgs::msg::PointCloud2 msg = make_default_sensor_pcd();
+  for (auto & field : msg.fields) {
+    if (field.name == "z") {
+      field.datatype = sensor_msgs::msg::PointField::FLOAT64;
+    }
+  }
+
+  pcl::PointCloud<pcl::PointXYZ> output;
+  EXPECT_FALSE(
+    autoware::ndt_scan_matcher::transform_xyz_from_msg(msg, make_transform(), output));
+  EXPECT_TRUE(output.empty());
+}
+
+TEST(SensorPointsConversion, DISABLED_Benchmark)  // NOLINT
+{
+  const sensor_msgs::msg::PointCloud2 msg = make_default_sensor_pcd();
+  const Eigen::Matrix4f transform = make_transform();
+  constexpr int nb_iteration = 1000;
+
+  const auto measure = [&](const std::string & name, const auto & convert) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nb_iteration; ++i) {
+      convert();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::micro>(end - start).count() / nb_iteration
+              << " [us]" << std::endl;
+  };
+
+  measure("fromROSMsg and transform_pointcloud", [&] { convert_by_pcl(msg, transform); });
+
+  pcl::PointCloud<pcl::PointXYZ> output;
+  measure("transform_xyz_from_msg", [&] {
+    autoware::ndt_scan_matcher::transform_xyz_from_msg(msg, transform, output);
+  });
+}
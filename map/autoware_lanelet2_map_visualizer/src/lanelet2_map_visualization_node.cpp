@@ -46,17 +46,22 @@
 #include <lanelet2_core/LaneletMap.h>
 #include <lanelet2_projection/UTM.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace autoware::lanelet2_map_visualizer
 {
-void insert_marker_array(
-  visualization_msgs::msg::MarkerArray * a1, const visualization_msgs::msg::MarkerArray & a2)
-{
-  a1->markers.insert(a1->markers.end(), a2.markers.begin(), a2.markers.end());
-}
-
 void set_color(std_msgs::msg::ColorRGBA * cl, double r, double g, double b, double a)
 {
   cl->r = static_cast<float>(r);
@@ -65,19 +70,414 @@ void set_color(std_msgs::msg::ColorRGBA * cl, double r, double g, double b, doub
   cl->a = static_cast<float>(a);
 }
 
+namespace
+{
+using visualization_msgs::msg::MarkerArray;
+using MarkerGenerator = std::function<MarkerArray()>;
+using Tile = std::pair<int64_t, int64_t>;
+
+// The primitives which the markers are generated from
+struct MapElements
+{
+  lanelet::ConstLanelets road_lanelets;
+  lanelet::ConstLanelets shoulder_lanelets;
+  lanelet::ConstLanelets crosswalk_lanelets;
+  lanelet::ConstLanelets bicycle_lane_lanelets;
+  lanelet::ConstLanelets walkway_lanelets;
+  lanelet::ConstLineStrings3d partitions;
+  lanelet::ConstLineStrings3d pedestrian_polygon_markings;
+  lanelet::ConstLineStrings3d pedestrian_line_markings;
+  lanelet::ConstLineStrings3d stop_lines;
+  lanelet::ConstLineStrings3d parking_spaces;
+  lanelet::ConstLineStrings3d curbstones;
+  lanelet::ConstLineStrings3d waypoints;
+  lanelet::ConstPolygons3d parking_lots;
+  lanelet::ConstPolygons3d obstacle_polygons;
+  lanelet::ConstPolygons3d no_obstacle_segmentation_area;
+  lanelet::ConstPolygons3d no_obstacle_segmentation_area_for_run_out;
+  lanelet::ConstPolygons3d hatched_road_markings_area;
+  lanelet::ConstPolygons3d intersection_areas;
+  std::vector<lanelet::AutowareTrafficLightConstPtr> aw_tl_reg_elems;
+  std::vector<lanelet::DetectionAreaConstPtr> da_reg_elems;
+  std::vector<lanelet::NoStoppingAreaConstPtr> no_reg_elems;
+  std::vector<lanelet::SpeedBumpConstPtr> sb_reg_elems;
+  std::vector<lanelet::CrosswalkConstPtr> cw_reg_elems;
+  std::vector<lanelet::NoParkingAreaConstPtr> no_parking_reg_elems;
+  std::vector<lanelet::BusStopAreaConstPtr> bus_stop_reg_elems;
+};
+
+struct MarkerColors
+{
+  std_msgs::msg::ColorRGBA road;
+  std_msgs::msg::ColorRGBA shoulder;
+  std_msgs::msg::ColorRGBA cross;
+  std_msgs::msg::ColorRGBA partitions;
+  std_msgs::msg::ColorRGBA pedestrian_markings;
+  std_msgs::msg::ColorRGBA ll_borders;
+  std_msgs::msg::ColorRGBA shoulder_borders;
+  std_msgs::msg::ColorRGBA stoplines;
+  std_msgs::msg::ColorRGBA trafficlights;
+  std_msgs::msg::ColorRGBA detection_areas;
+  std_msgs::msg::ColorRGBA speed_bumps;
+  std_msgs::msg::ColorRGBA crosswalks;
+  std_msgs::msg::ColorRGBA parking_lots;
+  std_msgs::msg::ColorRGBA parking_spaces;
+  std_msgs::msg::ColorRGBA lanelet_id;
+  std_msgs::msg::ColorRGBA obstacle_polygons;
+  std_msgs::msg::ColorRGBA no_stopping_areas;
+  std_msgs::msg::ColorRGBA no_obstacle_segmentation_area;
+  std_msgs::msg::ColorRGBA no_obstacle_segmentation_area_for_run_out;
+  std_msgs::msg::ColorRGBA hatched_road_markings_area;
+  std_msgs::msg::ColorRGBA hatched_road_markings_line;
+  std_msgs::msg::ColorRGBA no_parking_areas;
+  std_msgs::msg::ColorRGBA curbstones;
+  std_msgs::msg::ColorRGBA intersection_area;
+  std_msgs::msg::ColorRGBA bus_stop_area;
+  std_msgs::msg::ColorRGBA bicycle_lane;
+  std_msgs::msg::ColorRGBA waypoints;
+};
+
+MapElements query_map_elements(const lanelet::LaneletMapPtr & viz_lanelet_map)
+{
+  MapElements e;
+  lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(viz_lanelet_map);
+  e.road_lanelets = lanelet::utils::query::roadLanelets(all_lanelets);
+  e.shoulder_lanelets = lanelet::utils::query::shoulderLanelets(all_lanelets);
+  e.crosswalk_lanelets = lanelet::utils::query::crosswalkLanelets(all_lanelets);
+  e.bicycle_lane_lanelets = lanelet::utils::query::bicycleLaneLanelets(all_lanelets);
+  e.partitions = lanelet::utils::query::getAllPartitions(viz_lanelet_map);
+  e.pedestrian_polygon_markings =
+    lanelet::utils::query::getAllPedestrianPolygonMarkings(viz_lanelet_map);
+  e.pedestrian_line_markings = lanelet::utils::query::getAllPedestrianLineMarkings(viz_lanelet_map);
+  e.walkway_lanelets = lanelet::utils::query::walkwayLanelets(all_lanelets);
+  e.stop_lines = lanelet::utils::query::stopLinesLanelets(e.road_lanelets);
+  e.aw_tl_reg_elems = lanelet::utils::query::autowareTrafficLights(all_lanelets);
+  e.da_reg_elems = lanelet::utils::query::detectionAreas(all_lanelets);
+  e.no_reg_elems = lanelet::utils::query::noStoppingAreas(all_lanelets);
+  e.sb_reg_elems = lanelet::utils::query::speedBumps(all_lanelets);
+  e.cw_reg_elems = lanelet::utils::query::crosswalks(all_lanelets);
+  e.parking_spaces = lanelet::utils::query::getAllParkingSpaces(viz_lanelet_map);
+  e.parking_lots = lanelet::utils::query::getAllParkingLots(viz_lanelet_map);
+  e.obstacle_polygons = lanelet::utils::query::getAllObstaclePolygons(viz_lanelet_map);
+  e.no_obstacle_segmentation_area =
+    lanelet::utils::query::getAllPolygonsByType(viz_lanelet_map, "no_obstacle_segmentation_area");
+  e.no_obstacle_segmentation_area_for_run_out = lanelet::utils::query::getAllPolygonsByType(
+    viz_lanelet_map, "no_obstacle_segmentation_area_for_run_out");
+  e.hatched_road_markings_area =
+    lanelet::utils::query::getAllPolygonsByType(viz_lanelet_map, "hatched_road_markings");
+  e.intersection_areas =
+    lanelet::utils::query::getAllPolygonsByType(viz_lanelet_map, "intersection_area");
+  e.no_parking_reg_elems = lanelet::utils::query::noParkingAreas(all_lanelets);
+  e.curbstones = lanelet::utils::query::curbstones(viz_lanelet_map);
+  e.bus_stop_reg_elems = lanelet::utils::query::busStopAreas(all_lanelets);
+  e.waypoints = lanelet::utils::query::getAllWaypoints(viz_lanelet_map);
+  return e;
+}
+
+MarkerColors create_marker_colors()
+{
+  MarkerColors c;
+  set_color(&c.road, 0.27, 0.27, 0.27, 0.999);
+  set_color(&c.shoulder, 0.15, 0.15, 0.15, 0.999);
+  set_color(&c.cross, 0.27, 0.3, 0.27, 0.5);
+  set_color(&c.partitions, 0.25, 0.25, 0.25, 0.999);
+  set_color(&c.pedestrian_markings, 0.5, 0.5, 0.5, 0.999);
+  set_color(&c.ll_borders, 0.5, 0.5, 0.5, 0.999);
+  set_color(&c.shoulder_borders, 0.2, 0.2, 0.2, 0.999);
+  set_color(&c.stoplines, 0.5, 0.5, 0.5, 0.999);
+  set_color(&c.trafficlights, 0.5, 0.5, 0.5, 0.8);
+  set_color(&c.detection_areas, 0.27, 0.27, 0.37, 0.5);
+  set_color(&c.no_stopping_areas, 0.37, 0.37, 0.37, 0.5);
+  set_color(&c.speed_bumps, 0.56, 0.40, 0.27, 0.5);
+  set_color(&c.crosswalks, 0.80, 0.80, 0.0, 0.5);
+  set_color(&c.obstacle_polygons, 0.4, 0.27, 0.27, 0.5);
+  set_color(&c.parking_lots, 1.0, 1.0, 1.0, 0.2);
+  set_color(&c.parking_spaces, 1.0, 1.0, 1.0, 0.3);
+  set_color(&c.lanelet_id, 0.5, 0.5, 0.5, 0.999);
+  set_color(&c.no_obstacle_segmentation_area, 0.37, 0.37, 0.27, 0.5);
+  set_color(&c.no_obstacle_segmentation_area_for_run_out, 0.37, 0.7, 0.27, 0.5);
+  set_color(&c.hatched_road_markings_area, 0.3, 0.3, 0.3, 0.5);
+  set_color(&c.hatched_road_markings_line, 0.5, 0.5, 0.5, 0.999);
+  set_color(&c.no_parking_areas, 0.42, 0.42, 0.42, 0.5);
+  set_color(&c.curbstones, 0.1, 0.1, 0.2, 0.999);
+  set_color(&c.intersection_area, 0.16, 1.0, 0.69, 0.5);
+  set_color(&c.bus_stop_area, 0.863, 0.863, 0.863, 0.5);
+  set_color(&c.bicycle_lane, 0.0, 0.3843, 0.6274, 0.5);
+  set_color(&c.waypoints, 0.6, 0.4, 0.3, 0.999);
+  return c;
+}
+
+// The marker categories in the order of the published array. They only read the elements, so
+// they can run concurrently as long as e and c outlive them.
+std::vector<MarkerGenerator> create_marker_generators(
+  const MapElements & e, const MarkerColors & c, const bool viz_centerline)
+{
+  namespace viz = lanelet::visualization;
+  std::vector<MarkerGenerator> generators;
+  generators.emplace_back(
+    [&] { return viz::lineStringsAsMarkerArray(e.stop_lines, "stop_lines", c.stoplines, 0.5); });
+  generators.emplace_back(
+    [&] { return viz::lineStringsAsMarkerArray(e.partitions, "partitions", c.partitions, 0.1); });
+  generators.emplace_back(
+    [&] { return viz::laneletDirectionAsMarkerArray(e.shoulder_lanelets, "shoulder_"); });
+  generators.emplace_back([&] { return viz::laneletDirectionAsMarkerArray(e.road_lanelets); });
+  generators.emplace_back([&] {
+    return viz::laneletsAsTriangleMarkerArray("crosswalk_lanelets", e.crosswalk_lanelets, c.cross);
+  });
+  generators.emplace_back([&] {
+    return viz::pedestrianPolygonMarkingsAsMarkerArray(
+      e.pedestrian_polygon_markings, c.pedestrian_markings);
+  });
+  generators.emplace_back([&] {
+    return viz::pedestrianLineMarkingsAsMarkerArray(
+      e.pedestrian_line_markings, c.pedestrian_markings);
+  });
+  generators.emplace_back([&] {
+    return viz::laneletsAsTriangleMarkerArray("walkway_lanelets", e.walkway_lanelets, c.cross);
+  });
+  generators.emplace_back(
+    [&] { return viz::obstaclePolygonsAsMarkerArray(e.obstacle_polygons, c.obstacle_polygons); });
+  generators.emplace_back(
+    [&] { return viz::detectionAreasAsMarkerArray(e.da_reg_elems, c.detection_areas); });
+  generators.emplace_back(
+    [&] { return viz::noStoppingAreasAsMarkerArray(e.no_reg_elems, c.no_stopping_areas); });
+  generators.emplace_back(
+    [&] { return viz::speedBumpsAsMarkerArray(e.sb_reg_elems, c.speed_bumps); });
+  generators.emplace_back(
+    [&] { return viz::crosswalkAreasAsMarkerArray(e.cw_reg_elems, c.crosswalks); });
+  generators.emplace_back(
+    [&] { return viz::parkingLotsAsMarkerArray(e.parking_lots, c.parking_lots); });
+  generators.emplace_back(
+    [&] { return viz::parkingSpacesAsMarkerArray(e.parking_spaces, c.parking_spaces); });
+  generators.emplace_back([&, viz_centerline] {
+    return viz::laneletsBoundaryAsMarkerArray(
+      e.shoulder_lanelets, c.shoulder_borders, viz_centerline, "shoulder_");
+  });
+  generators.emplace_back([&, viz_centerline] {
+    return viz::laneletsBoundaryAsMarkerArray(e.road_lanelets, c.ll_borders, viz_centerline);
+  });
+  generators.emplace_back(
+    [&] { return viz::autowareTrafficLightsAsMarkerArray(e.aw_tl_reg_elems, c.trafficlights); });
+  generators.emplace_back([&] {
+    return viz::generateTrafficLightRegulatoryElementIdMaker(e.road_lanelets, c.trafficlights);
+  });
+  generators.emplace_back([&] {
+    return viz::generateTrafficLightRegulatoryElementIdMaker(e.crosswalk_lanelets, c.trafficlights);
+  });
+  generators.emplace_back(
+    [&] { return viz::generateTrafficLightIdMaker(e.aw_tl_reg_elems, c.trafficlights); });
+  generators.emplace_back(
+    [&] { return viz::generateLaneletIdMarker(e.shoulder_lanelets, c.lanelet_id); });
+  generators.emplace_back(
+    [&] { return viz::generateLaneletIdMarker(e.road_lanelets, c.lanelet_id); });
+  generators.emplace_back([&] {
+    return viz::generateLaneletIdMarker(e.crosswalk_lanelets, c.lanelet_id, "crosswalk_lanelet_id");
+  });
+  generators.emplace_back([&] {
+    return viz::laneletsAsTriangleMarkerArray(
+      "shoulder_road_lanelets", e.shoulder_lanelets, c.shoulder);
+  });
+  generators.emplace_back(
+    [&] { return viz::laneletsAsTriangleMarkerArray("road_lanelets", e.road_lanelets, c.road); });
+  generators.emplace_back([&] {
+    return viz::noObstacleSegmentationAreaAsMarkerArray(
+      e.no_obstacle_segmentation_area, c.no_obstacle_segmentation_area);
+  });
+  generators.emplace_back([&] {
+    return viz::noObstacleSegmentationAreaForRunOutAsMarkerArray(
+      e.no_obstacle_segmentation_area_for_run_out, c.no_obstacle_segmentation_area_for_run_out);
+  });
+  generators.emplace_back([&] {
+    return viz::hatchedRoadMarkingsAreaAsMarkerArray(
+      e.hatched_road_markings_area, c.hatched_road_markings_area, c.hatched_road_markings_line);
+  });
+  generators.emplace_back(
+    [&] { return viz::noParkingAreasAsMarkerArray(e.no_parking_reg_elems, c.no_parking_areas); });
+  generators.emplace_back(
+    [&] { return viz::lineStringsAsMarkerArray(e.curbstones, "curbstone", c.curbstones, 0.2); });
+  generators.emplace_back(
+    [&] { return viz::intersectionAreaAsMarkerArray(e.intersection_areas, c.intersection_area); });
+  generators.emplace_back(
+    [&] { return viz::busStopAreasAsMarkerArray(e.bus_stop_reg_elems, c.bus_stop_area); });
+  generators.emplace_back([&] {
+    return viz::laneletDirectionAsMarkerArray(e.bicycle_lane_lanelets, "bicycle_lane_");
+  });
+  generators.emplace_back([&, viz_centerline] {
+    return viz::laneletsBoundaryAsMarkerArray(
+      e.bicycle_lane_lanelets, c.ll_borders /* use ll_border color */, viz_centerline,
+      "bicycle_lane_");
+  });
+  generators.emplace_back([&] {
+    return viz::generateLaneletIdMarker(
+      e.bicycle_lane_lanelets, c.lanelet_id /* use lanelet_id color */);
+  });
+  generators.emplace_back([&] {
+    return viz::laneletsAsTriangleMarkerArray(
+      "bicycle_lane_lanelets", e.bicycle_lane_lanelets, c.bicycle_lane);
+  });
+  generators.emplace_back(
+    [&] { return viz::lineStringsAsMarkerArray(e.waypoints, "waypoints", c.waypoints, 0.02); });
+  return generators;
+}
+
+// Run the generators on thread_num threads, keeping their results in the order of the generators
+std::vector<MarkerArray> run_marker_generators(
+  const std::vector<MarkerGenerator> & generators, const size_t thread_num)
+{
+  std::vector<MarkerArray> marker_arrays(generators.size());
+  std::atomic<size_t> next_generator{0};
+  const auto work = [&]() {
+    for (size_t i = next_generator++; i < generators.size(); i = next_generator++) {
+      marker_arrays[i] = generators[i]();
+    }
+  };
+
+  const size_t worker_num =
+    std::clamp<size_t>(thread_num, 1, std::max<size_t>(generators.size(), 1));
+  std::vector<std::thread> workers;
+  for (size_t w = 1; w < worker_num; ++w) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto & worker : workers) {
+    worker.join();
+  }
+  return marker_arrays;
+}
+
+MarkerArray merge_marker_arrays(std::vector<MarkerArray> && marker_arrays)
+{
+  size_t marker_num = 0;
+  for (const auto & marker_array : marker_arrays) {
+    marker_num += marker_array.markers.size();
+  }
+  MarkerArray merged;
+  merged.markers.reserve(marker_num);
+  for (auto & marker_array : marker_arrays) {
+    merged.markers.insert(
+      merged.markers.end(), std::make_move_iterator(marker_array.markers.begin()),
+      std::make_move_iterator(marker_array.markers.end()));
+  }
+  return merged;
+}
+
+Tile point_to_tile(const lanelet::ConstPoint3d & point, const double chunk_size)
+{
+  return {
+    static_cast<int64_t>(std::floor(point.x() / chunk_size)),
+    static_cast<int64_t>(std::floor(point.y() / chunk_size))};
+}
+
+// A primitive belongs to the tile of its first point
+std::optional<Tile> to_tile(const lanelet::ConstLanelet & lanelet, const double chunk_size)
+{
+  if (lanelet.leftBound().empty()) {
+    return std::nullopt;
+  }
+  return point_to_tile(lanelet.leftBound().front(), chunk_size);
+}
+
+template <typename PrimitiveT>
+std::optional<Tile> to_tile(const PrimitiveT & primitive, const double chunk_size)
+{
+  if (primitive.empty()) {
+    return std::nullopt;
+  }
+  return point_to_tile(primitive.front(), chunk_size);
+}
+
+template <typename ElementT, typename ToTile>
+void split_elements(
+  const std::vector<ElementT> & elements, std::vector<ElementT> MapElements::*member,
+  const ToTile & to_element_tile, std::map<Tile, MapElements> & tiles)
+{
+  for (const auto & element : elements) {
+    (tiles[to_element_tile(element).value_or(Tile{0, 0})].*member).push_back(element);
+  }
+}
+
+// Split the elements into square tiles of chunk_size. A regulatory element belongs to the tile of
+// the first lanelet which refers to it.
+std::map<Tile, MapElements> split_map_elements(
+  const MapElements & e, const lanelet::ConstLanelets & all_lanelets, const double chunk_size)
+{
+  std::unordered_map<lanelet::Id, Tile> regulatory_element_tiles;
+  for (const auto & lanelet : all_lanelets) {
+    const auto tile = to_tile(lanelet, chunk_size);
+    if (!tile) {
+      continue;
+    }
+    for (const auto & regulatory_element : lanelet.regulatoryElements()) {
+      regulatory_element_tiles.emplace(regulatory_element->id(), *tile);
+    }
+  }
+
+  const auto primitive_tile = [chunk_size](const auto & primitive) {
+    return to_tile(primitive, chunk_size);
+  };
+  const auto regulatory_element_tile =
+    [&regulatory_element_tiles](const auto & element) -> std::optional<Tile> {
+    const auto it = regulatory_element_tiles.find(element->id());
+    if (it == regulatory_element_tiles.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  };
+
+  std::map<Tile, MapElements> tiles;
+  for (const auto member :
+       {&MapElements::road_lanelets, &MapElements::shoulder_lanelets,
+        &MapElements::crosswalk_lanelets, &MapElements::bicycle_lane_lanelets,
+        &MapElements::walkway_lanelets}) {
+    split_elements(e.*member, member, primitive_tile, tiles);
+  }
+  for (const auto member :
+       {&MapElements::partitions, &MapElements::pedestrian_polygon_markings,
+        &MapElements::pedestrian_line_markings, &MapElements::stop_lines,
+        &MapElements::parking_spaces, &MapElements::curbstones, &MapElements::waypoints}) {
+    split_elements(e.*member, member, primitive_tile, tiles);
+  }
+  for (const auto member :
+       {&MapElements::parking_lots, &MapElements::obstacle_polygons,
+        &MapElements::no_obstacle_segmentation_area,
+        &MapElements::no_obstacle_segmentation_area_for_run_out,
+        &MapElements::hatched_road_markings_area, &MapElements::intersection_areas}) {
+    split_elements(e.*member, member, primitive_tile, tiles);
+  }
+  split_elements(
+    e.aw_tl_reg_elems, &MapElements::aw_tl_reg_elems, regulatory_element_tile, tiles);
+  split_elements(e.da_reg_elems, &MapElements::da_reg_elems, regulatory_element_tile, tiles);
+  split_elements(e.no_reg_elems, &MapElements::no_reg_elems, regulatory_element_tile, tiles);
+  split_elements(e.sb_reg_elems, &MapElements::sb_reg_elems, regulatory_element_tile, tiles);
+  split_elements(e.cw_reg_elems, &MapElements::cw_reg_elems, regulatory_element_tile, tiles);
+  split_elements(
+    e.no_parking_reg_elems, &MapElements::no_parking_reg_elems, regulatory_element_tile, tiles);
+  split_elements(
+    e.bus_stop_reg_elems, &MapElements::bus_stop_reg_elems, regulatory_element_tile, tiles);
+  return tiles;
+}
+}  // namespace
+
 Lanelet2MapVisualizationNode::Lanelet2MapVisualizationNode(const rclcpp::NodeOptions & options)
 : Node("lanelet2_map_visualization", options)
 {
   using std::placeholders::_1;
 
   viz_lanelets_centerline_ = true;
+  marker_chunk_size_ = declare_parameter<double>("marker_chunk_size");
+  marker_history_depth_ = static_cast<size_t>(
+    std::max<int64_t>(declare_parameter<int64_t>("marker_history_depth"), 1));
+  thread_num_ =
+    static_cast<size_t>(std::max<int64_t>(declare_parameter<int64_t>("thread_num"), 1));
 
   sub_map_bin_ = this->create_subscription<autoware_map_msgs::msg::LaneletMapBin>(
     "input/lanelet2_map", rclcpp::QoS{1}.transient_local(),
     std::bind(&Lanelet2MapVisualizationNode::on_map_bin, this, _1));
 
+  // the marker arrays of all the tiles are kept for the late subscribers
+  const size_t depth = marker_chunk_size_ > 0.0 ? marker_history_depth_ : 1;
   pub_marker_ = this->create_publisher<visualization_msgs::msg::MarkerArray>(
-    "output/lanelet2_map_marker", rclcpp::QoS{1}.transient_local());
+    "output/lanelet2_map_marker", rclcpp::QoS{depth}.transient_local());
 }
 
 void Lanelet2MapVisualizationNode::on_map_bin(
@@ -89,236 +489,63 @@ void Lanelet2MapVisualizationNode::on_map_bin(
   RCLCPP_INFO(this->get_logger(), "Map is loaded\n");
 
   // get lanelets etc to visualize
-  lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(viz_lanelet_map);
-  lanelet::ConstLanelets road_lanelets = lanelet::utils::query::roadLanelets(all_lanelets);
-  lanelet::ConstLanelets shoulder_lanelets = lanelet::utils::query::shoulderLanelets(all_lanelets);
-  lanelet::ConstLanelets crosswalk_lanelets =
-    lanelet::utils::query::crosswalkLanelets(all_lanelets);
-  lanelet::ConstLanelets bicycle_lane_lanelets =
-    lanelet::utils::query::bicycleLaneLanelets(all_lanelets);
-  lanelet::ConstLineStrings3d partitions = lanelet::utils::query::getAllPartitions(viz_lanelet_map);
-  lanelet::ConstLineStrings3d pedestrian_polygon_markings =
-    lanelet::utils::query::getAllPedestrianPolygonMarkings(viz_lanelet_map);
-  lanelet::ConstLineStrings3d pedestrian_line_markings =
-    lanelet::utils::query::getAllPedestrianLineMarkings(viz_lanelet_map);
-  lanelet::ConstLanelets walkway_lanelets = lanelet::utils::query::walkwayLanelets(all_lanelets);
-  std::vector<lanelet::ConstLineString3d> stop_lines =
-    lanelet::utils::query::stopLinesLanelets(road_lanelets);
-  std::vector<lanelet::AutowareTrafficLightConstPtr> aw_tl_reg_elems =
-    lanelet::utils::query::autowareTrafficLights(all_lanelets);
-  std::vector<lanelet::DetectionAreaConstPtr> da_reg_elems =
-    lanelet::utils::query::detectionAreas(all_lanelets);
-  std::vector<lanelet::NoStoppingAreaConstPtr> no_reg_elems =
-    lanelet::utils::query::noStoppingAreas(all_lanelets);
-  std::vector<lanelet::SpeedBumpConstPtr> sb_reg_elems =
-    lanelet::utils::query::speedBumps(all_lanelets);
-  std::vector<lanelet::CrosswalkConstPtr> cw_reg_elems =
-    lanelet::utils::query::crosswalks(all_lanelets);
-  lanelet::ConstLineStrings3d parking_spaces =
-    lanelet::utils::query::getAllParkingSpaces(viz_lanelet_map);
-  lanelet::ConstPolygons3d parking_lots = lanelet::utils::query::getAllParkingLots(viz_lanelet_map);
-  lanelet::ConstPolygons3d obstacle_polygons =
-    lanelet::utils::query::getAllObstaclePolygons(viz_lanelet_map);
-  lanelet::ConstPolygons3d no_obstacle_segmentation_area =
-    lanelet::utils::query::getAllPolygonsByType(viz_lanelet_map, "no_obstacle_segmentation_area");
-  lanelet::ConstPolygons3d no_obstacle_segmentation_area_for_run_out =
-    lanelet::utils::query::getAllPolygonsByType(
-      viz_lanelet_map, "no_obstacle_segmentation_area_for_run_out");
-  lanelet::ConstPolygons3d hatched_road_markings_area =
-    lanelet::utils::query::getAllPolygonsByType(viz_lanelet_map, "hatched_road_markings");
-  lanelet::ConstPolygons3d intersection_areas =
-    lanelet::utils::query::getAllPolygonsByType(viz_lanelet_map, "intersection_area");
-  std::vector<lanelet::NoParkingAreaConstPtr> no_parking_reg_elems =
-    lanelet::utils::query::noParkingAreas(all_lanelets);
-  lanelet::ConstLineStrings3d curbstones = lanelet::utils::query::curbstones(viz_lanelet_map);
-  std::vector<lanelet::BusStopAreaConstPtr> bus_stop_reg_elems =
-    lanelet::utils::query::busStopAreas(all_lanelets);
-  lanelet::ConstLineStrings3d waypoints = lanelet::utils::query::getAllWaypoints(viz_lanelet_map);
-
-  std_msgs::msg::ColorRGBA cl_road;
-  std_msgs::msg::ColorRGBA cl_shoulder;
-  std_msgs::msg::ColorRGBA cl_cross;
-  std_msgs::msg::ColorRGBA cl_partitions;
-  std_msgs::msg::ColorRGBA cl_pedestrian_markings;
-  std_msgs::msg::ColorRGBA cl_ll_borders;
-  std_msgs::msg::ColorRGBA cl_shoulder_borders;
-  std_msgs::msg::ColorRGBA cl_stoplines;
-  std_msgs::msg::ColorRGBA cl_trafficlights;
-  std_msgs::msg::ColorRGBA cl_detection_areas;
-  std_msgs::msg::ColorRGBA cl_speed_bumps;
-  std_msgs::msg::ColorRGBA cl_crosswalks;
-  std_msgs::msg::ColorRGBA cl_parking_lots;
-  std_msgs::msg::ColorRGBA cl_parking_spaces;
-  std_msgs::msg::ColorRGBA cl_lanelet_id;
-  std_msgs::msg::ColorRGBA cl_obstacle_polygons;
-  std_msgs::msg::ColorRGBA cl_no_stopping_areas;
-  std_msgs::msg::ColorRGBA cl_no_obstacle_segmentation_area;
-  std_msgs::msg::ColorRGBA cl_no_obstacle_segmentation_area_for_run_out;
-  std_msgs::msg::ColorRGBA cl_hatched_road_markings_area;
-  std_msgs::msg::ColorRGBA cl_hatched_road_markings_line;
-  std_msgs::msg::ColorRGBA cl_no_parking_areas;
-  std_msgs::msg::ColorRGBA cl_curbstones;
-  std_msgs::msg::ColorRGBA cl_intersection_area;
-  std_msgs::msg::ColorRGBA cl_bus_stop_area;
-  std_msgs::msg::ColorRGBA cl_bicycle_lane;
-  std_msgs::msg::ColorRGBA cl_waypoints;
-  set_color(&cl_road, 0.27, 0.27, 0.27, 0.999);
-  set_color(&cl_shoulder, 0.15, 0.15, 0.15, 0.999);
-  set_color(&cl_cross, 0.27, 0.3, 0.27, 0.5);
-  set_color(&cl_partitions, 0.25, 0.25, 0.25, 0.999);
-  set_color(&cl_pedestrian_markings, 0.5, 0.5, 0.5, 0.999);
-  set_color(&cl_ll_borders, 0.5, 0.5, 0.5, 0.999);
-  set_color(&cl_shoulder_borders, 0.2, 0.2, 0.2, 0.999);
-  set_color(&cl_stoplines, 0.5, 0.5, 0.5, 0.999);
-  set_color(&cl_trafficlights, 0.5, 0.5, 0.5, 0.8);
-  set_color(&cl_detection_areas, 0.27, 0.27, 0.37, 0.5);
-  set_color(&cl_no_stopping_areas, 0.37, 0.37, 0.37, 0.5);
-  set_color(&cl_speed_bumps, 0.56, 0.40, 0.27, 0.5);
-  set_color(&cl_crosswalks, 0.80, 0.80, 0.0, 0.5);
-  set_color(&cl_obstacle_polygons, 0.4, 0.27, 0.27, 0.5);
-  set_color(&cl_parking_lots, 1.0, 1.0, 1.0, 0.2);
-  set_color(&cl_parking_spaces, 1.0, 1.0, 1.0, 0.3);
-  set_color(&cl_lanelet_id, 0.5, 0.5, 0.5, 0.999);
-  set_color(&cl_no_obstacle_segmentation_area, 0.37, 0.37, 0.27, 0.5);
-  set_color(&cl_no_obstacle_segmentation_area_for_run_out, 0.37, 0.7, 0.27, 0.5);
-  set_color(&cl_hatched_road_markings_area, 0.3, 0.3, 0.3, 0.5);
-  set_color(&cl_hatched_road_markings_line, 0.5, 0.5, 0.5, 0.999);
-  set_color(&cl_no_parking_areas, 0.42, 0.42, 0.42, 0.5);
-  set_color(&cl_curbstones, 0.1, 0.1, 0.2, 0.999);
-  set_color(&cl_intersection_area, 0.16, 1.0, 0.69, 0.5);
-  set_color(&cl_bus_stop_area, 0.863, 0.863, 0.863, 0.5);
-  set_color(&cl_bicycle_lane, 0.0, 0.3843, 0.6274, 0.5);
-  set_color(&cl_waypoints, 0.6, 0.4, 0.3, 0.999);
-
-  visualization_msgs::msg::MarkerArray map_marker_array;
-
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::lineStringsAsMarkerArray(stop_lines, "stop_lines", cl_stoplines, 0.5));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::lineStringsAsMarkerArray(partitions, "partitions", cl_partitions, 0.1));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::laneletDirectionAsMarkerArray(shoulder_lanelets, "shoulder_"));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::laneletDirectionAsMarkerArray(road_lanelets));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::laneletsAsTriangleMarkerArray(
-                         "crosswalk_lanelets", crosswalk_lanelets, cl_cross));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::pedestrianPolygonMarkingsAsMarkerArray(
-                         pedestrian_polygon_markings, cl_pedestrian_markings));
-
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::pedestrianLineMarkingsAsMarkerArray(
-                         pedestrian_line_markings, cl_pedestrian_markings));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::laneletsAsTriangleMarkerArray(
-                         "walkway_lanelets", walkway_lanelets, cl_cross));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::obstaclePolygonsAsMarkerArray(obstacle_polygons, cl_obstacle_polygons));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::detectionAreasAsMarkerArray(da_reg_elems, cl_detection_areas));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::noStoppingAreasAsMarkerArray(no_reg_elems, cl_no_stopping_areas));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::speedBumpsAsMarkerArray(sb_reg_elems, cl_speed_bumps));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::crosswalkAreasAsMarkerArray(cw_reg_elems, cl_crosswalks));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::parkingLotsAsMarkerArray(parking_lots, cl_parking_lots));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::parkingSpacesAsMarkerArray(parking_spaces, cl_parking_spaces));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::laneletsBoundaryAsMarkerArray(
-      shoulder_lanelets, cl_shoulder_borders, viz_lanelets_centerline_, "shoulder_"));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::laneletsBoundaryAsMarkerArray(
-                         road_lanelets, cl_ll_borders, viz_lanelets_centerline_));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::autowareTrafficLightsAsMarkerArray(aw_tl_reg_elems, cl_trafficlights));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::generateTrafficLightRegulatoryElementIdMaker(
-                         road_lanelets, cl_trafficlights));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::generateTrafficLightRegulatoryElementIdMaker(
-                         crosswalk_lanelets, cl_trafficlights));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::generateTrafficLightIdMaker(aw_tl_reg_elems, cl_trafficlights));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::generateLaneletIdMarker(shoulder_lanelets, cl_lanelet_id));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::generateLaneletIdMarker(road_lanelets, cl_lanelet_id));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::generateLaneletIdMarker(
-                         crosswalk_lanelets, cl_lanelet_id, "crosswalk_lanelet_id"));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::laneletsAsTriangleMarkerArray(
-                         "shoulder_road_lanelets", shoulder_lanelets, cl_shoulder));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::laneletsAsTriangleMarkerArray("road_lanelets", road_lanelets, cl_road));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::noObstacleSegmentationAreaAsMarkerArray(
-                         no_obstacle_segmentation_area, cl_no_obstacle_segmentation_area));
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::noObstacleSegmentationAreaForRunOutAsMarkerArray(
-      no_obstacle_segmentation_area_for_run_out, cl_no_obstacle_segmentation_area_for_run_out));
-
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::hatchedRoadMarkingsAreaAsMarkerArray(
-      hatched_road_markings_area, cl_hatched_road_markings_area, cl_hatched_road_markings_line));
-
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::noParkingAreasAsMarkerArray(no_parking_reg_elems, cl_no_parking_areas));
-
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::lineStringsAsMarkerArray(curbstones, "curbstone", cl_curbstones, 0.2));
-
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::intersectionAreaAsMarkerArray(
-                         intersection_areas, cl_intersection_area));
-
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::busStopAreasAsMarkerArray(bus_stop_reg_elems, cl_bus_stop_area));
-
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::laneletDirectionAsMarkerArray(bicycle_lane_lanelets, "bicycle_lane_"));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::laneletsBoundaryAsMarkerArray(
-                         bicycle_lane_lanelets, cl_ll_borders /* use ll_border color */,
-                         viz_lanelets_centerline_, "bicycle_lane_"));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::generateLaneletIdMarker(
-                         bicycle_lane_lanelets, cl_lanelet_id /* use lanelet_id color */));
-  insert_marker_array(
-    &map_marker_array, lanelet::visualization::laneletsAsTriangleMarkerArray(
-                         "bicycle_lane_lanelets", bicycle_lane_lanelets, cl_bicycle_lane));
-
-  insert_marker_array(
-    &map_marker_array,
-    lanelet::visualization::lineStringsAsMarkerArray(waypoints, "waypoints", cl_waypoints, 0.02));
-
-  pub_marker_->publish(map_marker_array);
+  const lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(viz_lanelet_map);
+  const MapElements map_elements = query_map_elements(viz_lanelet_map);
+  const MarkerColors colors = create_marker_colors();
+
+  // the centerlines are computed and cached lazily, which must not happen concurrently
+  for (const auto & lanelet : all_lanelets) {
+    static_cast<void>(lanelet.centerline());
+  }
+
+  if (marker_chunk_size_ <= 0.0) {
+    const auto generators =
+      create_marker_generators(map_elements, colors, viz_lanelets_centerline_);
+    pub_marker_->publish(merge_marker_arrays(run_marker_generators(generators, thread_num_)));
+    return;
+  }
+
+  // publish a marker array for each tile, whose markers have the namespaces of the tile
+  const auto tiles = split_map_elements(map_elements, all_lanelets, marker_chunk_size_);
+  std::vector<MarkerGenerator> generators;
+  std::vector<std::pair<Tile, size_t>> tile_generator_nums;
+  for (const auto & [tile, tile_elements] : tiles) {
+    auto tile_generators =
+      create_marker_generators(tile_elements, colors, viz_lanelets_centerline_);
+    tile_generator_nums.emplace_back(tile, tile_generators.size());
+    std::move(tile_generators.begin(), tile_generators.end(), std::back_inserter(generators));
+  }
+  auto marker_arrays = run_marker_generators(generators, thread_num_);
+
+  // the late subscribers receive the history of marker_history_depth marker arrays
+  if (tiles.size() + 1 > marker_history_depth_) {
+    RCLCPP_WARN(
+      get_logger(),
+      "The map has %zu tiles, more than marker_history_depth - 1 (%zu). The late subscribers "
+      "will miss some of them.",
+      tiles.size(), marker_history_depth_ - 1);
+  }
+  // the tiles of the previous map are cleared first, as they may still be in the history
+  visualization_msgs::msg::Marker delete_all_marker;
+  delete_all_marker.action = visualization_msgs::msg::Marker::DELETEALL;
+  MarkerArray delete_all_marker_array;
+  delete_all_marker_array.markers.push_back(delete_all_marker);
+  pub_marker_->publish(delete_all_marker_array);
+
+  auto marker_array_it = marker_arrays.begin();
+  for (const auto & [tile, generator_num] : tile_generator_nums) {
+    std::vector<MarkerArray> tile_marker_arrays(
+      std::make_move_iterator(marker_array_it),
+      std::make_move_iterator(marker_array_it + static_cast<std::ptrdiff_t>(generator_num)));
+    marker_array_it += static_cast<std::ptrdiff_t>(generator_num);
+
+    auto tile_marker_array = merge_marker_arrays(std::move(tile_marker_arrays));
+    const auto tile_suffix = "/" + std::to_string(tile.first) + "_" + std::to_string(tile.second);
+    for (auto & marker : tile_marker_array.markers) {
+      marker.ns += tile_suffix;
+    }
+    pub_marker_->publish(tile_marker_array);
+  }
 }
 }  // namespace autoware::lanelet2_map_visualizer
 
@@ -35,6 +35,12 @@ private:
   rclcpp::Publisher<visualization_msgs::msg::MarkerArray>::SharedPtr pub_marker_;
 
   bool viz_lanelets_centerline_;
+  // the markers are published for each square tile of this size if positive
+  double marker_chunk_size_;
+  // the number of the tile marker arrays kept for the late subscribers
+  size_t marker_history_depth_;
+  // the number of the threads generating the markers
+  size_t thread_num_;
 
   void on_map_bin(const autoware_map_msgs::msg::LaneletMapBin::ConstSharedPtr msg);
 };
@@ -40,6 +40,8 @@ def generate_test_description():
                 "lanelet2_map_path": lanelet2_map_path,
                 "center_line_resolution": 5.0,
                 "use_waypoints": True,
+                "lanelet2_map_cache_path": "",
+                "thread_num": 1,
                 "allow_unsupported_version": True,
             }
         ],
@@ -49,6 +51,12 @@ def generate_test_description():
     lanelet2_map_visualizer = Node(
         package="autoware_lanelet2_map_visualizer",
         executable="autoware_lanelet2_map_visualizer",
+        parameters=[
+            os.path.join(
+                get_package_share_directory("autoware_lanelet2_map_visualizer"),
+                "config/lanelet2_map_visualization.param.yaml",
+            )
+        ],
     )
 
     context = {}
@@ -43,7 +43,10 @@ protected:
     node_ = std::make_shared<rclcpp::Node>("test_lanelet2_map_visualization_node");
 
     // Create the visualization node
-    visualization_node_ = std::make_shared<Lanelet2MapVisualizationNode>(rclcpp::NodeOptions());
+    rclcpp::NodeOptions options;
+    options.parameter_overrides(
+      {{"marker_chunk_size", 0.0}, {"marker_history_depth", 1024}, {"thread_num", 4}});
+    visualization_node_ = std::make_shared<Lanelet2MapVisualizationNode>(options);
 
     // Create publisher for map bin messages
     map_bin_pub_ = node_->create_publisher<autoware_map_msgs::msg::LaneletMapBin>(
@@ -133,6 +136,77 @@ TEST_F(TestLanelet2MapVisualizationNode, VisualizeLaneletMap)
   EXPECT_TRUE(found_marker_with_map_frame);
 }
 
+TEST_F(TestLanelet2MapVisualizationNode, VisualizeLaneletMapInChunks)
+{
+  // Replace the visualization node with the one which publishes the markers for each tile
+  visualization_node_.reset();
+  rclcpp::NodeOptions options;
+  options.parameter_overrides(
+    {{"marker_chunk_size", 100.0}, {"marker_history_depth", 3}, {"thread_num", 4}});
+  visualization_node_ = std::make_shared<Lanelet2MapVisualizationNode>(options);
+
+  using MarkerArrays = std::vector<visualization_msgs::msg::MarkerArray::ConstSharedPtr>;
+  const auto subscribe = [this](MarkerArrays & received_chunks) {
+    return node_->create_subscription<visualization_msgs::msg::MarkerArray>(
+      "output/lanelet2_map_marker", rclcpp::QoS{3}.transient_local(),
+      [&received_chunks](const visualization_msgs::msg::MarkerArray::ConstSharedPtr msg) {
+        received_chunks.push_back(msg);
+      });
+  };
+  const auto wait_for = [this](const MarkerArrays & received_chunks, const size_t chunk_num) {
+    auto start_time = node_->now();
+    while (received_chunks.size() < chunk_num && (node_->now() - start_time).seconds() < 5.0) {
+      rclcpp::spin_some(node_);
+      rclcpp::spin_some(visualization_node_);
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  };
+
+  // The markers of the previous map are deleted, and then each tile is published separately with
+  // the namespaces of the tile
+  const auto check_chunks = [](const MarkerArrays & received_chunks) {
+    ASSERT_EQ(received_chunks.size(), 3u);
+    ASSERT_EQ(received_chunks[0]->markers.size(), 1u);
+    EXPECT_EQ(received_chunks[0]->markers[0].action, visualization_msgs::msg::Marker::DELETEALL);
+    const std::vector<std::string> tile_suffixes = {"/0_0", "/10_0"};
+    for (size_t i = 0; i < tile_suffixes.size(); ++i) {
+      const auto & chunk = received_chunks[i + 1];
+      ASSERT_GT(chunk->markers.size(), 0u);
+      for (const auto & marker : chunk->markers) {
+        const auto & suffix = tile_suffixes[i];
+        ASSERT_GE(marker.ns.size(), suffix.size());
+        EXPECT_EQ(marker.ns.substr(marker.ns.size() - suffix.size()), suffix);
+      }
+    }
+  };
+
+  MarkerArrays received_chunks;
+  const auto chunk_sub = subscribe(received_chunks);
+
+  // Add a lanelet in another tile
+  auto lanelet_map = createSimpleLaneletMap();
+  lanelet::Point3d p1{11, 1000, 0, 0};
+  lanelet::Point3d p2{12, 1010, 0, 0};
+  lanelet::Point3d p3{13, 1000, 5, 0};
+  lanelet::Point3d p4{14, 1010, 5, 0};
+  lanelet::Lanelet ll(17, lanelet::LineString3d(15, {p1, p2}), lanelet::LineString3d(16, {p3, p4}));
+  ll.attributes()["subtype"] = "road";
+  lanelet_map->add(ll);
+
+  autoware_map_msgs::msg::LaneletMapBin map_bin_msg;
+  lanelet::utils::conversion::toBinMsg(lanelet_map, &map_bin_msg);
+  map_bin_pub_->publish(map_bin_msg);
+
+  wait_for(received_chunks, 3);
+  check_chunks(received_chunks);
+
+  // A late subscriber with the depth of marker_history_depth receives all the tiles
+  MarkerArrays late_received_chunks;
+  const auto late_chunk_sub = subscribe(late_received_chunks);
+  wait_for(late_received_chunks, 3);
+  check_chunks(late_received_chunks);
+}
+
 int main(int argc, char ** argv)
 {
   testing::InitGoogleTest(&argc, argv);
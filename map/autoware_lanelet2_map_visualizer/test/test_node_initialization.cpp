@@ -34,6 +34,8 @@ TEST_F(TestNodeInitialization, InitializationTest)
 {
   // Test that the node can be constructed without errors
   rclcpp::NodeOptions options;
+  options.parameter_overrides(
+    {{"marker_chunk_size", 0.0}, {"marker_history_depth", 1024}, {"thread_num", 1}});
   std::shared_ptr<Lanelet2MapVisualizationNode> node =
     std::make_shared<Lanelet2MapVisualizationNode>(options);
 
@@ -22,6 +22,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace autoware::map_height_fitter
 {
@@ -38,6 +39,11 @@ public:
   MapHeightFitter(MapHeightFitter &&) = delete;
   MapHeightFitter & operator=(MapHeightFitter &&) = delete;
   std::optional<Point> fit(const Point & position, const std::string & frame);
+  // Fit many points in one call, e.g. along a route. Each result is the same as that of a single
+  // fit, and the result of a point which could not be fitted is nullopt while the others are
+  // still fitted.
+  std::vector<std::optional<Point>> fit(
+    const std::vector<Point> & positions, const std::string & frame);
 
 private:
   struct Impl;
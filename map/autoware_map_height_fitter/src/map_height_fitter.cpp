@@ -14,6 +14,8 @@
 
 #include "autoware/map_height_fitter/map_height_fitter.hpp"
 
+#include "point_cloud_height_index.hpp"
+
 #include <autoware_lanelet2_extension/utility/message_conversion.hpp>
 #include <autoware_lanelet2_extension/utility/query.hpp>
 
@@ -30,8 +32,10 @@
 #include <tf2_ros/transform_listener.h>
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace autoware::map_height_fitter
 {
@@ -39,13 +43,17 @@ namespace autoware::map_height_fitter
 struct MapHeightFitter::Impl
 {
   static constexpr char enable_partial_load[] = "enable_partial_load";
+  static constexpr double partial_map_load_radius = 50.0;
+  // The lowest point is searched within this margin beyond the closest point
+  static constexpr double ground_search_margin = 1.0;
 
   explicit Impl(rclcpp::Node * node);
   void on_pcd_map(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg);
   void on_vector_map(const autoware_map_msgs::msg::LaneletMapBin::ConstSharedPtr msg);
   bool get_partial_point_cloud_map(const Point & point);
   double get_ground_height(const Point & point) const;
-  std::optional<Point> fit(const Point & position, const std::string & frame);
+  std::vector<std::optional<Point>> fit(
+    const std::vector<Point> & positions, const std::string & frame);
 
   tf2::BufferCore tf2_buffer_;
   tf2_ros::TransformListener tf2_listener_;
@@ -56,7 +64,7 @@ struct MapHeightFitter::Impl
 
   // for fitting by pointcloud_map_loader
   rclcpp::CallbackGroup::SharedPtr group_;
-  pcl::PointCloud<pcl::PointXYZ>::Ptr map_cloud_;
+  std::unique_ptr<PointCloudHeightIndex> map_index_;
   rclcpp::Client<autoware_map_msgs::srv::GetPartialPointCloudMap>::SharedPtr cli_pcd_map_;
   rclcpp::Subscription<sensor_msgs::msg::PointCloud2>::SharedPtr sub_pcd_map_;
   rclcpp::AsyncParametersClient::SharedPtr params_pcd_map_loader_;
@@ -111,8 +119,9 @@ MapHeightFitter::Impl::Impl(rclcpp::Node * node) : tf2_listener_(tf2_buffer_), n
 void MapHeightFitter::Impl::on_pcd_map(const sensor_msgs::msg::PointCloud2::ConstSharedPtr msg)
 {
   map_frame_ = msg->header.frame_id;
-  map_cloud_ = std::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
-  pcl::fromROSMsg(*msg, *map_cloud_);
+  pcl::PointCloud<pcl::PointXYZ> map_cloud;
+  pcl::fromROSMsg(*msg, map_cloud);
+  map_index_ = std::make_unique<PointCloudHeightIndex>(map_cloud);
 }
 
 bool MapHeightFitter::Impl::get_partial_point_cloud_map(const Point & point)
@@ -131,7 +140,7 @@ bool MapHeightFitter::Impl::get_partial_point_cloud_map(const Point & point)
   const auto req = std::make_shared<autoware_map_msgs::srv::GetPartialPointCloudMap::Request>();
   req->area.center_x = static_cast<float>(point.x);
   req->area.center_y = static_cast<float>(point.y);
-  req->area.radius = 50;
+  req->area.radius = static_cast<float>(partial_map_load_radius);
 
   RCLCPP_DEBUG(logger, "Send request to map_loader");
   auto future = cli_pcd_map_->async_send_request(req);
@@ -161,8 +170,9 @@ bool MapHeightFitter::Impl::get_partial_point_cloud_map(const Point & point)
     }
   }
   map_frame_ = res->header.frame_id;
-  map_cloud_ = std::make_shared<pcl::PointCloud<pcl::PointXYZ>>();
-  pcl::fromROSMsg(pcd_msg, *map_cloud_);
+  pcl::PointCloud<pcl::PointXYZ> map_cloud;
+  pcl::fromROSMsg(pcd_msg, map_cloud);
+  map_index_ = std::make_unique<PointCloudHeightIndex>(map_cloud);
   return true;
 }
 
@@ -183,26 +193,8 @@ double MapHeightFitter::Impl::get_ground_height(const Point & point) const
 
   double height = INFINITY;
   if (fit_target_ == "pointcloud_map") {
-    // find distance d to closest point
-    double min_dist2 = INFINITY;
-    for (const auto & p : map_cloud_->points) {
-      const double dx = x - p.x;
-      const double dy = y - p.y;
-      const double sd = (dx * dx) + (dy * dy);
-      min_dist2 = std::min(min_dist2, sd);
-    }
-
-    // find lowest height within radius (d+1.0)
-    const double radius2 = std::pow(std::sqrt(min_dist2) + 1.0, 2.0);
-
-    for (const auto & p : map_cloud_->points) {
-      const double dx = x - p.x;
-      const double dy = y - p.y;
-      const double sd = (dx * dx) + (dy * dy);
-      if (sd < radius2) {
-        height = std::min(height, static_cast<double>(p.z));
-      }
-    }
+    // lowest height within the closest distance plus the margin, looked up in the grid index
+    height = map_index_->get_ground_height(x, y, ground_search_margin).value_or(INFINITY);
   } else if (fit_target_ == "vector_map") {
     const auto closest_points = vector_map_->pointLayer.nearest(lanelet::BasicPoint2d{x, y}, 1);
     if (closest_points.empty()) {
@@ -215,64 +207,93 @@ double MapHeightFitter::Impl::get_ground_height(const Point & point) const
   return std::isfinite(height) ? height : point.z;
 }
 
-std::optional<Point> MapHeightFitter::Impl::fit(const Point & position, const std::string & frame)
+std::vector<std::optional<Point>> MapHeightFitter::Impl::fit(
+  const std::vector<Point> & positions, const std::string & frame)
 {
   const auto logger = node_->get_logger();
-  RCLCPP_INFO_STREAM(logger, "fit_target: " << fit_target_ << ", frame: " << frame);
+  RCLCPP_INFO_STREAM(
+    logger, "fit_target: " << fit_target_ << ", frame: " << frame
+                           << ", points: " << positions.size());
 
-  Point point;
-  point.x = position.x;
-  point.y = position.y;
-  point.z = position.z;
-
-  RCLCPP_DEBUG(logger, "original point: %.3f %.3f %.3f", point.x, point.y, point.z);
+  std::vector<std::optional<Point>> fitted(positions.size());
+  if (positions.empty()) {
+    return fitted;
+  }
 
   // prepare data
   if (fit_target_ == "pointcloud_map") {
-    if (cli_pcd_map_) {  // if cli_pcd_map_ is available, prepare pointcloud map by partial loading
-      if (!get_partial_point_cloud_map(position)) {
-        RCLCPP_WARN_STREAM(logger, "failed to get partial point cloud map");
-        return std::nullopt;
-      }
-    }  // otherwise, pointcloud map should be already prepared by on_pcd_map
-    if (!map_cloud_) {
+    // if cli_pcd_map_ is available, the pointcloud map is prepared by partial loading for each
+    // point below, otherwise it should be already prepared by on_pcd_map
+    if (!cli_pcd_map_ && !map_index_) {
       RCLCPP_WARN_STREAM(logger, "point cloud map is not ready");
-      return std::nullopt;
+      return fitted;
     }
   } else if (fit_target_ == "vector_map") {
     // vector_map_ should be already prepared by on_vector_map
     if (!vector_map_) {
       RCLCPP_WARN_STREAM(logger, "vector map is not ready");
-      return std::nullopt;
+      return fitted;
     }
   } else {
     throw std::runtime_error("invalid fit_target");
   }
 
-  // transform frame to map_frame_
-  try {
-    const auto stamped = tf2_buffer_.lookupTransform(frame, map_frame_, tf2::TimePointZero);
-    tf2::doTransform(point, point, stamped);
-  } catch (tf2::TransformException & exception) {
-    RCLCPP_WARN_STREAM(logger, "failed to lookup transform: " << exception.what());
-    return std::nullopt;
-  }
+  std::optional<Point> partial_map_center;
+  std::optional<geometry_msgs::msg::TransformStamped> frame_to_map;
+  std::optional<geometry_msgs::msg::TransformStamped> map_to_frame;
+  for (size_t i = 0; i < positions.size(); ++i) {
+    const Point & position = positions[i];
+
+    if (cli_pcd_map_) {
+      // the partial map loaded around another point may differ from the one around this point,
+      // so it is reused only for the same position to give the same result as a single fit
+      const bool is_loaded = partial_map_center && position.x == partial_map_center->x &&
+                             position.y == partial_map_center->y;
+      if (!is_loaded) {
+        partial_map_center.reset();
+        if (!get_partial_point_cloud_map(position)) {
+          RCLCPP_WARN_STREAM(logger, "failed to get partial point cloud map for point " << i);
+          continue;
+        }
+        partial_map_center = position;
+      }
+    }
+
+    Point point;
+    point.x = position.x;
+    point.y = position.y;
+    point.z = position.z;
+
+    RCLCPP_DEBUG(logger, "original point: %.3f %.3f %.3f", point.x, point.y, point.z);
+
+    // the transforms are looked up once map_frame_ is known, and shared among the points
+    if (!frame_to_map) {
+      try {
+        frame_to_map = tf2_buffer_.lookupTransform(frame, map_frame_, tf2::TimePointZero);
+        map_to_frame = tf2_buffer_.lookupTransform(map_frame_, frame, tf2::TimePointZero);
+      } catch (tf2::TransformException & exception) {
+        frame_to_map.reset();
+        RCLCPP_WARN_STREAM(
+          logger, "failed to lookup transform for point " << i << ": " << exception.what());
+        continue;
+      }
+    }
 
-  // fit height on map_frame_
-  point.z = get_ground_height(point);
+    // transform frame to map_frame_
+    tf2::doTransform(point, point, *frame_to_map);
 
-  // transform map_frame_ to frame
-  try {
-    const auto stamped = tf2_buffer_.lookupTransform(map_frame_, frame, tf2::TimePointZero);
-    tf2::doTransform(point, point, stamped);
-  } catch (tf2::TransformException & exception) {
-    RCLCPP_WARN_STREAM(logger, "failed to lookup transform: " << exception.what());
-    return std::nullopt;
-  }
+    // fit height on map_frame_
+    point.z = get_ground_height(point);
+
+    // transform map_frame_ to frame
+    tf2::doTransform(point, point, *map_to_frame);
 
-  RCLCPP_DEBUG(logger, "modified point: %.3f %.3f %.3f", point.x, point.y, point.z);
+    RCLCPP_DEBUG(logger, "modified point: %.3f %.3f %.3f", point.x, point.y, point.z);
 
-  return point;
+    fitted[i] = point;
+  }
+
+  return fitted;
 }
 
 MapHeightFitter::MapHeightFitter(rclcpp::Node * node)
@@ -284,7 +305,13 @@ MapHeightFitter::~MapHeightFitter() = default;
 
 std::optional<Point> MapHeightFitter::fit(const Point & position, const std::string & frame)
 {
-  return impl_->fit(position, frame);
+  return impl_->fit(std::vector<Point>{position}, frame).front();
+}
+
+std::vector<std::optional<Point>> MapHeightFitter::fit(
+  const std::vector<Point> & positions, const std::string & frame)
+{
+  return impl_->fit(positions, frame);
 }
 
 }  // namespace autoware::map_height_fitter
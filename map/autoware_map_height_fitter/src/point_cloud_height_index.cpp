@@ -0,0 +1,228 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "point_cloud_height_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace autoware::map_height_fitter
+{
+
+namespace
+{
+// The cell size is chosen so that a cell has about this number of points on average
+constexpr double points_per_cell = 16.0;
+constexpr double min_cell_size = 0.1;
+
+// The cell bounds are widened by this ratio of the cell size to absorb the rounding of the
+// coordinates into cells, so that the bounds of the distances to a cell are conservative
+constexpr double cell_bound_margin = 1e-6;
+
+struct DistanceRange
+{
+  double min2;
+  double max2;
+};
+
+DistanceRange get_distance_range(const double v, const double lower, const double upper)
+{
+  const double min = std::max({lower - v, v - upper, 0.0});
+  const double max = std::max(std::abs(v - lower), std::abs(v - upper));
+  return {min * min, max * max};
+}
+}  // namespace
+
+PointCloudHeightIndex::PointCloudHeightIndex(const pcl::PointCloud<pcl::PointXYZ> & cloud)
+: min_x_(0.0), min_y_(0.0), cell_size_(1.0), cols_(0), rows_(0)
+{
+  double max_x = -std::numeric_limits<double>::infinity();
+  double max_y = -std::numeric_limits<double>::infinity();
+  min_x_ = std::numeric_limits<double>::infinity();
+  min_y_ = std::numeric_limits<double>::infinity();
+  // A point with a non-finite height is kept for the closest distance as in a linear search,
+  // but it is never the lowest point since std::min ignores NaN as its second argument
+  size_t point_num = 0;
+  for (const auto & p : cloud.points) {
+    if (std::isfinite(p.x) && std::isfinite(p.y)) {
+      min_x_ = std::min(min_x_, static_cast<double>(p.x));
+      min_y_ = std::min(min_y_, static_cast<double>(p.y));
+      max_x = std::max(max_x, static_cast<double>(p.x));
+      max_y = std::max(max_y, static_cast<double>(p.y));
+      ++point_num;
+    }
+  }
+  if (point_num == 0) {
+    cell_begins_.assign(1, 0);
+    return;
+  }
+
+  const double area = (max_x - min_x_) * (max_y - min_y_);
+  // The lower bounds by the extents keep the number of cells proportional to the number of
+  // points when the points lie on a line
+  cell_size_ = std::max(
+    {std::sqrt(area * points_per_cell / static_cast<double>(point_num)), min_cell_size,
+     (max_x - min_x_) / static_cast<double>(point_num),
+     (max_y - min_y_) / static_cast<double>(point_num)});
+  cols_ = static_cast<int64_t>((max_x - min_x_) / cell_size_) + 1;
+  rows_ = static_cast<int64_t>((max_y - min_y_) / cell_size_) + 1;
+
+  // sort the points by cell with a counting sort
+  std::vector<uint32_t> point_cells;
+  point_cells.reserve(point_num);
+  cell_begins_.assign(cols_ * rows_ + 1, 0);
+  for (const auto & p : cloud.points) {
+    if (std::isfinite(p.x) && std::isfinite(p.y)) {
+      const auto col = std::min(static_cast<int64_t>((p.x - min_x_) / cell_size_), cols_ - 1);
+      const auto row = std::min(static_cast<int64_t>((p.y - min_y_) / cell_size_), rows_ - 1);
+      point_cells.push_back(static_cast<uint32_t>(row * cols_ + col));
+      ++cell_begins_[point_cells.back() + 1];
+    }
+  }
+  for (size_t cell = 1; cell < cell_begins_.size(); ++cell) {
+    cell_begins_[cell] += cell_begins_[cell - 1];
+  }
+
+  x_.resize(point_num);
+  y_.resize(point_num);
+  z_.resize(point_num);
+  cell_min_z_.assign(cols_ * rows_, std::numeric_limits<float>::infinity());
+  std::vector<uint32_t> positions(cell_begins_.begin(), cell_begins_.end() - 1);
+  size_t i = 0;
+  for (const auto & p : cloud.points) {
+    if (std::isfinite(p.x) && std::isfinite(p.y)) {
+      const uint32_t cell = point_cells[i++];
+      const uint32_t position = positions[cell]++;
+      x_[position] = p.x;
+      y_[position] = p.y;
+      z_[position] = p.z;
+      cell_min_z_[cell] = std::min(cell_min_z_[cell], p.z);
+    }
+  }
+}
+
+std::optional<double> PointCloudHeightIndex::get_ground_height(
+  const double x, const double y, const double margin) const
+{
+  if (z_.empty() || !std::isfinite(x) || !std::isfinite(y)) {
+    return std::nullopt;
+  }
+
+  // find distance d to closest point
+  const double min_dist2 = find_closest_distance2(x, y);
+
+  // find lowest height within radius (d + margin)
+  const double radius2 = std::pow(std::sqrt(min_dist2) + margin, 2.0);
+  return find_min_height(x, y, radius2);
+}
+
+double PointCloudHeightIndex::find_closest_distance2(const double x, const double y) const
+{
+  const auto query_col = static_cast<int64_t>(std::floor((x - min_x_) / cell_size_));
+  const auto query_row = static_cast<int64_t>(std::floor((y - min_y_) / cell_size_));
+
+  // Visit the rings of cells around the query cell, starting from the first ring which
+  // overlaps the grid, until the rings are farther than the closest point found
+  const int64_t first_ring = std::max(
+    {int64_t{0}, query_col - (cols_ - 1), -query_col, query_row - (rows_ - 1), -query_row});
+  const int64_t last_ring =
+    std::max({query_col, cols_ - 1 - query_col, query_row, rows_ - 1 - query_row});
+
+  double min_dist2 = std::numeric_limits<double>::infinity();
+  const auto visit_cell = [&](const int64_t col, const int64_t row) {
+    if (col < 0 || cols_ <= col || row < 0 || rows_ <= row) {
+      return;
+    }
+    const size_t cell = row * cols_ + col;
+    for (uint32_t i = cell_begins_[cell]; i < cell_begins_[cell + 1]; ++i) {
+      const double dx = x - x_[i];
+      const double dy = y - y_[i];
+      min_dist2 = std::min(min_dist2, (dx * dx) + (dy * dy));
+    }
+  };
+
+  for (int64_t ring = first_ring; ring <= last_ring; ++ring) {
+    // every cell of the ring is at least ring - 1 cells away from the query point
+    const double ring_dist = (static_cast<double>(ring - 1) - cell_bound_margin) * cell_size_;
+    if (0.0 < ring_dist && min_dist2 < ring_dist * ring_dist) {
+      break;
+    }
+
+    const int64_t row_begin = std::max(query_row - ring, int64_t{0});
+    const int64_t row_end = std::min(query_row + ring, rows_ - 1);
+    for (int64_t row = row_begin; row <= row_end; ++row) {
+      if (row == query_row - ring || row == query_row + ring) {
+        const int64_t col_begin = std::max(query_col - ring, int64_t{0});
+        const int64_t col_end = std::min(query_col + ring, cols_ - 1);
+        for (int64_t col = col_begin; col <= col_end; ++col) {
+          visit_cell(col, row);
+        }
+      } else {
+        visit_cell(query_col - ring, row);
+        if (ring != 0) {
+          visit_cell(query_col + ring, row);
+        }
+      }
+    }
+  }
+  return min_dist2;
+}
+
+double PointCloudHeightIndex::find_min_height(
+  const double x, const double y, const double radius2) const
+{
+  const double radius = std::sqrt(radius2);
+  const auto to_index = [this](const double v, const double min, const int64_t size) {
+    const auto index = static_cast<int64_t>(std::floor((v - min) / cell_size_));
+    return std::clamp(index, int64_t{0}, size - 1);
+  };
+  const int64_t col_begin = to_index(x - radius, min_x_, cols_);
+  const int64_t col_end = to_index(x + radius, min_x_, cols_);
+  const int64_t row_begin = to_index(y - radius, min_y_, rows_);
+  const int64_t row_end = to_index(y + radius, min_y_, rows_);
+  const double margin = cell_bound_margin * cell_size_;
+
+  double height = std::numeric_limits<double>::infinity();
+  for (int64_t row = row_begin; row <= row_end; ++row) {
+    const double lower_y = min_y_ + static_cast<double>(row) * cell_size_ - margin;
+    const DistanceRange range_y = get_distance_range(y, lower_y, lower_y + cell_size_ + 2 * margin);
+    for (int64_t col = col_begin; col <= col_end; ++col) {
+      const double lower_x = min_x_ + static_cast<double>(col) * cell_size_ - margin;
+      const DistanceRange range_x =
+        get_distance_range(x, lower_x, lower_x + cell_size_ + 2 * margin);
+      if (radius2 <= range_x.min2 + range_y.min2) {
+        continue;
+      }
+
+      const size_t cell = row * cols_ + col;
+      if (range_x.max2 + range_y.max2 < radius2) {
+        // the whole cell is within the radius
+        height = std::min(height, static_cast<double>(cell_min_z_[cell]));
+        continue;
+      }
+      for (uint32_t i = cell_begins_[cell]; i < cell_begins_[cell + 1]; ++i) {
+        const double dx = x - x_[i];
+        const double dy = y - y_[i];
+        if ((dx * dx) + (dy * dy) < radius2) {
+          height = std::min(height, static_cast<double>(z_[i]));
+        }
+      }
+    }
+  }
+  return height;
+}
+
+}  // namespace autoware::map_height_fitter
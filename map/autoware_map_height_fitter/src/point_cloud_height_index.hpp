@@ -0,0 +1,61 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINT_CLOUD_HEIGHT_INDEX_HPP_
+#define POINT_CLOUD_HEIGHT_INDEX_HPP_
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace autoware::map_height_fitter
+{
+
+// A 2D grid over the XY coordinates of the map points, where the points of each cell are stored
+// contiguously together with the lowest height of the cell.
+class PointCloudHeightIndex
+{
+public:
+  explicit PointCloudHeightIndex(const pcl::PointCloud<pcl::PointXYZ> & cloud);
+
+  // Return the lowest height of the points whose XY distance to (x, y) is less than d + margin,
+  // where d is the XY distance to the closest point, or nullopt if there is no point.
+  std::optional<double> get_ground_height(double x, double y, double margin) const;
+
+  size_t size() const { return z_.size(); }
+
+private:
+  double min_x_;
+  double min_y_;
+  double cell_size_;
+  int64_t cols_;
+  int64_t rows_;
+
+  // the points sorted by cell, and the range of each cell in them
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> z_;
+  std::vector<uint32_t> cell_begins_;
+  std::vector<float> cell_min_z_;
+
+  double find_closest_distance2(double x, double y) const;
+  double find_min_height(double x, double y, double radius2) const;
+};
+
+}  // namespace autoware::map_height_fitter
+
+#endif  // POINT_CLOUD_HEIGHT_INDEX_HPP_
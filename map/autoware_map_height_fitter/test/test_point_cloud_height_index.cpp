@@ -0,0 +1,137 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "point_cloud_height_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+
+using autoware::map_height_fitter::PointCloudHeightIndex;
+
+namespace
+{
+// The two linear passes the index replaces
+double get_ground_height_by_linear_search(
+  const pcl::PointCloud<pcl::PointXYZ> & cloud, const double x, const double y)
+{
+  double min_dist2 = INFINITY;
+  for (const auto & p : cloud.points) {
+    const double dx = x - p.x;
+    const double dy = y - p.y;
+    min_dist2 = std::min(min_dist2, (dx * dx) + (dy * dy));
+  }
+
+  const double radius2 = std::pow(std::sqrt(min_dist2) + 1.0, 2.0);
+  double height = INFINITY;
+  for (const auto & p : cloud.points) {
+    const double dx = x - p.x;
+    const double dy = y - p.y;
+    if ((dx * dx) + (dy * dy) < radius2) {
+      height = std::min(height, static_cast<double>(p.z));
+    }
+  }
+  return height;
+}
+
+// A sloped ground with a few clusters of points above it, and holes without points
+pcl::PointCloud<pcl::PointXYZ> make_map(const size_t point_num)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> xy_dist(-200.0f, 200.0f);
+  std::uniform_real_distribution<float> noise_dist(0.0f, 3.0f);
+  pcl::PointCloud<pcl::PointXYZ> cloud;
+  while (cloud.points.size() < point_num) {
+    const float x = xy_dist(engine);
+    const float y = xy_dist(engine);
+    if (std::abs(x - 50.0f) < 30.0f && std::abs(y + 20.0f) < 40.0f) {
+      continue;
+    }
+    cloud.points.emplace_back(x, y, 0.05f * x - 0.02f * y + noise_dist(engine));
+  }
+  cloud.points.emplace_back(0.0f, 0.0f, std::numeric_limits<float>::quiet_NaN());
+  cloud.width = cloud.points.size();
+  cloud.height = 1;
+  return cloud;
+}
+}  // namespace
+
+TEST(PointCloudHeightIndex, MatchesLinearSearch)  // NOLINT
+{
+  const auto cloud = make_map(20000);
+  const PointCloudHeightIndex index(cloud);
+  EXPECT_EQ(index.size(), 20001u);
+
+  std::mt19937 engine(1);
+  // the queries include points in the holes and far outside the map
+  std::uniform_real_distribution<double> xy_dist(-300.0, 300.0);
+  for (int i = 0; i < 500; ++i) {
+    const double x = i == 0 ? 0.0 : xy_dist(engine);
+    const double y = i == 0 ? 0.0 : xy_dist(engine);
+    const auto height = index.get_ground_height(x, y, 1.0);
+    ASSERT_TRUE(height.has_value());
+    EXPECT_DOUBLE_EQ(height.value(), get_ground_height_by_linear_search(cloud, x, y));
+  }
+}
+
+TEST(PointCloudHeightIndex, HandlesDegenerateMaps)  // NOLINT
+{
+  pcl::PointCloud<pcl::PointXYZ> empty_cloud;
+  EXPECT_FALSE(PointCloudHeightIndex(empty_cloud).get_ground_height(0.0, 0.0, 1.0).has_value());
+
+  // the points on a line parallel to the x axis
+  pcl::PointCloud<pcl::PointXYZ> line_cloud;
+  for (int i = 0; i < 1000; ++i) {
+    const auto f = static_cast<float>(i);
+    line_cloud.points.emplace_back(0.1f * f, 5.0f, 0.01f * f);
+  }
+  const PointCloudHeightIndex index(line_cloud);
+  for (const double x : {-10.0, 0.0, 33.3, 99.9, 150.0}) {
+    EXPECT_DOUBLE_EQ(
+      index.get_ground_height(x, 0.0, 1.0).value(),
+      get_ground_height_by_linear_search(line_cloud, x, 0.0));
+  }
+}
+
+TEST(PointCloudHeightIndex, DISABLED_Benchmark)  // NOLINT
+{
+  const auto cloud = make_map(2000000);
+  constexpr int nb_query = 20;
+
+  const auto start = std::chrono::steady_clock::now();
+  const PointCloudHeightIndex index(cloud);
+  const auto built = std::chrono::steady_clock::now();
+  double sum = 0.0;
+  for (int i = 0; i < nb_query; ++i) {
+    sum += index.get_ground_height(10.0 * i, -5.0 * i, 1.0).value();
+  }
+  const auto indexed = std::chrono::steady_clock::now();
+  for (int i = 0; i < nb_query; ++i) {
+    sum -= get_ground_height_by_linear_search(cloud, 10.0 * i, -5.0 * i);
+  }
+  const auto linear = std::chrono::steady_clock::now();
+
+  const auto to_ms = [](const auto duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+  std::cout << "build index: " << to_ms(built - start) << " [ms]" << std::endl;
+  std::cout << "indexed query: " << to_ms(indexed - built) / nb_query << " [ms]" << std::endl;
+  std::cout << "linear query: " << to_ms(linear - indexed) / nb_query << " [ms]" << std::endl;
+  EXPECT_NEAR(sum, 0.0, 1e-6);
+}
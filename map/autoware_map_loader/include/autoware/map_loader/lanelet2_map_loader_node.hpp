@@ -48,6 +48,10 @@ private:
   using MapProjectorInfo = autoware::component_interface_specs::map::MapProjectorInfo;
   using VectorMap = autoware::component_interface_specs::map::VectorMap;
   void on_map_projector_info(const MapProjectorInfo::Message::ConstSharedPtr msg);
+  // Throw std::invalid_argument if the format version is not supported and it is not allowed
+  void check_format_version(
+    const std::string & format_version, const std::string & lanelet2_filename,
+    const bool allow_unsupported_version) const;
 
   rclcpp::Subscription<MapProjectorInfo::Message>::SharedPtr sub_map_projector_info_;
   rclcpp::Publisher<VectorMap::Message>::SharedPtr pub_map_bin_;
@@ -0,0 +1,309 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "lanelet2_map_cache.hpp"
+
+#include <autoware_lanelet2_extension/utility/utilities.hpp>
+#include <autoware_lanelet2_extension/version.hpp>
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+
+#include <fmt/format.h>
+#include <lanelet2_core/geometry/LineString.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace autoware::map_loader
+{
+namespace
+{
+constexpr char cache_magic[8] = {'A', 'W', 'L', 'L', 'M', 'A', 'P', '1'};
+
+// FNV-1a, which is enough to tell the versions of a map apart
+class Hash
+{
+public:
+  void add(const void * data, const size_t size)
+  {
+    const auto * bytes = static_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; ++i) {
+      value_ = (value_ ^ bytes[i]) * 1099511628211ULL;
+    }
+  }
+
+  template <typename T>
+  void add(const T & value)
+  {
+    add(&value, sizeof(T));
+  }
+
+  uint64_t value() const { return value_; }
+
+private:
+  uint64_t value_{14695981039346656037ULL};
+};
+
+template <typename MessageT>
+rclcpp::SerializedMessage serialize(const MessageT & msg)
+{
+  rclcpp::SerializedMessage serialized_msg;
+  rclcpp::Serialization<MessageT>().serialize_message(&msg, &serialized_msg);
+  return serialized_msg;
+}
+
+bool write_all(const int fd, const void * data, size_t size)
+{
+  const auto * bytes = static_cast<const uint8_t *>(data);
+  while (size > 0) {
+    const ssize_t written = ::write(fd, bytes, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+// The points of generateFineCenterline, which are resampled in the same way
+lanelet::BasicPoints3d resample_points(
+  const lanelet::ConstLineString3d & line_string, const int num_segments)
+{
+  if (line_string.size() < 2) {
+    return {};
+  }
+  std::vector<double> accumulated_lengths{0.0};
+  for (size_t i = 1; i < line_string.size(); ++i) {
+    accumulated_lengths.push_back(
+      accumulated_lengths.back() + lanelet::geometry::distance(line_string[i], line_string[i - 1]));
+  }
+  const auto line_length = lanelet::geometry::length(line_string);
+
+  lanelet::BasicPoints3d resampled_points;
+  resampled_points.reserve(num_segments + 1);
+  for (int i = 0; i <= num_segments; ++i) {
+    const auto target_length = (static_cast<double>(i) / num_segments) * line_length;
+
+    // the segment which contains the target length, and the first or the last one beyond the ends
+    const auto n = accumulated_lengths.size();
+    size_t back = 0;
+    if (target_length < accumulated_lengths.at(1)) {
+      back = 0;
+    } else if (target_length > accumulated_lengths.at(n - 2)) {
+      back = n - 2;
+    } else {
+      for (size_t j = 1; j < n; ++j) {
+        if (
+          accumulated_lengths.at(j - 1) <= target_length &&
+          target_length <= accumulated_lengths.at(j)) {
+          back = j - 1;
+          break;
+        }
+      }
+    }
+
+    const lanelet::BasicPoint3d back_point = line_string[back];
+    const lanelet::BasicPoint3d front_point = line_string[back + 1];
+    const auto back_length = accumulated_lengths.at(back);
+    const auto segment_length = accumulated_lengths.at(back + 1) - back_length;
+    resampled_points.push_back(
+      back_point + ((front_point - back_point) * (target_length - back_length) / segment_length));
+  }
+  return resampled_points;
+}
+
+// The geometry of generateFineCenterline, which does not take any IDs
+lanelet::BasicLineString3d generate_fine_centerline_points(
+  const lanelet::ConstLanelet & lanelet, const double resolution)
+{
+  const double longer_length = std::max(
+    lanelet::geometry::length(lanelet.leftBound()),
+    lanelet::geometry::length(lanelet.rightBound()));
+  const int num_segments = std::max(static_cast<int>(std::ceil(longer_length / resolution)), 1);
+
+  const auto left_points = resample_points(lanelet.leftBound(), num_segments);
+  const auto right_points = resample_points(lanelet.rightBound(), num_segments);
+
+  lanelet::BasicLineString3d centerline;
+  centerline.reserve(num_segments + 1);
+  for (int i = 0; i <= num_segments; ++i) {
+    centerline.push_back((right_points.at(i) + left_points.at(i)) / 2);
+  }
+  return centerline;
+}
+}  // namespace
+
+std::string compute_lanelet2_map_cache_key(
+  const std::string & lanelet2_filename,
+  const autoware_map_msgs::msg::MapProjectorInfo & projector_info,
+  const double center_line_resolution, const bool use_waypoints)
+{
+  std::ifstream ifs(lanelet2_filename, std::ios::binary);
+  if (!ifs) {
+    return "";
+  }
+  const std::vector<char> osm(
+    (std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+  Hash hash;
+  hash.add(osm.data(), osm.size());
+  const auto serialized_projector_info = serialize(projector_info);
+  hash.add(
+    serialized_projector_info.get_rcl_serialized_message().buffer,
+    serialized_projector_info.size());
+  hash.add(center_line_resolution);
+  hash.add(use_waypoints);
+  hash.add(static_cast<uint64_t>(lanelet::autoware::version));
+
+  // the size of the file guards against the collisions of the hash
+  return fmt::format("{:016x}-{}", hash.value(), osm.size());
+}
+
+std::optional<autoware_map_msgs::msg::LaneletMapBin> load_lanelet2_map_cache(
+  const std::string & cache_path, const std::string & key)
+{
+  std::ifstream ifs(cache_path, std::ios::binary);
+  if (!ifs) {
+    return std::nullopt;
+  }
+
+  char magic[sizeof(cache_magic)];
+  uint32_t key_size = 0;
+  ifs.read(magic, sizeof(magic));
+  ifs.read(reinterpret_cast<char *>(&key_size), sizeof(key_size));
+  if (
+    !ifs || std::memcmp(magic, cache_magic, sizeof(cache_magic)) != 0 ||
+    key_size != key.size()) {
+    return std::nullopt;
+  }
+  std::string cached_key(key_size, '\0');
+  uint64_t payload_size = 0;
+  ifs.read(cached_key.data(), key_size);
+  ifs.read(reinterpret_cast<char *>(&payload_size), sizeof(payload_size));
+  if (!ifs || cached_key != key) {
+    return std::nullopt;
+  }
+
+  rclcpp::SerializedMessage serialized_msg(payload_size);
+  auto & rcl_serialized_msg = serialized_msg.get_rcl_serialized_message();
+  ifs.read(
+    reinterpret_cast<char *>(rcl_serialized_msg.buffer),
+    static_cast<std::streamsize>(payload_size));
+  if (!ifs) {
+    return std::nullopt;
+  }
+  rcl_serialized_msg.buffer_length = payload_size;
+
+  autoware_map_msgs::msg::LaneletMapBin map_bin_msg;
+  try {
+    rclcpp::Serialization<autoware_map_msgs::msg::LaneletMapBin>().deserialize_message(
+      &serialized_msg, &map_bin_msg);
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+  return map_bin_msg;
+}
+
+bool save_lanelet2_map_cache(
+  const std::string & cache_path, const std::string & key,
+  const autoware_map_msgs::msg::LaneletMapBin & map_bin_msg)
+{
+  const auto serialized_msg = serialize(map_bin_msg);
+  const auto key_size = static_cast<uint32_t>(key.size());
+  const auto payload_size = static_cast<uint64_t>(serialized_msg.size());
+
+  // write to a temporary file first, so that a reader never sees a partially written file.
+  // The name is unique, so that the loaders launched at the same time do not write the same file.
+  std::string temporary_path = cache_path + ".XXXXXX";
+  const int fd = ::mkstemp(temporary_path.data());
+  if (fd < 0) {
+    return false;
+  }
+  const auto & rcl_serialized_msg = serialized_msg.get_rcl_serialized_message();
+  const bool is_written =
+    write_all(fd, cache_magic, sizeof(cache_magic)) &&
+    write_all(fd, &key_size, sizeof(key_size)) && write_all(fd, key.data(), key_size) &&
+    write_all(fd, &payload_size, sizeof(payload_size)) &&
+    write_all(fd, rcl_serialized_msg.buffer, static_cast<size_t>(payload_size));
+  if (::close(fd) != 0 || !is_written) {
+    ::unlink(temporary_path.c_str());
+    return false;
+  }
+  std::error_code ec;
+  std::filesystem::rename(temporary_path, cache_path, ec);
+  if (ec) {
+    ::unlink(temporary_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+void overwrite_lanelets_centerline(
+  const lanelet::LaneletMapPtr & map, const double center_line_resolution,
+  const bool use_waypoints, const size_t thread_num)
+{
+  // with use_waypoints, the custom centerlines are kept as the waypoints and replaced as well
+  std::vector<lanelet::Lanelet> lanelets;
+  for (lanelet::Lanelet lanelet : map->laneletLayer) {
+    if (use_waypoints || !lanelet.hasCustomCenterline()) {
+      lanelets.push_back(lanelet);
+    }
+  }
+
+  // only the geometry is computed in parallel, since the IDs come from a global counter
+  std::vector<lanelet::BasicLineString3d> centerlines(lanelets.size());
+  const size_t worker_num =
+    std::clamp<size_t>(thread_num, 1, std::max<size_t>(lanelets.size(), 1));
+  std::vector<std::thread> workers;
+  for (size_t w = 0; w < worker_num; ++w) {
+    workers.emplace_back([&, w]() {
+      for (size_t i = w; i < lanelets.size(); i += worker_num) {
+        centerlines[i] = generate_fine_centerline_points(lanelets[i], center_line_resolution);
+      }
+    });
+  }
+  for (auto & worker : workers) {
+    worker.join();
+  }
+
+  // the lanelets are visited in the order of the lanelet layer, and the IDs are taken in the
+  // order of generateFineCenterline, the line string and then its points
+  for (size_t i = 0; i < lanelets.size(); ++i) {
+    if (lanelets[i].hasCustomCenterline()) {
+      lanelets[i].setAttribute("waypoints", lanelets[i].centerline().id());
+    }
+    lanelet::LineString3d centerline(lanelet::utils::getId());
+    for (const auto & point : centerlines[i]) {
+      centerline.push_back(lanelet::Point3d(lanelet::utils::getId(), point));
+    }
+    lanelets[i].setCenterline(centerline);
+  }
+}
+}  // namespace autoware::map_loader
@@ -0,0 +1,51 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LANELET2_MAP_LOADER__LANELET2_MAP_CACHE_HPP_
+#define LANELET2_MAP_LOADER__LANELET2_MAP_CACHE_HPP_
+
+#include <autoware_map_msgs/msg/lanelet_map_bin.hpp>
+#include <autoware_map_msgs/msg/map_projector_info.hpp>
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace autoware::map_loader
+{
+// The key of the processed map, which changes when the OSM file, the projection, the centerline
+// parameters or the version of the lanelet2 extension changes. It is empty if the OSM file cannot
+// be read.
+std::string compute_lanelet2_map_cache_key(
+  const std::string & lanelet2_filename,
+  const autoware_map_msgs::msg::MapProjectorInfo & projector_info,
+  const double center_line_resolution, const bool use_waypoints);
+
+// Return the cached map message, or std::nullopt if there is no cache with the key
+std::optional<autoware_map_msgs::msg::LaneletMapBin> load_lanelet2_map_cache(
+  const std::string & cache_path, const std::string & key);
+bool save_lanelet2_map_cache(
+  const std::string & cache_path, const std::string & key,
+  const autoware_map_msgs::msg::LaneletMapBin & map_bin_msg);
+
+// Same as overwriteLaneletsCenterline and overwriteLaneletsCenterlineWithWaypoints without
+// force_overwrite, except that the fine centerlines are generated on thread_num threads
+void overwrite_lanelets_centerline(
+  const lanelet::LaneletMapPtr & map, const double center_line_resolution,
+  const bool use_waypoints, const size_t thread_num);
+}  // namespace autoware::map_loader
+
+#endif  // LANELET2_MAP_LOADER__LANELET2_MAP_CACHE_HPP_
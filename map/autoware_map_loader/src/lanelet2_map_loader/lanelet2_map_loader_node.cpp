@@ -34,6 +34,7 @@
 #include "autoware/map_loader/lanelet2_map_loader_node.hpp"
 
 #include "lanelet2_local_projector.hpp"
+#include "lanelet2_map_cache.hpp"
 
 #include <autoware/geography_utils/lanelet2_projector.hpp>
 #include <autoware_lanelet2_extension/io/autoware_osm_parser.hpp>
@@ -48,6 +49,8 @@
 #include <lanelet2_io/Io.h>
 #include <lanelet2_projection/UTM.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -69,6 +72,8 @@ Lanelet2MapLoaderNode::Lanelet2MapLoaderNode(const rclcpp::NodeOptions & options
   declare_parameter<std::string>("lanelet2_map_path");
   declare_parameter<double>("center_line_resolution");
   declare_parameter<bool>("use_waypoints");
+  declare_parameter<std::string>("lanelet2_map_cache_path");
+  declare_parameter<int64_t>("thread_num");
 }
 
 void Lanelet2MapLoaderNode::on_map_projector_info(
@@ -78,6 +83,28 @@ void Lanelet2MapLoaderNode::on_map_projector_info(
   const auto lanelet2_filename = get_parameter("lanelet2_map_path").as_string();
   const auto center_line_resolution = get_parameter("center_line_resolution").as_double();
   const auto use_waypoints = get_parameter("use_waypoints").as_bool();
+  const auto lanelet2_map_cache_path = get_parameter("lanelet2_map_cache_path").as_string();
+  const auto thread_num =
+    static_cast<size_t>(std::max<int64_t>(get_parameter("thread_num").as_int(), 1));
+
+  // load the processed map from the cache
+  std::string cache_key;
+  if (!lanelet2_map_cache_path.empty()) {
+    cache_key = compute_lanelet2_map_cache_key(
+      lanelet2_filename, *msg, center_line_resolution, use_waypoints);
+    if (auto map_bin_msg = load_lanelet2_map_cache(lanelet2_map_cache_path, cache_key)) {
+      check_format_version(
+        map_bin_msg->version_map_format, lanelet2_filename, allow_unsupported_version);
+      map_bin_msg->header.stamp = now();
+      pub_map_bin_ =
+        create_publisher<VectorMap::Message>(VectorMap::name, rclcpp::QoS{1}.transient_local());
+      pub_map_bin_->publish(*map_bin_msg);
+      RCLCPP_INFO(
+        get_logger(), "Succeeded to load lanelet2_map from the cache %s. Map is published.",
+        lanelet2_map_cache_path.c_str());
+      return;
+    }
+  }
 
   // load map from file
   const auto map = load_map(lanelet2_filename, *msg);
@@ -89,6 +116,31 @@ void Lanelet2MapLoaderNode::on_map_projector_info(
   std::string format_version{"null"}, map_version{""};
   lanelet::io_handlers::AutowareOsmParser::parseVersions(
     lanelet2_filename, &format_version, &map_version);
+  check_format_version(format_version, lanelet2_filename, allow_unsupported_version);
+
+  // overwrite centerline
+  overwrite_lanelets_centerline(map, center_line_resolution, use_waypoints, thread_num);
+
+  // create map bin msg
+  const auto map_bin_msg = create_map_bin_msg(map, lanelet2_filename, now());
+  if (
+    !cache_key.empty() &&
+    !save_lanelet2_map_cache(lanelet2_map_cache_path, cache_key, map_bin_msg)) {
+    RCLCPP_WARN(
+      get_logger(), "Failed to save lanelet2_map to the cache %s", lanelet2_map_cache_path.c_str());
+  }
+
+  // create publisher and publish
+  pub_map_bin_ =
+    create_publisher<VectorMap::Message>(VectorMap::name, rclcpp::QoS{1}.transient_local());
+  pub_map_bin_->publish(map_bin_msg);
+  RCLCPP_INFO(get_logger(), "Succeeded to load lanelet2_map. Map is published.");
+}
+
+void Lanelet2MapLoaderNode::check_format_version(
+  const std::string & format_version, const std::string & lanelet2_filename,
+  const bool allow_unsupported_version) const
+{
   if (format_version == "null" || format_version.empty() || !isdigit(format_version[0])) {
     RCLCPP_WARN(
       get_logger(),
@@ -114,22 +166,6 @@ void Lanelet2MapLoaderNode::on_map_projector_info(
     }
   }
   RCLCPP_INFO(get_logger(), "Loaded map format_version: %s", format_version.c_str());
-
-  // overwrite centerline
-  if (use_waypoints) {
-    lanelet::utils::overwriteLaneletsCenterlineWithWaypoints(map, center_line_resolution, false);
-  } else {
-    lanelet::utils::overwriteLaneletsCenterline(map, center_line_resolution, false);
-  }
-
-  // create map bin msg
-  const auto map_bin_msg = create_map_bin_msg(map, lanelet2_filename, now());
-
-  // create publisher and publish
-  pub_map_bin_ =
-    create_publisher<VectorMap::Message>(VectorMap::name, rclcpp::QoS{1}.transient_local());
-  pub_map_bin_->publish(map_bin_msg);
-  RCLCPP_INFO(get_logger(), "Succeeded to load lanelet2_map. Map is published.");
 }
 
 lanelet::LaneletMapPtr Lanelet2MapLoaderNode::load_map(
@@ -0,0 +1,229 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "parallel_pcd_loader.hpp"
+
+#include <rclcpp/logging.hpp>
+
+#include <pcl/filters/voxel_grid.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace autoware::map_loader
+{
+namespace
+{
+// Call func(i) for every i in [0, task_num) on thread_num threads, which take the tasks in order
+template <typename Func>
+void run_in_parallel(const size_t task_num, const size_t thread_num, const Func & func)
+{
+  std::atomic<size_t> next_task{0};
+  const auto work = [&]() {
+    for (size_t i = next_task++; i < task_num; i = next_task++) {
+      func(i);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < std::min(thread_num, task_num); ++t) {
+    threads.emplace_back(work);
+  }
+  work();
+  for (auto & thread : threads) {
+    thread.join();
+  }
+}
+
+size_t get_data_size(const sensor_msgs::msg::PointCloud2 & header)
+{
+  return static_cast<size_t>(header.width) * header.height * header.point_step;
+}
+
+bool has_same_layout(
+  const sensor_msgs::msg::PointCloud2 & cloud, const sensor_msgs::msg::PointCloud2 & reference)
+{
+  if (
+    cloud.point_step != reference.point_step || cloud.fields.size() != reference.fields.size() ||
+    cloud.is_bigendian != reference.is_bigendian) {
+    return false;
+  }
+  for (size_t i = 0; i < cloud.fields.size(); ++i) {
+    const auto & field = cloud.fields[i];
+    const auto & reference_field = reference.fields[i];
+    if (
+      field.name != reference_field.name || field.offset != reference_field.offset ||
+      field.datatype != reference_field.datatype || field.count != reference_field.count) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+sensor_msgs::msg::PointCloud2 downsample(
+  const sensor_msgs::msg::PointCloud2 & msg_input, const float leaf_size)
+{
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
+  pcl::fromROSMsg(msg_input, *pcl_input);
+  pcl::VoxelGrid<pcl::PointXYZ> filter;
+  filter.setInputCloud(pcl_input);
+  filter.setLeafSize(leaf_size, leaf_size, leaf_size);
+  filter.filter(*pcl_output);
+
+  sensor_msgs::msg::PointCloud2 msg_output;
+  pcl::toROSMsg(*pcl_output, msg_output);
+  msg_output.header = msg_input.header;
+  return msg_output;
+}
+
+sensor_msgs::msg::PointCloud2 load_pcd_files_in_parallel(
+  const std::vector<std::string> & pcd_paths, const boost::optional<float> leaf_size,
+  const size_t thread_num, const rclcpp::Logger & logger, PcdLoadStatistics & statistics)
+{
+  const auto start_time = std::chrono::steady_clock::now();
+  const size_t file_num = pcd_paths.size();
+  const size_t worker_num = std::max<size_t>(thread_num, 1);
+
+  sensor_msgs::msg::PointCloud2 whole_pcd;
+  whole_pcd.header.frame_id = "map";
+  whole_pcd.height = 1;
+  whole_pcd.is_dense = true;
+
+  // read the headers to lay out the output buffer, where a file without points takes no space
+  std::vector<sensor_msgs::msg::PointCloud2> headers(file_num);
+  std::vector<uint8_t> is_header_valid(file_num, false);
+  run_in_parallel(file_num, worker_num, [&](const size_t i) {
+    pcl::PCDReader reader;
+    pcl::PCLPointCloud2 header;
+    if (reader.readHeader(pcd_paths[i], header) == 0) {
+      pcl_conversions::fromPCL(header, headers[i]);
+      is_header_valid[i] = true;
+    }
+  });
+
+  std::vector<size_t> offsets(file_num, 0);
+  if (!leaf_size) {
+    const auto reference =
+      std::find(is_header_valid.begin(), is_header_valid.end(), 1) - is_header_valid.begin();
+    if (reference < static_cast<ptrdiff_t>(file_num)) {
+      whole_pcd.fields = headers[reference].fields;
+      whole_pcd.point_step = headers[reference].point_step;
+      whole_pcd.is_bigendian = headers[reference].is_bigendian;
+    }
+
+    size_t data_size = 0;
+    for (size_t i = 0; i < file_num; ++i) {
+      if (!is_header_valid[i] || !has_same_layout(headers[i], whole_pcd)) {
+        is_header_valid[i] = false;
+        continue;
+      }
+      offsets[i] = data_size;
+      data_size += get_data_size(headers[i]);
+    }
+    whole_pcd.data.resize(data_size);
+  }
+
+  // load the files, and copy them to the output buffer unless they are downsampled
+  std::vector<size_t> sizes(file_num, 0);
+  std::vector<sensor_msgs::msg::PointCloud2> downsampled_pcds(leaf_size ? file_num : 0);
+  std::atomic<size_t> processed_num{0};
+  std::atomic<bool> is_dense{true};
+  run_in_parallel(file_num, worker_num, [&](const size_t i) {
+    const auto & path = pcd_paths[i];
+    sensor_msgs::msg::PointCloud2 partial_pcd;
+    if (!is_header_valid[i] && !leaf_size) {
+      RCLCPP_ERROR_STREAM(logger, "PCD header is invalid or its layout differs: " << path);
+    } else if (pcl::io::loadPCDFile(path, partial_pcd) == -1) {
+      RCLCPP_ERROR_STREAM(logger, "PCD load failed: " << path);
+    } else if (leaf_size) {
+      downsampled_pcds[i] = downsample(partial_pcd, leaf_size.get());
+      sizes[i] = downsampled_pcds[i].data.size();
+      if (!downsampled_pcds[i].is_dense) {
+        is_dense = false;
+      }
+    } else if (
+      !has_same_layout(partial_pcd, whole_pcd) ||
+      partial_pcd.data.size() != get_data_size(headers[i])) {
+      RCLCPP_ERROR_STREAM(logger, "PCD layout differs from its header: " << path);
+    } else if (!partial_pcd.data.empty()) {
+      std::memcpy(&whole_pcd.data[offsets[i]], partial_pcd.data.data(), partial_pcd.data.size());
+      sizes[i] = partial_pcd.data.size();
+      if (!partial_pcd.is_dense) {
+        is_dense = false;
+      }
+    }
+
+    const size_t processed = ++processed_num;
+    if (processed % std::max<size_t>(file_num / 10, 1) == 0) {
+      RCLCPP_INFO(logger, "Loaded %zu out of %zu PCD files", processed, file_num);
+    }
+  });
+
+  size_t data_size = 0;
+  if (leaf_size) {
+    // the downsampled files are small, so they are concatenated after they are all ready
+    for (size_t i = 0; i < file_num; ++i) {
+      if (sizes[i] > 0 && whole_pcd.fields.empty()) {
+        whole_pcd.fields = downsampled_pcds[i].fields;
+        whole_pcd.point_step = downsampled_pcds[i].point_step;
+        whole_pcd.is_bigendian = downsampled_pcds[i].is_bigendian;
+      }
+      data_size += sizes[i];
+    }
+    whole_pcd.data.resize(data_size);
+    data_size = 0;
+    for (size_t i = 0; i < file_num; ++i) {
+      if (sizes[i] > 0) {
+        std::memcpy(&whole_pcd.data[data_size], downsampled_pcds[i].data.data(), sizes[i]);
+      }
+      data_size += sizes[i];
+    }
+  } else {
+    // close the gaps left by the files which failed to load
+    for (size_t i = 0; i < file_num; ++i) {
+      if (sizes[i] > 0 && offsets[i] != data_size) {
+        std::memmove(&whole_pcd.data[data_size], &whole_pcd.data[offsets[i]], sizes[i]);
+      }
+      data_size += sizes[i];
+    }
+    whole_pcd.data.resize(data_size);
+  }
+
+  whole_pcd.width = whole_pcd.point_step == 0 ? 0 : data_size / whole_pcd.point_step;
+  whole_pcd.row_step = data_size;
+  whole_pcd.is_dense = is_dense;
+
+  statistics.loaded_file_num = std::count_if(sizes.begin(), sizes.end(), [](size_t size) {
+    return size > 0;
+  });
+  statistics.failed_file_num = file_num - statistics.loaded_file_num;
+  statistics.point_num = whole_pcd.width;
+  statistics.byte_num = data_size;
+  statistics.elapsed_sec =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+  return whole_pcd;
+}
+}  // namespace autoware::map_loader
@@ -0,0 +1,52 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_LOADER__PARALLEL_PCD_LOADER_HPP_
+#define POINTCLOUD_MAP_LOADER__PARALLEL_PCD_LOADER_HPP_
+
+#include <rclcpp/logger.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace autoware::map_loader
+{
+struct PcdLoadStatistics
+{
+  size_t loaded_file_num{0};
+  size_t failed_file_num{0};
+  size_t point_num{0};
+  size_t byte_num{0};
+  double elapsed_sec{0.0};
+};
+
+sensor_msgs::msg::PointCloud2 downsample(
+  const sensor_msgs::msg::PointCloud2 & msg_input, const float leaf_size);
+
+// Load the PCD files on thread_num threads and concatenate them in the order of pcd_paths.
+// Without downsampling, the output buffer is sized from the PCD headers and every file is copied
+// to its place as soon as it is loaded. The files whose layout differs from the first one, or
+// which fail to load, are skipped. The numbers of the loaded files, points and bytes and the
+// elapsed time are returned in statistics.
+sensor_msgs::msg::PointCloud2 load_pcd_files_in_parallel(
+  const std::vector<std::string> & pcd_paths, const boost::optional<float> leaf_size,
+  const size_t thread_num, const rclcpp::Logger & logger, PcdLoadStatistics & statistics);
+}  // namespace autoware::map_loader
+
+#endif  // POINTCLOUD_MAP_LOADER__PARALLEL_PCD_LOADER_HPP_
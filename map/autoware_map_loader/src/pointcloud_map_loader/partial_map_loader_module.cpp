@@ -14,15 +14,23 @@
 
 #include "partial_map_loader_module.hpp"
 
+#include <chrono>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
 namespace autoware::map_loader
 {
 PartialMapLoaderModule::PartialMapLoaderModule(
-  rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict)
-: logger_(node->get_logger()), all_pcd_file_metadata_dict_(std::move(pcd_file_metadata_dict))
+  rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict,
+  std::shared_ptr<PointCloudMapCellCache> cell_cache)
+: logger_(node->get_logger()),
+  clock_(node->get_clock()),
+  pcd_file_metadata_index_(pcd_file_metadata_dict),
+  cell_cache_(cell_cache ? std::move(cell_cache) : std::make_shared<PointCloudMapCellCache>("", 0)),
+  diagnostics_(std::make_unique<autoware_utils_diagnostics::DiagnosticsInterface>(
+    node, "partial_map_loader_status"))
 {
   get_partial_pcd_maps_service_ = node->create_service<GetPartialPointCloudMap>(
     "service/get_partial_pcd_map",
@@ -35,17 +43,14 @@ void PartialMapLoaderModule::partial_area_load(
   const autoware_map_msgs::msg::AreaInfo & area,
   const GetPartialPointCloudMap::Response::SharedPtr & response) const
 {
-  // iterate over all the available pcd map grids
-  for (const auto & ele : all_pcd_file_metadata_dict_) {
-    std::string path = ele.first;
-    PCDFileMetadata metadata = ele.second;
+  // iterate over the pcd map grids around the queried area
+  for (const size_t index : pcd_file_metadata_index_.query(area)) {
+    const std::string & path = pcd_file_metadata_index_.id(index);
+    const PCDFileMetadata & metadata = pcd_file_metadata_index_.metadata(index);
 
     // assume that the map ID = map path (for now)
     const std::string & map_id = path;
 
-    // skip if the pcd file is not within the queried area
-    if (!is_grid_within_queried_area(area, metadata)) continue;
-
     autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id =
       load_point_cloud_map_cell_with_id(path, map_id);
     pointcloud_map_cell_with_id.metadata.min_x = metadata.min.x;
@@ -61,9 +66,14 @@ bool PartialMapLoaderModule::on_service_get_partial_point_cloud_map(
   GetPartialPointCloudMap::Request::SharedPtr req,
   GetPartialPointCloudMap::Response::SharedPtr res) const
 {
+  const auto start_time = std::chrono::steady_clock::now();
   auto area = req->area;
   partial_area_load(area, res);
   res->header.frame_id = "map";
+  publish_diagnostics(
+    res->new_pointcloud_with_ids.size(),
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time)
+      .count());
   return true;
 }
 
@@ -71,13 +81,29 @@ autoware_map_msgs::msg::PointCloudMapCellWithID
 PartialMapLoaderModule::load_point_cloud_map_cell_with_id(
   const std::string & path, const std::string & map_id) const
 {
-  sensor_msgs::msg::PointCloud2 pcd;
-  if (pcl::io::loadPCDFile(path, pcd) == -1) {
+  autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id;
+  const auto pcd = cell_cache_->load(path);
+  if (pcd) {
+    pointcloud_map_cell_with_id.pointcloud = *pcd;
+  } else {
     RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
   }
-  autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id;
-  pointcloud_map_cell_with_id.pointcloud = pcd;
   pointcloud_map_cell_with_id.cell_id = map_id;
   return pointcloud_map_cell_with_id;
 }
+
+void PartialMapLoaderModule::publish_diagnostics(
+  const size_t served_cell_num, const double serve_latency_ms) const
+{
+  const auto statistics = cell_cache_->get_statistics();
+  diagnostics_->clear();
+  diagnostics_->add_key_value("served_cell_num", served_cell_num);
+  diagnostics_->add_key_value("serve_latency_ms", serve_latency_ms);
+  diagnostics_->add_key_value("memory_hit_num", statistics.memory_hit_num);
+  diagnostics_->add_key_value("disk_hit_num", statistics.disk_hit_num);
+  diagnostics_->add_key_value("miss_num", statistics.miss_num);
+  diagnostics_->add_key_value("memory_usage", statistics.memory_usage);
+  diagnostics_->add_key_value("memory_cell_num", statistics.memory_cell_num);
+  diagnostics_->publish(clock_->now());
+}
 }  // namespace autoware::map_loader
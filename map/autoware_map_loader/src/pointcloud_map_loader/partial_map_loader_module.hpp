@@ -15,8 +15,12 @@
 #ifndef POINTCLOUD_MAP_LOADER__PARTIAL_MAP_LOADER_MODULE_HPP_
 #define POINTCLOUD_MAP_LOADER__PARTIAL_MAP_LOADER_MODULE_HPP_
 
+#include "point_cloud_map_cell_cache.hpp"
+#include "pcd_file_metadata_index.hpp"
 #include "utils.hpp"
 
+#include <autoware_utils_diagnostics/diagnostics_interface.hpp>
+
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_map_msgs/srv/get_partial_point_cloud_map.hpp>
@@ -29,6 +33,7 @@
 #include <pcl_conversions/pcl_conversions.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -40,13 +45,17 @@ class PartialMapLoaderModule
 
 public:
   explicit PartialMapLoaderModule(
-    rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict);
+    rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict,
+    std::shared_ptr<PointCloudMapCellCache> cell_cache = nullptr);
 
 private:
   rclcpp::Logger logger_;
+  rclcpp::Clock::SharedPtr clock_;
 
-  std::map<std::string, PCDFileMetadata> all_pcd_file_metadata_dict_;
+  PCDFileMetadataIndex pcd_file_metadata_index_;
   rclcpp::Service<GetPartialPointCloudMap>::SharedPtr get_partial_pcd_maps_service_;
+  std::shared_ptr<PointCloudMapCellCache> cell_cache_;
+  std::unique_ptr<autoware_utils_diagnostics::DiagnosticsInterface> diagnostics_;
 
   [[nodiscard]] bool on_service_get_partial_point_cloud_map(
     GetPartialPointCloudMap::Request::SharedPtr req,
@@ -56,6 +65,7 @@ private:
     const GetPartialPointCloudMap::Response::SharedPtr & response) const;
   [[nodiscard]] autoware_map_msgs::msg::PointCloudMapCellWithID load_point_cloud_map_cell_with_id(
     const std::string & path, const std::string & map_id) const;
+  void publish_diagnostics(const size_t served_cell_num, const double serve_latency_ms) const;
 };
 }  // namespace autoware::map_loader
 
@@ -0,0 +1,165 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "pcd_file_metadata_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::map_loader
+{
+namespace
+{
+// The query range is widened by this margin [m], so that the rounding errors of the grid never
+// drop an entry which is_grid_within_queried_area accepts
+constexpr double query_margin = 1e-3;
+
+bool has_finite_bounds(const PCDFileMetadata & metadata)
+{
+  return std::isfinite(metadata.min.x) && std::isfinite(metadata.min.y) &&
+         std::isfinite(metadata.max.x) && std::isfinite(metadata.max.y) &&
+         metadata.min.x <= metadata.max.x && metadata.min.y <= metadata.max.y;
+}
+}  // namespace
+
+PCDFileMetadataIndex::PCDFileMetadataIndex(
+  const std::map<std::string, PCDFileMetadata> & pcd_file_metadata_dict)
+: entries_(pcd_file_metadata_dict.begin(), pcd_file_metadata_dict.end())
+{
+  id_to_index_.reserve(entries_.size());
+  std::vector<size_t> indexed_entries;
+  std::vector<double> extents;
+  double max_x = std::numeric_limits<double>::lowest();
+  double max_y = std::numeric_limits<double>::lowest();
+  origin_x_ = std::numeric_limits<double>::max();
+  origin_y_ = std::numeric_limits<double>::max();
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const auto & metadata = entries_[i].second;
+    id_to_index_.emplace(entries_[i].first, i);
+    if (!has_finite_bounds(metadata)) {
+      unindexed_entries_.push_back(i);
+      continue;
+    }
+    indexed_entries.push_back(i);
+    extents.push_back(std::max(metadata.max.x - metadata.min.x, metadata.max.y - metadata.min.y));
+    origin_x_ = std::min<double>(origin_x_, metadata.min.x);
+    origin_y_ = std::min<double>(origin_y_, metadata.min.y);
+    max_x = std::max<double>(max_x, metadata.max.x);
+    max_y = std::max<double>(max_y, metadata.max.y);
+  }
+  if (indexed_entries.empty()) {
+    return;
+  }
+
+  // the cells are as large as a typical tile, and are enlarged when the map is sparse
+  std::nth_element(extents.begin(), extents.begin() + extents.size() / 2, extents.end());
+  cell_size_ = std::max(extents[extents.size() / 2], 1.0);
+  const double max_cell_num = 4.0 * static_cast<double>(indexed_entries.size()) + 16.0;
+  while (std::floor((max_x - origin_x_) / cell_size_ + 1.0) *
+           std::floor((max_y - origin_y_) / cell_size_ + 1.0) >
+         max_cell_num) {
+    cell_size_ *= 2.0;
+  }
+  grid_width_ = static_cast<int>(std::floor((max_x - origin_x_) / cell_size_)) + 1;
+  grid_height_ = static_cast<int>(std::floor((max_y - origin_y_) / cell_size_)) + 1;
+
+  const auto to_cell_range = [this](const PCDFileMetadata & metadata) {
+    return std::make_pair(
+      std::make_pair(
+        static_cast<int>(std::floor((metadata.min.x - origin_x_) / cell_size_)),
+        static_cast<int>(std::floor((metadata.max.x - origin_x_) / cell_size_))),
+      std::make_pair(
+        static_cast<int>(std::floor((metadata.min.y - origin_y_) / cell_size_)),
+        static_cast<int>(std::floor((metadata.max.y - origin_y_) / cell_size_))));
+  };
+
+  // count the entries per cell, and then fill them in the order of the entries
+  cell_begins_.assign(static_cast<size_t>(grid_width_) * grid_height_ + 1, 0);
+  for (const size_t i : indexed_entries) {
+    const auto [x_range, y_range] = to_cell_range(entries_[i].second);
+    for (int y = y_range.first; y <= y_range.second; ++y) {
+      for (int x = x_range.first; x <= x_range.second; ++x) {
+        ++cell_begins_[static_cast<size_t>(y) * grid_width_ + x + 1];
+      }
+    }
+  }
+  for (size_t c = 1; c < cell_begins_.size(); ++c) {
+    cell_begins_[c] += cell_begins_[c - 1];
+  }
+  cell_entries_.resize(cell_begins_.back());
+  std::vector<size_t> cell_fill(cell_begins_.begin(), cell_begins_.end() - 1);
+  for (const size_t i : indexed_entries) {
+    const auto [x_range, y_range] = to_cell_range(entries_[i].second);
+    for (int y = y_range.first; y <= y_range.second; ++y) {
+      for (int x = x_range.first; x <= x_range.second; ++x) {
+        cell_entries_[cell_fill[static_cast<size_t>(y) * grid_width_ + x]++] = i;
+      }
+    }
+  }
+}
+
+std::optional<size_t> PCDFileMetadataIndex::find(const std::string & id) const
+{
+  const auto it = id_to_index_.find(id);
+  if (it == id_to_index_.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+std::vector<size_t> PCDFileMetadataIndex::query(const autoware_map_msgs::msg::AreaInfo & area) const
+{
+  // a cylinder overlaps a box when its center is in the box expanded by its radius, so only the
+  // boxes which overlap the square around the center can be accepted
+  const auto to_cell_range = [this](
+                               const double lower, const double upper, const double origin,
+                               const int cell_num) {
+    const double lower_cell = std::floor((lower - query_margin - origin) / cell_size_);
+    const double upper_cell = std::floor((upper + query_margin - origin) / cell_size_);
+    if (!(lower_cell <= upper_cell) || upper_cell < 0.0 || lower_cell >= cell_num) {
+      return std::make_pair(0, -1);
+    }
+    return std::make_pair(
+      static_cast<int>(std::max(lower_cell, 0.0)),
+      static_cast<int>(std::min(upper_cell, cell_num - 1.0)));
+  };
+  const auto x_range = to_cell_range(
+    area.center_x - area.radius, area.center_x + area.radius, origin_x_, grid_width_);
+  const auto y_range = to_cell_range(
+    area.center_y - area.radius, area.center_y + area.radius, origin_y_, grid_height_);
+
+  std::vector<size_t> candidates = unindexed_entries_;
+  for (int y = y_range.first; y <= y_range.second; ++y) {
+    const size_t row = static_cast<size_t>(y) * grid_width_;
+    candidates.insert(
+      candidates.end(), cell_entries_.begin() + cell_begins_[row + x_range.first],
+      cell_entries_.begin() + cell_begins_[row + x_range.second + 1]);
+  }
+
+  // an entry which spans several cells appears once per cell
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  candidates.erase(
+    std::remove_if(
+      candidates.begin(), candidates.end(),
+      [&](const size_t i) { return !is_grid_within_queried_area(area, entries_[i].second); }),
+    candidates.end());
+  return candidates;
+}
+}  // namespace autoware::map_loader
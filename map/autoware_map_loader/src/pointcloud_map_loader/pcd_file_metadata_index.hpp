@@ -0,0 +1,68 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_LOADER__PCD_FILE_METADATA_INDEX_HPP_
+#define POINTCLOUD_MAP_LOADER__PCD_FILE_METADATA_INDEX_HPP_
+
+#include "utils.hpp"
+
+#include <autoware_map_msgs/msg/area_info.hpp>
+
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace autoware::map_loader
+{
+// The PCD file metadata, indexed by their IDs and by a uniform 2D grid over their bounding boxes.
+// The entries keep the order of the dictionary, so the results of the queries are the same as a
+// scan over the dictionary.
+class PCDFileMetadataIndex
+{
+public:
+  explicit PCDFileMetadataIndex(
+    const std::map<std::string, PCDFileMetadata> & pcd_file_metadata_dict);
+
+  size_t size() const { return entries_.size(); }
+  const std::string & id(const size_t index) const { return entries_[index].first; }
+  const PCDFileMetadata & metadata(const size_t index) const { return entries_[index].second; }
+
+  std::optional<size_t> find(const std::string & id) const;
+
+  // Return the indices of the entries which satisfy is_grid_within_queried_area, in ascending order
+  std::vector<size_t> query(const autoware_map_msgs::msg::AreaInfo & area) const;
+
+private:
+  std::vector<std::pair<std::string, PCDFileMetadata>> entries_;
+  std::unordered_map<std::string, size_t> id_to_index_;
+
+  double origin_x_{0.0};
+  double origin_y_{0.0};
+  double cell_size_{1.0};
+  int grid_width_{0};
+  int grid_height_{0};
+  // the entries in the cell (x, y) are cell_entries_[cell_begins_[c]:cell_begins_[c + 1]], where
+  // c = y * grid_width_ + x
+  std::vector<size_t> cell_begins_;
+  std::vector<size_t> cell_entries_;
+  // the entries whose bounding boxes are not finite, which are checked by every query
+  std::vector<size_t> unindexed_entries_;
+};
+}  // namespace autoware::map_loader
+
+#endif  // POINTCLOUD_MAP_LOADER__PCD_FILE_METADATA_INDEX_HPP_
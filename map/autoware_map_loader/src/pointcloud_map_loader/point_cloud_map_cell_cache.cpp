@@ -0,0 +1,438 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "point_cloud_map_cell_cache.hpp"
+
+#include <pcl/io/pcd_io.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <fcntl.h>
+#include <fmt/format.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace autoware::map_loader
+{
+namespace fs = std::filesystem;
+
+namespace
+{
+constexpr char cache_magic[8] = {'A', 'W', 'P', 'C', 'C', 'E', 'L', '1'};
+
+// The size and the modification time of a PCD, which invalidate its cache file when they change
+struct SourceStamp
+{
+  uint64_t size{0};
+  int64_t mtime{0};
+};
+
+bool get_source_stamp(const std::string & pcd_path, SourceStamp & stamp)
+{
+  std::error_code ec;
+  stamp.size = fs::file_size(pcd_path, ec);
+  if (ec) {
+    return false;
+  }
+  stamp.mtime = fs::last_write_time(pcd_path, ec).time_since_epoch().count();
+  return !ec;
+}
+
+bool write_all(const int fd, const uint8_t * data, size_t size)
+{
+  while (size > 0) {
+    const ssize_t written = ::write(fd, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += written;
+    size -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+class Writer
+{
+public:
+  template <typename T>
+  void write(const T & value)
+  {
+    const auto * bytes = reinterpret_cast<const uint8_t *>(&value);
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(T));
+  }
+
+  void write_string(const std::string & value)
+  {
+    write(static_cast<uint32_t>(value.size()));
+    buffer_.insert(buffer_.end(), value.begin(), value.end());
+  }
+
+  const std::vector<uint8_t> & buffer() const { return buffer_; }
+
+private:
+  std::vector<uint8_t> buffer_;
+};
+
+// Reads from a mapped file, failing instead of reading past its end
+class Reader
+{
+public:
+  Reader(const uint8_t * data, const size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool read(T & value)
+  {
+    if (size_ - position_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_ + position_, sizeof(T));
+    position_ += sizeof(T);
+    return true;
+  }
+
+  bool read_string(std::string & value)
+  {
+    uint32_t length = 0;
+    if (!read(length) || size_ - position_ < length) {
+      return false;
+    }
+    value.assign(reinterpret_cast<const char *>(data_ + position_), length);
+    position_ += length;
+    return true;
+  }
+
+  bool read_bytes(std::vector<uint8_t> & value, const size_t length)
+  {
+    if (size_ - position_ < length) {
+      return false;
+    }
+    value.resize(length);
+    if (length > 0) {
+      std::memcpy(value.data(), data_ + position_, length);
+    }
+    position_ += length;
+    return true;
+  }
+
+private:
+  const uint8_t * data_;
+  size_t size_;
+  size_t position_{0};
+};
+
+// A read-only mapping of a whole file
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string & path)
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+    struct stat file_stat
+    {
+    };
+    if (::fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      void * data =
+        ::mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data != MAP_FAILED) {
+        data_ = static_cast<const uint8_t *>(data);
+        size_ = static_cast<size_t>(file_stat.st_size);
+      }
+    }
+    ::close(fd);
+  }
+  ~MappedFile()
+  {
+    if (data_) {
+      ::munmap(const_cast<uint8_t *>(data_), size_);
+    }
+  }
+  MappedFile(const MappedFile &) = delete;
+  MappedFile & operator=(const MappedFile &) = delete;
+
+  const uint8_t * data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  const uint8_t * data_{nullptr};
+  size_t size_{0};
+};
+}  // namespace
+
+PointCloudMapCellCache::PointCloudMapCellCache(
+  std::string cache_directory, const size_t memory_limit)
+: cache_directory_(std::move(cache_directory)), memory_limit_(memory_limit)
+{
+  if (!cache_directory_.empty()) {
+    std::error_code ec;
+    fs::create_directories(cache_directory_, ec);
+    writer_thread_ = std::thread(&PointCloudMapCellCache::write_loop, this);
+  }
+}
+
+PointCloudMapCellCache::~PointCloudMapCellCache()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    is_stopped_ = true;
+  }
+  write_cv_.notify_all();
+
+  if (writer_thread_.joinable()) {
+    writer_thread_.join();
+  }
+}
+
+PointCloudMapCellCache::PointCloud2ConstSharedPtr PointCloudMapCellCache::load(
+  const std::string & pcd_path)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = lru_index_.find(pcd_path);
+    if (it != lru_index_.end()) {
+      lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
+      ++statistics_.memory_hit_num;
+      return it->second->second;
+    }
+  }
+
+  auto cloud = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  const std::string cache_path = get_cache_path(pcd_path);
+  if (!cache_path.empty() && read_cache_file(cache_path, pcd_path, *cloud)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++statistics_.disk_hit_num;
+  } else {
+    if (pcl::io::loadPCDFile(pcd_path, *cloud) == -1) {
+      return nullptr;
+    }
+    if (!cache_path.empty()) {
+      request_write(pcd_path, cloud);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++statistics_.miss_num;
+  }
+
+  insert_to_memory(pcd_path, cloud);
+  return cloud;
+}
+
+PointCloudMapCellCacheStatistics PointCloudMapCellCache::get_statistics() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+void PointCloudMapCellCache::wait_for_pending_writes()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  write_cv_.wait(lock, [this] { return pending_write_paths_.empty() || is_stopped_; });
+}
+
+void PointCloudMapCellCache::request_write(
+  const std::string & pcd_path, const PointCloud2ConstSharedPtr & cloud)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    // the cloud is already being written by a previous miss of the same PCD
+    if (!pending_write_paths_.insert(pcd_path).second) {
+      return;
+    }
+    write_queue_.emplace_back(pcd_path, cloud);
+  }
+  write_cv_.notify_all();
+}
+
+void PointCloudMapCellCache::write_loop()
+{
+  while (true) {
+    std::pair<std::string, PointCloud2ConstSharedPtr> request;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      write_cv_.wait(lock, [this] { return is_stopped_ || !write_queue_.empty(); });
+      if (is_stopped_) {
+        return;
+      }
+      request = std::move(write_queue_.front());
+      write_queue_.pop_front();
+    }
+
+    write_cache_file(get_cache_path(request.first), request.first, *request.second);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      pending_write_paths_.erase(request.first);
+    }
+    write_cv_.notify_all();
+  }
+}
+
+std::string PointCloudMapCellCache::get_cache_path(const std::string & pcd_path) const
+{
+  if (cache_directory_.empty()) {
+    return "";
+  }
+  // the PCD path is also stored in the file, which resolves the collisions of the hash
+  const auto hash = std::hash<std::string>{}(pcd_path);
+  return (fs::path(cache_directory_) / fmt::format("{:016x}.cell", hash)).string();
+}
+
+void PointCloudMapCellCache::insert_to_memory(
+  const std::string & pcd_path, const PointCloud2ConstSharedPtr & cloud)
+{
+  const size_t cloud_size = cloud->data.size();
+  if (cloud_size > memory_limit_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (lru_index_.count(pcd_path) > 0) {
+    return;
+  }
+  while (!lru_list_.empty() && statistics_.memory_usage + cloud_size > memory_limit_) {
+    statistics_.memory_usage -= lru_list_.back().second->data.size();
+    lru_index_.erase(lru_list_.back().first);
+    lru_list_.pop_back();
+  }
+  lru_list_.emplace_front(pcd_path, cloud);
+  lru_index_[pcd_path] = lru_list_.begin();
+  statistics_.memory_usage += cloud_size;
+  statistics_.memory_cell_num = lru_list_.size();
+}
+
+bool PointCloudMapCellCache::write_cache_file(
+  const std::string & cache_path, const std::string & pcd_path,
+  const sensor_msgs::msg::PointCloud2 & cloud)
+{
+  SourceStamp stamp;
+  if (!get_source_stamp(pcd_path, stamp)) {
+    return false;
+  }
+
+  Writer writer;
+  for (const char c : cache_magic) {
+    writer.write(c);
+  }
+  writer.write(stamp.size);
+  writer.write(stamp.mtime);
+  writer.write_string(pcd_path);
+  writer.write(cloud.height);
+  writer.write(cloud.width);
+  writer.write(cloud.point_step);
+  writer.write(cloud.row_step);
+  writer.write(static_cast<uint8_t>(cloud.is_bigendian));
+  writer.write(static_cast<uint8_t>(cloud.is_dense));
+  writer.write(static_cast<uint32_t>(cloud.fields.size()));
+  for (const auto & field : cloud.fields) {
+    writer.write_string(field.name);
+    writer.write(field.offset);
+    writer.write(field.datatype);
+    writer.write(field.count);
+  }
+  writer.write(static_cast<uint64_t>(cloud.data.size()));
+
+  // write to a temporary file first, so that a reader never sees a partially written file.
+  // The name is unique, so that the processes sharing the directory do not write the same file.
+  std::string temporary_path = cache_path + ".XXXXXX";
+  const int fd = ::mkstemp(temporary_path.data());
+  if (fd < 0) {
+    return false;
+  }
+  const bool is_written = write_all(fd, writer.buffer().data(), writer.buffer().size()) &&
+                          write_all(fd, cloud.data.data(), cloud.data.size());
+  if (::close(fd) != 0 || !is_written) {
+    ::unlink(temporary_path.c_str());
+    return false;
+  }
+  std::error_code ec;
+  fs::rename(temporary_path, cache_path, ec);
+  if (ec) {
+    ::unlink(temporary_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool PointCloudMapCellCache::read_cache_file(
+  const std::string & cache_path, const std::string & pcd_path,
+  sensor_msgs::msg::PointCloud2 & cloud)
+{
+  const MappedFile file(cache_path);
+  if (!file.data()) {
+    return false;
+  }
+  Reader reader(file.data(), file.size());
+
+  char magic[sizeof(cache_magic)];
+  for (char & c : magic) {
+    if (!reader.read(c)) {
+      return false;
+    }
+  }
+  if (std::memcmp(magic, cache_magic, sizeof(cache_magic)) != 0) {
+    return false;
+  }
+
+  SourceStamp stamp;
+  SourceStamp current_stamp;
+  std::string source_path;
+  if (
+    !reader.read(stamp.size) || !reader.read(stamp.mtime) || !reader.read_string(source_path) ||
+    source_path != pcd_path || !get_source_stamp(pcd_path, current_stamp) ||
+    stamp.size != current_stamp.size || stamp.mtime != current_stamp.mtime) {
+    return false;
+  }
+
+  uint8_t is_bigendian = 0;
+  uint8_t is_dense = 0;
+  uint32_t field_num = 0;
+  if (
+    !reader.read(cloud.height) || !reader.read(cloud.width) || !reader.read(cloud.point_step) ||
+    !reader.read(cloud.row_step) || !reader.read(is_bigendian) || !reader.read(is_dense) ||
+    !reader.read(field_num)) {
+    return false;
+  }
+  cloud.is_bigendian = is_bigendian;
+  cloud.is_dense = is_dense;
+
+  cloud.fields.clear();
+  for (uint32_t i = 0; i < field_num; ++i) {
+    sensor_msgs::msg::PointField field;
+    if (
+      !reader.read_string(field.name) || !reader.read(field.offset) ||
+      !reader.read(field.datatype) || !reader.read(field.count)) {
+      return false;
+    }
+    cloud.fields.push_back(field);
+  }
+
+  uint64_t data_size = 0;
+  return reader.read(data_size) && reader.read_bytes(cloud.data, data_size);
+}
+}  // namespace autoware::map_loader
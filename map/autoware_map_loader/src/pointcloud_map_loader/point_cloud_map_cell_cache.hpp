@@ -0,0 +1,102 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef POINTCLOUD_MAP_LOADER__POINT_CLOUD_MAP_CELL_CACHE_HPP_
+#define POINTCLOUD_MAP_LOADER__POINT_CLOUD_MAP_CELL_CACHE_HPP_
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace autoware::map_loader
+{
+struct PointCloudMapCellCacheStatistics
+{
+  size_t memory_hit_num{0};
+  size_t disk_hit_num{0};
+  size_t miss_num{0};
+  size_t memory_usage{0};
+  size_t memory_cell_num{0};
+};
+
+// The point clouds of the map cells, kept at two levels:
+// - an LRU of the recently served clouds in memory, bounded by memory_limit bytes
+// - a binary file per PCD in cache_directory, which holds the ready-to-publish PointCloud2. The
+//   file is mapped with mmap and its data is copied once into the message, which is much cheaper
+//   than parsing the PCD. It is written by a background thread when its PCD is parsed for the
+//   first time, and written again when the PCD is modified.
+// An empty cache_directory disables the files and a memory_limit of 0 disables the LRU.
+class PointCloudMapCellCache
+{
+public:
+  using PointCloud2ConstSharedPtr = std::shared_ptr<const sensor_msgs::msg::PointCloud2>;
+
+  PointCloudMapCellCache(std::string cache_directory, const size_t memory_limit);
+  // The files not written yet are discarded, they are written again when the PCDs are loaded
+  ~PointCloudMapCellCache();
+
+  PointCloudMapCellCache(const PointCloudMapCellCache &) = delete;
+  PointCloudMapCellCache & operator=(const PointCloudMapCellCache &) = delete;
+
+  // Return the cloud of the PCD, or nullptr if it cannot be loaded
+  PointCloud2ConstSharedPtr load(const std::string & pcd_path);
+
+  PointCloudMapCellCacheStatistics get_statistics() const;
+
+  // Wait until the files of the PCDs loaded so far are written
+  void wait_for_pending_writes();
+
+  // The file format of the cache
+  static bool write_cache_file(
+    const std::string & cache_path, const std::string & pcd_path,
+    const sensor_msgs::msg::PointCloud2 & cloud);
+  static bool read_cache_file(
+    const std::string & cache_path, const std::string & pcd_path,
+    sensor_msgs::msg::PointCloud2 & cloud);
+
+private:
+  std::string cache_directory_;
+  size_t memory_limit_;
+
+  mutable std::mutex mutex_;
+  // the most recently used cloud is at the front
+  std::list<std::pair<std::string, PointCloud2ConstSharedPtr>> lru_list_;
+  std::unordered_map<std::string, decltype(lru_list_)::iterator> lru_index_;
+  PointCloudMapCellCacheStatistics statistics_;
+
+  // The files to be written, which are written by writer_thread_ off the service calls
+  std::condition_variable write_cv_;
+  std::deque<std::pair<std::string, PointCloud2ConstSharedPtr>> write_queue_;
+  std::unordered_set<std::string> pending_write_paths_;
+  bool is_stopped_{false};
+  std::thread writer_thread_;
+
+  std::string get_cache_path(const std::string & pcd_path) const;
+  void insert_to_memory(const std::string & pcd_path, const PointCloud2ConstSharedPtr & cloud);
+  void request_write(const std::string & pcd_path, const PointCloud2ConstSharedPtr & cloud);
+  void write_loop();
+};
+}  // namespace autoware::map_loader
+
+#endif  // POINTCLOUD_MAP_LOADER__POINT_CLOUD_MAP_CELL_CACHE_HPP_
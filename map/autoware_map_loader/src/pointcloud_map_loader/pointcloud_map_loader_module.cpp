@@ -14,36 +14,19 @@
 
 #include "pointcloud_map_loader_module.hpp"
 
+#include "parallel_pcd_loader.hpp"
 #include "utils.hpp"
 
-#include <fmt/format.h>
-
+#include <algorithm>
 #include <string>
 #include <vector>
 
 namespace autoware::map_loader
 {
-sensor_msgs::msg::PointCloud2 downsample(
-  const sensor_msgs::msg::PointCloud2 & msg_input, const float leaf_size)
-{
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_input(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pcl_output(new pcl::PointCloud<pcl::PointXYZ>);
-  pcl::fromROSMsg(msg_input, *pcl_input);
-  pcl::VoxelGrid<pcl::PointXYZ> filter;
-  filter.setInputCloud(pcl_input);
-  filter.setLeafSize(leaf_size, leaf_size, leaf_size);
-  filter.filter(*pcl_output);
-
-  sensor_msgs::msg::PointCloud2 msg_output;
-  pcl::toROSMsg(*pcl_output, msg_output);
-  msg_output.header = msg_input.header;
-  return msg_output;
-}
-
 PointcloudMapLoaderModule::PointcloudMapLoaderModule(
   rclcpp::Node * node, const std::vector<std::string> & pcd_paths,
-  const std::string & publisher_name, const bool use_downsample)
-: logger_(node->get_logger())
+  const std::string & publisher_name, const bool use_downsample, const size_t thread_num)
+: logger_(node->get_logger()), thread_num_(std::max<size_t>(thread_num, 1))
 {
   rclcpp::QoS durable_qos{1};
   durable_qos.transient_local();
@@ -70,35 +53,16 @@ PointcloudMapLoaderModule::PointcloudMapLoaderModule(
 sensor_msgs::msg::PointCloud2 PointcloudMapLoaderModule::load_pcd_files(
   const std::vector<std::string> & pcd_paths, const boost::optional<float> leaf_size) const
 {
-  sensor_msgs::msg::PointCloud2 whole_pcd;
-  sensor_msgs::msg::PointCloud2 partial_pcd;
-
-  for (size_t i = 0; i < pcd_paths.size(); ++i) {
-    auto & path = pcd_paths[i];
-    if (i % 50 == 0) {
-      RCLCPP_DEBUG_STREAM(
-        logger_, fmt::format("Load {} ({} out of {})", path, i + 1, pcd_paths.size()));
-    }
-
-    if (pcl::io::loadPCDFile(path, partial_pcd) == -1) {
-      RCLCPP_ERROR_STREAM(logger_, "PCD load failed: " << path);
-    }
-
-    if (leaf_size) {
-      partial_pcd = downsample(partial_pcd, leaf_size.get());
-    }
-
-    if (whole_pcd.width == 0) {
-      whole_pcd = partial_pcd;
-    } else {
-      whole_pcd.width += partial_pcd.width;
-      whole_pcd.row_step += partial_pcd.row_step;
-      whole_pcd.data.insert(whole_pcd.data.end(), partial_pcd.data.begin(), partial_pcd.data.end());
-    }
-  }
+  PcdLoadStatistics statistics;
+  auto pcd = load_pcd_files_in_parallel(pcd_paths, leaf_size, thread_num_, logger_, statistics);
 
-  whole_pcd.header.frame_id = "map";
+  RCLCPP_INFO(
+    logger_,
+    "Loaded %zu PCD files (%zu failed or empty), %zu points, %.1f MB in %.2f s (%.1f MB/s)",
+    statistics.loaded_file_num, statistics.failed_file_num, statistics.point_num,
+    static_cast<double>(statistics.byte_num) / 1e6, statistics.elapsed_sec,
+    static_cast<double>(statistics.byte_num) / 1e6 / std::max(statistics.elapsed_sec, 1e-9));
 
-  return whole_pcd;
+  return pcd;
 }
 }  // namespace autoware::map_loader
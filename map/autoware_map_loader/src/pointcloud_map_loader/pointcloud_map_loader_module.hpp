@@ -35,10 +35,11 @@ class PointcloudMapLoaderModule
 public:
   explicit PointcloudMapLoaderModule(
     rclcpp::Node * node, const std::vector<std::string> & pcd_paths,
-    const std::string & publisher_name, const bool use_downsample);
+    const std::string & publisher_name, const bool use_downsample, const size_t thread_num = 1);
 
 private:
   rclcpp::Logger logger_;
+  size_t thread_num_;
   rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr pub_pointcloud_map_;
 
   [[nodiscard]] sensor_msgs::msg::PointCloud2 load_pcd_files(
@@ -19,6 +19,8 @@
 #include <pcl/io/pcd_io.h>
 #include <pcl_conversions/pcl_conversions.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <memory>
@@ -54,27 +56,38 @@ PointCloudMapLoaderNode::PointCloudMapLoaderNode(const rclcpp::NodeOptions & opt
   bool enable_downsample_whole_load = declare_parameter<bool>("enable_downsampled_whole_load");
   bool enable_partial_load = declare_parameter<bool>("enable_partial_load");
   bool enable_selected_load = declare_parameter<bool>("enable_selected_load");
+  const auto cell_cache_directory = declare_parameter<std::string>("cell_cache_directory");
+  const auto cell_cache_memory_limit_mb = declare_parameter<int64_t>("cell_cache_memory_limit_mb");
+  const auto thread_num =
+    static_cast<size_t>(std::max<int64_t>(declare_parameter<int64_t>("thread_num"), 1));
 
   if (enable_whole_load) {
     std::string publisher_name = "output/pointcloud_map";
-    pcd_map_loader_ =
-      std::make_unique<PointcloudMapLoaderModule>(this, pcd_paths, publisher_name, false);
+    pcd_map_loader_ = std::make_unique<PointcloudMapLoaderModule>(
+      this, pcd_paths, publisher_name, false, thread_num);
   }
 
   if (enable_downsample_whole_load) {
     std::string publisher_name = "output/debug/downsampled_pointcloud_map";
-    downsampled_pcd_map_loader_ =
-      std::make_unique<PointcloudMapLoaderModule>(this, pcd_paths, publisher_name, true);
+    downsampled_pcd_map_loader_ = std::make_unique<PointcloudMapLoaderModule>(
+      this, pcd_paths, publisher_name, true, thread_num);
   }
 
   // Parse the metadata file and get the map of (absolute pcd path, pcd file metadata)
   auto pcd_metadata_dict = get_pcd_metadata(pcd_metadata_path, pcd_paths);
 
+  // the partial and the differential loaders serve the same cells, so they share the cache
+  const auto cell_cache = std::make_shared<PointCloudMapCellCache>(
+    cell_cache_directory, static_cast<size_t>(std::max<int64_t>(cell_cache_memory_limit_mb, 0))
+                            << 20);
+
   if (enable_partial_load) {
-    partial_map_loader_ = std::make_unique<PartialMapLoaderModule>(this, pcd_metadata_dict);
+    partial_map_loader_ =
+      std::make_unique<PartialMapLoaderModule>(this, pcd_metadata_dict, cell_cache);
   }
 
-  differential_map_loader_ = std::make_unique<DifferentialMapLoaderModule>(this, pcd_metadata_dict);
+  differential_map_loader_ =
+    std::make_unique<DifferentialMapLoaderModule>(this, pcd_metadata_dict, cell_cache);
 
   if (enable_selected_load) {
     selected_map_loader_ = std::make_unique<SelectedMapLoaderModule>(this, pcd_metadata_dict);
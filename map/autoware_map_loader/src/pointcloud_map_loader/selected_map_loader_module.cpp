@@ -48,7 +48,7 @@ autoware_map_msgs::msg::PointCloudMapMetaData create_metadata(
 
 SelectedMapLoaderModule::SelectedMapLoaderModule(
   rclcpp::Node * node, std::map<std::string, PCDFileMetadata> pcd_file_metadata_dict)
-: logger_(node->get_logger()), all_pcd_file_metadata_dict_(std::move(pcd_file_metadata_dict))
+: logger_(node->get_logger()), pcd_file_metadata_index_(pcd_file_metadata_dict)
 {
   get_selected_pcd_maps_service_ = node->create_service<GetSelectedPointCloudMap>(
     "service/get_selected_pcd_map",
@@ -61,7 +61,7 @@ SelectedMapLoaderModule::SelectedMapLoaderModule(
   durable_qos.transient_local();
   pub_metadata_ = node->create_publisher<autoware_map_msgs::msg::PointCloudMapMetaData>(
     "output/pointcloud_map_metadata", durable_qos);
-  pub_metadata_->publish(create_metadata(all_pcd_file_metadata_dict_));
+  pub_metadata_->publish(create_metadata(pcd_file_metadata_dict));
 }
 
 bool SelectedMapLoaderModule::on_service_get_selected_point_cloud_map(
@@ -70,18 +70,19 @@ bool SelectedMapLoaderModule::on_service_get_selected_point_cloud_map(
 {
   const auto request_ids = req->cell_ids;
   for (const auto & request_id : request_ids) {
-    const auto requested_selected_map_iterator = all_pcd_file_metadata_dict_.find(request_id);
+    const auto requested_selected_map_index = pcd_file_metadata_index_.find(request_id);
 
     // skip if the requested ID is not found
-    if (requested_selected_map_iterator == all_pcd_file_metadata_dict_.end()) {
+    if (!requested_selected_map_index) {
       RCLCPP_WARN(logger_, "ID %s not found", request_id.c_str());
       continue;
     }
 
-    const std::string path = requested_selected_map_iterator->first;
+    const std::string & path = pcd_file_metadata_index_.id(*requested_selected_map_index);
     // assume that the map ID = map path (for now)
     const std::string & map_id = path;
-    PCDFileMetadata metadata = requested_selected_map_iterator->second;
+    const PCDFileMetadata & metadata =
+      pcd_file_metadata_index_.metadata(*requested_selected_map_index);
 
     autoware_map_msgs::msg::PointCloudMapCellWithID pointcloud_map_cell_with_id =
       load_point_cloud_map_cell_with_id(path, map_id);
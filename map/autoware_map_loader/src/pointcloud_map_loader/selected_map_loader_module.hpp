@@ -15,6 +15,7 @@
 #ifndef POINTCLOUD_MAP_LOADER__SELECTED_MAP_LOADER_MODULE_HPP_
 #define POINTCLOUD_MAP_LOADER__SELECTED_MAP_LOADER_MODULE_HPP_
 
+#include "pcd_file_metadata_index.hpp"
 #include "utils.hpp"
 
 #include <rclcpp/rclcpp.hpp>
@@ -46,7 +47,7 @@ public:
 private:
   rclcpp::Logger logger_;
 
-  std::map<std::string, PCDFileMetadata> all_pcd_file_metadata_dict_;
+  PCDFileMetadataIndex pcd_file_metadata_index_;
   rclcpp::Service<GetSelectedPointCloudMap>::SharedPtr get_selected_pcd_maps_service_;
 
   rclcpp::Publisher<autoware_map_msgs::msg::PointCloudMapMetaData>::SharedPtr pub_metadata_;
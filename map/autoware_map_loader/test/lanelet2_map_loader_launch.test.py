@@ -39,6 +39,8 @@ def generate_test_description():
                 "lanelet2_map_path": lanelet2_map_path,
                 "center_line_resolution": 5.0,
                 "use_waypoints": True,
+                "lanelet2_map_cache_path": "",
+                "thread_num": 1,
                 "allow_unsupported_version": True,
             }
         ],
@@ -0,0 +1,188 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/lanelet2_map_loader/lanelet2_map_cache.hpp"
+
+#include <autoware_lanelet2_extension/utility/utilities.hpp>
+#include <gmock/gmock.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/primitives/Lanelet.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+using autoware::map_loader::compute_lanelet2_map_cache_key;
+using autoware::map_loader::load_lanelet2_map_cache;
+using autoware::map_loader::save_lanelet2_map_cache;
+
+namespace
+{
+std::filesystem::path create_directory(const std::string & directory_name)
+{
+  const auto directory = std::filesystem::temp_directory_path() / directory_name;
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  return directory;
+}
+
+void write_file(const std::filesystem::path & path, const std::string & content)
+{
+  std::ofstream ofs(path, std::ios::binary | std::ios::trunc);
+  ofs << content;
+}
+
+autoware_map_msgs::msg::MapProjectorInfo create_projector_info(const int mgrs_grid)
+{
+  autoware_map_msgs::msg::MapProjectorInfo projector_info;
+  projector_info.projector_type = autoware_map_msgs::msg::MapProjectorInfo::MGRS;
+  projector_info.vertical_datum = autoware_map_msgs::msg::MapProjectorInfo::WGS84;
+  projector_info.mgrs_grid = mgrs_grid == 0 ? "54SUE" : "53SPU";
+  return projector_info;
+}
+
+// Two lanelets whose bounds have different numbers of points, and one with a custom centerline
+lanelet::LaneletMapPtr create_map()
+{
+  lanelet::Id id = 1;
+  const auto create_line = [&id](const std::vector<std::pair<double, double>> & points) {
+    lanelet::LineString3d line(id++);
+    for (const auto & [x, y] : points) {
+      line.push_back(lanelet::Point3d(id++, x, y, 0.0));
+    }
+    return line;
+  };
+
+  lanelet::Lanelet straight(
+    id++, create_line({{0.0, 0.0}, {30.0, 0.0}}),
+    create_line({{0.0, -3.0}, {10.0, -3.0}, {20.0, -3.0}, {30.0, -3.0}}));
+  lanelet::Lanelet curved(
+    id++, create_line({{30.0, 0.0}, {45.0, 5.0}, {55.0, 15.0}}),
+    create_line({{30.0, -3.0}, {47.0, 2.0}, {58.0, 13.0}}));
+  lanelet::Lanelet custom(
+    id++, create_line({{55.0, 15.0}, {65.0, 25.0}}), create_line({{58.0, 13.0}, {68.0, 23.0}}));
+  custom.setCenterline(create_line({{56.5, 14.0}, {61.5, 19.0}, {66.5, 24.0}}));
+  return lanelet::utils::createMap({straight, curved, custom});
+}
+}  // namespace
+
+TEST(Lanelet2MapCacheTest, KeyChangesWithTheInputs)
+{
+  const auto directory = create_directory("lanelet2_map_cache_key_test");
+  const auto osm_path = (directory / "lanelet2_map.osm").string();
+  write_file(osm_path, "<osm version=\"0.6\"></osm>");
+
+  const auto key = compute_lanelet2_map_cache_key(osm_path, create_projector_info(0), 5.0, true);
+  ASSERT_FALSE(key.empty());
+  EXPECT_EQ(compute_lanelet2_map_cache_key(osm_path, create_projector_info(0), 5.0, true), key);
+  EXPECT_NE(compute_lanelet2_map_cache_key(osm_path, create_projector_info(1), 5.0, true), key);
+  EXPECT_NE(compute_lanelet2_map_cache_key(osm_path, create_projector_info(0), 2.0, true), key);
+  EXPECT_NE(compute_lanelet2_map_cache_key(osm_path, create_projector_info(0), 5.0, false), key);
+
+  write_file(osm_path, "<osm version=\"0.6\"><node/></osm>");
+  EXPECT_NE(compute_lanelet2_map_cache_key(osm_path, create_projector_info(0), 5.0, true), key);
+
+  EXPECT_TRUE(compute_lanelet2_map_cache_key(
+                (directory / "missing.osm").string(), create_projector_info(0), 5.0, true)
+                .empty());
+}
+
+TEST(Lanelet2MapCacheTest, LoadsTheSavedMessage)
+{
+  const auto directory = create_directory("lanelet2_map_cache_round_trip_test");
+  const auto cache_path = (directory / "lanelet2_map.cache").string();
+
+  autoware_map_msgs::msg::LaneletMapBin map_bin_msg;
+  map_bin_msg.version_map_format = "1.2.0";
+  map_bin_msg.version_map = "0.1.0";
+  map_bin_msg.name_map = "test_map";
+  for (size_t i = 0; i < 100000; ++i) {
+    map_bin_msg.data.push_back(static_cast<uint8_t>(i * 7));
+  }
+
+  EXPECT_FALSE(load_lanelet2_map_cache(cache_path, "key").has_value());
+  ASSERT_TRUE(save_lanelet2_map_cache(cache_path, "key", map_bin_msg));
+  // the temporary file is renamed to the cache
+  EXPECT_EQ(
+    std::distance(
+      std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()),
+    1);
+
+  const auto loaded = load_lanelet2_map_cache(cache_path, "key");
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(*loaded, map_bin_msg);
+  EXPECT_FALSE(load_lanelet2_map_cache(cache_path, "other").has_value());
+
+  // a truncated file is not used
+  std::filesystem::resize_file(cache_path, std::filesystem::file_size(cache_path) / 2);
+  EXPECT_FALSE(load_lanelet2_map_cache(cache_path, "key").has_value());
+}
+
+TEST(Lanelet2MapCacheTest, CenterlineMatchesTheSequentialOne)
+{
+  for (const bool use_waypoints : {false, true}) {
+    // the IDs are compared relative to the ID taken just before the centerlines are generated
+    const auto expected_map = create_map();
+    const auto expected_first_id = lanelet::utils::getId();
+    if (use_waypoints) {
+      lanelet::utils::overwriteLaneletsCenterlineWithWaypoints(expected_map, 5.0, false);
+    } else {
+      lanelet::utils::overwriteLaneletsCenterline(expected_map, 5.0, false);
+    }
+
+    for (const size_t thread_num : {1u, 4u}) {
+      const auto map = create_map();
+      const auto first_id = lanelet::utils::getId();
+      autoware::map_loader::overwrite_lanelets_centerline(map, 5.0, use_waypoints, thread_num);
+
+      for (const auto & expected_lanelet : expected_map->laneletLayer) {
+        SCOPED_TRACE(
+          "use_waypoints: " + std::to_string(use_waypoints) +
+          ", thread_num: " + std::to_string(thread_num) +
+          ", lanelet: " + std::to_string(expected_lanelet.id()));
+        const auto lanelet = map->laneletLayer.get(expected_lanelet.id());
+        ASSERT_TRUE(lanelet.hasCustomCenterline());
+        ASSERT_EQ(lanelet.hasAttribute("waypoints"), expected_lanelet.hasAttribute("waypoints"));
+        if (expected_lanelet.hasAttribute("waypoints")) {
+          EXPECT_EQ(
+            lanelet.attribute("waypoints").asId(), expected_lanelet.attribute("waypoints").asId());
+        }
+
+        // the custom centerline is kept as is without use_waypoints
+        const auto expected_centerline = expected_lanelet.centerline();
+        const auto centerline = lanelet.centerline();
+        const auto is_generated = expected_centerline.id() >= expected_first_id;
+        EXPECT_EQ(centerline.id() >= first_id, is_generated);
+        const auto offset = is_generated ? first_id - expected_first_id : 0;
+        EXPECT_EQ(centerline.id(), expected_centerline.id() + offset);
+        ASSERT_EQ(centerline.size(), expected_centerline.size());
+        for (size_t i = 0; i < centerline.size(); ++i) {
+          EXPECT_EQ(centerline[i].id(), expected_centerline[i].id() + offset);
+          EXPECT_DOUBLE_EQ(centerline[i].x(), expected_centerline[i].x());
+          EXPECT_DOUBLE_EQ(centerline[i].y(), expected_centerline[i].y());
+          EXPECT_DOUBLE_EQ(centerline[i].z(), expected_centerline[i].z());
+        }
+      }
+    }
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleMock(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,151 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/pointcloud_map_loader/parallel_pcd_loader.hpp"
+
+#include <rclcpp/logging.hpp>
+
+#include <gmock/gmock.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using autoware::map_loader::load_pcd_files_in_parallel;
+using autoware::map_loader::PcdLoadStatistics;
+
+namespace
+{
+// Write a synthetic tile set, where each tile covers a 20m x 20m grid cell
+std::vector<std::string> create_tiles(
+  const std::string & directory_name, const size_t tile_num, const size_t point_num_per_tile)
+{
+  const auto directory = std::filesystem::temp_directory_path() / directory_name;
+  std::filesystem::create_directories(directory);
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> dist(0.0f, 20.0f);
+  std::vector<std::string> paths;
+  for (size_t i = 0; i < tile_num; ++i) {
+    pcl::PointCloud<pcl::PointXYZ> tile;
+    for (size_t j = 0; j < point_num_per_tile; ++j) {
+      tile.points.emplace_back(
+        static_cast<float>(i % 100) * 20.0f + dist(engine),
+        static_cast<float>(i / 100) * 20.0f + dist(engine), dist(engine) * 0.1f);
+    }
+    tile.width = tile.points.size();
+    tile.height = 1;
+
+    const auto path = (directory / ("tile_" + std::to_string(i) + ".pcd")).string();
+    pcl::io::savePCDFileBinary(path, tile);
+    paths.push_back(path);
+  }
+  return paths;
+}
+
+sensor_msgs::msg::PointCloud2 load_sequentially(const std::vector<std::string> & paths)
+{
+  sensor_msgs::msg::PointCloud2 whole_pcd;
+  for (const auto & path : paths) {
+    sensor_msgs::msg::PointCloud2 partial_pcd;
+    if (pcl::io::loadPCDFile(path, partial_pcd) == -1) {
+      continue;
+    }
+    if (whole_pcd.width == 0) {
+      whole_pcd = partial_pcd;
+    } else {
+      whole_pcd.width += partial_pcd.width;
+      whole_pcd.row_step += partial_pcd.row_step;
+      whole_pcd.data.insert(whole_pcd.data.end(), partial_pcd.data.begin(), partial_pcd.data.end());
+    }
+  }
+  return whole_pcd;
+}
+}  // namespace
+
+TEST(ParallelPcdLoaderTest, KeepsTheOrderOfTheFiles)
+{
+  auto paths = create_tiles("test_parallel_pcd_loader", 30, 100);
+  const auto expected = load_sequentially(paths);
+
+  // a missing file in the middle is skipped
+  paths.insert(paths.begin() + 10, "/tmp/test_parallel_pcd_loader/missing.pcd");
+
+  for (const size_t thread_num : {1, 4}) {
+    PcdLoadStatistics statistics;
+    const auto whole_pcd = load_pcd_files_in_parallel(
+      paths, boost::none, thread_num, rclcpp::get_logger("test"), statistics);
+
+    EXPECT_EQ(whole_pcd.width, expected.width);
+    EXPECT_EQ(whole_pcd.row_step, expected.row_step);
+    EXPECT_EQ(whole_pcd.point_step, expected.point_step);
+    EXPECT_EQ(whole_pcd.header.frame_id, "map");
+    EXPECT_TRUE(whole_pcd.data == expected.data);
+    EXPECT_EQ(statistics.loaded_file_num, 30u);
+    EXPECT_EQ(statistics.failed_file_num, 1u);
+    EXPECT_EQ(statistics.point_num, 3000u);
+  }
+}
+
+TEST(ParallelPcdLoaderTest, DownsamplesEachFile)
+{
+  const auto paths = create_tiles("test_parallel_pcd_loader_downsample", 8, 1000);
+
+  PcdLoadStatistics statistics;
+  const auto whole_pcd = load_pcd_files_in_parallel(
+    paths, 5.0f, 4, rclcpp::get_logger("test"), statistics);
+
+  size_t expected_point_num = 0;
+  for (const auto & path : paths) {
+    sensor_msgs::msg::PointCloud2 partial_pcd;
+    ASSERT_NE(pcl::io::loadPCDFile(path, partial_pcd), -1);
+    expected_point_num += autoware::map_loader::downsample(partial_pcd, 5.0f).width;
+  }
+  EXPECT_EQ(whole_pcd.width, expected_point_num);
+  EXPECT_EQ(whole_pcd.row_step, whole_pcd.width * whole_pcd.point_step);
+  EXPECT_EQ(whole_pcd.data.size(), whole_pcd.row_step);
+}
+
+TEST(ParallelPcdLoaderTest, DISABLED_StartupBenchmark)
+{
+  const auto paths = create_tiles("test_parallel_pcd_loader_benchmark", 2000, 20000);
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto expected = load_sequentially(paths);
+  const auto end = std::chrono::steady_clock::now();
+  std::cout << "sequential load: " << std::chrono::duration<double, std::milli>(end - start).count()
+            << " [ms]" << std::endl;
+
+  for (const size_t thread_num : {1u, 2u, 4u, std::thread::hardware_concurrency()}) {
+    PcdLoadStatistics statistics;
+    const auto whole_pcd = load_pcd_files_in_parallel(
+      paths, boost::none, thread_num, rclcpp::get_logger("test"), statistics);
+    std::cout << "parallel load with " << thread_num
+              << " threads: " << statistics.elapsed_sec * 1000.0 << " [ms]" << std::endl;
+    EXPECT_TRUE(whole_pcd.data == expected.data);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleMock(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,185 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/pointcloud_map_loader/pcd_file_metadata_index.hpp"
+
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using autoware::map_loader::is_grid_within_queried_area;
+using autoware::map_loader::PCDFileMetadata;
+using autoware::map_loader::PCDFileMetadataIndex;
+
+namespace
+{
+// A square grid of 20m x 20m tiles, as produced by the map divider
+std::map<std::string, PCDFileMetadata> create_tiles(const size_t tile_num)
+{
+  const auto side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(tile_num))));
+  std::map<std::string, PCDFileMetadata> dict;
+  for (size_t i = 0; i < tile_num; ++i) {
+    const auto x = static_cast<float>(i % side) * 20.0f + 1000.0f;
+    const auto y = static_cast<float>(i / side) * 20.0f - 500.0f;
+    PCDFileMetadata metadata;
+    metadata.min = pcl::PointXYZ(x, y, 0.0f);
+    metadata.max = pcl::PointXYZ(x + 20.0f, y + 20.0f, 10.0f);
+    dict["/map/" + std::to_string(i) + ".pcd"] = metadata;
+  }
+  return dict;
+}
+
+autoware_map_msgs::msg::AreaInfo create_area(const double x, const double y, const double radius)
+{
+  autoware_map_msgs::msg::AreaInfo area;
+  area.center_x = static_cast<float>(x);
+  area.center_y = static_cast<float>(y);
+  area.radius = static_cast<float>(radius);
+  return area;
+}
+
+std::vector<std::string> query_linearly(
+  const std::map<std::string, PCDFileMetadata> & dict,
+  const autoware_map_msgs::msg::AreaInfo & area)
+{
+  std::vector<std::string> ids;
+  for (const auto & [id, metadata] : dict) {
+    if (is_grid_within_queried_area(area, metadata)) {
+      ids.push_back(id);
+    }
+  }
+  return ids;
+}
+
+std::vector<std::string> query_index(
+  const PCDFileMetadataIndex & index, const autoware_map_msgs::msg::AreaInfo & area)
+{
+  std::vector<std::string> ids;
+  for (const size_t i : index.query(area)) {
+    ids.push_back(index.id(i));
+  }
+  return ids;
+}
+}  // namespace
+
+TEST(PCDFileMetadataIndexTest, QueryMatchesTheLinearScan)
+{
+  auto dict = create_tiles(1000);
+
+  // tiles of various sizes, including one larger than the whole map and one without bounds
+  PCDFileMetadata large;
+  large.min = pcl::PointXYZ(-5000.0f, -5000.0f, 0.0f);
+  large.max = pcl::PointXYZ(5000.0f, 5000.0f, 0.0f);
+  dict["/map/large.pcd"] = large;
+  PCDFileMetadata small;
+  small.min = pcl::PointXYZ(1234.5f, -123.0f, 0.0f);
+  small.max = pcl::PointXYZ(1234.5f, -123.0f, 0.0f);
+  dict["/map/small.pcd"] = small;
+  PCDFileMetadata unbounded;
+  unbounded.min = pcl::PointXYZ(
+    -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), 0.0f);
+  unbounded.max = pcl::PointXYZ(1100.0f, 0.0f, 0.0f);
+  dict["/map/unbounded.pcd"] = unbounded;
+
+  const PCDFileMetadataIndex index(dict);
+  ASSERT_EQ(index.size(), dict.size());
+
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> position(-200.0, 1800.0);
+  std::uniform_real_distribution<double> radius(0.0, 300.0);
+  for (size_t i = 0; i < 1000; ++i) {
+    const auto area = create_area(position(engine), position(engine), radius(engine));
+    EXPECT_EQ(query_index(index, area), query_linearly(dict, area));
+  }
+
+  // on the borders of the tiles and far from the map
+  for (const auto & area :
+       {create_area(1000.0, -500.0, 0.0), create_area(1020.0, -480.0, 0.0),
+        create_area(1234.5, -123.0, 0.0), create_area(1e7, 1e7, 1.0),
+        create_area(0.0, 0.0, 1e7)}) {
+    EXPECT_EQ(query_index(index, area), query_linearly(dict, area));
+  }
+}
+
+TEST(PCDFileMetadataIndexTest, FindsTheIds)
+{
+  const auto dict = create_tiles(10);
+  const PCDFileMetadataIndex index(dict);
+
+  const auto found = index.find("/map/3.pcd");
+  ASSERT_TRUE(found.has_value());
+  EXPECT_EQ(index.id(*found), "/map/3.pcd");
+  EXPECT_EQ(index.metadata(*found), dict.at("/map/3.pcd"));
+  EXPECT_FALSE(index.find("/map/missing.pcd").has_value());
+
+  EXPECT_TRUE(PCDFileMetadataIndex({}).query(create_area(0.0, 0.0, 100.0)).empty());
+}
+
+TEST(PCDFileMetadataIndexTest, DISABLED_QueryBenchmark)
+{
+  for (const size_t tile_num : {1000u, 10000u, 100000u}) {
+    const auto dict = create_tiles(tile_num);
+    const auto start_build = std::chrono::steady_clock::now();
+    const PCDFileMetadataIndex index(dict);
+    const auto end_build = std::chrono::steady_clock::now();
+
+    // the areas which the NDT scan matcher requests, around a vehicle in the map
+    const auto side = std::sqrt(static_cast<double>(tile_num)) * 20.0;
+    std::mt19937 engine(0);
+    std::uniform_real_distribution<double> x(1000.0, 1000.0 + side);
+    std::uniform_real_distribution<double> y(-500.0, -500.0 + side);
+    std::vector<autoware_map_msgs::msg::AreaInfo> areas;
+    for (size_t i = 0; i < 100; ++i) {
+      areas.push_back(create_area(x(engine), y(engine), 150.0));
+    }
+
+    size_t linear_hit_num = 0;
+    const auto start_linear = std::chrono::steady_clock::now();
+    for (const auto & area : areas) {
+      linear_hit_num += query_linearly(dict, area).size();
+    }
+    const auto end_linear = std::chrono::steady_clock::now();
+
+    size_t index_hit_num = 0;
+    const auto start_index = std::chrono::steady_clock::now();
+    for (const auto & area : areas) {
+      index_hit_num += index.query(area).size();
+    }
+    const auto end_index = std::chrono::steady_clock::now();
+
+    EXPECT_EQ(index_hit_num, linear_hit_num);
+    std::cout << tile_num << " tiles: build "
+              << std::chrono::duration<double, std::milli>(end_build - start_build).count()
+              << " [ms], linear scan "
+              << std::chrono::duration<double, std::milli>(end_linear - start_linear).count() /
+                   areas.size()
+              << " [ms/query], index "
+              << std::chrono::duration<double, std::milli>(end_index - start_index).count() /
+                   areas.size()
+              << " [ms/query]" << std::endl;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleMock(&argc, argv);
+  return RUN_ALL_TESTS();
+}
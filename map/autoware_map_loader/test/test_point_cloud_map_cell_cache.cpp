@@ -0,0 +1,209 @@
+// Copyright 2025 The Autoware Contributors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "../src/pointcloud_map_loader/point_cloud_map_cell_cache.hpp"
+
+#include <gmock/gmock.h>
+#include <pcl/io/pcd_io.h>
+#include <pcl/point_types.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using autoware::map_loader::PointCloudMapCellCache;
+
+namespace
+{
+std::filesystem::path create_directory(const std::string & directory_name)
+{
+  const auto directory = std::filesystem::temp_directory_path() / directory_name;
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  return directory;
+}
+
+std::string create_tile(
+  const std::filesystem::path & directory, const std::string & name, const size_t point_num,
+  const unsigned int seed = 0)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> dist(0.0f, 20.0f);
+  pcl::PointCloud<pcl::PointXYZ> tile;
+  for (size_t i = 0; i < point_num; ++i) {
+    tile.points.emplace_back(dist(engine), dist(engine), dist(engine) * 0.1f);
+  }
+  tile.width = tile.points.size();
+  tile.height = 1;
+
+  const auto path = (directory / name).string();
+  pcl::io::savePCDFileBinary(path, tile);
+  return path;
+}
+
+void expect_same_cloud(
+  const sensor_msgs::msg::PointCloud2 & cloud, const sensor_msgs::msg::PointCloud2 & expected)
+{
+  EXPECT_EQ(cloud.height, expected.height);
+  EXPECT_EQ(cloud.width, expected.width);
+  EXPECT_EQ(cloud.point_step, expected.point_step);
+  EXPECT_EQ(cloud.row_step, expected.row_step);
+  EXPECT_EQ(cloud.is_dense, expected.is_dense);
+  ASSERT_EQ(cloud.fields.size(), expected.fields.size());
+  for (size_t i = 0; i < cloud.fields.size(); ++i) {
+    EXPECT_EQ(cloud.fields[i].name, expected.fields[i].name);
+    EXPECT_EQ(cloud.fields[i].offset, expected.fields[i].offset);
+    EXPECT_EQ(cloud.fields[i].datatype, expected.fields[i].datatype);
+    EXPECT_EQ(cloud.fields[i].count, expected.fields[i].count);
+  }
+  EXPECT_TRUE(cloud.data == expected.data);
+}
+}  // namespace
+
+TEST(PointCloudMapCellCacheTest, CacheFileKeepsTheCloud)
+{
+  const auto directory = create_directory("test_point_cloud_map_cell_cache_file");
+  const auto pcd_path = create_tile(directory, "tile.pcd", 100);
+  const auto cache_path = (directory / "tile.cell").string();
+
+  sensor_msgs::msg::PointCloud2 expected;
+  ASSERT_NE(pcl::io::loadPCDFile(pcd_path, expected), -1);
+  ASSERT_TRUE(PointCloudMapCellCache::write_cache_file(cache_path, pcd_path, expected));
+
+  // the temporary file has been renamed to the cache file
+  size_t file_num = 0;
+  for ([[maybe_unused]] const auto & entry : std::filesystem::directory_iterator(directory)) {
+    ++file_num;
+  }
+  EXPECT_EQ(file_num, 2u);
+
+  sensor_msgs::msg::PointCloud2 cloud;
+  ASSERT_TRUE(PointCloudMapCellCache::read_cache_file(cache_path, pcd_path, cloud));
+  expect_same_cloud(cloud, expected);
+
+  // the file belongs to another PCD
+  EXPECT_FALSE(PointCloudMapCellCache::read_cache_file(cache_path, cache_path, cloud));
+
+  // the file is truncated
+  std::filesystem::resize_file(cache_path, std::filesystem::file_size(cache_path) - 1);
+  EXPECT_FALSE(PointCloudMapCellCache::read_cache_file(cache_path, pcd_path, cloud));
+}
+
+TEST(PointCloudMapCellCacheTest, CacheFileIsRebuiltWhenThePcdChanges)
+{
+  const auto directory = create_directory("test_point_cloud_map_cell_cache_rebuild");
+  const auto pcd_path = create_tile(directory, "tile.pcd", 100);
+
+  {
+    PointCloudMapCellCache cache((directory / "cache").string(), 0);
+    ASSERT_NE(cache.load(pcd_path), nullptr);
+    cache.wait_for_pending_writes();
+    ASSERT_NE(cache.load(pcd_path), nullptr);
+    EXPECT_EQ(cache.get_statistics().miss_num, 1u);
+    EXPECT_EQ(cache.get_statistics().disk_hit_num, 1u);
+  }
+
+  create_tile(directory, "tile.pcd", 200, 1);
+  sensor_msgs::msg::PointCloud2 expected;
+  ASSERT_NE(pcl::io::loadPCDFile(pcd_path, expected), -1);
+
+  PointCloudMapCellCache cache((directory / "cache").string(), 0);
+  const auto cloud = cache.load(pcd_path);
+  ASSERT_NE(cloud, nullptr);
+  expect_same_cloud(*cloud, expected);
+  EXPECT_EQ(cache.get_statistics().miss_num, 1u);
+  EXPECT_EQ(cache.get_statistics().disk_hit_num, 0u);
+}
+
+TEST(PointCloudMapCellCacheTest, MemoryIsBoundedByTheLimit)
+{
+  const auto directory = create_directory("test_point_cloud_map_cell_cache_memory");
+  std::vector<std::string> pcd_paths;
+  for (size_t i = 0; i < 3; ++i) {
+    pcd_paths.push_back(create_tile(directory, "tile_" + std::to_string(i) + ".pcd", 100, i));
+  }
+  const size_t cell_size = PointCloudMapCellCache("", 1 << 20).load(pcd_paths[0])->data.size();
+
+  // two cells fit in the memory
+  PointCloudMapCellCache cache("", cell_size * 2);
+  const auto first = cache.load(pcd_paths[0]);
+  EXPECT_EQ(cache.load(pcd_paths[0]), first);
+  cache.load(pcd_paths[1]);
+  cache.load(pcd_paths[0]);
+  cache.load(pcd_paths[2]);  // evicts the least recently used one, which is pcd_paths[1]
+  EXPECT_EQ(cache.load(pcd_paths[0]), first);
+
+  auto statistics = cache.get_statistics();
+  EXPECT_EQ(statistics.memory_hit_num, 3u);
+  EXPECT_EQ(statistics.miss_num, 3u);
+  EXPECT_EQ(statistics.memory_cell_num, 2u);
+  EXPECT_EQ(statistics.memory_usage, cell_size * 2);
+
+  cache.load(pcd_paths[1]);
+  statistics = cache.get_statistics();
+  EXPECT_EQ(statistics.miss_num, 4u);
+  EXPECT_LE(statistics.memory_usage, cell_size * 2);
+
+  EXPECT_EQ(cache.load((directory / "missing.pcd").string()), nullptr);
+}
+
+TEST(PointCloudMapCellCacheTest, DISABLED_ServeBenchmark)
+{
+  const auto directory = create_directory("test_point_cloud_map_cell_cache_benchmark");
+  std::vector<std::string> pcd_paths;
+  for (size_t i = 0; i < 50; ++i) {
+    pcd_paths.push_back(create_tile(directory, "tile_" + std::to_string(i) + ".pcd", 200000, i));
+  }
+
+  const auto measure = [&](const std::string & name, const auto & load) {
+    const auto start = std::chrono::steady_clock::now();
+    for (const auto & path : pcd_paths) {
+      load(path);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::milli>(end - start).count() / pcd_paths.size()
+              << " [ms/cell]" << std::endl;
+  };
+
+  measure("parse", [](const std::string & path) {
+    sensor_msgs::msg::PointCloud2 cloud;
+    pcl::io::loadPCDFile(path, cloud);
+  });
+
+  const auto cache_directory = (directory / "cache").string();
+  PointCloudMapCellCache writer(cache_directory, 0);
+  measure("parse and write cache file", [&](const std::string & path) {
+    writer.load(path);
+    writer.wait_for_pending_writes();
+  });
+
+  PointCloudMapCellCache cache(cache_directory, size_t{1} << 32);
+  measure("mmap cache file", [&](const std::string & path) {
+    sensor_msgs::msg::PointCloud2 cloud = *cache.load(path);
+  });
+  measure("memory", [&](const std::string & path) {
+    sensor_msgs::msg::PointCloud2 cloud = *cache.load(path);
+  });
+}
+
+int main(int argc, char ** argv)
+{
+  ::testing::InitGoogleMock(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include <autoware/worker_pool/worker_pool.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <autoware_perception_msgs/msg/detected_objects.hpp>
@@ -22,6 +23,7 @@
 #include <pcl/point_cloud.h>
 #include <pcl/point_types.h>
 
+#include <memory>
 #include <vector>
 
 namespace autoware::euclidean_cluster
@@ -40,6 +42,11 @@ public:
   void setUseHeight(bool use_height) { use_height_ = use_height; }
   void setMinClusterSize(int size) { min_cluster_size_ = size; }
   void setMaxClusterSize(int size) { max_cluster_size_ = size; }
+  // The threads are started here and kept alive for the clouds to come
+  void setThreadNum(size_t thread_num)
+  {
+    worker_pool_ = std::make_unique<autoware::worker_pool::WorkerPool>(thread_num);
+  }
   virtual bool cluster(
     const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
     std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters) = 0;
@@ -57,6 +64,7 @@ protected:
   bool use_height_ = true;
   int min_cluster_size_;
   int max_cluster_size_;
+  std::unique_ptr<autoware::worker_pool::WorkerPool> worker_pool_{nullptr};
 };
 
 }  // namespace autoware::euclidean_cluster
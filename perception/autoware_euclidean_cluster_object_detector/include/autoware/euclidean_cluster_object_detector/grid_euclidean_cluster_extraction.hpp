@@ -0,0 +1,63 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <autoware/worker_pool/worker_pool.hpp>
+
+#include <pcl/PointIndices.h>
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace autoware::euclidean_cluster
+{
+// Euclidean clustering which gives the same clusters as pcl::EuclideanClusterExtraction, i.e. the
+// connected components of the points within the tolerance of each other. The points are bucketed
+// into a 2D grid and the neighboring cells are merged by a lock-free union-find on the threads of
+// the worker pool, instead of a kd-tree radius search from each point. The points with non-finite
+// coordinates do not belong to any cluster.
+class GridEuclideanClusterExtraction
+{
+public:
+  void setClusterTolerance(float tolerance) { tolerance_ = tolerance; }
+  void setMinClusterSize(int min_cluster_size) { min_cluster_size_ = min_cluster_size; }
+  void setMaxClusterSize(int max_cluster_size) { max_cluster_size_ = max_cluster_size; }
+  // If false, the distance is measured on the xy plane
+  void setUseHeight(bool use_height) { use_height_ = use_height; }
+  // The cells are merged on the calling thread only if no worker pool is set
+  void setWorkerPool(autoware::worker_pool::WorkerPool * worker_pool)
+  {
+    worker_pool_ = worker_pool;
+  }
+
+  // The indices in each cluster are sorted, and the clusters are sorted by their size in
+  // descending order, as pcl::EuclideanClusterExtraction does. The clusters of the same size are
+  // in the order of their smallest indices.
+  void extract(
+    const pcl::PointCloud<pcl::PointXYZ> & pointcloud,
+    std::vector<pcl::PointIndices> & cluster_indices) const;
+
+private:
+  float tolerance_{1.0f};
+  int min_cluster_size_{1};
+  int max_cluster_size_{std::numeric_limits<int>::max()};
+  bool use_height_{true};
+  autoware::worker_pool::WorkerPool * worker_pool_{nullptr};
+};
+
+}  // namespace autoware::euclidean_cluster
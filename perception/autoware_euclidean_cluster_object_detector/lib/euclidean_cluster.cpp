@@ -13,9 +13,7 @@
 // limitations under the License.
 
 #include <autoware/euclidean_cluster_object_detector/euclidean_cluster.hpp>
-
-#include <pcl/kdtree/kdtree.h>
-#include <pcl/segmentation/extract_clusters.h>
+#include <autoware/euclidean_cluster_object_detector/grid_euclidean_cluster_extraction.hpp>
 
 #include <vector>
 
@@ -60,35 +58,15 @@ bool EuclideanCluster::cluster(
   const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud,
   std::vector<pcl::PointCloud<pcl::PointXYZ>> & clusters)
 {
-  // convert 2d pointcloud
-  pcl::PointCloud<pcl::PointXYZ>::ConstPtr pointcloud_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  if (!use_height_) {
-    pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_2d_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-    for (const auto & point : pointcloud->points) {
-      pcl::PointXYZ point2d;
-      point2d.x = point.x;
-      point2d.y = point.y;
-      point2d.z = 0.0;
-      pointcloud_2d_ptr->push_back(point2d);
-    }
-    pointcloud_ptr = pointcloud_2d_ptr;
-  } else {
-    pointcloud_ptr = pointcloud;
-  }
-
-  // create tree
-  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-  tree->setInputCloud(pointcloud_ptr);
-
-  // clustering
+  // clustering, which measures the distance on the xy plane if use_height_ is false
   std::vector<pcl::PointIndices> cluster_indices;
-  pcl::EuclideanClusterExtraction<pcl::PointXYZ> pcl_euclidean_cluster;
-  pcl_euclidean_cluster.setClusterTolerance(tolerance_);
-  pcl_euclidean_cluster.setMinClusterSize(min_cluster_size_);
-  pcl_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
-  pcl_euclidean_cluster.setSearchMethod(tree);
-  pcl_euclidean_cluster.setInputCloud(pointcloud_ptr);
-  pcl_euclidean_cluster.extract(cluster_indices);
+  GridEuclideanClusterExtraction grid_euclidean_cluster;
+  grid_euclidean_cluster.setClusterTolerance(tolerance_);
+  grid_euclidean_cluster.setMinClusterSize(min_cluster_size_);
+  grid_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
+  grid_euclidean_cluster.setUseHeight(use_height_);
+  grid_euclidean_cluster.setWorkerPool(worker_pool_.get());
+  grid_euclidean_cluster.extract(*pointcloud, cluster_indices);
 
   // build output
   {
@@ -0,0 +1,298 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/euclidean_cluster_object_detector/grid_euclidean_cluster_extraction.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace autoware::euclidean_cluster
+{
+namespace
+{
+// Union-find whose operations can run concurrently. A root is always linked under a smaller
+// root, so the parents only decrease and the compare-and-swap never forms a cycle.
+class ConcurrentDisjointSet
+{
+public:
+  explicit ConcurrentDisjointSet(const size_t size) : parents_(size)
+  {
+    for (size_t i = 0; i < size; ++i) {
+      parents_[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    }
+  }
+
+  uint32_t find(uint32_t x)
+  {
+    while (true) {
+      uint32_t parent = parents_[x].load(std::memory_order_relaxed);
+      if (parent == x) {
+        return x;
+      }
+      const uint32_t grandparent = parents_[parent].load(std::memory_order_relaxed);
+      if (grandparent != parent) {
+        // path halving, which is harmless if another thread has already changed the parent
+        parents_[x].compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+      }
+      x = grandparent;
+    }
+  }
+
+  void unite(uint32_t a, uint32_t b)
+  {
+    while (true) {
+      a = find(a);
+      b = find(b);
+      if (a == b) {
+        return;
+      }
+      if (a < b) {
+        std::swap(a, b);
+      }
+      uint32_t expected = a;
+      if (parents_[a].compare_exchange_strong(expected, b, std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+private:
+  std::vector<std::atomic<uint32_t>> parents_;
+};
+
+struct CellPoint
+{
+  int64_t cell_x;
+  int64_t cell_y;
+  uint32_t index;
+};
+
+bool operator<(const CellPoint & a, const CellPoint & b)
+{
+  return std::tie(a.cell_x, a.cell_y, a.index) < std::tie(b.cell_x, b.cell_y, b.index);
+}
+
+// Sort the points, which are in the order of their indices, by their cells. The cells span the
+// extent of a scan in most cases, so a counting sort on y and then on x is used.
+void sort_by_cell(std::vector<CellPoint> & cell_points)
+{
+  if (cell_points.empty()) {
+    return;
+  }
+  const auto [min_x, max_x] = std::minmax_element(
+    cell_points.begin(), cell_points.end(),
+    [](const CellPoint & a, const CellPoint & b) { return a.cell_x < b.cell_x; });
+  const auto [min_y, max_y] = std::minmax_element(
+    cell_points.begin(), cell_points.end(),
+    [](const CellPoint & a, const CellPoint & b) { return a.cell_y < b.cell_y; });
+  const auto range_x = static_cast<uint64_t>(max_x->cell_x - min_x->cell_x) + 1;
+  const auto range_y = static_cast<uint64_t>(max_y->cell_y - min_y->cell_y) + 1;
+  const uint64_t max_range = std::max<uint64_t>(4 * cell_points.size(), 1 << 16);
+  if (range_x > max_range || range_y > max_range) {
+    std::sort(cell_points.begin(), cell_points.end());
+    return;
+  }
+
+  std::vector<CellPoint> sorted(cell_points.size());
+  const auto counting_sort = [&sorted](
+                               std::vector<CellPoint> & points, const uint64_t range,
+                               const auto & to_bucket) {
+    std::vector<size_t> offsets(range + 1, 0);
+    for (const auto & point : points) {
+      ++offsets[to_bucket(point) + 1];
+    }
+    for (size_t i = 1; i < offsets.size(); ++i) {
+      offsets[i] += offsets[i - 1];
+    }
+    for (const auto & point : points) {
+      sorted[offsets[to_bucket(point)]++] = point;
+    }
+    points.swap(sorted);
+  };
+  const int64_t origin_x = min_x->cell_x;
+  const int64_t origin_y = min_y->cell_y;
+  counting_sort(cell_points, range_y, [origin_y](const CellPoint & point) {
+    return static_cast<uint64_t>(point.cell_y - origin_y);
+  });
+  counting_sort(cell_points, range_x, [origin_x](const CellPoint & point) {
+    return static_cast<uint64_t>(point.cell_x - origin_x);
+  });
+}
+}  // namespace
+
+void GridEuclideanClusterExtraction::extract(
+  const pcl::PointCloud<pcl::PointXYZ> & pointcloud,
+  std::vector<pcl::PointIndices> & cluster_indices) const
+{
+  cluster_indices.clear();
+
+  // Without the height, a cell whose diagonal is shorter than the tolerance is connected by
+  // itself, so that only a pair of points is checked between the cells. The margin absorbs the
+  // rounding of the cell coordinates.
+  const bool cells_are_connected = !use_height_ && tolerance_ > 0.0f;
+  const double cell_size = std::max(
+    cells_are_connected ? tolerance_ / std::sqrt(2.0) * 0.999 : static_cast<double>(tolerance_),
+    1e-3);
+  const auto reach = static_cast<int64_t>(std::ceil(tolerance_ / cell_size));
+  const float squared_tolerance = tolerance_ > 0.0f ? tolerance_ * tolerance_ : 0.0f;
+
+  // sort the points by their cells
+  std::vector<CellPoint> cell_points;
+  cell_points.reserve(pointcloud.size());
+  for (size_t i = 0; i < pointcloud.size(); ++i) {
+    const auto & point = pointcloud.points[i];
+    if (!std::isfinite(point.x) || !std::isfinite(point.y) || !std::isfinite(point.z)) {
+      continue;
+    }
+    cell_points.push_back(
+      {static_cast<int64_t>(std::floor(point.x / cell_size)),
+       static_cast<int64_t>(std::floor(point.y / cell_size)), static_cast<uint32_t>(i)});
+  }
+  sort_by_cell(cell_points);
+
+  // the points of the cell c are [cell_begins[c], cell_begins[c + 1]) in the sorted order, whose
+  // coordinates are gathered for the distance checks
+  std::vector<std::pair<int64_t, int64_t>> cells;
+  std::vector<uint32_t> cell_begins;
+  std::vector<float> xs(cell_points.size());
+  std::vector<float> ys(cell_points.size());
+  std::vector<float> zs(cell_points.size());
+  for (size_t p = 0; p < cell_points.size(); ++p) {
+    const auto & cell_point = cell_points[p];
+    const std::pair<int64_t, int64_t> cell{cell_point.cell_x, cell_point.cell_y};
+    if (cells.empty() || cells.back() != cell) {
+      cells.push_back(cell);
+      cell_begins.push_back(static_cast<uint32_t>(p));
+    }
+    const auto & point = pointcloud.points[cell_point.index];
+    xs[p] = point.x;
+    ys[p] = point.y;
+    zs[p] = use_height_ ? point.z : 0.0f;
+  }
+  cell_begins.push_back(static_cast<uint32_t>(cell_points.size()));
+
+  const auto is_within_tolerance = [&](const uint32_t p, const uint32_t q) {
+    const float dx = xs[p] - xs[q];
+    const float dy = ys[p] - ys[q];
+    const float dz = zs[p] - zs[q];
+    return dx * dx + dy * dy + dz * dz <= squared_tolerance;
+  };
+
+  ConcurrentDisjointSet disjoint_set(cell_points.size());
+  const auto connect_cells = [&](const size_t a, const size_t b) {
+    if (cells_are_connected) {
+      if (disjoint_set.find(cell_begins[a]) == disjoint_set.find(cell_begins[b])) {
+        return;
+      }
+      for (uint32_t p = cell_begins[a]; p < cell_begins[a + 1]; ++p) {
+        for (uint32_t q = cell_begins[b]; q < cell_begins[b + 1]; ++q) {
+          if (is_within_tolerance(p, q)) {
+            disjoint_set.unite(cell_begins[a], cell_begins[b]);
+            return;
+          }
+        }
+      }
+      return;
+    }
+    for (uint32_t p = cell_begins[a]; p < cell_begins[a + 1]; ++p) {
+      for (uint32_t q = a == b ? p + 1 : cell_begins[b]; q < cell_begins[b + 1]; ++q) {
+        if (disjoint_set.find(p) != disjoint_set.find(q) && is_within_tolerance(p, q)) {
+          disjoint_set.unite(p, q);
+        }
+      }
+    }
+  };
+
+  // each pair of the neighboring cells is checked once, from the smaller cell in the sorted order
+  const auto process_cell = [&](const size_t a) {
+    if (cells_are_connected) {
+      for (uint32_t p = cell_begins[a] + 1; p < cell_begins[a + 1]; ++p) {
+        disjoint_set.unite(cell_begins[a], p);
+      }
+    } else {
+      connect_cells(a, a);
+    }
+    const auto [cell_x, cell_y] = cells[a];
+    for (int64_t dx = 0; dx <= reach; ++dx) {
+      const std::pair<int64_t, int64_t> first{cell_x + dx, dx == 0 ? cell_y + 1 : cell_y - reach};
+      const auto last_y = cell_y + reach;
+      const auto begin = cells.begin() + static_cast<std::ptrdiff_t>(a);
+      for (auto it = std::lower_bound(begin, cells.end(), first);
+           it != cells.end() && it->first == first.first && it->second <= last_y; ++it) {
+        connect_cells(a, static_cast<size_t>(it - cells.begin()));
+      }
+    }
+  };
+
+  constexpr size_t cell_block_size = 64;
+  std::atomic<size_t> next_cell{0};
+  const auto work = [&]() {
+    for (size_t begin = next_cell.fetch_add(cell_block_size); begin < cells.size();
+         begin = next_cell.fetch_add(cell_block_size)) {
+      const size_t end = std::min(begin + cell_block_size, cells.size());
+      for (size_t a = begin; a < end; ++a) {
+        process_cell(a);
+      }
+    }
+  };
+  const size_t block_num = (cells.size() + cell_block_size - 1) / cell_block_size;
+  if (worker_pool_) {
+    // each task takes the blocks until none is left
+    const size_t task_num = std::min(worker_pool_->getThreadNum(), block_num);
+    worker_pool_->run(task_num, [&](const size_t) { work(); });
+  } else {
+    work();
+  }
+
+  // the clusters are numbered in the order of their smallest indices
+  constexpr uint32_t no_root = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> roots(pointcloud.size(), no_root);
+  for (size_t p = 0; p < cell_points.size(); ++p) {
+    roots[cell_points[p].index] = disjoint_set.find(static_cast<uint32_t>(p));
+  }
+  std::vector<uint32_t> root_to_cluster(cell_points.size(), no_root);
+  std::vector<pcl::PointIndices> clusters;
+  for (size_t i = 0; i < roots.size(); ++i) {
+    if (roots[i] == no_root) {
+      continue;
+    }
+    auto & cluster = root_to_cluster[roots[i]];
+    if (cluster == no_root) {
+      cluster = static_cast<uint32_t>(clusters.size());
+      clusters.emplace_back();
+    }
+    clusters[cluster].indices.push_back(static_cast<int>(i));
+  }
+
+  for (auto & cluster : clusters) {
+    const auto size = static_cast<int64_t>(cluster.indices.size());
+    if (size >= min_cluster_size_ && size <= max_cluster_size_) {
+      cluster.header = pointcloud.header;
+      cluster_indices.push_back(std::move(cluster));
+    }
+  }
+  std::stable_sort(
+    cluster_indices.begin(), cluster_indices.end(),
+    [](const pcl::PointIndices & a, const pcl::PointIndices & b) {
+      return a.indices.size() > b.indices.size();
+    });
+}
+
+}  // namespace autoware::euclidean_cluster
@@ -12,14 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <autoware/euclidean_cluster_object_detector/grid_euclidean_cluster_extraction.hpp>
 #include <autoware/euclidean_cluster_object_detector/voxel_grid_based_euclidean_cluster.hpp>
 #include <rclcpp/node.hpp>
 
-#include <pcl/kdtree/kdtree.h>
-#include <pcl/segmentation/extract_clusters.h>
-
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 namespace autoware::euclidean_cluster
@@ -107,32 +104,19 @@ bool VoxelGridBasedEuclideanCluster::cluster(
   voxel_grid_.setSaveLeafLayout(true);
   voxel_grid_.filter(*voxel_map_ptr);
 
-  // voxel is pressed 2d
-  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_2d_ptr(new pcl::PointCloud<pcl::PointXYZ>);
-  for (const auto & point : voxel_map_ptr->points) {
-    pcl::PointXYZ point2d;
-    point2d.x = point.x;
-    point2d.y = point.y;
-    point2d.z = 0.0;
-    pointcloud_2d_ptr->push_back(point2d);
-  }
-
-  // create tree
-  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
-  tree->setInputCloud(pointcloud_2d_ptr);
-
-  // clustering
+  // clustering on the xy plane
   std::vector<pcl::PointIndices> cluster_indices;
-  pcl::EuclideanClusterExtraction<pcl::PointXYZ> pcl_euclidean_cluster;
-  pcl_euclidean_cluster.setClusterTolerance(tolerance_);
-  pcl_euclidean_cluster.setMinClusterSize(1);
-  pcl_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
-  pcl_euclidean_cluster.setSearchMethod(tree);
-  pcl_euclidean_cluster.setInputCloud(pointcloud_2d_ptr);
-  pcl_euclidean_cluster.extract(cluster_indices);
-
-  // create map to search cluster index from voxel grid index
-  std::unordered_map</* voxel grid index */ int, /* cluster index */ int> map;
+  GridEuclideanClusterExtraction grid_euclidean_cluster;
+  grid_euclidean_cluster.setClusterTolerance(tolerance_);
+  grid_euclidean_cluster.setMinClusterSize(1);
+  grid_euclidean_cluster.setMaxClusterSize(max_cluster_size_);
+  grid_euclidean_cluster.setUseHeight(false);
+  grid_euclidean_cluster.setWorkerPool(worker_pool_.get());
+  grid_euclidean_cluster.extract(*voxel_map_ptr, cluster_indices);
+
+  // create table to search cluster index from voxel grid index
+  constexpr int no_cluster = -1;
+  std::vector</* cluster index */ int> voxel_to_cluster(voxel_map_ptr->points.size(), no_cluster);
   std::vector<sensor_msgs::msg::PointCloud2> temporary_clusters;  // no check about cluster size
   std::vector<size_t> clusters_data_size;
   temporary_clusters.resize(cluster_indices.size());
@@ -141,7 +125,7 @@ bool VoxelGridBasedEuclideanCluster::cluster(
     const auto & cluster = cluster_indices.at(cluster_idx);
     auto & temporary_cluster = temporary_clusters.at(cluster_idx);
     for (const auto & point_idx : cluster.indices) {
-      map[point_idx] = cluster_idx;
+      voxel_to_cluster[point_idx] = static_cast<int>(cluster_idx);
     }
     temporary_cluster.height = pointcloud_msg->height;
     temporary_cluster.fields = pointcloud_msg->fields;
@@ -162,21 +146,23 @@ bool VoxelGridBasedEuclideanCluster::cluster(
     const int index =
       voxel_grid_.getCentroidIndexAt(voxel_grid_.getGridCoordinates(point.x, point.y, point.z));
 #pragma GCC diagnostic pop
-    if (map.find(index) != map.end()) {
-      auto & cluster_data_size = clusters_data_size.at(map[index]);
-      if (
-        cluster_data_size >
-        static_cast<std::size_t>(max_cluster_size_) * static_cast<std::size_t>(point_step)) {
-        continue;
-      }
-      std::memcpy(
-        &temporary_clusters.at(map[index]).data[cluster_data_size],
-        &pointcloud_msg->data[i * point_step], point_step);
-      cluster_data_size += point_step;
-      if (cluster_data_size == temporary_clusters.at(map[index]).data.size()) {
-        temporary_clusters.at(map[index])
-          .data.resize(temporary_clusters.at(map[index]).data.size() * 2);
-      }
+    if (index < 0 || voxel_to_cluster[index] == no_cluster) {
+      continue;
+    }
+    const int cluster_idx = voxel_to_cluster[index];
+    auto & cluster_data_size = clusters_data_size.at(cluster_idx);
+    if (
+      cluster_data_size >
+      static_cast<std::size_t>(max_cluster_size_) * static_cast<std::size_t>(point_step)) {
+      continue;
+    }
+    auto & temporary_cluster = temporary_clusters.at(cluster_idx);
+    std::memcpy(
+      &temporary_cluster.data[cluster_data_size], &pointcloud_msg->data[i * point_step],
+      point_step);
+    cluster_data_size += point_step;
+    if (cluster_data_size == temporary_cluster.data.size()) {
+      temporary_cluster.data.resize(temporary_cluster.data.size() * 2);
     }
   }
 
@@ -16,6 +16,7 @@
 
 #include <autoware/euclidean_cluster_object_detector/utils.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -28,8 +29,10 @@ EuclideanClusterNode::EuclideanClusterNode(const rclcpp::NodeOptions & options)
   const int min_cluster_size = this->declare_parameter("min_cluster_size", 3);
   const int max_cluster_size = this->declare_parameter("max_cluster_size", 200);
   const float tolerance = this->declare_parameter("tolerance", 1.0);
+  const int thread_num = this->declare_parameter("thread_num", 1);
   cluster_ =
     std::make_shared<EuclideanCluster>(use_height, min_cluster_size, max_cluster_size, tolerance);
+  cluster_->setThreadNum(std::max(thread_num, 1));
 
   using std::placeholders::_1;
   pointcloud_sub_ = this->create_subscription<sensor_msgs::msg::PointCloud2>(
@@ -16,6 +16,7 @@
 
 #include <autoware/euclidean_cluster_object_detector/utils.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 
@@ -31,10 +32,12 @@ VoxelGridBasedEuclideanClusterNode::VoxelGridBasedEuclideanClusterNode(
   const float tolerance = this->declare_parameter("tolerance", 1.0);
   const float voxel_leaf_size = this->declare_parameter("voxel_leaf_size", 0.5);
   const int min_points_number_per_voxel = this->declare_parameter("min_points_number_per_voxel", 3);
+  const int thread_num = this->declare_parameter("thread_num", 1);
 
   cluster_ = std::make_shared<VoxelGridBasedEuclideanCluster>(
     use_height, min_cluster_size, max_cluster_size, tolerance, voxel_leaf_size,
     min_points_number_per_voxel);
+  cluster_->setThreadNum(std::max(thread_num, 1));
   // Pass the diagnostics interface pointer from the node to the cluster
   diagnostics_interface_ptr_ =
     std::make_unique<autoware_utils_diagnostics::DiagnosticsInterface>(this, "euclidean_cluster");
@@ -0,0 +1,191 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <autoware/euclidean_cluster_object_detector/grid_euclidean_cluster_extraction.hpp>
+
+#include <gtest/gtest.h>
+#include <pcl/kdtree/kdtree.h>
+#include <pcl/segmentation/extract_clusters.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+using autoware::euclidean_cluster::GridEuclideanClusterExtraction;
+using autoware::worker_pool::WorkerPool;
+
+namespace
+{
+// An obstacle scan around the vehicle after the ground removal: boxes of various sizes whose
+// surfaces are sampled more sparsely with the distance, and scattered noise points
+pcl::PointCloud<pcl::PointXYZ>::Ptr create_scan(const size_t object_num, const unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> position(-80.0f, 80.0f);
+  std::uniform_real_distribution<float> size(0.3f, 6.0f);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+  pcl::PointCloud<pcl::PointXYZ>::Ptr scan(new pcl::PointCloud<pcl::PointXYZ>);
+  for (size_t i = 0; i < object_num; ++i) {
+    const float x = position(engine);
+    const float y = position(engine);
+    const float length = size(engine);
+    const float width = size(engine) * 0.5f;
+    const float height = size(engine) * 0.4f;
+    const float distance = std::hypot(x, y);
+    const auto point_num = static_cast<size_t>(3000.0f / std::max(distance, 5.0f) * length);
+    for (size_t j = 0; j < point_num; ++j) {
+      scan->push_back(pcl::PointXYZ(
+        x + unit(engine) * length, y + unit(engine) * width, unit(engine) * height - 1.5f));
+    }
+  }
+  for (size_t i = 0; i < object_num * 5; ++i) {
+    scan->push_back(pcl::PointXYZ(position(engine), position(engine), unit(engine)));
+  }
+  scan->width = scan->size();
+  scan->height = 1;
+  return scan;
+}
+
+std::vector<pcl::PointIndices> extract_by_pcl(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud, const float tolerance,
+  const int min_cluster_size, const int max_cluster_size, const bool use_height)
+{
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud_ptr(
+    new pcl::PointCloud<pcl::PointXYZ>(*pointcloud));
+  if (!use_height) {
+    for (auto & point : pointcloud_ptr->points) {
+      point.z = 0.0f;
+    }
+  }
+  pcl::search::KdTree<pcl::PointXYZ>::Ptr tree(new pcl::search::KdTree<pcl::PointXYZ>);
+  tree->setInputCloud(pointcloud_ptr);
+
+  std::vector<pcl::PointIndices> cluster_indices;
+  pcl::EuclideanClusterExtraction<pcl::PointXYZ> pcl_euclidean_cluster;
+  pcl_euclidean_cluster.setClusterTolerance(tolerance);
+  pcl_euclidean_cluster.setMinClusterSize(min_cluster_size);
+  pcl_euclidean_cluster.setMaxClusterSize(max_cluster_size);
+  pcl_euclidean_cluster.setSearchMethod(tree);
+  pcl_euclidean_cluster.setInputCloud(pointcloud_ptr);
+  pcl_euclidean_cluster.extract(cluster_indices);
+  return cluster_indices;
+}
+
+std::vector<pcl::PointIndices> extract_by_grid(
+  const pcl::PointCloud<pcl::PointXYZ>::ConstPtr & pointcloud, const float tolerance,
+  const int min_cluster_size, const int max_cluster_size, const bool use_height,
+  const size_t thread_num)
+{
+  std::vector<pcl::PointIndices> cluster_indices;
+  GridEuclideanClusterExtraction grid_euclidean_cluster;
+  grid_euclidean_cluster.setClusterTolerance(tolerance);
+  grid_euclidean_cluster.setMinClusterSize(min_cluster_size);
+  grid_euclidean_cluster.setMaxClusterSize(max_cluster_size);
+  grid_euclidean_cluster.setUseHeight(use_height);
+  WorkerPool worker_pool(thread_num);
+  grid_euclidean_cluster.setWorkerPool(&worker_pool);
+  grid_euclidean_cluster.extract(*pointcloud, cluster_indices);
+  return cluster_indices;
+}
+
+// The clusters of the same size may be in any order in pcl::EuclideanClusterExtraction
+std::vector<std::vector<int>> to_sorted_clusters(const std::vector<pcl::PointIndices> & clusters)
+{
+  std::vector<std::vector<int>> sorted_clusters;
+  for (const auto & cluster : clusters) {
+    std::vector<int> indices(cluster.indices.begin(), cluster.indices.end());
+    std::sort(indices.begin(), indices.end());
+    sorted_clusters.push_back(indices);
+  }
+  std::sort(sorted_clusters.begin(), sorted_clusters.end());
+  return sorted_clusters;
+}
+}  // namespace
+
+TEST(GridEuclideanClusterExtractionTest, MatchesPclEuclideanClusterExtraction)
+{
+  for (const unsigned int seed : {0u, 1u, 2u}) {
+    const auto scan = create_scan(50, seed);
+    for (const bool use_height : {false, true}) {
+      for (const float tolerance : {0.3f, 0.7f, 1.5f}) {
+        const auto expected = extract_by_pcl(scan, tolerance, 3, 3000, use_height);
+        const auto actual = extract_by_grid(scan, tolerance, 3, 3000, use_height, 4);
+
+        EXPECT_EQ(to_sorted_clusters(actual), to_sorted_clusters(expected))
+          << "seed: " << seed << ", use_height: " << use_height << ", tolerance: " << tolerance;
+        for (size_t i = 1; i < actual.size(); ++i) {
+          EXPECT_GE(actual[i - 1].indices.size(), actual[i].indices.size());
+        }
+      }
+    }
+  }
+}
+
+TEST(GridEuclideanClusterExtractionTest, HandlesDegenerateInputs)
+{
+  pcl::PointCloud<pcl::PointXYZ>::Ptr empty(new pcl::PointCloud<pcl::PointXYZ>);
+  EXPECT_TRUE(extract_by_grid(empty, 0.7f, 1, 100, false, 4).empty());
+
+  // duplicated points, far points and a point without coordinates
+  pcl::PointCloud<pcl::PointXYZ>::Ptr pointcloud(new pcl::PointCloud<pcl::PointXYZ>);
+  pointcloud->push_back(pcl::PointXYZ(1.0f, 1.0f, 0.0f));
+  pointcloud->push_back(pcl::PointXYZ(1.0f, 1.0f, 0.0f));
+  pointcloud->push_back(pcl::PointXYZ(std::numeric_limits<float>::quiet_NaN(), 0.0f, 0.0f));
+  pointcloud->push_back(pcl::PointXYZ(1e5f, -1e5f, 0.0f));
+  pointcloud->push_back(pcl::PointXYZ(1.5f, 1.0f, 10.0f));
+
+  const auto clusters_2d = extract_by_grid(pointcloud, 0.7f, 1, 100, false, 4);
+  ASSERT_EQ(clusters_2d.size(), 2u);
+  EXPECT_EQ(clusters_2d[0].indices, (std::vector<int>{0, 1, 4}));
+  EXPECT_EQ(clusters_2d[1].indices, (std::vector<int>{3}));
+
+  const auto clusters_3d = extract_by_grid(pointcloud, 0.7f, 2, 100, true, 4);
+  ASSERT_EQ(clusters_3d.size(), 1u);
+  EXPECT_EQ(clusters_3d[0].indices, (std::vector<int>{0, 1}));
+}
+
+TEST(GridEuclideanClusterExtractionTest, DISABLED_Benchmark)
+{
+  for (const size_t object_num : {50u, 200u, 800u}) {
+    const auto scan = create_scan(object_num, 0);
+
+    const auto start_pcl = std::chrono::steady_clock::now();
+    const auto expected = extract_by_pcl(scan, 0.7f, 10, 3000, false);
+    const auto end_pcl = std::chrono::steady_clock::now();
+
+    std::cout << scan->size() << " points: pcl "
+              << std::chrono::duration<double, std::milli>(end_pcl - start_pcl).count() << " [ms]";
+    for (const size_t thread_num : {1u, 4u}) {
+      const auto start_grid = std::chrono::steady_clock::now();
+      const auto actual = extract_by_grid(scan, 0.7f, 10, 3000, false, thread_num);
+      const auto end_grid = std::chrono::steady_clock::now();
+      EXPECT_EQ(to_sorted_clusters(actual), to_sorted_clusters(expected));
+      std::cout << ", grid with " << thread_num << " threads "
+                << std::chrono::duration<double, std::milli>(end_grid - start_grid).count()
+                << " [ms]";
+    }
+    std::cout << std::endl;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
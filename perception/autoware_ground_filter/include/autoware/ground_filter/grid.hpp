@@ -105,12 +105,24 @@ struct Point
   float height;
 };
 
+// view of the points of a cell, which are stored contiguously in the grid
+struct PointList
+{
+  const Point * begin_ = nullptr;
+  const Point * end_ = nullptr;
+
+  inline const Point * begin() const { return begin_; }
+  inline const Point * end() const { return end_; }
+  inline size_t size() const { return static_cast<size_t>(end_ - begin_); }
+  inline bool empty() const { return begin_ == end_; }
+};
+
 // Concentric Zone Model (CZM) based polar grid
 class Cell
 {
 public:
-  // list of point indices
-  std::vector<Point> point_list_;  // point index and distance
+  // list of point indices, in the order in which they are added to the grid
+  PointList point_list_;  // point index and distance
 
   // method to check if the cell is empty
   inline bool isEmpty() const { return point_list_.empty(); }
@@ -181,6 +193,7 @@ public:
     // initialize and resize cells
     cells_.clear();
     cells_.resize(radial_idx_offsets_.back() + azimuth_grids_per_radial_.back());
+    cell_point_offsets_.assign(cells_.size() + 1, 0);
 
     // set cell geometry
     setCellGeometry();
@@ -189,7 +202,7 @@ public:
     is_initialized_ = true;
   }
 
-  // method to add a point to the grid
+  // method to add a point to the grid, which is stored in the cell by sortPoints()
   void addPoint(const float x, const float y, const float z, const size_t point_idx)
   {
     const float x_fixed = x - origin_x_;
@@ -206,8 +219,36 @@ public:
     }
     const size_t grid_idx_idx = static_cast<size_t>(grid_idx);
 
-    // add the point to the cell
-    cells_[grid_idx_idx].point_list_.emplace_back(Point{point_idx, radius, z});
+    // add the point to the cell, counting the points of the cell
+    added_points_.emplace_back(Point{point_idx, radius, z});
+    added_point_grid_idcs_.push_back(grid_idx_idx);
+    ++cell_point_offsets_[grid_idx_idx + 1];
+  }
+
+  // method to store the added points in the cells
+  // the points are sorted by their cells into one array by a counting sort, so that no memory is
+  // allocated for each cell
+  void sortPoints()
+  {
+    std::unique_ptr<ScopedTimeTrack> st_ptr;
+    if (time_keeper_) st_ptr = std::make_unique<ScopedTimeTrack>(__func__, *time_keeper_);
+
+    // accumulate the number of points per cell, set offset for each cell
+    for (size_t i = 1; i < cell_point_offsets_.size(); ++i) {
+      cell_point_offsets_[i] += cell_point_offsets_[i - 1];
+    }
+
+    // place the points, keeping the order in which they are added in each cell
+    points_.resize(added_points_.size());
+    cell_point_write_offsets_.assign(cell_point_offsets_.begin(), cell_point_offsets_.end() - 1);
+    for (size_t i = 0; i < added_points_.size(); ++i) {
+      points_[cell_point_write_offsets_[added_point_grid_idcs_[i]]++] = added_points_[i];
+    }
+
+    for (size_t idx = 0; idx < cells_.size(); ++idx) {
+      cells_[idx].point_list_.begin_ = points_.data() + cell_point_offsets_[idx];
+      cells_[idx].point_list_.end_ = points_.data() + cell_point_offsets_[idx + 1];
+    }
   }
 
   size_t getGridSize() const { return cells_.size(); }
@@ -227,8 +268,12 @@ public:
     std::unique_ptr<ScopedTimeTrack> st_ptr;
     if (time_keeper_) st_ptr = std::make_unique<ScopedTimeTrack>(__func__, *time_keeper_);
 
+    added_points_.clear();
+    added_point_grid_idcs_.clear();
+    std::fill(cell_point_offsets_.begin(), cell_point_offsets_.end(), 0);
+
     for (auto & cell : cells_) {
-      cell.point_list_.clear();
+      cell.point_list_ = PointList{};
       cell.is_processed_ = false;
       cell.is_ground_initialized_ = false;
       cell.has_ground_ = false;
@@ -284,6 +329,16 @@ private:
   // list of cells
   std::vector<Cell> cells_;
 
+  // points of the cells, where the points of the cell idx are
+  // [cell_point_offsets_[idx], cell_point_offsets_[idx + 1]) in points_
+  std::vector<Point> points_;
+  std::vector<size_t> cell_point_offsets_;
+
+  // buffers to sort the points, which are kept to reuse the memory
+  std::vector<Point> added_points_;
+  std::vector<size_t> added_point_grid_idcs_;
+  std::vector<size_t> cell_point_write_offsets_;
+
   // debug information
   std::shared_ptr<autoware_utils_debug::TimeKeeper> time_keeper_;
 
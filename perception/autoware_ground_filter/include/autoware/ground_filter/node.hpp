@@ -18,6 +18,7 @@
 #include "autoware/ground_filter/data.hpp"
 #include "autoware/ground_filter/ground_filter.hpp"
 
+#include <autoware/worker_pool/worker_pool.hpp>
 #include <autoware_utils_debug/time_keeper.hpp>
 #include <autoware_vehicle_info_utils/vehicle_info.hpp>
 
@@ -240,6 +241,9 @@ private:
   // grid ground filter processor
   std::unique_ptr<GroundFilter> ground_filter_ptr_;
 
+  // threads to process the azimuth angle groups in non-grid mode
+  std::unique_ptr<autoware::worker_pool::WorkerPool> worker_pool_ptr_;
+
   // time keeper related
   rclcpp::Publisher<autoware_utils_debug::ProcessingTimeDetail>::SharedPtr
     detailed_processing_time_publisher_;
@@ -281,6 +285,19 @@ private:
     const sensor_msgs::msg::PointCloud2::ConstSharedPtr & in_cloud,
     const std::vector<PointCloudVector> & in_radial_ordered_clouds,
     pcl::PointIndices & out_no_ground_indices) const;
+
+  /*!
+   * Classifies the Points in a ray, i.e. an azimuth angle group, as Ground and Not Ground
+   * @param in_radial_ordered_points Points of the ray ordered by radial distance from the origin
+   * @param virtual_ground_point Virtual ground origin point
+   * @param out_no_ground_indices Appended with the indices of the points classified as not
+   *     ground in the original PointCloud
+   */
+  void classifyRay(
+    const sensor_msgs::msg::PointCloud2::ConstSharedPtr & in_cloud,
+    const PointCloudVector & in_radial_ordered_points, const pcl::PointXYZ & virtual_ground_point,
+    pcl::PointIndices & out_no_ground_indices) const;
+
   /*!
    * Returns the resulting complementary PointCloud, one with the points kept
    * and the other removed as indicated in the indices
@@ -0,0 +1,72 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__GROUND_FILTER__RADIAL_DIVISION_HPP_
+#define AUTOWARE__GROUND_FILTER__RADIAL_DIVISION_HPP_
+
+#include <autoware_utils_math/normalization.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+namespace autoware::ground_filter
+{
+// an upper bound of the error of fast_atan2() [rad], with a margin for the float rounding
+constexpr double fast_atan2_error_bound = 1e-5;
+
+/** \brief Approximation of std::atan2() by a polynomial, whose error is about 2e-6 rad. It has no
+ * branches, so that a loop of it is vectorized. */
+inline float fast_atan2(const float y, const float x)
+{
+  const float abs_x = std::abs(x);
+  const float abs_y = std::abs(y);
+  const float max_abs = std::max(abs_x, abs_y);
+  const float ratio = max_abs > 0.0f ? std::min(abs_x, abs_y) / max_abs : 0.0f;
+  const float squared_ratio = ratio * ratio;
+  // minimax polynomial of atan() on [0, 1] in the Horner's method
+  float angle = -0.01172120f;
+  angle = angle * squared_ratio + 0.05265332f;
+  angle = angle * squared_ratio - 0.11643287f;
+  angle = angle * squared_ratio + 0.19354346f;
+  angle = angle * squared_ratio - 0.33262347f;
+  angle = angle * squared_ratio + 0.99997726f;
+  angle *= ratio;
+  angle = abs_y > abs_x ? static_cast<float>(M_PI_2) - angle : angle;
+  angle = x < 0.0f ? static_cast<float>(M_PI) - angle : angle;
+  return y < 0.0f ? -angle : angle;
+}
+
+/** \brief The azimuth angle group of the point, from the approximated azimuth angle
+ * fast_atan2(x, y). The group is recomputed by std::atan2() only if the approximated angle is
+ * too close to a border of the groups, so that it is always the same as the exact one. */
+inline size_t to_radial_division(
+  const float x, const float y, const float approximated_theta,
+  const float inv_radial_divider_angle_rad)
+{
+  const double theta =
+    approximated_theta < 0.0f ? approximated_theta + 2.0 * M_PI : approximated_theta;
+  const double lower_div =
+    std::floor((theta - fast_atan2_error_bound) * inv_radial_divider_angle_rad);
+  const double upper_div =
+    std::floor((theta + fast_atan2_error_bound) * inv_radial_divider_angle_rad);
+  if (lower_div == upper_div) {
+    return static_cast<size_t>(lower_div);
+  }
+  const auto exact_theta{autoware_utils_math::normalize_radian(std::atan2(x, y), 0.0)};
+  return static_cast<size_t>(std::floor(exact_theta * inv_radial_divider_angle_rad));
+}
+}  // namespace autoware::ground_filter
+
+#endif  // AUTOWARE__GROUND_FILTER__RADIAL_DIVISION_HPP_
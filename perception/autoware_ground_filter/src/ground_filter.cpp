@@ -40,6 +40,7 @@ void GroundFilter::convert()
     data_accessor_.getPoint(in_cloud_, data_index, input_point);
     grid_ptr_->addPoint(input_point.x, input_point.y, input_point.z, data_index);
   }
+  grid_ptr_->sortPoints();
 }
 
 // preprocess the grid data, set the grid connections
@@ -132,6 +133,9 @@ void GroundFilter::initializeGround(pcl::PointIndices & out_no_ground_indices)
   std::unique_ptr<ScopedTimeTrack> st_ptr;
   if (time_keeper_) st_ptr = std::make_unique<ScopedTimeTrack>(__func__, *time_keeper_);
 
+  // reused over the cells to avoid the memory allocation for each cell
+  PointsCentroid ground_bin;
+
   const auto grid_size = grid_ptr_->getGridSize();
   // loop over grid cells
   for (size_t idx = 0; idx < grid_size; idx++) {
@@ -151,7 +155,7 @@ void GroundFilter::initializeGround(pcl::PointIndices & out_no_ground_indices)
 
     // initialize ground in this cell
     bool is_ground_found = false;
-    PointsCentroid ground_bin;
+    ground_bin.initialize();
 
     for (const auto & pt : cell.point_list_) {
       const size_t & pt_idx = pt.index;
@@ -359,6 +363,10 @@ void GroundFilter::classify(pcl::PointIndices & out_no_ground_indices)
   std::unique_ptr<ScopedTimeTrack> st_ptr;
   if (time_keeper_) st_ptr = std::make_unique<ScopedTimeTrack>(__func__, *time_keeper_);
 
+  // reused over the cells to avoid the memory allocation for each cell
+  std::vector<int> grid_idcs;
+  PointsCentroid ground_bin;
+
   // loop over grid cells
   const auto grid_size = grid_ptr_->getGridSize();
   for (size_t idx = 0; idx < grid_size; idx++) {
@@ -374,7 +382,7 @@ void GroundFilter::classify(pcl::PointIndices & out_no_ground_indices)
     if (!(prev_cell.is_ground_initialized_)) continue;
 
     // get current cell gradient and intercept
-    std::vector<int> grid_idcs;
+    grid_idcs.clear();
     {
       const int search_count = param_.ground_grid_buffer_size;
       const int check_cell_idx = cell.scan_grid_root_idx_;
@@ -401,7 +409,7 @@ void GroundFilter::classify(pcl::PointIndices & out_no_ground_indices)
     }
 
     {
-      PointsCentroid ground_bin;
+      ground_bin.initialize();
       if (mode == SegmentationMode::CONTINUOUS) {
         // calculate the gradient and intercept by least square method
         float a, b;
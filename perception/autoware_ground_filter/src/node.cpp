@@ -15,6 +15,7 @@
 #include "autoware/ground_filter/node.hpp"
 
 #include "autoware/ground_filter/ground_filter.hpp"
+#include "autoware/ground_filter/radial_division.hpp"
 #include "autoware/ground_filter/sanity_check.hpp"
 
 #include <autoware_utils_geometry/geometry.hpp>
@@ -25,6 +26,9 @@
 #include <pcl_ros/transforms.hpp>
 #include <rclcpp/rclcpp.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
@@ -45,6 +49,9 @@ bool get_param(const std::vector<rclcpp::Parameter> & p, const std::string & nam
   }
   return false;
 }
+
+// the number of the points whose azimuth angles are computed together
+constexpr size_t point_block_size = 1024;
 }  // namespace
 
 namespace autoware::ground_filter
@@ -111,6 +118,11 @@ GroundFilterComponent::GroundFilterComponent(const rclcpp::NodeOptions & options
     ground_grid_buffer_size_ = rclcpp::Node::declare_parameter<int>("ground_grid_buffer_size");
     virtual_lidar_z_ = vehicle_info_.vehicle_height_m;
 
+    // multithreading parameters
+    const auto thread_num = rclcpp::Node::declare_parameter<int>("thread_num", 1);
+    worker_pool_ptr_ = std::make_unique<autoware::worker_pool::WorkerPool>(
+      static_cast<size_t>(std::max(thread_num, 1)));
+
     // initialize grid filter
     {
       GroundFilterParameter param;
@@ -408,6 +420,8 @@ void GroundFilterComponent::convertPointcloud(
 
   const size_t in_cloud_data_size = in_cloud->data.size();
   const size_t in_cloud_point_step = in_cloud->point_step;
+  const size_t in_cloud_point_num =
+    in_cloud_point_step > 0 ? in_cloud_data_size / in_cloud_point_step : 0;
 
   {  // grouping pointcloud by its azimuth angle
     std::unique_ptr<autoware_utils_debug::ScopedTimeTrack> inner_st_ptr;
@@ -415,23 +429,41 @@ void GroundFilterComponent::convertPointcloud(
       inner_st_ptr = std::make_unique<autoware_utils_debug::ScopedTimeTrack>(
         "azimuth_angle_grouping", *time_keeper_);
 
-    pcl::PointXYZ input_point;
-    for (size_t data_index = 0; data_index + in_cloud_point_step <= in_cloud_data_size;
-         data_index += in_cloud_point_step) {
-      // Get Point
-      data_accessor_.getPoint(in_cloud, data_index, input_point);
-
-      // determine the azimuth angle group
-      auto radius{static_cast<float>(std::hypot(input_point.x, input_point.y))};
-      auto theta{normalize_radian(std::atan2(input_point.x, input_point.y), 0.0)};
-      auto radial_div{static_cast<size_t>(std::floor(theta * inv_radial_divider_angle_rad))};
+    // the radius and the azimuth angle group are computed for blocks of points on the threads
+    std::vector<float> radii(in_cloud_point_num);
+    std::vector<size_t> radial_divs(in_cloud_point_num);
+    const size_t point_block_num = (in_cloud_point_num + point_block_size - 1) / point_block_size;
+    worker_pool_ptr_->run(point_block_num, [&](const size_t block) {
+      const size_t begin = block * point_block_size;
+      const size_t size = std::min(point_block_size, in_cloud_point_num - begin);
+      std::array<float, point_block_size> xs;
+      std::array<float, point_block_size> ys;
+      std::array<float, point_block_size> thetas;
+
+      pcl::PointXYZ input_point;
+      for (size_t k = 0; k < size; ++k) {
+        data_accessor_.getPoint(in_cloud, (begin + k) * in_cloud_point_step, input_point);
+        xs[k] = input_point.x;
+        ys[k] = input_point.y;
+        radii[begin + k] = static_cast<float>(std::hypot(input_point.x, input_point.y));
+      }
+      for (size_t k = 0; k < size; ++k) {
+        thetas[k] = fast_atan2(xs[k], ys[k]);
+      }
+      for (size_t k = 0; k < size; ++k) {
+        radial_divs[begin + k] =
+          to_radial_division(xs[k], ys[k], thetas[k], inv_radial_divider_angle_rad);
+      }
+    });
 
-      current_point.radius = radius;
+    // store the points in the order of their indices, since the sort below is not stable
+    for (size_t i = 0; i < in_cloud_point_num; ++i) {
+      current_point.radius = radii[i];
       current_point.point_state = PointLabel::INIT;
-      current_point.data_index = data_index;
+      current_point.data_index = i * in_cloud_point_step;
 
       // store the point in the corresponding radial division
-      out_radial_ordered_points[radial_div].emplace_back(current_point);
+      out_radial_ordered_points[radial_divs[i]].emplace_back(current_point);
     }
   }
 
@@ -440,11 +472,11 @@ void GroundFilterComponent::convertPointcloud(
     if (time_keeper_)
       inner_st_ptr = std::make_unique<autoware_utils_debug::ScopedTimeTrack>("sort", *time_keeper_);
 
-    for (size_t i = 0; i < radial_dividers_num_; ++i) {
+    worker_pool_ptr_->run(radial_dividers_num_, [&](const size_t i) {
       std::sort(
         out_radial_ordered_points[i].begin(), out_radial_ordered_points[i].end(),
         [](const PointData & a, const PointData & b) { return a.radius < b.radius; });
-    }
+    });
   }
 }
 
@@ -466,115 +498,146 @@ void GroundFilterComponent::classifyPointCloud(
 
   out_no_ground_indices.indices.clear();
 
-  const pcl::PointXYZ init_ground_point(0, 0, 0);
   pcl::PointXYZ virtual_ground_point(0, 0, 0);
   calcVirtualGroundOrigin(virtual_ground_point);
 
-  // run the classification algorithm for each ray (azimuth division)
-  for (size_t i = 0; i < in_radial_ordered_clouds.size(); ++i) {
-    float prev_gnd_radius = 0.0f;
-    float prev_gnd_slope = 0.0f;
-    PointsCentroid ground_cluster, non_ground_cluster;
-    PointLabel point_label_curr = PointLabel::INIT;
-
-    pcl::PointXYZ prev_gnd_point(0, 0, 0), point_curr, point_prev;
-
-    // iterate over the points in the ray
-    for (size_t j = 0; j < in_radial_ordered_clouds[i].size(); ++j) {
-      float points_distance = 0.0f;
-      const float local_slope_max_angle = local_slope_max_angle_rad_;
-
-      // set the previous point
-      point_prev = point_curr;
-      PointLabel point_label_prev = point_label_curr;
-
-      // set the current point
-      const PointData & pd = in_radial_ordered_clouds[i][j];
-      point_label_curr = pd.point_state;
-
-      data_accessor_.getPoint(in_cloud, pd.data_index, point_curr);
-      if (j == 0) {
-        bool is_front_side = (point_curr.x > virtual_ground_point.x);
-        if (use_virtual_ground_point_ && is_front_side) {
-          prev_gnd_point = virtual_ground_point;
-        } else {
-          prev_gnd_point = init_ground_point;
-        }
-        prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
-        prev_gnd_slope = 0.0f;
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
-        points_distance = calc_distance3d(point_curr, prev_gnd_point);
-      } else {
-        points_distance = calc_distance3d(point_curr, point_prev);
-      }
+  // run the classification algorithm for each ray (azimuth division). The rays are split into
+  // contiguous blocks on the threads, and the outputs of the blocks are concatenated in the order
+  // of the rays, so that the result does not depend on the number of the threads.
+  const size_t ray_num = in_radial_ordered_clouds.size();
+  const size_t thread_num = worker_pool_ptr_->getThreadNum();
+  const size_t ray_block_num = std::min(ray_num, thread_num == 1 ? 1 : thread_num * 4);
+  std::vector<pcl::PointIndices> block_no_ground_indices(ray_block_num);
+  worker_pool_ptr_->run(ray_block_num, [&](const size_t block) {
+    const size_t begin = ray_num * block / ray_block_num;
+    const size_t end = ray_num * (block + 1) / ray_block_num;
+    for (size_t i = begin; i < end; ++i) {
+      classifyRay(
+        in_cloud, in_radial_ordered_clouds[i], virtual_ground_point,
+        block_no_ground_indices[block]);
+    }
+  });
 
-      float radius_distance_from_gnd = pd.radius - prev_gnd_radius;
-      float height_from_gnd = point_curr.z - prev_gnd_point.z;
-      float height_from_obj = point_curr.z - non_ground_cluster.getAverageHeight();
-      bool calculate_slope = true;
-      bool is_point_close_to_prev =
-        (points_distance <
-         (pd.radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
-
-      float global_slope_ratio = point_curr.z / pd.radius;
-      // check points which is far enough from previous point
-      if (global_slope_ratio > global_slope_max_ratio_) {
-        point_label_curr = PointLabel::NON_GROUND;
-        calculate_slope = false;
-      } else if (
-        (point_label_prev == PointLabel::NON_GROUND) &&
-        (std::abs(height_from_obj) >= split_height_distance_)) {
-        calculate_slope = true;
-      } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
-        // close to the previous point, set point follow label
-        point_label_curr = PointLabel::POINT_FOLLOW;
-        calculate_slope = false;
-      }
-      if (is_point_close_to_prev) {
-        height_from_gnd = point_curr.z - ground_cluster.getAverageHeight();
-        radius_distance_from_gnd = pd.radius - ground_cluster.getAverageRadius();
-      }
-      if (calculate_slope) {
-        // far from the previous point
-        auto local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
-        if (local_slope - prev_gnd_slope > local_slope_max_angle) {
-          // the point is outside of the local slope threshold
-          point_label_curr = PointLabel::NON_GROUND;
-        } else {
-          point_label_curr = PointLabel::GROUND;
-        }
-      }
+  size_t no_ground_point_num = 0;
+  for (const auto & indices : block_no_ground_indices) {
+    no_ground_point_num += indices.indices.size();
+  }
+  out_no_ground_indices.indices.reserve(no_ground_point_num);
+  for (const auto & indices : block_no_ground_indices) {
+    out_no_ground_indices.indices.insert(
+      out_no_ground_indices.indices.end(), indices.indices.begin(), indices.indices.end());
+  }
+}
 
-      if (point_label_curr == PointLabel::GROUND) {
-        ground_cluster.initialize();
-        non_ground_cluster.initialize();
+void GroundFilterComponent::classifyRay(
+  const sensor_msgs::msg::PointCloud2::ConstSharedPtr & in_cloud,
+  const PointCloudVector & in_radial_ordered_points, const pcl::PointXYZ & virtual_ground_point,
+  pcl::PointIndices & out_no_ground_indices) const
+{
+  const pcl::PointXYZ init_ground_point(0, 0, 0);
+
+  float prev_gnd_radius = 0.0f;
+  float prev_gnd_slope = 0.0f;
+  PointsCentroid ground_cluster, non_ground_cluster;
+  PointLabel point_label_curr = PointLabel::INIT;
+
+  pcl::PointXYZ prev_gnd_point(0, 0, 0), point_curr, point_prev;
+
+  // iterate over the points in the ray
+  for (size_t j = 0; j < in_radial_ordered_points.size(); ++j) {
+    float points_distance = 0.0f;
+    const float local_slope_max_angle = local_slope_max_angle_rad_;
+
+    // set the previous point
+    point_prev = point_curr;
+    PointLabel point_label_prev = point_label_curr;
+
+    // set the current point
+    const PointData & pd = in_radial_ordered_points[j];
+    point_label_curr = pd.point_state;
+
+    data_accessor_.getPoint(in_cloud, pd.data_index, point_curr);
+    if (j == 0) {
+      bool is_front_side = (point_curr.x > virtual_ground_point.x);
+      if (use_virtual_ground_point_ && is_front_side) {
+        prev_gnd_point = virtual_ground_point;
+      } else {
+        prev_gnd_point = init_ground_point;
       }
-      if (point_label_curr == PointLabel::NON_GROUND) {
-        out_no_ground_indices.indices.push_back(pd.data_index);
-      } else if (  // NOLINT
-        (point_label_prev == PointLabel::NON_GROUND) &&
-        (point_label_curr == PointLabel::POINT_FOLLOW)) {
+      prev_gnd_radius = std::hypot(prev_gnd_point.x, prev_gnd_point.y);
+      prev_gnd_slope = 0.0f;
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+      points_distance = calc_distance3d(point_curr, prev_gnd_point);
+    } else {
+      points_distance = calc_distance3d(point_curr, point_prev);
+    }
+
+    float radius_distance_from_gnd = pd.radius - prev_gnd_radius;
+    float height_from_gnd = point_curr.z - prev_gnd_point.z;
+    float height_from_obj = point_curr.z - non_ground_cluster.getAverageHeight();
+    bool calculate_slope = true;
+    bool is_point_close_to_prev =
+      (points_distance <
+       (pd.radius * radial_divider_angle_rad_ + split_points_distance_tolerance_));
+
+    float global_slope_ratio = point_curr.z / pd.radius;
+    // check points which is far enough from previous point
+    if (global_slope_ratio > global_slope_max_ratio_) {
+      point_label_curr = PointLabel::NON_GROUND;
+      calculate_slope = false;
+    } else if (
+      (point_label_prev == PointLabel::NON_GROUND) &&
+      (std::abs(height_from_obj) >= split_height_distance_)) {
+      calculate_slope = true;
+    } else if (is_point_close_to_prev && std::abs(height_from_gnd) < split_height_distance_) {
+      // close to the previous point, set point follow label
+      point_label_curr = PointLabel::POINT_FOLLOW;
+      calculate_slope = false;
+    }
+    if (is_point_close_to_prev) {
+      height_from_gnd = point_curr.z - ground_cluster.getAverageHeight();
+      radius_distance_from_gnd = pd.radius - ground_cluster.getAverageRadius();
+    }
+    if (calculate_slope) {
+      // far from the previous point
+      auto local_slope = std::atan2(height_from_gnd, radius_distance_from_gnd);
+      if (local_slope - prev_gnd_slope > local_slope_max_angle) {
+        // the point is outside of the local slope threshold
         point_label_curr = PointLabel::NON_GROUND;
-        out_no_ground_indices.indices.push_back(pd.data_index);
-      } else if (  // NOLINT
-        (point_label_prev == PointLabel::GROUND) &&
-        (point_label_curr == PointLabel::POINT_FOLLOW)) {
-        point_label_curr = PointLabel::GROUND;
       } else {
+        point_label_curr = PointLabel::GROUND;
       }
+    }
 
-      // update the ground state
-      if (point_label_curr == PointLabel::GROUND) {
-        prev_gnd_radius = pd.radius;
-        prev_gnd_point = pcl::PointXYZ(point_curr.x, point_curr.y, point_curr.z);
-        ground_cluster.addPoint(pd.radius, point_curr.z);
-        prev_gnd_slope = ground_cluster.getAverageSlope();
-      }
-      // update the non ground state
-      if (point_label_curr == PointLabel::NON_GROUND) {
-        non_ground_cluster.addPoint(pd.radius, point_curr.z);
-      }
+    if (point_label_curr == PointLabel::GROUND) {
+      ground_cluster.initialize();
+      non_ground_cluster.initialize();
+    }
+    if (point_label_curr == PointLabel::NON_GROUND) {
+      out_no_ground_indices.indices.push_back(pd.data_index);
+    } else if (  // NOLINT
+      (point_label_prev == PointLabel::NON_GROUND) &&
+      (point_label_curr == PointLabel::POINT_FOLLOW)) {
+      point_label_curr = PointLabel::NON_GROUND;
+      out_no_ground_indices.indices.push_back(pd.data_index);
+    } else if (  // NOLINT
+      (point_label_prev == PointLabel::GROUND) &&
+      (point_label_curr == PointLabel::POINT_FOLLOW)) {
+      point_label_curr = PointLabel::GROUND;
+    } else {
+    }
+
+    // update the ground state
+    if (point_label_curr == PointLabel::GROUND) {
+      prev_gnd_radius = pd.radius;
+      prev_gnd_point = pcl::PointXYZ(point_curr.x, point_curr.y, point_curr.z);
+      ground_cluster.addPoint(pd.radius, point_curr.z);
+      prev_gnd_slope = ground_cluster.getAverageSlope();
+    }
+    // update the non ground state
+    if (point_label_curr == PointLabel::NON_GROUND) {
+      non_ground_cluster.addPoint(pd.radius, point_curr.z);
     }
   }
 }
@@ -0,0 +1,247 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/ground_filter/ground_filter.hpp"
+#include "autoware/ground_filter/grid.hpp"
+#include "reference_ground_filter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+using autoware::ground_filter::Grid;
+using autoware::ground_filter::GroundFilter;
+using autoware::ground_filter::GroundFilterParameter;
+
+namespace
+{
+constexpr float virtual_lidar_x = 1.5f;
+constexpr float virtual_lidar_z = 2.5f;
+
+// A scan of a gently sloped road, with obstacles and noise points below the road
+std::vector<pcl::PointXYZ> create_scan(const size_t point_num, const unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+  std::vector<pcl::PointXYZ> points;
+  for (size_t i = 0; i < point_num; ++i) {
+    // denser near the vehicle, as a lidar scan is
+    const float radius = 1.0f + 120.0f * unit(engine) * unit(engine);
+    const float azimuth = 2.0f * static_cast<float>(M_PI) * unit(engine);
+    const float x = radius * std::cos(azimuth);
+    const float y = radius * std::sin(azimuth);
+    float z = 0.02f * x + 0.05f * std::sin(0.1f * y) + 0.03f * (unit(engine) - 0.5f);
+    if (unit(engine) < 0.2f) {
+      z += 2.0f * unit(engine);
+    } else if (unit(engine) < 0.01f) {
+      z -= 1.0f;
+    }
+    points.emplace_back(x, y, z);
+  }
+  return points;
+}
+
+sensor_msgs::msg::PointCloud2::ConstSharedPtr to_cloud(const std::vector<pcl::PointXYZ> & points)
+{
+  auto cloud = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  uint32_t offset = 0;
+  for (const auto & name : {"x", "y", "z", "intensity"}) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = offset;
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    cloud->fields.push_back(field);
+    offset += sizeof(float);
+  }
+  cloud->point_step = offset;
+  cloud->height = 1;
+  cloud->width = points.size();
+  cloud->row_step = cloud->width * cloud->point_step;
+  cloud->data.resize(cloud->row_step);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const float values[] = {points[i].x, points[i].y, points[i].z, 0.0f};
+    std::memcpy(&cloud->data[i * cloud->point_step], values, sizeof(values));
+  }
+  return cloud;
+}
+
+GroundFilterParameter create_parameter()
+{
+  GroundFilterParameter param;
+  param.global_slope_max_angle_rad = 10.0f * static_cast<float>(M_PI) / 180.0f;
+  param.local_slope_max_angle_rad = 13.0f * static_cast<float>(M_PI) / 180.0f;
+  param.radial_divider_angle_rad = 1.0f * static_cast<float>(M_PI) / 180.0f;
+  param.use_recheck_ground_cluster = true;
+  param.use_lowest_point = true;
+  param.detection_range_z_max = 2.5f;
+  param.non_ground_height_threshold = 0.2f;
+  param.grid_size_m = 0.5f;
+  param.grid_mode_switch_radius = 20.0f;
+  param.ground_grid_buffer_size = 4;
+  param.virtual_lidar_x = virtual_lidar_x;
+  param.virtual_lidar_y = 0.0f;
+  param.virtual_lidar_z = virtual_lidar_z;
+  return param;
+}
+
+std::unique_ptr<Grid> create_grid()
+{
+  const auto param = create_parameter();
+  auto grid = std::make_unique<Grid>(virtual_lidar_x, 0.0f, virtual_lidar_z);
+  grid->initialize(
+    param.grid_size_m, param.radial_divider_angle_rad, param.grid_mode_switch_radius);
+  return grid;
+}
+
+template <typename GroundFilterType>
+std::vector<int> process(
+  GroundFilterType & ground_filter, const std::vector<pcl::PointXYZ> & points)
+{
+  const auto cloud = to_cloud(points);
+  ground_filter.setDataAccessor(cloud);
+  pcl::PointIndices no_ground_indices;
+  ground_filter.process(cloud, no_ground_indices);
+  return no_ground_indices.indices;
+}
+}  // namespace
+
+TEST(GroundFilterGridTest, StoresPointsInTheirCells)
+{
+  const auto grid = create_grid();
+  const auto points = create_scan(2000, 0);
+
+  // the cell of each point, found by adding the point alone
+  std::vector<std::vector<size_t>> expected_cells(grid->getGridSize());
+  for (size_t i = 0; i < points.size(); ++i) {
+    grid->resetCells();
+    grid->addPoint(points[i].x, points[i].y, points[i].z, i);
+    grid->sortPoints();
+    for (size_t idx = 0; idx < grid->getGridSize(); ++idx) {
+      if (!grid->getCell(idx).isEmpty()) {
+        expected_cells[idx].push_back(i);
+      }
+    }
+  }
+
+  // a scan of other points is added before, to check that the cells are reset
+  for (const auto & scan : {create_scan(3000, 1), points}) {
+    grid->resetCells();
+    for (size_t i = 0; i < scan.size(); ++i) {
+      grid->addPoint(scan[i].x, scan[i].y, scan[i].z, i);
+    }
+    grid->sortPoints();
+  }
+
+  for (size_t idx = 0; idx < grid->getGridSize(); ++idx) {
+    const auto & cell = grid->getCell(idx);
+    std::vector<size_t> indices;
+    for (const auto & point : cell.point_list_) {
+      indices.push_back(point.index);
+      const float x = points[point.index].x - virtual_lidar_x;
+      const float y = points[point.index].y;
+      EXPECT_FLOAT_EQ(point.distance, std::sqrt(x * x + y * y));
+      EXPECT_EQ(point.height, points[point.index].z);
+    }
+    EXPECT_EQ(indices, expected_cells[idx]) << "cell: " << idx;
+    EXPECT_EQ(cell.isEmpty(), expected_cells[idx].empty());
+  }
+}
+
+TEST(GroundFilterGridTest, ClassifiesObstaclesOnFlatGround)
+{
+  // flat ground around the vehicle, and the front and the back faces of a box at 10 m ahead, which
+  // is lifted from the ground
+  std::vector<pcl::PointXYZ> points;
+  for (float radius = 2.0f; radius < 40.0f; radius += 0.2f) {
+    for (float azimuth = 0.0f; azimuth < 2.0f * static_cast<float>(M_PI); azimuth += 0.01f) {
+      points.emplace_back(radius * std::cos(azimuth), radius * std::sin(azimuth), 0.0f);
+    }
+  }
+  const size_t ground_point_num = points.size();
+  for (const float x : {10.0f, 11.0f}) {
+    for (int y = -10; y <= 10; ++y) {
+      for (int z = 10; z <= 20; ++z) {
+        points.emplace_back(x, 0.1f * y, 0.1f * z);
+      }
+    }
+  }
+
+  auto param = create_parameter();
+  GroundFilter ground_filter(param);
+  for (int frame = 0; frame < 2; ++frame) {
+    const auto no_ground_indices = process(ground_filter, points);
+    const size_t point_step = 4 * sizeof(float);
+    std::vector<bool> is_no_ground(points.size(), false);
+    for (const auto data_index : no_ground_indices) {
+      is_no_ground[data_index / point_step] = true;
+    }
+    for (size_t i = 0; i < points.size(); ++i) {
+      EXPECT_EQ(is_no_ground[i], i >= ground_point_num) << "frame: " << frame << ", point: " << i;
+    }
+  }
+}
+
+TEST(GroundFilterGridTest, ClassificationMatchesThePerCellVectorLayout)
+{
+  auto param = create_parameter();
+  GroundFilter ground_filter(param);
+  autoware::ground_filter::reference::GroundFilter reference_ground_filter(param);
+
+  // the filters are reused for the scans, as the buffers of the grid are
+  for (unsigned int seed = 0; seed < 3; ++seed) {
+    const auto points = create_scan(30000, seed);
+    const auto expected_indices = process(reference_ground_filter, points);
+    EXPECT_FALSE(expected_indices.empty());
+    EXPECT_EQ(process(ground_filter, points), expected_indices) << "seed: " << seed;
+  }
+}
+
+TEST(GroundFilterGridTest, DISABLED_Benchmark)
+{
+  auto param = create_parameter();
+  GroundFilter ground_filter(param);
+
+  for (const size_t point_num : {30000u, 100000u, 300000u}) {
+    const auto cloud = to_cloud(create_scan(point_num, 0));
+    ground_filter.setDataAccessor(cloud);
+
+    constexpr int frame_num = 20;
+    pcl::PointIndices no_ground_indices;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frame_num; ++i) {
+      ground_filter.process(cloud, no_ground_indices);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << point_num << " points: "
+              << std::chrono::duration<double, std::milli>(end - start).count() / frame_num
+              << " [ms] per frame" << std::endl;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,217 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/ground_filter/node.hpp"
+#include "autoware/ground_filter/radial_division.hpp"
+
+#include <ament_index_cpp/get_package_share_directory.hpp>
+#include <autoware_utils_math/normalization.hpp>
+#include <autoware_utils_math/unit_conversion.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <gtest/gtest.h>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+using autoware::ground_filter::fast_atan2;
+using autoware::ground_filter::fast_atan2_error_bound;
+using autoware::ground_filter::GroundFilterComponent;
+using autoware::ground_filter::to_radial_division;
+
+namespace
+{
+// A scan of a gently sloped road with obstacles, and with some points exactly on the borders of
+// the azimuth angle groups
+std::vector<pcl::PointXYZ> create_scan(
+  const size_t point_num, const double radial_divider_angle_rad, const unsigned int seed)
+{
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+  std::vector<pcl::PointXYZ> points;
+  for (size_t i = 0; i < point_num; ++i) {
+    const float radius = 1.0f + 80.0f * unit(engine) * unit(engine);
+    const double border = std::floor(2.0 * M_PI / radial_divider_angle_rad * unit(engine));
+    const double azimuth =
+      i % 10 == 0 ? radial_divider_angle_rad * border : 2.0 * M_PI * unit(engine);
+    const float x = radius * static_cast<float>(std::sin(azimuth));
+    const float y = radius * static_cast<float>(std::cos(azimuth));
+    float z = 0.02f * x + 0.05f * std::sin(0.1f * y) + 0.03f * (unit(engine) - 0.5f);
+    if (unit(engine) < 0.2f) {
+      z += 2.0f * unit(engine);
+    }
+    points.emplace_back(x, y, z);
+  }
+  return points;
+}
+
+sensor_msgs::msg::PointCloud2::ConstSharedPtr to_cloud(const std::vector<pcl::PointXYZ> & points)
+{
+  auto cloud = std::make_shared<sensor_msgs::msg::PointCloud2>();
+  uint32_t offset = 0;
+  for (const auto & name : {"x", "y", "z", "intensity"}) {
+    sensor_msgs::msg::PointField field;
+    field.name = name;
+    field.offset = offset;
+    field.datatype = sensor_msgs::msg::PointField::FLOAT32;
+    field.count = 1;
+    cloud->fields.push_back(field);
+    offset += sizeof(float);
+  }
+  cloud->point_step = offset;
+  cloud->height = 1;
+  cloud->width = points.size();
+  cloud->row_step = cloud->width * cloud->point_step;
+  cloud->data.resize(cloud->row_step);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const float values[] = {points[i].x, points[i].y, points[i].z, 0.0f};
+    std::memcpy(&cloud->data[i * cloud->point_step], values, sizeof(values));
+  }
+  return cloud;
+}
+
+// The group of the point computed by std::atan2() alone
+size_t to_exact_radial_division(const float x, const float y, const float inv_angle_rad)
+{
+  const auto theta{autoware_utils_math::normalize_radian(std::atan2(x, y), 0.0)};
+  return static_cast<size_t>(std::floor(theta * inv_angle_rad));
+}
+}  // namespace
+
+class GroundFilterTest : public ::testing::Test
+{
+protected:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+
+  void TearDown() override { rclcpp::shutdown(); }
+
+  static std::shared_ptr<GroundFilterComponent> create_node(
+    const double radial_divider_angle_deg, const int thread_num)
+  {
+    rclcpp::NodeOptions options;
+    options.arguments(
+      {"--ros-args", "--params-file",
+       ament_index_cpp::get_package_share_directory("autoware_vehicle_info_utils") +
+         "/config/vehicle_info.param.yaml"});
+    options.append_parameter_override("elevation_grid_mode", false);
+    options.append_parameter_override("radial_divider_angle_deg", radial_divider_angle_deg);
+    options.append_parameter_override("global_slope_max_angle_deg", 10.0);
+    options.append_parameter_override("local_slope_max_angle_deg", 30.0);
+    options.append_parameter_override("split_points_distance_tolerance", 0.2);
+    options.append_parameter_override("use_virtual_ground_point", true);
+    options.append_parameter_override("split_height_distance", 0.2);
+    options.append_parameter_override("use_recheck_ground_cluster", true);
+    options.append_parameter_override("use_lowest_point", true);
+    options.append_parameter_override("detection_range_z_max", 2.5);
+    options.append_parameter_override("low_priority_region_x", -20.0);
+    options.append_parameter_override("center_pcl_shift", 0.0);
+    options.append_parameter_override("non_ground_height_threshold", 0.2);
+    options.append_parameter_override("grid_size_m", 0.5);
+    options.append_parameter_override("grid_mode_switch_radius", 20.0);
+    options.append_parameter_override("ground_grid_buffer_size", 4);
+    options.append_parameter_override("thread_num", thread_num);
+    options.append_parameter_override("publish_processing_time_detail", false);
+    return std::make_shared<GroundFilterComponent>(options);
+  }
+
+  // The indices of the points classified as not ground in non elevation_grid_mode
+  static std::vector<int> classify(
+    GroundFilterComponent & node, const sensor_msgs::msg::PointCloud2::ConstSharedPtr & cloud)
+  {
+    node.data_accessor_.setField(cloud);
+    std::vector<GroundFilterComponent::PointCloudVector> radial_ordered_points;
+    node.convertPointcloud(cloud, radial_ordered_points);
+    pcl::PointIndices no_ground_indices;
+    node.classifyPointCloud(cloud, radial_ordered_points, no_ground_indices);
+    return no_ground_indices.indices;
+  }
+};
+
+TEST_F(GroundFilterTest, ClassificationDoesNotDependOnTheThreadNum)
+{
+  for (const double radial_divider_angle_deg : {1.0, 0.1}) {
+    const auto radial_divider_angle_rad = autoware_utils_math::deg2rad(radial_divider_angle_deg);
+    const auto serial_node = create_node(radial_divider_angle_deg, 1);
+    const auto parallel_node = create_node(radial_divider_angle_deg, 4);
+
+    // the nodes are reused for the scans, as the thread pool is
+    for (unsigned int seed = 0; seed < 3; ++seed) {
+      const auto cloud = to_cloud(create_scan(50000, radial_divider_angle_rad, seed));
+      const auto expected_indices = classify(*serial_node, cloud);
+      EXPECT_FALSE(expected_indices.empty());
+      EXPECT_EQ(classify(*parallel_node, cloud), expected_indices)
+        << "radial_divider_angle_deg: " << radial_divider_angle_deg << ", seed: " << seed;
+    }
+  }
+}
+
+TEST(RadialDivisionTest, FastAtan2IsWithinTheErrorBound)
+{
+  for (int i = 0; i < 100000; ++i) {
+    const double azimuth = 2.0 * M_PI * i / 100000;
+    for (const float radius : {0.01f, 1.0f, 200.0f}) {
+      const float x = radius * static_cast<float>(std::sin(azimuth));
+      const float y = radius * static_cast<float>(std::cos(azimuth));
+      const double error =
+        autoware_utils_math::normalize_radian(fast_atan2(x, y) - std::atan2(x, y));
+      EXPECT_LT(std::abs(error), fast_atan2_error_bound) << "x: " << x << ", y: " << y;
+    }
+  }
+}
+
+TEST(RadialDivisionTest, MatchesStdAtan2AtTheBorders)
+{
+  for (const double radial_divider_angle_deg : {1.0, 0.5, 0.1, 3.0}) {
+    const auto radial_divider_angle_rad = autoware_utils_math::deg2rad(radial_divider_angle_deg);
+    const auto inv_angle_rad = 1.0f / static_cast<float>(radial_divider_angle_rad);
+    const auto border_num = static_cast<int>(std::ceil(2.0 * M_PI / radial_divider_angle_rad));
+
+    size_t mismatch_num = 0;
+    for (int border = 0; border < border_num; ++border) {
+      // on the border, and at the distances around the error bound of fast_atan2()
+      for (const double offset :
+           {0.0, 1e-7, -1e-7, 1e-6, -1e-6, 5e-6, -5e-6, 1e-5, -1e-5, 2e-5, -2e-5, 1e-4, -1e-4}) {
+        const double azimuth = border * radial_divider_angle_rad + offset;
+        for (const float radius : {0.5f, 10.0f, 100.0f}) {
+          const float x0 = radius * static_cast<float>(std::sin(azimuth));
+          const float y = radius * static_cast<float>(std::cos(azimuth));
+          // the neighboring floats step over the border
+          float x = x0;
+          for (int ulp = 0; ulp < 3; ++ulp) {
+            x = std::nextafter(x, -INFINITY);
+          }
+          for (int ulp = -3; ulp <= 3; ++ulp, x = std::nextafter(x, INFINITY)) {
+            const auto div = to_radial_division(x, y, fast_atan2(x, y), inv_angle_rad);
+            if (div != to_exact_radial_division(x, y, inv_angle_rad)) {
+              ++mismatch_num;
+            }
+          }
+        }
+      }
+    }
+    EXPECT_EQ(mismatch_num, 0u) << "radial_divider_angle_deg: " << radial_divider_angle_deg;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -32,7 +32,11 @@
 #include <autoware_vehicle_msgs/msg/turn_indicators_command.hpp>
 #include <nav_msgs/msg/odometry.hpp>
 
+#include <lanelet2_core/primitives/LaneletSequence.h>
+
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace autoware::path_generator
 {
@@ -81,6 +85,7 @@ private:
   rclcpp::Publisher<TurnIndicatorsCommand>::SharedPtr turn_signal_publisher_;
   rclcpp::Publisher<HazardLightsCommand>::SharedPtr hazard_signal_publisher_;
   rclcpp::Publisher<Float64Stamped>::SharedPtr debug_calculation_time_;
+  rclcpp::Publisher<Float64Stamped>::SharedPtr debug_trajectory_build_time_;
 
   rclcpp::TimerBase::SharedPtr timer_;
 
@@ -91,9 +96,25 @@ private:
 
   std::optional<lanelet::ConstLanelet> current_lanelet_{std::nullopt};
 
+  // trajectory built from the path points of a lanelet sequence, which depends neither on the ego
+  // pose nor on the route, so it is reused while the lanelet sequence is unchanged
+  struct BuiltTrajectory
+  {
+    lanelet::ConstLanelets lanelets;
+    double waypoint_group_separation_threshold;
+    double waypoint_group_interval_margin_ratio;
+
+    lanelet::LaneletSequence extended_lanelet_sequence;
+    double extended_arc_length;
+    std::vector<PathPointWithLaneId> path_points;
+    Trajectory trajectory;
+  };
+  std::optional<BuiltTrajectory> built_trajectory_{std::nullopt};
+
   mutable std::shared_ptr<autoware_utils_debug::TimeKeeper> time_keeper_{nullptr};
 
   autoware_utils_system::StopWatch<std::chrono::milliseconds> stop_watch_;
+  double trajectory_build_time_ms_{0.};
 
   void run();
 
@@ -105,7 +126,10 @@ private:
 
   std::optional<PathWithLaneId> generate_path(
     const lanelet::LaneletSequence & lanelet_sequence, const double s_start, const double s_end,
-    const Params & params) const;
+    const Params & params);
+
+  std::optional<BuiltTrajectory> build_trajectory(
+    const lanelet::LaneletSequence & lanelet_sequence, const Params & params) const;
 
   bool update_current_lanelet(const geometry_msgs::msg::Pose & current_pose, const Params & params);
 
@@ -65,6 +65,8 @@ PathGenerator::PathGenerator(const rclcpp::NodeOptions & node_options)
   time_keeper_ = std::make_shared<autoware_utils_debug::TimeKeeper>(debug_processing_time_detail);
 
   debug_calculation_time_ = create_publisher<Float64Stamped>("~/debug/processing_time_ms", 1);
+  debug_trajectory_build_time_ =
+    create_publisher<Float64Stamped>("~/debug/trajectory_build_time_ms", 1);
 
   const auto params = param_listener_->get_params();
 
@@ -340,13 +342,87 @@ std::optional<PathWithLaneId> PathGenerator::generate_path(
 
 std::optional<PathWithLaneId> PathGenerator::generate_path(
   const lanelet::LaneletSequence & lanelet_sequence, const double s_start, const double s_end,
-  const Params & params) const
+  const Params & params)
 {
   if (lanelet_sequence.empty()) {
     RCLCPP_ERROR(get_logger(), "Lanelet sequence is empty");
     return std::nullopt;
   }
 
+  // the trajectory is built again only if the lanelet sequence or the parameters have changed since
+  // the previous cycle, so that the output is the same as the one built in every cycle
+  stop_watch_.tic("build_trajectory");
+  if (
+    !params.reuse_built_trajectory || !built_trajectory_ ||
+    built_trajectory_->lanelets != lanelet_sequence.lanelets() ||
+    built_trajectory_->waypoint_group_separation_threshold !=
+      params.waypoint_group.separation_threshold ||
+    built_trajectory_->waypoint_group_interval_margin_ratio !=
+      params.waypoint_group.interval_margin_ratio) {
+    built_trajectory_ = build_trajectory(lanelet_sequence, params);
+  }
+  trajectory_build_time_ms_ = stop_watch_.toc("build_trajectory");
+  if (!built_trajectory_) {
+    return std::nullopt;
+  }
+
+  const auto & extended_lanelet_sequence = built_trajectory_->extended_lanelet_sequence;
+  const auto & extended_arc_length = built_trajectory_->extended_arc_length;
+  const auto & path_points_with_lane_id = built_trajectory_->path_points;
+  std::optional<Trajectory> trajectory = built_trajectory_->trajectory;
+
+  const auto s_path_start = utils::get_arc_length_on_path(
+    extended_lanelet_sequence, path_points_with_lane_id, extended_arc_length + s_start);
+  const auto s_path_end = utils::get_arc_length_on_path(
+    extended_lanelet_sequence, path_points_with_lane_id, extended_arc_length + s_end);
+
+  // Refine the trajectory by cropping
+  if (trajectory->length() - s_path_end > 0) {
+    trajectory->crop(0., s_path_end);
+  }
+
+  trajectory = utils::connect_path_to_goal_inside_lanelets(
+    *trajectory, extended_lanelet_sequence.lanelets(), planner_data_.goal_pose,
+    planner_data_.preferred_lanelets.back().id(), params.goal_connection.connection_section_length,
+    params.goal_connection.pre_goal_offset);
+
+  if (!trajectory) {
+    RCLCPP_ERROR(get_logger(), "Failed to connect trajectory to goal");
+    return std::nullopt;
+  }
+
+  if (trajectory->length() - s_path_start > 0) {
+    trajectory->crop(s_path_start, trajectory->length() - s_path_start);
+  }
+
+  // Compose the polished path
+  PathWithLaneId finalized_path_with_lane_id{};
+  finalized_path_with_lane_id.points = trajectory->restore();
+
+  if (finalized_path_with_lane_id.points.empty()) {
+    RCLCPP_ERROR(get_logger(), "Finalized path points are empty after cropping");
+    return std::nullopt;
+  }
+
+  // Set header which is needed to engage
+  finalized_path_with_lane_id.header.frame_id = planner_data_.route_frame_id;
+  finalized_path_with_lane_id.header.stamp = now();
+
+  const auto [left_bound, right_bound] = utils::get_path_bounds(
+    extended_lanelet_sequence,
+    std::max(0., extended_arc_length + s_start - vehicle_info_.max_longitudinal_offset_m),
+    extended_arc_length + s_end + vehicle_info_.max_longitudinal_offset_m);
+  finalized_path_with_lane_id.left_bound = left_bound;
+  finalized_path_with_lane_id.right_bound = right_bound;
+
+  return finalized_path_with_lane_id;
+}
+
+std::optional<PathGenerator::BuiltTrajectory> PathGenerator::build_trajectory(
+  const lanelet::LaneletSequence & lanelet_sequence, const Params & params) const
+{
+  autoware_utils_debug::ScopedTimeTrack st(__func__, *time_keeper_);
+
   std::vector<PathPointWithLaneId> path_points_with_lane_id{};
 
   const auto waypoint_groups = utils::get_waypoint_groups(
@@ -446,51 +522,14 @@ std::optional<PathWithLaneId> PathGenerator::generate_path(
   // Attach orientation for all the points
   trajectory->align_orientation_with_trajectory_direction();
 
-  const auto s_path_start = utils::get_arc_length_on_path(
-    extended_lanelet_sequence, path_points_with_lane_id, extended_arc_length + s_start);
-  const auto s_path_end = utils::get_arc_length_on_path(
-    extended_lanelet_sequence, path_points_with_lane_id, extended_arc_length + s_end);
-
-  // Refine the trajectory by cropping
-  if (trajectory->length() - s_path_end > 0) {
-    trajectory->crop(0., s_path_end);
-  }
-
-  trajectory = utils::connect_path_to_goal_inside_lanelets(
-    *trajectory, extended_lanelet_sequence.lanelets(), planner_data_.goal_pose,
-    planner_data_.preferred_lanelets.back().id(), params.goal_connection.connection_section_length,
-    params.goal_connection.pre_goal_offset);
-
-  if (!trajectory) {
-    RCLCPP_ERROR(get_logger(), "Failed to connect trajectory to goal");
-    return std::nullopt;
-  }
-
-  if (trajectory->length() - s_path_start > 0) {
-    trajectory->crop(s_path_start, trajectory->length() - s_path_start);
-  }
-
-  // Compose the polished path
-  PathWithLaneId finalized_path_with_lane_id{};
-  finalized_path_with_lane_id.points = trajectory->restore();
-
-  if (finalized_path_with_lane_id.points.empty()) {
-    RCLCPP_ERROR(get_logger(), "Finalized path points are empty after cropping");
-    return std::nullopt;
-  }
-
-  // Set header which is needed to engage
-  finalized_path_with_lane_id.header.frame_id = planner_data_.route_frame_id;
-  finalized_path_with_lane_id.header.stamp = now();
-
-  const auto [left_bound, right_bound] = utils::get_path_bounds(
+  return BuiltTrajectory{
+    lanelet_sequence.lanelets(),
+    params.waypoint_group.separation_threshold,
+    params.waypoint_group.interval_margin_ratio,
     extended_lanelet_sequence,
-    std::max(0., extended_arc_length + s_start - vehicle_info_.max_longitudinal_offset_m),
-    extended_arc_length + s_end + vehicle_info_.max_longitudinal_offset_m);
-  finalized_path_with_lane_id.left_bound = left_bound;
-  finalized_path_with_lane_id.right_bound = right_bound;
-
-  return finalized_path_with_lane_id;
+    extended_arc_length,
+    std::move(path_points_with_lane_id),
+    std::move(*trajectory)};
 }
 
 bool PathGenerator::update_current_lanelet(
@@ -539,6 +578,12 @@ void PathGenerator::publishStopWatchTime()
   calculation_time_data.stamp = this->now();
   calculation_time_data.data = stop_watch_.toc();
   debug_calculation_time_->publish(calculation_time_data);
+
+  // the part of the processing time which the reuse of the built trajectory saves
+  Float64Stamped trajectory_build_time_data{};
+  trajectory_build_time_data.stamp = calculation_time_data.stamp;
+  trajectory_build_time_data.data = trajectory_build_time_ms_;
+  debug_trajectory_build_time_->publish(trajectory_build_time_data);
 }
 }  // namespace autoware::path_generator
 
@@ -36,6 +36,7 @@
 #include <lanelet2_core/geometry/Lanelet.h>
 
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <optional>
 #include <set>
@@ -83,6 +84,132 @@ lanelet::BasicPoints3d to_lanelet_points(
     [](const auto & point) { return lanelet::utils::conversion::toLaneletPoint(point); });
   return lanelet_points;
 }
+
+// Segments of a line string bucketed into a uniform grid by their bounding boxes, so that the
+// segments which may intersect a segment are found without checking all the others
+class SegmentGrid
+{
+public:
+  explicit SegmentGrid(const lanelet::BasicLineString2d & line_string)
+  {
+    const size_t segment_num = line_string.size() - 1;
+    boxes_.reserve(segment_num);
+    bool is_finite = true;
+    double extent_sum = 0.;
+    for (size_t i = 0; i < segment_num; ++i) {
+      const auto & p1 = line_string.at(i);
+      const auto & p2 = line_string.at(i + 1);
+      const Box box{
+        std::min(p1.x(), p2.x()), std::min(p1.y(), p2.y()), std::max(p1.x(), p2.x()),
+        std::max(p1.y(), p2.y())};
+      is_finite = is_finite && std::isfinite(box.min_x) && std::isfinite(box.min_y) &&
+                  std::isfinite(box.max_x) && std::isfinite(box.max_y);
+      extent_sum += std::max(box.max_x - box.min_x, box.max_y - box.min_y);
+      boxes_.push_back(box);
+    }
+
+    // a grid of one cell, which checks all the segments, unless the coordinates are finite
+    if (is_finite) {
+      double max_x = std::numeric_limits<double>::lowest();
+      double max_y = std::numeric_limits<double>::lowest();
+      for (const auto & box : boxes_) {
+        min_x_ = std::min(min_x_, box.min_x);
+        min_y_ = std::min(min_y_, box.min_y);
+        max_x = std::max(max_x, box.max_x);
+        max_y = std::max(max_y, box.max_y);
+      }
+      // a cell of about a segment, enlarged so that there are not much more cells than segments
+      const double width = max_x - min_x_;
+      const double height = max_y - min_y_;
+      cell_size_ = std::max(
+        extent_sum / static_cast<double>(segment_num),
+        std::sqrt(width * height / static_cast<double>(4 * segment_num)));
+      if (cell_size_ > 0.) {
+        x_num_ = static_cast<size_t>(width / cell_size_) + 1;
+        y_num_ = static_cast<size_t>(height / cell_size_) + 1;
+      }
+    }
+
+    // the segments of each cell are listed in ascending order
+    cell_offsets_.assign(x_num_ * y_num_ + 1, 0);
+    for (const auto & box : boxes_) {
+      for_each_cell(box, [&](const size_t cell) { ++cell_offsets_[cell + 1]; });
+    }
+    for (size_t cell = 0; cell < x_num_ * y_num_; ++cell) {
+      cell_offsets_[cell + 1] += cell_offsets_[cell];
+    }
+    segment_indices_.resize(cell_offsets_.back());
+    std::vector<size_t> cell_sizes(x_num_ * y_num_, 0);
+    for (size_t i = 0; i < segment_num; ++i) {
+      for_each_cell(boxes_[i], [&](const size_t cell) {
+        segment_indices_[cell_offsets_[cell] + cell_sizes[cell]++] = i;
+      });
+    }
+  }
+
+  // indices of the segments after the i-th one whose bounding box touches its bounding box, in
+  // ascending order. The others cannot intersect with it.
+  void get_candidates(const size_t i, std::vector<size_t> & candidates) const
+  {
+    candidates.clear();
+    const auto & box = boxes_[i];
+    for_each_cell(box, [&](const size_t cell) {
+      const auto cell_begin = segment_indices_.begin() + cell_offsets_[cell];
+      const auto cell_end = segment_indices_.begin() + cell_offsets_[cell + 1];
+      for (auto j = std::upper_bound(cell_begin, cell_end, i); j != cell_end; ++j) {
+        const auto & other_box = boxes_[*j];
+        if (
+          other_box.min_x <= box.max_x && box.min_x <= other_box.max_x &&
+          other_box.min_y <= box.max_y && box.min_y <= other_box.max_y) {
+          candidates.push_back(*j);
+        }
+      }
+    });
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+  }
+
+private:
+  struct Box
+  {
+    double min_x;
+    double min_y;
+    double max_x;
+    double max_y;
+  };
+
+  // the cell index is monotonic in the coordinate, so the boxes which touch share a cell
+  size_t to_cell_index(const double value, const double min_value, const size_t num) const
+  {
+    if (num == 1) {
+      return 0;
+    }
+    return std::min(static_cast<size_t>((value - min_value) / cell_size_), num - 1);
+  }
+
+  template <typename Function>
+  void for_each_cell(const Box & box, const Function & function) const
+  {
+    const size_t x_begin = to_cell_index(box.min_x, min_x_, x_num_);
+    const size_t x_end = to_cell_index(box.max_x, min_x_, x_num_);
+    const size_t y_begin = to_cell_index(box.min_y, min_y_, y_num_);
+    const size_t y_end = to_cell_index(box.max_y, min_y_, y_num_);
+    for (size_t x = x_begin; x <= x_end; ++x) {
+      for (size_t y = y_begin; y <= y_end; ++y) {
+        function(x * y_num_ + y);
+      }
+    }
+  }
+
+  std::vector<Box> boxes_;
+  double min_x_{std::numeric_limits<double>::max()};
+  double min_y_{std::numeric_limits<double>::max()};
+  double cell_size_{0.};
+  size_t x_num_{1};
+  size_t y_num_{1};
+  std::vector<size_t> cell_offsets_;
+  std::vector<size_t> segment_indices_;
+};
 }  // namespace
 
 std::optional<lanelet::ConstLanelets> get_lanelets_within_route_up_to(
@@ -400,6 +527,9 @@ std::optional<double> get_first_self_intersection_arc_length(
   std::optional<double> intersection_arc_length_on_latter_segment = std::nullopt;
   double s = 0.;
 
+  const SegmentGrid segment_grid(line_string);
+  std::vector<size_t> candidate_indices;
+
   for (size_t i = 0; i < line_string.size() - 1; ++i) {
     if (
       first_self_intersection_index && i == first_self_intersection_index &&
@@ -411,7 +541,8 @@ std::optional<double> get_first_self_intersection_arc_length(
     s += lanelet::geometry::length(current_segment);
 
     lanelet::BasicPoints2d self_intersections{};
-    for (size_t j = i + 1; j < line_string.size() - 1; ++j) {
+    segment_grid.get_candidates(i, candidate_indices);
+    for (const auto j : candidate_indices) {
       const auto segment = lanelet::BasicSegment2d{line_string.at(j), line_string.at(j + 1)};
       if (
         segment.first == current_segment.second || segment.second == current_segment.first ||
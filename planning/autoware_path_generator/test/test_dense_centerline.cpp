@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace autoware::path_generator
 {
@@ -56,30 +57,23 @@ PathGenerator::InputData create_input_data()
 
   return input_data;
 }
-}  // namespace
 
-TEST(DenseCenterlineTest, generatePath)
+rclcpp::NodeOptions create_node_options()
 {
-  if (!rclcpp::ok()) {
-    rclcpp::init(0, nullptr);
-  }
-
   const auto autoware_test_utils_dir =
     ament_index_cpp::get_package_share_directory("autoware_test_utils");
   const auto path_generator_dir =
     ament_index_cpp::get_package_share_directory("autoware_path_generator");
 
-  const auto node_options = rclcpp::NodeOptions{}.arguments(
+  return rclcpp::NodeOptions{}.arguments(
     {"--ros-args", "--params-file",
      autoware_test_utils_dir + "/config/test_vehicle_info.param.yaml", "--params-file",
      autoware_test_utils_dir + "/config/test_nearest_search.param.yaml", "--params-file",
      path_generator_dir + "/config/path_generator.param.yaml"});
+}
 
-  PathGenerator path_generator(node_options);
-
-  const auto input_data = create_input_data();
-  path_generator.set_planner_data(input_data);
-
+Params get_params(PathGenerator & path_generator)
+{
   Params params;
   path_generator.get_parameter("path_length.backward", params.path_length.backward);
   path_generator.get_parameter("path_length.forward", params.path_length.forward);
@@ -91,10 +85,67 @@ TEST(DenseCenterlineTest, generatePath)
     "goal_connection.connection_section_length", params.goal_connection.connection_section_length);
   path_generator.get_parameter(
     "smooth_goal_connection.pre_goal_offset", params.goal_connection.pre_goal_offset);
+  path_generator.get_parameter("reuse_built_trajectory", params.reuse_built_trajectory);
+  return params;
+}
+}  // namespace
+
+TEST(DenseCenterlineTest, generatePath)
+{
+  if (!rclcpp::ok()) {
+    rclcpp::init(0, nullptr);
+  }
+
+  PathGenerator path_generator(create_node_options());
+
+  const auto input_data = create_input_data();
+  path_generator.set_planner_data(input_data);
+
+  const auto params = get_params(path_generator);
 
   const auto path = path_generator.generate_path(input_data.route_ptr->start_pose, params);
 
   ASSERT_TRUE(path.has_value());
   ASSERT_FALSE(path->points.empty());
 }
+
+TEST(DenseCenterlineTest, generatePathReusingBuiltTrajectory)
+{
+  if (!rclcpp::ok()) {
+    rclcpp::init(0, nullptr);
+  }
+
+  PathGenerator reusing_path_generator(create_node_options());
+  PathGenerator rebuilding_path_generator(create_node_options());
+
+  const auto input_data = create_input_data();
+  reusing_path_generator.set_planner_data(input_data);
+  rebuilding_path_generator.set_planner_data(input_data);
+
+  auto reusing_params = get_params(reusing_path_generator);
+  reusing_params.reuse_built_trajectory = true;
+  auto rebuilding_params = reusing_params;
+  rebuilding_params.reuse_built_trajectory = false;
+
+  // ego moves along the path over several lanelets, as in consecutive cycles
+  const auto initial_path =
+    rebuilding_path_generator.generate_path(input_data.route_ptr->start_pose, rebuilding_params);
+  ASSERT_TRUE(initial_path.has_value());
+  std::vector<geometry_msgs::msg::Pose> poses;
+  for (size_t i = 0; i < initial_path->points.size(); i += 10) {
+    poses.push_back(initial_path->points[i].point.pose);
+    poses.push_back(initial_path->points[i].point.pose);
+  }
+
+  for (size_t i = 0; i < poses.size(); ++i) {
+    auto expected = rebuilding_path_generator.generate_path(poses[i], rebuilding_params);
+    auto actual = reusing_path_generator.generate_path(poses[i], reusing_params);
+    ASSERT_EQ(actual.has_value(), expected.has_value()) << "pose: " << i;
+    if (!expected) {
+      continue;
+    }
+    actual->header.stamp = expected->header.stamp;
+    EXPECT_TRUE(*actual == *expected) << "pose: " << i;
+  }
+}
 }  // namespace autoware::path_generator
@@ -16,6 +16,14 @@
 
 #include <lanelet2_core/geometry/Lanelet.h>
 
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
 namespace
 {
 std::vector<autoware_internal_planning_msgs::msg::PathPointWithLaneId> create_path_points(
@@ -32,6 +40,80 @@ std::vector<autoware_internal_planning_msgs::msg::PathPointWithLaneId> create_pa
   }
   return path_points;
 }
+
+// The search over all the pairs of segments, which get_first_self_intersection_arc_length gives
+// the same result as
+std::optional<double> get_first_self_intersection_arc_length_by_all_pairs(
+  const lanelet::BasicLineString2d & line_string)
+{
+  if (line_string.size() < 3) {
+    return std::nullopt;
+  }
+
+  std::optional<size_t> first_self_intersection_index = std::nullopt;
+  std::optional<double> intersection_arc_length_on_latter_segment = std::nullopt;
+  double s = 0.;
+
+  for (size_t i = 0; i < line_string.size() - 1; ++i) {
+    if (
+      first_self_intersection_index && i == first_self_intersection_index &&
+      intersection_arc_length_on_latter_segment) {
+      return s + *intersection_arc_length_on_latter_segment;
+    }
+
+    const auto current_segment = lanelet::BasicSegment2d{line_string.at(i), line_string.at(i + 1)};
+    s += lanelet::geometry::length(current_segment);
+
+    lanelet::BasicPoints2d self_intersections{};
+    for (size_t j = i + 1; j < line_string.size() - 1; ++j) {
+      const auto segment = lanelet::BasicSegment2d{line_string.at(j), line_string.at(j + 1)};
+      if (
+        segment.first == current_segment.second || segment.second == current_segment.first ||
+        segment.first == current_segment.first) {
+        continue;
+      }
+      boost::geometry::intersection(current_segment, segment, self_intersections);
+      if (self_intersections.empty()) {
+        continue;
+      }
+      first_self_intersection_index = j;
+      intersection_arc_length_on_latter_segment =
+        (self_intersections.front() - segment.first).norm();
+      break;
+    }
+  }
+
+  return std::nullopt;
+}
+
+// A bound which loops around several times and then crosses all the loops
+lanelet::BasicLineString2d create_looping_bound(const size_t point_num)
+{
+  lanelet::BasicLineString2d bound;
+  for (size_t i = 0; i < point_num; ++i) {
+    const double angle = 0.05 * static_cast<double>(i);
+    const double radius = 10.0 + 0.1 * angle;
+    bound.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+  }
+  bound.emplace_back(0.0, 0.0);
+  bound.emplace_back(1000.0, 0.0);
+  return bound;
+}
+
+// A bound which goes straight, makes a U-turn and comes back across itself
+lanelet::BasicLineString2d create_u_turn_bound(const size_t point_num)
+{
+  lanelet::BasicLineString2d bound;
+  const size_t half_point_num = point_num / 2;
+  for (size_t i = 0; i < half_point_num; ++i) {
+    bound.emplace_back(0.5 * static_cast<double>(i), 0.0);
+  }
+  for (size_t i = 0; i < half_point_num; ++i) {
+    const double ratio = static_cast<double>(i) / static_cast<double>(half_point_num);
+    bound.emplace_back(0.5 * static_cast<double>(half_point_num - i) - 0.3, 3.0 - 6.0 * ratio);
+  }
+  return bound;
+}
 }  // namespace
 
 namespace autoware::path_generator
@@ -159,6 +241,67 @@ TEST_F(UtilsTest, getFirstSelfIntersectionArcLength)
   }
 }
 
+TEST(SelfIntersectionTest, getFirstSelfIntersectionArcLengthMatchesAllPairs)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+  for (size_t trial = 0; trial < 3000; ++trial) {
+    // random points, points on a coarse lattice which share vertices and overlap, and collinear
+    // points, at various scales
+    const size_t point_num = 2 + trial % 40;
+    const double scale = trial % 3 == 0 ? 1.0 : (trial % 3 == 1 ? 10.0 : 0.1);
+    lanelet::BasicLineString2d line_string;
+    for (size_t i = 0; i < point_num; ++i) {
+      if (trial % 5 == 0) {
+        line_string.emplace_back(std::round(4.0 * unit(engine)), std::round(4.0 * unit(engine)));
+      } else if (trial % 5 == 1 && i > 0) {
+        line_string.emplace_back(line_string.back().x() + scale * (unit(engine) - 0.3), 0.0);
+      } else {
+        line_string.emplace_back(scale * unit(engine), scale * unit(engine));
+      }
+    }
+
+    const auto expected = get_first_self_intersection_arc_length_by_all_pairs(line_string);
+    const auto actual = utils::get_first_self_intersection_arc_length(line_string);
+    ASSERT_EQ(actual.has_value(), expected.has_value()) << "trial: " << trial;
+    if (expected) {
+      ASSERT_EQ(*actual, *expected) << "trial: " << trial;
+    }
+  }
+
+  for (const auto & line_string : {create_looping_bound(1000), create_u_turn_bound(1000)}) {
+    const auto expected = get_first_self_intersection_arc_length_by_all_pairs(line_string);
+    const auto actual = utils::get_first_self_intersection_arc_length(line_string);
+    ASSERT_TRUE(expected);
+    ASSERT_TRUE(actual);
+    ASSERT_EQ(*actual, *expected);
+  }
+}
+
+TEST(SelfIntersectionTest, DISABLED_Benchmark)
+{
+  for (const size_t point_num : {1000u, 3000u, 10000u}) {
+    for (const auto & [name, line_string] :
+         {std::make_pair("looping", create_looping_bound(point_num)),
+          std::make_pair("U-turn", create_u_turn_bound(point_num))}) {
+      const auto start_all_pairs = std::chrono::steady_clock::now();
+      const auto expected = get_first_self_intersection_arc_length_by_all_pairs(line_string);
+      const auto end_all_pairs = std::chrono::steady_clock::now();
+      const auto actual = utils::get_first_self_intersection_arc_length(line_string);
+      const auto end_grid = std::chrono::steady_clock::now();
+      EXPECT_EQ(actual, expected);
+
+      const auto all_pairs_time =
+        std::chrono::duration<double, std::milli>(end_all_pairs - start_all_pairs).count();
+      std::cout << name << " bound of " << point_num << " points: all pairs " << all_pairs_time
+                << " [ms], grid "
+                << std::chrono::duration<double, std::milli>(end_grid - end_all_pairs).count()
+                << " [ms]" << std::endl;
+    }
+  }
+}
+
 TEST_F(UtilsTest, GetArcLengthOnPath)
 {
   const auto epsilon = 1e-1;
@@ -37,9 +37,14 @@
 #include <lanelet2_routing/RoutingCost.h>
 #include <lanelet2_traffic_rules/TrafficRules.h>
 
+#include <cstdint>
 #include <limits>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -75,14 +80,83 @@ struct PiecewiseWaypoints
 };
 using Waypoints = std::vector<PiecewiseWaypoints>;
 
+// Reference points of the center line path of a lanelet sequence, in the order of the path
+struct CenterLineReferencePoints
+{
+  std::vector<geometry_msgs::msg::Point> points;
+  std::vector<lanelet::Id> lane_ids;
+  std::vector<float> speed_limits;
+  // 2d arc length from the first point to each point, with the path length appended
+  std::vector<double> arc_lengths;
+};
+
+// Reference points of the recently requested lanelet sequences, shared by the const queries
+class CenterLineCache
+{
+public:
+  // each lanelet is keyed with whether it is inverted, since its center line is reversed then
+  using Key = std::vector<std::pair<lanelet::Id, bool>>;
+
+  CenterLineCache() = default;
+  // a copied route handler starts with an empty cache
+  CenterLineCache(const CenterLineCache &) {}
+  CenterLineCache & operator=(const CenterLineCache &)
+  {
+    clear();
+    return *this;
+  }
+
+  std::shared_ptr<const CenterLineReferencePoints> find(const Key & key) const;
+  void insert(const Key & key, std::shared_ptr<const CenterLineReferencePoints> reference_points);
+  void clear();
+
+private:
+  static constexpr size_t max_entry_num{64};
+
+  mutable std::mutex mutex_;
+  std::map<Key, std::shared_ptr<const CenterLineReferencePoints>> entries_;
+};
+
+// Static relations of the map lanelets, which are looked up by the queries instead of searching
+// the map. The relations refer to the lanelets by their index, or none if there is no lanelet.
+struct LaneletTopology
+{
+  static constexpr uint32_t none{std::numeric_limits<uint32_t>::max()};
+
+  std::unordered_map<lanelet::Id, uint32_t> indices;
+  lanelet::Lanelets lanelets;
+
+  std::vector<uint32_t> following_shoulders;
+  std::vector<uint32_t> previous_shoulders;
+  std::vector<uint32_t> left_shoulders;
+  std::vector<uint32_t> right_shoulders;
+  // road lanelets next to the shoulder lanelets
+  std::vector<uint32_t> left_roads_of_shoulders;
+  std::vector<uint32_t> right_roads_of_shoulders;
+  // opposite lanelets of the i-th lanelet are in [offsets[i], offsets[i + 1]) of the list
+  std::vector<uint32_t> left_opposite_offsets;
+  std::vector<uint32_t> left_opposites;
+  std::vector<uint32_t> right_opposite_offsets;
+  std::vector<uint32_t> right_opposites;
+
+  // index of the lanelet, which is missing for an inverted lanelet or one out of the map
+  std::optional<uint32_t> find(const lanelet::ConstLanelet & lanelet) const;
+  std::optional<lanelet::ConstLanelet> at(const uint32_t index) const;
+  lanelet::Lanelets at(
+    const std::vector<uint32_t> & offsets, const std::vector<uint32_t> & list,
+    const uint32_t index) const;
+  size_t memorySize() const;
+};
+
 class RouteHandler
 {
 public:
   RouteHandler() = default;
-  explicit RouteHandler(const LaneletMapBin & map_msg);
+  explicit RouteHandler(const LaneletMapBin & map_msg, const size_t thread_num = 1);
 
   // non-const methods
-  void setMap(const LaneletMapBin & map_msg);
+  // the shoulder and opposite lanelets of the map are looked up on thread_num threads
+  void setMap(const LaneletMapBin & map_msg, const size_t thread_num = 1);
   void setRoute(const LaneletRoute & route_msg);
   void setRouteLanelets(const lanelet::ConstLanelets & path_lanelets);
   void clearRoute();
@@ -347,6 +421,19 @@ private:
   lanelet::ConstLanelets goal_lanelets_;
   std::shared_ptr<LaneletRoute> route_ptr_{nullptr};
 
+  // hashed ids and relations of the route lanelets, so that the queries do not scan the route
+  std::unordered_map<lanelet::Id, size_t> route_lanelet_indices_;  // index in route_lanelets_
+  std::unordered_set<lanelet::Id> preferred_lanelet_ids_;
+  std::unordered_set<lanelet::Id> start_lanelet_ids_;
+  std::unordered_set<lanelet::Id> goal_lanelet_ids_;
+  std::unordered_set<lanelet::Id> goal_section_lanelet_ids_;  // primitives of the last segment
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> next_lanelets_within_route_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> previous_lanelets_within_route_;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> neighbors_within_route_;
+  std::unordered_map<lanelet::Id, double> route_lanelet_lengths_;  // 3d length of the center line
+  CenterLineCache center_line_cache_;
+  LaneletTopology lanelet_topology_;
+
   rclcpp::Logger logger_{rclcpp::get_logger("route_handler")};
 
   bool is_map_msg_ready_{false};
@@ -358,6 +445,9 @@ private:
 
   // non-const methods
   void setLaneletsFromRouteMsg();
+  void setRouteLaneletRelations();
+  void setLaneletTopology(const size_t thread_num);
+  void clearRouteLaneletRelations();
 
   // const methods
   // for routing
@@ -365,6 +455,9 @@ private:
 
   // for lanelet
   lanelet::ConstLanelets getRouteLanelets() const;
+  double getCenterlineLength(const lanelet::ConstLanelet & lanelet) const;
+  std::shared_ptr<const CenterLineReferencePoints> getCenterLineReferencePoints(
+    const lanelet::ConstLanelets & lanelet_sequence) const;
   lanelet::ConstLanelets getLaneletSequenceUpTo(
     const lanelet::ConstLanelet & lanelet,
     const double min_length = std::numeric_limits<double>::max()) const;
@@ -44,6 +44,8 @@
 #include <lanelet2_routing/RoutingGraphContainer.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <limits>
@@ -52,6 +54,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -69,24 +72,25 @@ using autoware_utils_geometry::create_quaternion_from_yaw;
 using geometry_msgs::msg::Pose;
 using lanelet::utils::to2D;
 
-bool exists(const std::vector<LaneletPrimitive> & primitives, const int64_t & id)
+bool exists(const std::unordered_set<lanelet::Id> & ids, const lanelet::ConstLanelet & item)
 {
-  for (const auto & p : primitives) {
-    if (p.id == id) {
-      return true;
-    }
-  }
-  return false;
+  return ids.find(item.id()) != ids.end();
 }
 
-bool exists(const lanelet::ConstLanelets & vectors, const lanelet::ConstLanelet & item)
+bool exists(
+  const std::unordered_map<lanelet::Id, size_t> & indices, const lanelet::ConstLanelet & item)
 {
-  for (const auto & i : vectors) {
-    if (i.id() == item.id()) {
-      return true;
-    }
+  return indices.find(item.id()) != indices.end();
+}
+
+std::unordered_set<lanelet::Id> toIdSet(const lanelet::ConstLanelets & lanelets)
+{
+  std::unordered_set<lanelet::Id> ids;
+  ids.reserve(lanelets.size());
+  for (const auto & lanelet : lanelets) {
+    ids.insert(lanelet.id());
   }
-  return false;
+  return ids;
 }
 
 geometry_msgs::msg::Point getGeometryPointFrom2DArcLength(
@@ -207,13 +211,84 @@ std::string convertLaneletsIdToString(const lanelet::ConstLanelets & lanelets)
 }
 }  // namespace
 
-RouteHandler::RouteHandler(const LaneletMapBin & map_msg)
+std::shared_ptr<const CenterLineReferencePoints> CenterLineCache::find(const Key & key) const
+{
+  std::scoped_lock lock(mutex_);
+  const auto entry = entries_.find(key);
+  return entry == entries_.end() ? nullptr : entry->second;
+}
+
+void CenterLineCache::insert(
+  const Key & key, std::shared_ptr<const CenterLineReferencePoints> reference_points)
+{
+  std::scoped_lock lock(mutex_);
+  // the sequences around the ego change as it moves, so the old ones are dropped all at once
+  if (entries_.size() >= max_entry_num) {
+    entries_.clear();
+  }
+  entries_.emplace(key, std::move(reference_points));
+}
+
+void CenterLineCache::clear()
+{
+  std::scoped_lock lock(mutex_);
+  entries_.clear();
+}
+
+std::optional<uint32_t> LaneletTopology::find(const lanelet::ConstLanelet & lanelet) const
+{
+  if (lanelet.inverted()) {
+    return std::nullopt;
+  }
+  const auto index = indices.find(lanelet.id());
+  if (index == indices.end() || lanelets[index->second].constData() != lanelet.constData()) {
+    return std::nullopt;
+  }
+  return index->second;
+}
+
+std::optional<lanelet::ConstLanelet> LaneletTopology::at(const uint32_t index) const
+{
+  if (index == none) {
+    return std::nullopt;
+  }
+  return lanelets[index];
+}
+
+lanelet::Lanelets LaneletTopology::at(
+  const std::vector<uint32_t> & offsets, const std::vector<uint32_t> & list,
+  const uint32_t index) const
 {
-  setMap(map_msg);
+  lanelet::Lanelets related_lanelets;
+  related_lanelets.reserve(offsets[index + 1] - offsets[index]);
+  for (uint32_t i = offsets[index]; i < offsets[index + 1]; ++i) {
+    related_lanelets.push_back(lanelets[list[i]]);
+  }
+  return related_lanelets;
+}
+
+size_t LaneletTopology::memorySize() const
+{
+  // a node of the hash map is counted as its entry and two pointers
+  size_t size = indices.bucket_count() * sizeof(void *);
+  size += indices.size() * (sizeof(std::pair<const lanelet::Id, uint32_t>) + 2 * sizeof(void *));
+  size += lanelets.capacity() * sizeof(lanelet::Lanelet);
+  for (const auto * relation :
+       {&following_shoulders, &previous_shoulders, &left_shoulders, &right_shoulders,
+        &left_roads_of_shoulders, &right_roads_of_shoulders, &left_opposite_offsets,
+        &left_opposites, &right_opposite_offsets, &right_opposites}) {
+    size += relation->capacity() * sizeof(uint32_t);
+  }
+  return size;
+}
+
+RouteHandler::RouteHandler(const LaneletMapBin & map_msg, const size_t thread_num)
+{
+  setMap(map_msg, thread_num);
   route_ptr_ = nullptr;
 }
 
-void RouteHandler::setMap(const LaneletMapBin & map_msg)
+void RouteHandler::setMap(const LaneletMapBin & map_msg, const size_t thread_num)
 {
   lanelet_map_ptr_ = std::make_shared<lanelet::LaneletMap>();
   lanelet::utils::conversion::fromBinMsg(
@@ -241,9 +316,11 @@ void RouteHandler::setMap(const LaneletMapBin & map_msg)
   overall_graphs_ptr_ =
     std::make_shared<const lanelet::routing::RoutingGraphContainer>(overall_graphs);
   lanelet::ConstLanelets all_lanelets = lanelet::utils::query::laneletLayer(lanelet_map_ptr_);
+  setLaneletTopology(thread_num);
 
   is_map_msg_ready_ = true;
   is_handler_ready_ = false;
+  center_line_cache_.clear();
 
   setLaneletsFromRouteMsg();
 }
@@ -271,6 +348,13 @@ void RouteHandler::setRoute(const LaneletRoute & route_msg)
       original_goal_pose_ = route_msg.goal_pose;
     }
     route_ptr_ = std::make_shared<LaneletRoute>(route_msg);
+    center_line_cache_.clear();
+    goal_section_lanelet_ids_.clear();
+    if (!route_ptr_->segments.empty()) {
+      for (const auto & primitive : route_ptr_->segments.back().primitives) {
+        goal_section_lanelet_ids_.insert(primitive.id);
+      }
+    }
     is_handler_ready_ = false;
     setLaneletsFromRouteMsg();
   } else {
@@ -293,6 +377,8 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
     const auto & last_lanelet = path_lanelets.back();
     goal_lanelets_ = lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, last_lanelet);
   }
+  const auto start_lanelet_ids = toIdSet(start_lanelets_);
+  const auto goal_lanelet_ids = toIdSet(goal_lanelets_);
 
   // set route lanelets
   std::unordered_set<lanelet::Id> route_lanelets_id;
@@ -323,7 +409,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
     auto previous_lanelets = routing_graph_ptr_->previous(lanelet);
     bool is_connected_to_main_lanes_prev = false;
     bool is_connected_to_candidate_prev = true;
-    if (exists(start_lanelets_, lanelet)) {
+    if (exists(start_lanelet_ids, lanelet)) {
       is_connected_to_candidate_prev = false;
     }
     while (!previous_lanelets.empty() && is_connected_to_candidate_prev &&
@@ -335,7 +421,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
           is_connected_to_main_lanes_prev = true;
           break;
         }
-        if (exists(start_lanelets_, prev_lanelet)) {
+        if (exists(start_lanelet_ids, prev_lanelet)) {
           break;
         }
 
@@ -350,7 +436,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
     auto following_lanelets = routing_graph_ptr_->following(lanelet);
     bool is_connected_to_main_lanes_next = false;
     bool is_connected_to_candidate_next = true;
-    if (exists(goal_lanelets_, lanelet)) {
+    if (exists(goal_lanelet_ids, lanelet)) {
       is_connected_to_candidate_next = false;
     }
     while (!following_lanelets.empty() && is_connected_to_candidate_next &&
@@ -361,7 +447,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
           is_connected_to_main_lanes_next = true;
           break;
         }
-        if (exists(goal_lanelets_, next_lanelet)) {
+        if (exists(goal_lanelet_ids, next_lanelet)) {
           break;
         }
         if (candidate_lanes_id.find(next_lanelet.id()) != candidate_lanes_id.end()) {
@@ -390,6 +476,7 @@ void RouteHandler::setRouteLanelets(const lanelet::ConstLanelets & path_lanelets
       i++);
   }
   route_lanelets_rtree_ = RouteRtree(rtree_nodes);
+  setRouteLaneletRelations();
   is_handler_ready_ = true;
 }
 
@@ -400,10 +487,154 @@ void RouteHandler::clearRoute()
   preferred_lanelets_.clear();
   start_lanelets_.clear();
   goal_lanelets_.clear();
+  clearRouteLaneletRelations();
+  goal_section_lanelet_ids_.clear();
+  center_line_cache_.clear();
   route_ptr_ = nullptr;
   is_handler_ready_ = false;
 }
 
+void RouteHandler::setRouteLaneletRelations()
+{
+  clearRouteLaneletRelations();
+  route_lanelet_indices_.reserve(route_lanelets_.size());
+  for (size_t i = 0; i < route_lanelets_.size(); ++i) {
+    route_lanelet_indices_.emplace(route_lanelets_[i].id(), i);
+  }
+  preferred_lanelet_ids_ = toIdSet(preferred_lanelets_);
+  start_lanelet_ids_ = toIdSet(start_lanelets_);
+  goal_lanelet_ids_ = toIdSet(goal_lanelets_);
+  route_lanelet_lengths_.reserve(route_lanelets_.size());
+  for (const auto & llt : route_lanelets_) {
+    route_lanelet_lengths_.emplace(
+      llt.id(), static_cast<double>(boost::geometry::length(llt.centerline().basicLineString())));
+  }
+
+  // the tables are moved in after the loop, so that the queries below search the routing graph
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> next_lanelets_within_route;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> previous_lanelets_within_route;
+  std::unordered_map<lanelet::Id, lanelet::ConstLanelets> neighbors_within_route;
+  next_lanelets_within_route.reserve(route_lanelets_.size());
+  previous_lanelets_within_route.reserve(route_lanelets_.size());
+  neighbors_within_route.reserve(route_lanelets_.size());
+  for (const auto & llt : route_lanelets_) {
+    lanelet::ConstLanelets next_lanelets;
+    getNextLaneletsWithinRoute(llt, &next_lanelets);
+    next_lanelets_within_route.emplace(llt.id(), std::move(next_lanelets));
+
+    lanelet::ConstLanelets previous_lanelets;
+    getPreviousLaneletsWithinRoute(llt, &previous_lanelets);
+    previous_lanelets_within_route.emplace(llt.id(), std::move(previous_lanelets));
+
+    neighbors_within_route.emplace(llt.id(), getNeighborsWithinRoute(llt));
+  }
+  next_lanelets_within_route_ = std::move(next_lanelets_within_route);
+  previous_lanelets_within_route_ = std::move(previous_lanelets_within_route);
+  neighbors_within_route_ = std::move(neighbors_within_route);
+}
+
+void RouteHandler::setLaneletTopology(const size_t thread_num)
+{
+  const auto start_time = std::chrono::steady_clock::now();
+
+  // the queries below search the map while lanelet_topology_ is empty
+  lanelet_topology_ = LaneletTopology{};
+  LaneletTopology topology;
+  topology.indices.reserve(lanelet_map_ptr_->laneletLayer.size());
+  topology.lanelets.reserve(lanelet_map_ptr_->laneletLayer.size());
+  for (const auto & lanelet : lanelet_map_ptr_->laneletLayer) {
+    topology.indices.emplace(lanelet.id(), static_cast<uint32_t>(topology.lanelets.size()));
+    topology.lanelets.push_back(lanelet);
+    // the center line is calculated and stored on its first access, so it is done before the
+    // threads read it
+    static_cast<void>(lanelet.centerline());
+  }
+
+  const size_t lanelet_num = topology.lanelets.size();
+  const auto to_index = [&topology](const std::optional<lanelet::ConstLanelet> & lanelet) {
+    if (!lanelet) {
+      return LaneletTopology::none;
+    }
+    const auto index = topology.indices.find(lanelet->id());
+    return index == topology.indices.end() ? LaneletTopology::none : index->second;
+  };
+  topology.following_shoulders.resize(lanelet_num, LaneletTopology::none);
+  topology.previous_shoulders.resize(lanelet_num, LaneletTopology::none);
+  topology.left_shoulders.resize(lanelet_num, LaneletTopology::none);
+  topology.right_shoulders.resize(lanelet_num, LaneletTopology::none);
+  topology.left_roads_of_shoulders.resize(lanelet_num, LaneletTopology::none);
+  topology.right_roads_of_shoulders.resize(lanelet_num, LaneletTopology::none);
+  std::vector<std::vector<uint32_t>> left_opposites(lanelet_num);
+  std::vector<std::vector<uint32_t>> right_opposites(lanelet_num);
+
+  // each lanelet only writes its own relations, so the lanelets are searched in parallel
+  std::atomic<size_t> next_lanelet{0};
+  const auto work = [&]() {
+    for (size_t i = next_lanelet++; i < lanelet_num; i = next_lanelet++) {
+      const lanelet::ConstLanelet lanelet = topology.lanelets[i];
+      if (!lanelet.centerline().empty()) {
+        topology.following_shoulders[i] = to_index(getFollowingShoulderLanelet(lanelet));
+        topology.previous_shoulders[i] = to_index(getPreviousShoulderLanelet(lanelet));
+      }
+      topology.left_shoulders[i] = to_index(getLeftShoulderLanelet(lanelet));
+      topology.right_shoulders[i] = to_index(getRightShoulderLanelet(lanelet));
+      if (isShoulderLanelet(lanelet)) {
+        topology.left_roads_of_shoulders[i] = to_index(getLeftLanelet(lanelet));
+        topology.right_roads_of_shoulders[i] = to_index(getRightLanelet(lanelet));
+      }
+      for (const auto & opposite_lanelet : getLeftOppositeLanelets(lanelet)) {
+        left_opposites[i].push_back(to_index(opposite_lanelet));
+      }
+      for (const auto & opposite_lanelet : getRightOppositeLanelets(lanelet)) {
+        right_opposites[i].push_back(to_index(opposite_lanelet));
+      }
+    }
+  };
+  const size_t worker_num =
+    std::clamp<size_t>(thread_num, 1, std::max<size_t>(lanelet_num, 1));
+  std::vector<std::thread> workers;
+  for (size_t w = 1; w < worker_num; ++w) {
+    workers.emplace_back(work);
+  }
+  work();
+  for (auto & worker : workers) {
+    worker.join();
+  }
+
+  const auto flatten = [](
+                         const std::vector<std::vector<uint32_t>> & lists,
+                         std::vector<uint32_t> & offsets, std::vector<uint32_t> & list) {
+    offsets.reserve(lists.size() + 1);
+    offsets.push_back(0);
+    for (const auto & related_indices : lists) {
+      list.insert(list.end(), related_indices.begin(), related_indices.end());
+      offsets.push_back(static_cast<uint32_t>(list.size()));
+    }
+    list.shrink_to_fit();
+  };
+  flatten(left_opposites, topology.left_opposite_offsets, topology.left_opposites);
+  flatten(right_opposites, topology.right_opposite_offsets, topology.right_opposites);
+  lanelet_topology_ = std::move(topology);
+
+  RCLCPP_INFO(
+    logger_, "Built the topology of %zu lanelets in %.1f ms, which takes %.2f MB", lanelet_num,
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start_time)
+      .count(),
+    static_cast<double>(lanelet_topology_.memorySize()) / (1024.0 * 1024.0));
+}
+
+void RouteHandler::clearRouteLaneletRelations()
+{
+  route_lanelet_indices_.clear();
+  preferred_lanelet_ids_.clear();
+  start_lanelet_ids_.clear();
+  goal_lanelet_ids_.clear();
+  next_lanelets_within_route_.clear();
+  previous_lanelets_within_route_.clear();
+  neighbors_within_route_.clear();
+  route_lanelet_lengths_.clear();
+}
+
 void RouteHandler::setLaneletsFromRouteMsg()
 {
   if (!route_ptr_ || !is_map_msg_ready_) {
@@ -412,6 +643,7 @@ void RouteHandler::setLaneletsFromRouteMsg()
   route_lanelets_.clear();
   route_lanelets_rtree_.clear();
   preferred_lanelets_.clear();
+  clearRouteLaneletRelations();
   const bool is_route_valid = lanelet::utils::route::isRouteValid(*route_ptr_, lanelet_map_ptr_);
   if (!is_route_valid) {
     return;
@@ -457,6 +689,7 @@ void RouteHandler::setLaneletsFromRouteMsg()
       start_lanelets_.push_back(llt);
     }
   }
+  setRouteLaneletRelations();
   is_handler_ready_ = true;
 }
 
@@ -510,6 +743,16 @@ lanelet::ConstLanelets RouteHandler::getRouteLanelets() const
   return route_lanelets_;
 }
 
+double RouteHandler::getCenterlineLength(const lanelet::ConstLanelet & lanelet) const
+{
+  // the length of an inverted lanelet is the same
+  const auto length = route_lanelet_lengths_.find(lanelet.id());
+  if (length != route_lanelet_lengths_.end()) {
+    return length->second;
+  }
+  return static_cast<double>(boost::geometry::length(lanelet.centerline().basicLineString()));
+}
+
 lanelet::ConstLanelets RouteHandler::getPreferredLanelets() const
 {
   return preferred_lanelets_;
@@ -562,22 +805,17 @@ lanelet::Id RouteHandler::getGoalLaneId() const
 
 bool RouteHandler::getGoalLanelet(lanelet::ConstLanelet * goal_lanelet) const
 {
-  const lanelet::Id goal_lane_id = getGoalLaneId();
-  for (const auto & llt : route_lanelets_) {
-    if (llt.id() == goal_lane_id) {
-      *goal_lanelet = llt;
-      return true;
-    }
+  const auto goal_lanelet_index = route_lanelet_indices_.find(getGoalLaneId());
+  if (goal_lanelet_index == route_lanelet_indices_.end()) {
+    return false;
   }
-  return false;
+  *goal_lanelet = route_lanelets_[goal_lanelet_index->second];
+  return true;
 }
 
 bool RouteHandler::isInGoalRouteSection(const lanelet::ConstLanelet & lanelet) const
 {
-  if (!route_ptr_ || route_ptr_->segments.empty()) {
-    return false;
-  }
-  return exists(route_ptr_->segments.back().primitives, lanelet.id());
+  return exists(goal_section_lanelet_ids_, lanelet);
 }
 
 lanelet::ConstLanelets RouteHandler::getLaneletsFromIds(const lanelet::Ids & ids) const
@@ -611,7 +849,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_forward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!exists(route_lanelet_indices_, lanelet)) {
     return lanelet_sequence_forward;
   }
 
@@ -628,8 +866,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceAfter(
     }
     lanelet_sequence_forward.push_back(next_lanelet);
     current_lanelet = next_lanelet;
-    length +=
-      static_cast<double>(boost::geometry::length(next_lanelet.centerline().basicLineString()));
+    length += getCenterlineLength(next_lanelet);
   }
 
   return lanelet_sequence_forward;
@@ -639,7 +876,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
   const lanelet::ConstLanelet & lanelet, const double min_length) const
 {
   lanelet::ConstLanelets lanelet_sequence_backward;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!exists(route_lanelet_indices_, lanelet)) {
     return lanelet_sequence_backward;
   }
 
@@ -676,10 +913,9 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequenceUpTo(
     if (checkForLoop(previous_lanelets, true)) break;
 
     for (const auto & prev_lanelet : previous_lanelets) {
-      if (!isNewLanelet(prev_lanelet) || exists(goal_lanelets_, prev_lanelet)) continue;
+      if (!isNewLanelet(prev_lanelet) || exists(goal_lanelet_ids_, prev_lanelet)) continue;
       lanelet_sequence_backward.push_back(prev_lanelet);
-      length +=
-        static_cast<double>(boost::geometry::length(prev_lanelet.centerline().basicLineString()));
+      length += getCenterlineLength(prev_lanelet);
       current_lanelet = prev_lanelet;
       break;
     }
@@ -700,7 +936,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   }
 
   lanelet::ConstLanelets lanelet_sequence;
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!exists(route_lanelet_indices_, lanelet)) {
     return lanelet_sequence;
   }
 
@@ -733,7 +969,7 @@ lanelet::ConstLanelets RouteHandler::getLaneletSequence(
   const lanelet::ConstLanelet & lanelet, const Pose & current_pose, const double backward_distance,
   const double forward_distance) const
 {
-  if (!exists(route_lanelets_, lanelet)) {
+  if (!exists(route_lanelet_indices_, lanelet)) {
     return {};
   }
 
@@ -777,6 +1013,9 @@ lanelet::ConstLanelets RouteHandler::getRoadLaneletsAtPose(const Pose & pose) co
 std::optional<lanelet::ConstLanelet> RouteHandler::getFollowingShoulderLanelet(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto index = lanelet_topology_.find(lanelet)) {
+    return lanelet_topology_.at(lanelet_topology_.following_shoulders[*index]);
+  }
   bool found = false;
   const auto & search_point = lanelet.centerline().back().basicPoint2d();
   const auto next_lanelet = lanelet_map_ptr_->laneletLayer.nearestUntil(
@@ -793,6 +1032,9 @@ std::optional<lanelet::ConstLanelet> RouteHandler::getFollowingShoulderLanelet(
 std::optional<lanelet::ConstLanelet> RouteHandler::getLeftShoulderLanelet(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto index = lanelet_topology_.find(lanelet)) {
+    return lanelet_topology_.at(lanelet_topology_.left_shoulders[*index]);
+  }
   for (const auto & other_lanelet :
        lanelet_map_ptr_->laneletLayer.findUsages(lanelet.leftBound())) {
     if (other_lanelet.rightBound() == lanelet.leftBound() && isShoulderLanelet(other_lanelet))
@@ -804,6 +1046,9 @@ std::optional<lanelet::ConstLanelet> RouteHandler::getLeftShoulderLanelet(
 std::optional<lanelet::ConstLanelet> RouteHandler::getRightShoulderLanelet(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto index = lanelet_topology_.find(lanelet)) {
+    return lanelet_topology_.at(lanelet_topology_.right_shoulders[*index]);
+  }
   for (const auto & other_lanelet :
        lanelet_map_ptr_->laneletLayer.findUsages(lanelet.rightBound())) {
     if (other_lanelet.leftBound() == lanelet.rightBound() && isShoulderLanelet(other_lanelet))
@@ -855,6 +1100,9 @@ lanelet::ConstLanelets RouteHandler::getShoulderLaneletSequenceAfter(
 std::optional<lanelet::ConstLanelet> RouteHandler::getPreviousShoulderLanelet(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto index = lanelet_topology_.find(lanelet)) {
+    return lanelet_topology_.at(lanelet_topology_.previous_shoulders[*index]);
+  }
   bool found = false;
   const auto & search_point = lanelet.centerline().front().basicPoint2d();
   const auto previous_lanelet = lanelet_map_ptr_->laneletLayer.nearestUntil(
@@ -1079,16 +1327,23 @@ bool RouteHandler::getClosestRouteLaneletFromLanelet(
 bool RouteHandler::getNextLaneletsWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelets * next_lanelets) const
 {
-  if (exists(goal_lanelets_, lanelet)) {
+  if (exists(goal_lanelet_ids_, lanelet)) {
     return false;
   }
+  if (const auto relation = next_lanelets_within_route_.find(lanelet.id());
+      relation != next_lanelets_within_route_.end()) {
+    *next_lanelets = relation->second;
+    return !(next_lanelets->empty());
+  }
 
-  const auto start_lane_id = route_ptr_->segments.front().preferred_primitive.id;
+  const auto start_lane_id = route_ptr_ && !route_ptr_->segments.empty()
+                               ? route_ptr_->segments.front().preferred_primitive.id
+                               : lanelet::InvalId;
 
   const auto following_lanelets = routing_graph_ptr_->following(lanelet);
   next_lanelets->clear();
   for (const auto & llt : following_lanelets) {
-    if (start_lane_id != llt.id() && exists(route_lanelets_, llt)) {
+    if (start_lane_id != llt.id() && exists(route_lanelet_indices_, llt)) {
       next_lanelets->push_back(llt);
     }
   }
@@ -1114,13 +1369,18 @@ lanelet::ConstLanelets RouteHandler::getNextLanelets(const lanelet::ConstLanelet
 bool RouteHandler::getPreviousLaneletsWithinRoute(
   const lanelet::ConstLanelet & lanelet, lanelet::ConstLanelets * prev_lanelets) const
 {
-  if (exists(start_lanelets_, lanelet)) {
+  if (exists(start_lanelet_ids_, lanelet)) {
     return false;
   }
+  if (const auto relation = previous_lanelets_within_route_.find(lanelet.id());
+      relation != previous_lanelets_within_route_.end()) {
+    *prev_lanelets = relation->second;
+    return !(prev_lanelets->empty());
+  }
   const auto candidate_lanelets = routing_graph_ptr_->previous(lanelet);
   prev_lanelets->clear();
   for (const auto & llt : candidate_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (exists(route_lanelet_indices_, llt)) {
       prev_lanelets->push_back(llt);
     }
   }
@@ -1139,6 +1399,9 @@ std::optional<lanelet::ConstLanelet> RouteHandler::getRightLanelet(
 {
   // right road lanelet of shoulder lanelet
   if (isShoulderLanelet(lanelet)) {
+    if (const auto index = lanelet_topology_.find(lanelet)) {
+      return lanelet_topology_.at(lanelet_topology_.right_roads_of_shoulders[*index]);
+    }
     const auto right_lanelets = lanelet_map_ptr_->laneletLayer.findUsages(lanelet.rightBound());
     for (const auto & right_lanelet : right_lanelets)
       if (isRoadLanelet(right_lanelet)) return right_lanelet;
@@ -1205,6 +1468,9 @@ std::optional<lanelet::ConstLanelet> RouteHandler::getLeftLanelet(
 {
   // left road lanelet of shoulder lanelet
   if (isShoulderLanelet(lanelet)) {
+    if (const auto index = lanelet_topology_.find(lanelet)) {
+      return lanelet_topology_.at(lanelet_topology_.left_roads_of_shoulders[*index]);
+    }
     const auto left_lanelets = lanelet_map_ptr_->laneletLayer.findUsages(lanelet.leftBound());
     for (const auto & left_lanelet : left_lanelets)
       if (isRoadLanelet(left_lanelet)) return left_lanelet;
@@ -1268,6 +1534,10 @@ std::optional<lanelet::ConstLanelet> RouteHandler::getLeftLanelet(
 lanelet::Lanelets RouteHandler::getRightOppositeLanelets(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto index = lanelet_topology_.find(lanelet)) {
+    return lanelet_topology_.at(
+      lanelet_topology_.right_opposite_offsets, lanelet_topology_.right_opposites, *index);
+  }
   const auto opposite_candidate_lanelets =
     lanelet_map_ptr_->laneletLayer.findUsages(lanelet.rightBound().invert());
 
@@ -1371,6 +1641,10 @@ lanelet::ConstLanelets RouteHandler::getAllRightSharedLinestringLanelets(
 
 lanelet::Lanelets RouteHandler::getLeftOppositeLanelets(const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto index = lanelet_topology_.find(lanelet)) {
+    return lanelet_topology_.at(
+      lanelet_topology_.left_opposite_offsets, lanelet_topology_.left_opposites, *index);
+  }
   const auto opposite_candidate_lanelets =
     lanelet_map_ptr_->laneletLayer.findUsages(lanelet.leftBound().invert());
 
@@ -1516,7 +1790,7 @@ std::optional<lanelet::ConstLanelet> RouteHandler::getPullOutStartLane(
 int RouteHandler::getNumLaneToPreferredLane(
   const lanelet::ConstLanelet & lanelet, const Direction direction) const
 {
-  if (exists(preferred_lanelets_, lanelet)) {
+  if (exists(preferred_lanelet_ids_, lanelet)) {
     return 0;
   }
 
@@ -1526,7 +1800,7 @@ int RouteHandler::getNumLaneToPreferredLane(
       lanelet::utils::query::getAllNeighborsRight(routing_graph_ptr_, lanelet);
     for (const auto & right : right_lanes) {
       num--;
-      if (exists(preferred_lanelets_, right)) {
+      if (exists(preferred_lanelet_ids_, right)) {
         return num;
       }
     }
@@ -1538,7 +1812,7 @@ int RouteHandler::getNumLaneToPreferredLane(
     int num = 0;
     for (const auto & left : left_lanes) {
       num++;
-      if (exists(preferred_lanelets_, left)) {
+      if (exists(preferred_lanelet_ids_, left)) {
         return num;
       }
     }
@@ -1550,7 +1824,7 @@ int RouteHandler::getNumLaneToPreferredLane(
 std::vector<double> RouteHandler::getLateralIntervalsToPreferredLane(
   const lanelet::ConstLanelet & lanelet, const Direction direction) const
 {
-  if (exists(preferred_lanelets_, lanelet)) {
+  if (exists(preferred_lanelet_ids_, lanelet)) {
     return {};
   }
 
@@ -1569,7 +1843,7 @@ std::vector<double> RouteHandler::getLateralIntervalsToPreferredLane(
       const auto & next_pt = next_centerline.front();
       intervals.push_back(-lanelet::geometry::distance2d(to2D(curr_pt), to2D(next_pt)));
 
-      if (exists(preferred_lanelets_, right)) {
+      if (exists(preferred_lanelet_ids_, right)) {
         return intervals;
       }
       current_lanelet = right;
@@ -1591,7 +1865,7 @@ std::vector<double> RouteHandler::getLateralIntervalsToPreferredLane(
       const auto & next_pt = next_centerline.front();
       intervals.push_back(lanelet::geometry::distance2d(to2D(curr_pt), to2D(next_pt)));
 
-      if (exists(preferred_lanelets_, left)) {
+      if (exists(preferred_lanelet_ids_, left)) {
         return intervals;
       }
       current_lanelet = left;
@@ -1601,10 +1875,18 @@ std::vector<double> RouteHandler::getLateralIntervalsToPreferredLane(
   return {};
 }
 
-PathWithLaneId RouteHandler::getCenterLinePath(
-  const lanelet::ConstLanelets & lanelet_sequence, const double s_start, const double s_end,
-  bool use_exact) const
+std::shared_ptr<const CenterLineReferencePoints> RouteHandler::getCenterLineReferencePoints(
+  const lanelet::ConstLanelets & lanelet_sequence) const
 {
+  CenterLineCache::Key key;
+  key.reserve(lanelet_sequence.size());
+  for (const auto & llt : lanelet_sequence) {
+    key.emplace_back(llt.id(), llt.inverted());
+  }
+  if (auto reference_points = center_line_cache_.find(key)) {
+    return reference_points;
+  }
+
   using lanelet::utils::to2D;
   using lanelet::utils::conversion::toLaneletPoint;
 
@@ -1688,17 +1970,8 @@ PathWithLaneId RouteHandler::getCenterLinePath(
     }
   }
 
-  PathWithLaneId reference_path{};
-  const auto add_path_point =
-    [&](const auto & point, const auto & lanelet, const auto & speed_limit) {
-      PathPointWithLaneId p{};
-      p.point.pose.position = point;
-      p.lane_ids.push_back(lanelet.id());
-      p.point.longitudinal_velocity_mps = speed_limit;
-      reference_path.points.push_back(p);
-    };
-
-  // 4. convert to PathPointsWithLaneIds with cropping
+  // 4. flatten the reference points with their arc length, so that the path is cropped by a search
+  auto reference_points = std::make_shared<CenterLineReferencePoints>();
   double s = 0.0;
   for (size_t lanelet_idx = 0; lanelet_idx < lanelet_sequence.size(); ++lanelet_idx) {
     const auto & lanelet = lanelet_sequence.at(lanelet_idx);
@@ -1712,23 +1985,62 @@ PathWithLaneId RouteHandler::getCenterLinePath(
                                       ? piecewise_ref_points.at(ref_point_idx + 1)
                                       : piecewise_ref_points.at(ref_point_idx);
 
-      const double distance =
-        autoware_utils_geometry::calc_distance2d(ref_point.point, next_ref_point.point);
+      reference_points->points.push_back(ref_point.point);
+      reference_points->lane_ids.push_back(lanelet.id());
+      reference_points->speed_limits.push_back(speed_limit);
+      reference_points->arc_lengths.push_back(s);
+      s += autoware_utils_geometry::calc_distance2d(ref_point.point, next_ref_point.point);
+    }
+  }
+  reference_points->arc_lengths.push_back(s);
+
+  center_line_cache_.insert(key, reference_points);
+  return reference_points;
+}
 
-      if (s < s_start && s + distance > s_start) {
-        const auto p =
-          use_exact ? getGeometryPointFrom2DArcLength(lanelet_sequence, s_start) : ref_point.point;
-        add_path_point(p, lanelet, speed_limit);
-      }
-      if (s >= s_start && s <= s_end) {
-        add_path_point(ref_point.point, lanelet, speed_limit);
-      }
-      if (s < s_end && s + distance > s_end) {
-        const auto p =
-          use_exact ? getGeometryPointFrom2DArcLength(lanelet_sequence, s_end) : ref_point.point;
-        add_path_point(p, lanelet, speed_limit);
-      }
-      s += distance;
+PathWithLaneId RouteHandler::getCenterLinePath(
+  const lanelet::ConstLanelets & lanelet_sequence, const double s_start, const double s_end,
+  bool use_exact) const
+{
+  const auto reference_points = getCenterLineReferencePoints(lanelet_sequence);
+  const auto & points = reference_points->points;
+  const auto & arc_lengths = reference_points->arc_lengths;
+
+  PathWithLaneId reference_path{};
+  const auto add_path_point = [&](const auto & point, const size_t idx) {
+    PathPointWithLaneId p{};
+    p.point.pose.position = point;
+    p.lane_ids.push_back(reference_points->lane_ids.at(idx));
+    p.point.longitudinal_velocity_mps = reference_points->speed_limits.at(idx);
+    reference_path.points.push_back(p);
+  };
+
+  // convert to PathPointsWithLaneIds with cropping. The points whose segment ends before
+  // min(s_start, s_end) and the points after max(s_start, s_end) add nothing, so they are skipped.
+  const double s_min = std::min(s_start, s_end);
+  const auto arc_lengths_end = arc_lengths.begin() + static_cast<std::ptrdiff_t>(points.size());
+  const auto begin_idx = static_cast<size_t>(std::min(
+    std::lower_bound(arc_lengths.begin(), arc_lengths_end, s_min) - arc_lengths.begin(),
+    std::upper_bound(arc_lengths.begin() + 1, arc_lengths.end(), s_min) -
+      (arc_lengths.begin() + 1)));
+  const auto end_idx = static_cast<size_t>(
+    std::upper_bound(arc_lengths.begin(), arc_lengths_end, std::max(s_start, s_end)) -
+    arc_lengths.begin());
+  for (size_t idx = begin_idx; idx < end_idx; ++idx) {
+    const double s = arc_lengths.at(idx);
+    const double next_s = arc_lengths.at(idx + 1);
+    if (s < s_start && next_s > s_start) {
+      const auto p = use_exact ? getGeometryPointFrom2DArcLength(lanelet_sequence, s_start)
+                               : points.at(idx);
+      add_path_point(p, idx);
+    }
+    if (s >= s_start && s <= s_end) {
+      add_path_point(points.at(idx), idx);
+    }
+    if (s < s_end && next_s > s_end) {
+      const auto p =
+        use_exact ? getGeometryPointFrom2DArcLength(lanelet_sequence, s_end) : points.at(idx);
+      add_path_point(p, idx);
     }
   }
   reference_path = removeOverlappingPoints(reference_path);
@@ -1927,7 +2239,7 @@ bool RouteHandler::isShoulderLanelet(const lanelet::ConstLanelet & lanelet) cons
 
 bool RouteHandler::isRouteLanelet(const lanelet::ConstLanelet & lanelet) const
 {
-  return lanelet::utils::contains(route_lanelets_, lanelet);
+  return exists(route_lanelet_indices_, lanelet);
 }
 
 bool RouteHandler::isRoadLanelet(const lanelet::ConstLanelet & lanelet) const
@@ -1945,7 +2257,7 @@ lanelet::ConstLanelets RouteHandler::getPreviousLaneletSequence(
   }
 
   const auto & first_lane = lanelet_sequence.front();
-  if (exists(start_lanelets_, first_lane)) {
+  if (exists(start_lanelet_ids_, first_lane)) {
     return previous_lanelet_sequence;
   }
 
@@ -1971,11 +2283,15 @@ lanelet::ConstLanelets RouteHandler::getPreviousLaneletSequence(
 lanelet::ConstLanelets RouteHandler::getNeighborsWithinRoute(
   const lanelet::ConstLanelet & lanelet) const
 {
+  if (const auto relation = neighbors_within_route_.find(lanelet.id());
+      relation != neighbors_within_route_.end()) {
+    return relation->second;
+  }
   const lanelet::ConstLanelets neighbor_lanelets =
     lanelet::utils::query::getAllNeighbors(routing_graph_ptr_, lanelet);
   lanelet::ConstLanelets neighbors_within_route;
   for (const auto & llt : neighbor_lanelets) {
-    if (exists(route_lanelets_, llt)) {
+    if (exists(route_lanelet_indices_, llt)) {
       neighbors_within_route.push_back(llt);
     }
   }
@@ -17,10 +17,75 @@
 #include <autoware_utils_geometry/geometry.hpp>
 #include <rclcpp/rclcpp.hpp>
 
+#include <autoware_planning_msgs/msg/lanelet_primitive.hpp>
+
 #include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/utility/Utilities.h>
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <vector>
 
 namespace autoware::route_handler::test
 {
+namespace
+{
+struct StraightRoad
+{
+  LaneletMapBin map_bin;
+  lanelet::Ids lanelet_ids;
+};
+
+// A one-way road of lanelets of 10 m, each of which follows the previous one
+StraightRoad create_straight_road(const size_t lanelet_num)
+{
+  const auto create_point = [](const double x, const double y) {
+    return lanelet::Point3d(lanelet::utils::getId(), x, y, 0.0);
+  };
+
+  StraightRoad road;
+  auto lanelet_map = std::make_shared<lanelet::LaneletMap>();
+  auto prev_left_point = create_point(0.0, 1.75);
+  auto prev_right_point = create_point(0.0, -1.75);
+  for (size_t i = 0; i < lanelet_num; ++i) {
+    const double x = 10.0 * static_cast<double>(i + 1);
+    const auto left_point = create_point(x, 1.75);
+    const auto right_point = create_point(x, -1.75);
+    lanelet::Lanelet lanelet(
+      lanelet::utils::getId(),
+      lanelet::LineString3d(lanelet::utils::getId(), {prev_left_point, left_point}),
+      lanelet::LineString3d(lanelet::utils::getId(), {prev_right_point, right_point}));
+    lanelet.attributes()[lanelet::AttributeName::Subtype] = lanelet::AttributeValueString::Road;
+    lanelet.attributes()[lanelet::AttributeName::OneWay] = "yes";
+    lanelet_map->add(lanelet);
+    road.lanelet_ids.push_back(lanelet.id());
+    prev_left_point = left_point;
+    prev_right_point = right_point;
+  }
+  lanelet::utils::conversion::toBinMsg(lanelet_map, &road.map_bin);
+  return road;
+}
+
+// A route along the first route_lanelet_num lanelets, with one lanelet in each segment
+LaneletRoute create_route(const lanelet::Ids & lanelet_ids, const size_t route_lanelet_num)
+{
+  LaneletRoute route;
+  for (size_t i = 0; i < route_lanelet_num; ++i) {
+    autoware_planning_msgs::msg::LaneletPrimitive primitive;
+    primitive.id = lanelet_ids.at(i);
+    primitive.primitive_type = "lane";
+    LaneletSegment segment;
+    segment.preferred_primitive = primitive;
+    segment.primitives.push_back(primitive);
+    route.segments.push_back(segment);
+  }
+  return route;
+}
+}  // namespace
+
 TEST_F(TestRouteHandler, isRouteHandlerReadyTest)
 {
   ASSERT_TRUE(route_handler_->isHandlerReady());
@@ -222,6 +287,29 @@ TEST_F(TestRouteHandler, testGetCenterLinePath)
     ASSERT_EQ(center_line_path.points.back().lane_ids.at(0), 4785);
   }
 }
+TEST_F(TestRouteHandler, testGetCenterLinePathAtMovingOffsets)
+{
+  const auto current_lanes = route_handler_->getLaneletsFromIds({4424, 4780, 4785});
+
+  // the paths from the cached reference points match the ones built from scratch
+  std::vector<PathWithLaneId> cached_paths;
+  for (double s_start = -1.0; s_start < 80.0; s_start += 2.7) {
+    cached_paths.push_back(
+      route_handler_->getCenterLinePath(current_lanes, s_start, s_start + 30.0));
+  }
+  size_t path_idx = 0;
+  for (double s_start = -1.0; s_start < 80.0; s_start += 2.7) {
+    route_handler_->clearRoute();
+    const auto path = route_handler_->getCenterLinePath(current_lanes, s_start, s_start + 30.0);
+    const auto & cached_path = cached_paths.at(path_idx++);
+    ASSERT_EQ(path.points.size(), cached_path.points.size()) << "s_start: " << s_start;
+    for (size_t i = 0; i < path.points.size(); ++i) {
+      EXPECT_EQ(path.points.at(i).point.pose, cached_path.points.at(i).point.pose);
+      EXPECT_EQ(path.points.at(i).lane_ids, cached_path.points.at(i).lane_ids);
+    }
+  }
+}
+
 TEST_F(TestRouteHandler, DISABLED_testGetCenterLinePathWhenLanesIsNotConnected)
 {
   // broken current lanes. 4424 and 4785 are not connected directly.
@@ -298,6 +386,58 @@ TEST_F(TestRouteHandler, testGetLaneChangeTargetLanes)
   }
 }
 
+TEST_F(TestRouteHandler, testLaneletTopologyMatchesMapSearch)
+{
+  const auto to_id = [](const std::optional<lanelet::ConstLanelet> & lanelet) {
+    return lanelet ? lanelet->id() : lanelet::InvalId;
+  };
+  const auto to_ids = [](const lanelet::Lanelets & lanelets) {
+    lanelet::Ids ids;
+    for (const auto & lanelet : lanelets) {
+      ids.push_back(lanelet.id());
+    }
+    return ids;
+  };
+  // the topology does not depend on the number of the threads building it
+  for (const size_t thread_num : {1u, 4u}) {
+    set_route_handler("overlap_map.osm", thread_num);
+
+    for (const auto & lanelet : route_handler_->getLaneletMapPtr()->laneletLayer) {
+      // a lanelet which is not the one in the map is searched in the map instead of looked up
+      const lanelet::ConstLanelet searched_lanelet(
+        lanelet.id(), lanelet.leftBound(), lanelet.rightBound(), lanelet.attributes());
+      EXPECT_EQ(
+        to_id(route_handler_->getLeftShoulderLanelet(lanelet)),
+        to_id(route_handler_->getLeftShoulderLanelet(searched_lanelet)));
+      EXPECT_EQ(
+        to_id(route_handler_->getRightShoulderLanelet(lanelet)),
+        to_id(route_handler_->getRightShoulderLanelet(searched_lanelet)));
+      EXPECT_EQ(
+        to_ids(route_handler_->getLeftOppositeLanelets(lanelet)),
+        to_ids(route_handler_->getLeftOppositeLanelets(searched_lanelet)));
+      EXPECT_EQ(
+        to_ids(route_handler_->getRightOppositeLanelets(lanelet)),
+        to_ids(route_handler_->getRightOppositeLanelets(searched_lanelet)));
+      if (route_handler_->isShoulderLanelet(lanelet)) {
+        EXPECT_EQ(
+          to_id(route_handler_->getLeftLanelet(lanelet)),
+          to_id(route_handler_->getLeftLanelet(searched_lanelet)));
+        EXPECT_EQ(
+          to_id(route_handler_->getRightLanelet(lanelet)),
+          to_id(route_handler_->getRightLanelet(searched_lanelet)));
+      }
+    }
+
+    // the shoulder lanelet shares its right bound with the road lanelet
+    const auto road_lanelet = route_handler_->getLaneletsFromId(302);
+    const auto shoulder_lanelet = route_handler_->getLaneletsFromId(359);
+    EXPECT_EQ(to_id(route_handler_->getLeftShoulderLanelet(road_lanelet)), 359);
+    EXPECT_EQ(to_id(route_handler_->getRightShoulderLanelet(road_lanelet)), lanelet::InvalId);
+    EXPECT_EQ(to_id(route_handler_->getLeftLanelet(road_lanelet)), 359);
+    EXPECT_EQ(to_id(route_handler_->getRightLanelet(shoulder_lanelet)), 302);
+  }
+}
+
 TEST_F(TestRouteHandler, testGetShoulderLaneletsAtPose)
 {
   set_route_handler("overlap_map.osm");
@@ -313,4 +453,91 @@ TEST_F(TestRouteHandler, testGetShoulderLaneletsAtPose)
   shoulder_lanelets = route_handler_->getShoulderLaneletsAtPose(pose);
   ASSERT_TRUE(shoulder_lanelets.empty());
 }
+
+TEST(RouteHandlerRouteLaneletTest, findsRelationsWithinRoute)
+{
+  constexpr size_t lanelet_num = 20;
+  const auto road = create_straight_road(lanelet_num);
+  RouteHandler route_handler(road.map_bin);
+
+  // the last lanelet is out of the route
+  route_handler.setRoute(create_route(road.lanelet_ids, lanelet_num - 1));
+  ASSERT_TRUE(route_handler.isHandlerReady());
+
+  for (size_t i = 0; i + 1 < lanelet_num; ++i) {
+    const auto lanelet = route_handler.getLaneletsFromId(road.lanelet_ids[i]);
+    EXPECT_TRUE(route_handler.isRouteLanelet(lanelet));
+    EXPECT_EQ(route_handler.isInGoalRouteSection(lanelet), i + 2 == lanelet_num);
+
+    lanelet::ConstLanelet next_lanelet;
+    const bool has_next_lanelet = route_handler.getNextLaneletWithinRoute(lanelet, &next_lanelet);
+    EXPECT_EQ(has_next_lanelet, i + 2 < lanelet_num) << "lanelet: " << i;
+    if (has_next_lanelet) {
+      EXPECT_EQ(next_lanelet.id(), road.lanelet_ids[i + 1]);
+    }
+
+    lanelet::ConstLanelets previous_lanelets;
+    const bool has_previous_lanelets =
+      route_handler.getPreviousLaneletsWithinRoute(lanelet, &previous_lanelets);
+    EXPECT_EQ(has_previous_lanelets, i > 0) << "lanelet: " << i;
+    if (has_previous_lanelets) {
+      ASSERT_EQ(previous_lanelets.size(), 1u);
+      EXPECT_EQ(previous_lanelets.front().id(), road.lanelet_ids[i - 1]);
+    }
+  }
+
+  lanelet::ConstLanelet goal_lanelet;
+  ASSERT_TRUE(route_handler.getGoalLanelet(&goal_lanelet));
+  EXPECT_EQ(goal_lanelet.id(), road.lanelet_ids[lanelet_num - 2]);
+
+  // the relations of a lanelet out of the route are searched in the routing graph
+  const auto last_lanelet = route_handler.getLaneletsFromId(road.lanelet_ids.back());
+  EXPECT_FALSE(route_handler.isRouteLanelet(last_lanelet));
+  EXPECT_FALSE(route_handler.isInGoalRouteSection(last_lanelet));
+  lanelet::ConstLanelets previous_lanelets;
+  ASSERT_TRUE(route_handler.getPreviousLaneletsWithinRoute(last_lanelet, &previous_lanelets));
+  ASSERT_EQ(previous_lanelets.size(), 1u);
+  EXPECT_EQ(previous_lanelets.front().id(), goal_lanelet.id());
+
+  route_handler.clearRoute();
+  EXPECT_FALSE(route_handler.isRouteLanelet(goal_lanelet));
+  EXPECT_FALSE(route_handler.isInGoalRouteSection(goal_lanelet));
+  EXPECT_FALSE(route_handler.getGoalLanelet(&goal_lanelet));
+}
+
+TEST(RouteHandlerRouteLaneletTest, DISABLED_Benchmark)
+{
+  for (const size_t lanelet_num : {100u, 1000u, 10000u}) {
+    const auto road = create_straight_road(lanelet_num);
+    RouteHandler route_handler(road.map_bin);
+
+    const auto start_set_route = std::chrono::steady_clock::now();
+    route_handler.setRoute(create_route(road.lanelet_ids, lanelet_num));
+    const auto end_set_route = std::chrono::steady_clock::now();
+
+    const auto lanelets = route_handler.getLaneletsFromIds(road.lanelet_ids);
+    constexpr size_t query_num = 100000;
+    size_t found_num = 0;
+    const auto start_query = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < query_num; ++i) {
+      const auto & lanelet = lanelets[i % lanelets.size()];
+      lanelet::ConstLanelet next_lanelet;
+      lanelet::ConstLanelets previous_lanelets;
+      found_num += route_handler.isRouteLanelet(lanelet);
+      found_num += route_handler.isInGoalRouteSection(lanelet);
+      found_num += route_handler.getNextLaneletWithinRoute(lanelet, &next_lanelet);
+      found_num += route_handler.getPreviousLaneletsWithinRoute(lanelet, &previous_lanelets);
+    }
+    const auto end_query = std::chrono::steady_clock::now();
+    EXPECT_GT(found_num, 0u);
+
+    // four queries in each iteration
+    std::cout << lanelet_num << " route lanelets: setRoute "
+              << std::chrono::duration<double, std::milli>(end_set_route - start_set_route).count()
+              << " [ms], "
+              << std::chrono::duration<double, std::nano>(end_query - start_query).count() /
+                   (4 * query_num)
+              << " [ns] per query" << std::endl;
+  }
+}
 }  // namespace autoware::route_handler::test
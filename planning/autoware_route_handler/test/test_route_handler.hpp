@@ -58,14 +58,14 @@ public:
   TestRouteHandler & operator=(TestRouteHandler &&) = delete;
   ~TestRouteHandler() override = default;
 
-  void set_route_handler(const std::string & lanelet_map_filename)
+  void set_route_handler(const std::string & lanelet_map_filename, const size_t thread_num = 1)
   {
     route_handler_.reset();
     const auto lanelet2_path =
       get_absolute_path_to_lanelet_map(autoware_test_utils_dir, lanelet_map_filename);
     const auto map_bin_msg =
       autoware::test_utils::make_map_bin_msg(lanelet2_path, center_line_resolution);
-    route_handler_ = std::make_shared<RouteHandler>(map_bin_msg);
+    route_handler_ = std::make_shared<RouteHandler>(map_bin_msg, thread_num);
   }
 
   void set_test_route(const std::string & route_filename)
@@ -17,7 +17,10 @@
 #ifndef AUTOWARE__CROP_BOX_FILTER__CROP_BOX_FILTER_NODE_HPP_
 #define AUTOWARE__CROP_BOX_FILTER__CROP_BOX_FILTER_NODE_HPP_
 
+#include "autoware/crop_box_filter/crop_box_kernel.hpp"
+
 #include <autoware/point_types/types.hpp>
+#include <autoware/worker_pool/worker_pool.hpp>
 #include <autoware_utils_debug/debug_publisher.hpp>
 #include <autoware_utils_debug/published_time_publisher.hpp>
 #include <autoware_utils_system/stop_watch.hpp>
@@ -75,16 +78,11 @@ private:
   Eigen::Matrix4f eigen_transform_preprocess_ = Eigen::Matrix4f::Identity(4, 4);
   Eigen::Matrix4f eigen_transform_postprocess_ = Eigen::Matrix4f::Identity(4, 4);
 
-  struct CropBoxParam
-  {
-    float min_x;
-    float max_x;
-    float min_y;
-    float max_y;
-    float min_z;
-    float max_z;
-    bool negative{false};
-  } param_;
+  using CropBoxParam = CropBox;
+  CropBoxParam param_;
+
+  /** \brief The threads the points of a large cloud are split among. */
+  std::unique_ptr<autoware::worker_pool::WorkerPool> worker_pool_{nullptr};
 
   /** \brief Parameter service callback result : needed to be hold */
   OnSetParametersCallbackHandle::SharedPtr set_param_res_;
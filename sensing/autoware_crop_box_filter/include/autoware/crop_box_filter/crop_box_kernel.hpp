@@ -0,0 +1,88 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef AUTOWARE__CROP_BOX_FILTER__CROP_BOX_KERNEL_HPP_
+#define AUTOWARE__CROP_BOX_FILTER__CROP_BOX_KERNEL_HPP_
+
+#include <autoware/worker_pool/worker_pool.hpp>
+#include <Eigen/Core>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autoware::crop_box_filter
+{
+
+/** \brief An axis-aligned box. Points inside the box are kept, or removed if negative is true. */
+struct CropBox
+{
+  float min_x;
+  float max_x;
+  float min_y;
+  float max_y;
+  float min_z;
+  float max_z;
+  bool negative{false};
+};
+
+/** \brief The layout of the points in a PointCloud2 data buffer. */
+struct PointLayout
+{
+  size_t point_step;
+  size_t x_offset;
+  size_t y_offset;
+  size_t z_offset;
+};
+
+/** \brief The transforms applied to the points while cropping them. */
+struct CropBoxTransforms
+{
+  /** \brief Whether the points are transformed before being tested against the boxes. */
+  bool need_preprocess_transform{false};
+  /** \brief Whether the kept points are transformed again after the test. */
+  bool need_postprocess_transform{false};
+  Eigen::Matrix4f preprocess_transform{Eigen::Matrix4f::Identity()};
+  Eigen::Matrix4f postprocess_transform{Eigen::Matrix4f::Identity()};
+};
+
+struct CropBoxResult
+{
+  /** \brief The number of bytes written to the output buffer. */
+  size_t output_size{0};
+  /** \brief The number of points skipped because of non-finite coordinates. */
+  size_t skipped_count{0};
+};
+
+/** \brief Copy the points kept by all the boxes from input to output, which must be as large as
+ * input. The points are processed in blocks, in which the coordinates are gathered into arrays so
+ * that the transforms and the box tests are vectorized by the compiler for the target instruction
+ * set. The pre- and post-process transforms are fused into a single transform of the output
+ * coordinates. Large clouds are split among the threads of worker_pool.
+ * \param[in] input the data buffer of the input cloud
+ * \param[in] point_num the number of points in input
+ * \param[in] layout the layout of the points in input, which is kept in output
+ * \param[in] boxes the boxes which every kept point has to pass
+ * \param[in] transforms the transforms applied to the points
+ * \param[out] output the data buffer the kept points are written to
+ * \param[in] worker_pool the threads the points are split among
+ */
+CropBoxResult crop_box_points(
+  const uint8_t * input, size_t point_num, const PointLayout & layout,
+  const std::vector<CropBox> & boxes, const CropBoxTransforms & transforms, uint8_t * output,
+  autoware::worker_pool::WorkerPool & worker_pool);
+
+}  // namespace autoware::crop_box_filter
+
+#endif  // AUTOWARE__CROP_BOX_FILTER__CROP_BOX_KERNEL_HPP_
@@ -18,6 +18,7 @@
 
 #include <tf2_eigen/tf2_eigen.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
@@ -43,6 +44,11 @@ CropBoxFilter::CropBoxFilter(const rclcpp::NodeOptions & node_options)
 
   max_queue_size_ = static_cast<int64_t>(declare_parameter("max_queue_size", 5));
 
+  // large clouds are split among the threads
+  const auto thread_num = declare_parameter<int64_t>("thread_num", 1);
+  worker_pool_ = std::make_unique<autoware::worker_pool::WorkerPool>(
+    static_cast<size_t>(std::max<int64_t>(thread_num, 1)));
+
   // get transform info for pointcloud
   {
     tf_input_orig_frame_ =
@@ -136,74 +142,33 @@ CropBoxFilter::CropBoxFilter(const rclcpp::NodeOptions & node_options)
 
 void CropBoxFilter::filter_pointcloud(const PointCloud2ConstPtr & cloud, PointCloud2 & output)
 {
-  int x_offset = cloud->fields[pcl::getFieldIndex(*cloud, "x")].offset;
-  int y_offset = cloud->fields[pcl::getFieldIndex(*cloud, "y")].offset;
-  int z_offset = cloud->fields[pcl::getFieldIndex(*cloud, "z")].offset;
+  PointLayout layout{};
+  layout.point_step = cloud->point_step;
+  layout.x_offset = cloud->fields[pcl::getFieldIndex(*cloud, "x")].offset;
+  layout.y_offset = cloud->fields[pcl::getFieldIndex(*cloud, "y")].offset;
+  layout.z_offset = cloud->fields[pcl::getFieldIndex(*cloud, "z")].offset;
+
+  CropBoxTransforms transforms;
+  transforms.need_preprocess_transform = need_preprocess_transform_;
+  transforms.need_postprocess_transform = need_postprocess_transform_;
+  transforms.preprocess_transform = eigen_transform_preprocess_;
+  transforms.postprocess_transform = eigen_transform_postprocess_;
 
   output.data.resize(cloud->data.size());
-  size_t output_size = 0;
-
-  int skipped_count = 0;
-
-  // pointcloud processing loop
-  for (size_t global_offset = 0; global_offset + cloud->point_step <= cloud->data.size();
-       global_offset += cloud->point_step) {
-    // extract point data from point cloud data buffer
-    Eigen::Vector4f point;
-
-    std::memcpy(&point[0], &cloud->data[global_offset + x_offset], sizeof(float));
-    std::memcpy(&point[1], &cloud->data[global_offset + y_offset], sizeof(float));
-    std::memcpy(&point[2], &cloud->data[global_offset + z_offset], sizeof(float));
-    point[3] = 1;
-
-    if (!std::isfinite(point[0]) || !std::isfinite(point[1]) || !std::isfinite(point[2])) {
-      skipped_count++;
-      continue;
-    }
-
-    // preprocess point for filtering
-    Eigen::Vector4f point_preprocessed = point;
-
-    // apply pre-transform if needed
-    if (need_preprocess_transform_) {
-      point_preprocessed = eigen_transform_preprocess_ * point;
-    }
 
-    bool point_is_inside =
-      point_preprocessed[2] > param_.min_z && point_preprocessed[2] < param_.max_z &&
-      point_preprocessed[1] > param_.min_y && point_preprocessed[1] < param_.max_y &&
-      point_preprocessed[0] > param_.min_x && point_preprocessed[0] < param_.max_x;
-    if ((!param_.negative && point_is_inside) || (param_.negative && !point_is_inside)) {
-      // apply post-transform if needed
-      if (need_postprocess_transform_) {
-        Eigen::Vector4f point_postprocessed = eigen_transform_postprocess_ * point_preprocessed;
-
-        memcpy(&output.data[output_size], &cloud->data[global_offset], cloud->point_step);
-
-        std::memcpy(&output.data[output_size + x_offset], &point_postprocessed[0], sizeof(float));
-        std::memcpy(&output.data[output_size + y_offset], &point_postprocessed[1], sizeof(float));
-        std::memcpy(&output.data[output_size + z_offset], &point_postprocessed[2], sizeof(float));
-      } else {
-        memcpy(&output.data[output_size], &cloud->data[global_offset], cloud->point_step);
-
-        if (need_preprocess_transform_) {
-          std::memcpy(&output.data[output_size + x_offset], &point_preprocessed[0], sizeof(float));
-          std::memcpy(&output.data[output_size + y_offset], &point_preprocessed[1], sizeof(float));
-          std::memcpy(&output.data[output_size + z_offset], &point_preprocessed[2], sizeof(float));
-        }
-      }
-      output_size += cloud->point_step;
-    }
-  }
+  // pointcloud processing
+  const CropBoxResult result = crop_box_points(
+    cloud->data.data(), cloud->data.size() / cloud->point_step, layout, {param_}, transforms,
+    output.data.data(), *worker_pool_);
 
-  if (skipped_count > 0) {
+  if (result.skipped_count > 0) {
     RCLCPP_WARN_THROTTLE(
-      get_logger(), *get_clock(), 1000, "%d points contained NaN values and have been ignored",
-      skipped_count);
+      get_logger(), *get_clock(), 1000, "%zu points contained NaN values and have been ignored",
+      result.skipped_count);
   }
 
   // construct output cloud
-  output.data.resize(output_size);
+  output.data.resize(result.output_size);
 
   output.header.frame_id = tf_output_frame_;
 
@@ -0,0 +1,201 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/crop_box_filter/crop_box_kernel.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace autoware::crop_box_filter
+{
+
+namespace
+{
+// The number of points whose coordinates are gathered into arrays at once
+constexpr size_t block_size = 256;
+
+// Clouds are split among threads only if every thread gets at least this number of points
+constexpr size_t min_points_per_thread = 32768;
+
+// Row-major coefficients of the top 3x4 part of a transform
+struct AffineCoefficients
+{
+  float m[12];
+};
+
+AffineCoefficients to_coefficients(const Eigen::Matrix4f & transform)
+{
+  AffineCoefficients coefficients{};
+  for (int row = 0; row < 3; ++row) {
+    for (int col = 0; col < 4; ++col) {
+      coefficients.m[row * 4 + col] = transform(row, col);
+    }
+  }
+  return coefficients;
+}
+
+// Transform the coordinates of n points in place
+void transform_block(const AffineCoefficients & t, const size_t n, float * x, float * y, float * z)
+{
+  for (size_t i = 0; i < n; ++i) {
+    const float px = x[i];
+    const float py = y[i];
+    const float pz = z[i];
+    x[i] = t.m[0] * px + t.m[1] * py + t.m[2] * pz + t.m[3];
+    y[i] = t.m[4] * px + t.m[5] * py + t.m[6] * pz + t.m[7];
+    z[i] = t.m[8] * px + t.m[9] * py + t.m[10] * pz + t.m[11];
+  }
+}
+
+struct KernelContext
+{
+  PointLayout layout;
+  const std::vector<CropBox> * boxes;
+  bool need_filter_transform;
+  bool need_output_transform;
+  AffineCoefficients filter_transform;
+  AffineCoefficients output_transform;
+};
+
+// Crop the points in [begin, end) and write the kept ones to output from its beginning
+CropBoxResult crop_range(
+  const KernelContext & context, const uint8_t * input, const size_t begin, const size_t end,
+  uint8_t * output)
+{
+  const PointLayout & layout = context.layout;
+
+  alignas(32) float x[block_size];
+  alignas(32) float y[block_size];
+  alignas(32) float z[block_size];
+  alignas(32) float filter_x[block_size];
+  alignas(32) float filter_y[block_size];
+  alignas(32) float filter_z[block_size];
+  alignas(32) uint8_t is_finite[block_size];
+  alignas(32) uint8_t is_kept[block_size];
+
+  CropBoxResult result;
+
+  for (size_t block_begin = begin; block_begin < end; block_begin += block_size) {
+    const size_t n = std::min(block_size, end - block_begin);
+    const uint8_t * block_input = input + block_begin * layout.point_step;
+
+    // gather the coordinates, which is the only strided access to the input
+    for (size_t i = 0; i < n; ++i) {
+      const uint8_t * point = block_input + i * layout.point_step;
+      std::memcpy(&x[i], point + layout.x_offset, sizeof(float));
+      std::memcpy(&y[i], point + layout.y_offset, sizeof(float));
+      std::memcpy(&z[i], point + layout.z_offset, sizeof(float));
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+      is_finite[i] = std::isfinite(x[i]) & std::isfinite(y[i]) & std::isfinite(z[i]);
+      is_kept[i] = is_finite[i];
+    }
+
+    std::copy(x, x + n, filter_x);
+    std::copy(y, y + n, filter_y);
+    std::copy(z, z + n, filter_z);
+    if (context.need_filter_transform) {
+      transform_block(context.filter_transform, n, filter_x, filter_y, filter_z);
+    }
+
+    for (const CropBox & box : *context.boxes) {
+      const uint8_t negative = box.negative;
+      for (size_t i = 0; i < n; ++i) {
+        const uint8_t is_inside = (filter_x[i] > box.min_x) & (filter_x[i] < box.max_x) &
+                                  (filter_y[i] > box.min_y) & (filter_y[i] < box.max_y) &
+                                  (filter_z[i] > box.min_z) & (filter_z[i] < box.max_z);
+        is_kept[i] &= is_inside ^ negative;
+      }
+    }
+
+    if (context.need_output_transform) {
+      transform_block(context.output_transform, n, x, y, z);
+    }
+
+    // compact the kept points
+    for (size_t i = 0; i < n; ++i) {
+      result.skipped_count += 1 - is_finite[i];
+      if (!is_kept[i]) {
+        continue;
+      }
+
+      uint8_t * output_point = output + result.output_size;
+      std::memcpy(output_point, block_input + i * layout.point_step, layout.point_step);
+      if (context.need_output_transform) {
+        std::memcpy(output_point + layout.x_offset, &x[i], sizeof(float));
+        std::memcpy(output_point + layout.y_offset, &y[i], sizeof(float));
+        std::memcpy(output_point + layout.z_offset, &z[i], sizeof(float));
+      }
+      result.output_size += layout.point_step;
+    }
+  }
+
+  return result;
+}
+}  // namespace
+
+CropBoxResult crop_box_points(
+  const uint8_t * input, const size_t point_num, const PointLayout & layout,
+  const std::vector<CropBox> & boxes, const CropBoxTransforms & transforms, uint8_t * output,
+  autoware::worker_pool::WorkerPool & worker_pool)
+{
+  KernelContext context{};
+  context.layout = layout;
+  context.boxes = &boxes;
+  context.need_filter_transform = transforms.need_preprocess_transform;
+  context.filter_transform = to_coefficients(transforms.preprocess_transform);
+
+  // The output coordinates are the pre-processed ones transformed by the post-process transform
+  context.need_output_transform =
+    transforms.need_preprocess_transform || transforms.need_postprocess_transform;
+  Eigen::Matrix4f output_transform = Eigen::Matrix4f::Identity();
+  if (transforms.need_postprocess_transform) {
+    output_transform = transforms.postprocess_transform;
+  }
+  if (transforms.need_preprocess_transform) {
+    output_transform = output_transform * transforms.preprocess_transform;
+  }
+  context.output_transform = to_coefficients(output_transform);
+
+  const size_t range_num =
+    std::max<size_t>(std::min(worker_pool.getThreadNum(), point_num / min_points_per_thread), 1);
+  if (range_num == 1) {
+    return crop_range(context, input, 0, point_num, output);
+  }
+
+  // Each range writes its kept points to the output from the offset of its first input point,
+  // which cannot overlap the next range because it keeps at most all of its points
+  const size_t range_size = (point_num + range_num - 1) / range_num;
+  std::vector<CropBoxResult> range_results(range_num);
+  worker_pool.run(range_num, [&](const size_t r) {
+    const size_t begin = r * range_size;
+    const size_t end = std::min(begin + range_size, point_num);
+    range_results[r] = crop_range(context, input, begin, end, output + begin * layout.point_step);
+  });
+
+  CropBoxResult result = range_results[0];
+  for (size_t r = 1; r < range_num; ++r) {
+    std::memmove(
+      output + result.output_size, output + r * range_size * layout.point_step,
+      range_results[r].output_size);
+    result.output_size += range_results[r].output_size;
+    result.skipped_count += range_results[r].skipped_count;
+  }
+  return result;
+}
+
+}  // namespace autoware::crop_box_filter
@@ -0,0 +1,218 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "autoware/crop_box_filter/crop_box_kernel.hpp"
+
+#include <Eigen/Geometry>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using autoware::crop_box_filter::crop_box_points;
+using autoware::crop_box_filter::CropBox;
+using autoware::crop_box_filter::CropBoxResult;
+using autoware::crop_box_filter::CropBoxTransforms;
+using autoware::crop_box_filter::PointLayout;
+using autoware::worker_pool::WorkerPool;
+
+namespace
+{
+// The layout of PointXYZIRC, where the coordinates are followed by the other fields
+constexpr PointLayout layout{16, 0, 4, 8};
+
+std::vector<uint8_t> make_points(const size_t point_num)
+{
+  std::mt19937 engine(0);
+  std::uniform_real_distribution<float> dist(-20.0f, 20.0f);
+  std::vector<uint8_t> data(point_num * layout.point_step);
+  for (size_t i = 0; i < point_num; ++i) {
+    float xyz[3] = {dist(engine), dist(engine), dist(engine) * 0.2f};
+    if (i % 97 == 0) {
+      xyz[i % 3] = std::numeric_limits<float>::quiet_NaN();
+    }
+    std::memcpy(&data[i * layout.point_step], xyz, sizeof(xyz));
+    const uint32_t others = static_cast<uint32_t>(i);
+    std::memcpy(&data[i * layout.point_step + 12], &others, sizeof(others));
+  }
+  return data;
+}
+
+CropBoxTransforms make_transforms(const bool need_preprocess, const bool need_postprocess)
+{
+  CropBoxTransforms transforms;
+  transforms.need_preprocess_transform = need_preprocess;
+  transforms.need_postprocess_transform = need_postprocess;
+  transforms.preprocess_transform =
+    (Eigen::Translation3f(1.0f, 0.5f, -0.3f) * Eigen::AngleAxisf(0.2f, Eigen::Vector3f::UnitZ()))
+      .matrix();
+  transforms.postprocess_transform =
+    (Eigen::Translation3f(-2.0f, 0.0f, 1.0f) * Eigen::AngleAxisf(-0.4f, Eigen::Vector3f::UnitZ()))
+      .matrix();
+  return transforms;
+}
+
+// The point-by-point loop the kernel replaces
+CropBoxResult crop_box_points_reference(
+  const std::vector<uint8_t> & input, const std::vector<CropBox> & boxes,
+  const CropBoxTransforms & transforms, std::vector<uint8_t> & output)
+{
+  CropBoxResult result;
+  output.resize(input.size());
+  for (size_t offset = 0; offset + layout.point_step <= input.size();
+       offset += layout.point_step) {
+    Eigen::Vector4f point;
+    std::memcpy(&point[0], &input[offset + layout.x_offset], sizeof(float));
+    std::memcpy(&point[1], &input[offset + layout.y_offset], sizeof(float));
+    std::memcpy(&point[2], &input[offset + layout.z_offset], sizeof(float));
+    point[3] = 1;
+
+    if (!std::isfinite(point[0]) || !std::isfinite(point[1]) || !std::isfinite(point[2])) {
+      result.skipped_count++;
+      continue;
+    }
+
+    Eigen::Vector4f point_preprocessed = point;
+    if (transforms.need_preprocess_transform) {
+      point_preprocessed = transforms.preprocess_transform * point;
+    }
+
+    bool is_kept = true;
+    for (const CropBox & box : boxes) {
+      const bool is_inside =
+        point_preprocessed[2] > box.min_z && point_preprocessed[2] < box.max_z &&
+        point_preprocessed[1] > box.min_y && point_preprocessed[1] < box.max_y &&
+        point_preprocessed[0] > box.min_x && point_preprocessed[0] < box.max_x;
+      is_kept &= (!box.negative && is_inside) || (box.negative && !is_inside);
+    }
+    if (!is_kept) {
+      continue;
+    }
+
+    Eigen::Vector4f point_output = point_preprocessed;
+    if (transforms.need_postprocess_transform) {
+      point_output = transforms.postprocess_transform * point_preprocessed;
+    }
+    std::memcpy(&output[result.output_size], &input[offset], layout.point_step);
+    std::memcpy(&output[result.output_size + layout.x_offset], &point_output[0], sizeof(float));
+    std::memcpy(&output[result.output_size + layout.y_offset], &point_output[1], sizeof(float));
+    std::memcpy(&output[result.output_size + layout.z_offset], &point_output[2], sizeof(float));
+    result.output_size += layout.point_step;
+  }
+  output.resize(result.output_size);
+  return result;
+}
+
+void expect_same_points(const std::vector<uint8_t> & expected, const std::vector<uint8_t> & actual)
+{
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t offset = 0; offset < expected.size(); offset += layout.point_step) {
+    float expected_xyz[3];
+    float actual_xyz[3];
+    std::memcpy(expected_xyz, &expected[offset], sizeof(expected_xyz));
+    std::memcpy(actual_xyz, &actual[offset], sizeof(actual_xyz));
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_NEAR(actual_xyz[i], expected_xyz[i], 1e-4f);
+    }
+    EXPECT_EQ(
+      std::memcmp(&expected[offset + 12], &actual[offset + 12], layout.point_step - 12), 0);
+  }
+}
+
+void run_and_compare(
+  const size_t point_num, const std::vector<CropBox> & boxes, const CropBoxTransforms & transforms,
+  const size_t thread_num)
+{
+  const std::vector<uint8_t> input = make_points(point_num);
+
+  std::vector<uint8_t> expected;
+  const CropBoxResult expected_result =
+    crop_box_points_reference(input, boxes, transforms, expected);
+
+  WorkerPool worker_pool(thread_num);
+  std::vector<uint8_t> actual(input.size());
+  const CropBoxResult result = crop_box_points(
+    input.data(), point_num, layout, boxes, transforms, actual.data(), worker_pool);
+  actual.resize(result.output_size);
+
+  EXPECT_EQ(result.skipped_count, expected_result.skipped_count);
+  expect_same_points(expected, actual);
+}
+}  // namespace
+
+TEST(CropBoxKernel, MatchesPointByPointLoop)  // NOLINT
+{
+  const std::vector<CropBox> boxes{{-5.0f, 5.0f, -5.0f, 5.0f, -5.0f, 5.0f, true}};
+  for (const bool need_preprocess : {false, true}) {
+    for (const bool need_postprocess : {false, true}) {
+      run_and_compare(1000, boxes, make_transforms(need_preprocess, need_postprocess), 1);
+    }
+  }
+}
+
+TEST(CropBoxKernel, AppliesAllBoxes)  // NOLINT
+{
+  // keep the points in the outer box which are outside the inner box
+  const std::vector<CropBox> boxes{
+    {-15.0f, 15.0f, -15.0f, 15.0f, -3.0f, 3.0f, false},
+    {-5.0f, 5.0f, -5.0f, 5.0f, -5.0f, 5.0f, true}};
+  run_and_compare(1000, boxes, make_transforms(true, true), 1);
+}
+
+TEST(CropBoxKernel, SplitsLargeCloudsAmongThreads)  // NOLINT
+{
+  const std::vector<CropBox> boxes{{-5.0f, 5.0f, -5.0f, 5.0f, -5.0f, 5.0f, true}};
+  run_and_compare(200000, boxes, make_transforms(true, false), 4);
+  run_and_compare(200003, boxes, make_transforms(false, false), 3);
+}
+
+TEST(CropBoxKernel, DISABLED_Benchmark)  // NOLINT
+{
+  constexpr size_t point_num = 200000;
+  constexpr int nb_iteration = 100;
+  const std::vector<uint8_t> input = make_points(point_num);
+  const std::vector<CropBox> boxes{{-5.0f, 5.0f, -5.0f, 5.0f, -5.0f, 5.0f, true}};
+  const CropBoxTransforms transforms = make_transforms(true, true);
+  std::vector<uint8_t> output(input.size());
+
+  const auto measure = [&](const std::string & name, const auto & crop) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nb_iteration; ++i) {
+      crop();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::milli>(end - start).count() / nb_iteration
+              << " [ms]" << std::endl;
+  };
+
+  measure("point-by-point loop", [&] {
+    crop_box_points_reference(input, boxes, transforms, output);
+  });
+  output.resize(input.size());
+  for (const size_t thread_num : {1, 2, 4}) {
+    WorkerPool worker_pool(thread_num);
+    measure("kernel with " + std::to_string(thread_num) + " threads", [&] {
+      crop_box_points(
+        input.data(), point_num, layout, boxes, transforms, output.data(), worker_pool);
+    });
+  }
+}
@@ -0,0 +1,341 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "sort_based_voxel_grid_downsample_filter.hpp"
+
+#include <pcl_conversions/pcl_conversions.h>
+#include <rclcpp/logging.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace autoware::downsample_filters
+{
+
+namespace
+{
+// The work is split among threads only if every thread gets at least this number of points
+constexpr size_t min_points_per_thread = 16384;
+
+constexpr int radix_bits = 8;
+constexpr size_t radix_size = 1 << radix_bits;
+
+// The voxel key is stored in the upper half of a pair and the point index in the lower half
+constexpr int key_shift = 32;
+
+// The number of the ranges work_size points are split into, one for each thread at most
+size_t get_range_num(const autoware::worker_pool::WorkerPool & worker_pool, const size_t work_size)
+{
+  const size_t max_range_num = std::max<size_t>(work_size / min_points_per_thread, 1);
+  return std::min(worker_pool.getThreadNum(), max_range_num);
+}
+
+// Call func(range_index, begin, end) for range_num contiguous ranges of [0, size) on the threads
+template <typename Func>
+void parallel_for(
+  autoware::worker_pool::WorkerPool & worker_pool, const size_t range_num, const size_t size,
+  const Func & func)
+{
+  const size_t range_size = (size + range_num - 1) / range_num;
+  worker_pool.run(range_num, [&](const size_t r) {
+    const size_t begin = std::min(r * range_size, size);
+    const size_t end = std::min(begin + range_size, size);
+    func(r, begin, end);
+  });
+}
+}  // namespace
+
+SortBasedVoxelGridDownsampleFilter::SortBasedVoxelGridDownsampleFilter()
+{
+  inverse_voxel_size_[0] = 1.0f;
+  inverse_voxel_size_[1] = 1.0f;
+  inverse_voxel_size_[2] = 1.0f;
+  x_offset_ = 0;
+  y_offset_ = 0;
+  z_offset_ = 0;
+  intensity_offset_ = -1;
+  offset_initialized_ = false;
+  worker_pool_ = std::make_unique<autoware::worker_pool::WorkerPool>(1);
+}
+
+void SortBasedVoxelGridDownsampleFilter::set_voxel_size(
+  float voxel_size_x, float voxel_size_y, float voxel_size_z)
+{
+  inverse_voxel_size_[0] = 1.0f / voxel_size_x;
+  inverse_voxel_size_[1] = 1.0f / voxel_size_y;
+  inverse_voxel_size_[2] = 1.0f / voxel_size_z;
+}
+
+void SortBasedVoxelGridDownsampleFilter::set_field_offsets(
+  const PointCloud2ConstPtr & input, const rclcpp::Logger & logger)
+{
+  x_offset_ = input->fields[pcl::getFieldIndex(*input, "x")].offset;
+  y_offset_ = input->fields[pcl::getFieldIndex(*input, "y")].offset;
+  z_offset_ = input->fields[pcl::getFieldIndex(*input, "z")].offset;
+  const int intensity_index = pcl::getFieldIndex(*input, "intensity");
+
+  if (
+    intensity_index < 0 ||
+    input->fields[intensity_index].datatype != sensor_msgs::msg::PointField::UINT8) {
+    RCLCPP_ERROR(
+      logger,
+      "There is no intensity field in the input point cloud or the intensity field is not of type "
+      "UINT8.");
+    intensity_offset_ = -1;
+  } else {
+    intensity_offset_ = input->fields[intensity_index].offset;
+  }
+  offset_initialized_ = true;
+}
+
+void SortBasedVoxelGridDownsampleFilter::set_thread_num(int thread_num)
+{
+  // The threads are started here and kept alive for the clouds to come
+  worker_pool_ = std::make_unique<autoware::worker_pool::WorkerPool>(
+    static_cast<size_t>(std::max(thread_num, 1)));
+}
+
+void SortBasedVoxelGridDownsampleFilter::filter(
+  const PointCloud2ConstPtr & input, PointCloud2 & output, const TransformInfo & transform_info,
+  const rclcpp::Logger & logger)
+{
+  // Check if the field offset has been set
+  if (!offset_initialized_) {
+    set_field_offsets(input, logger);
+  }
+
+  const size_t point_num = input->data.size() / input->point_step;
+  load_points(*input, point_num);
+
+  int max_key_bits = 0;
+  if (!compute_keys(point_num, max_key_bits)) {
+    RCLCPP_ERROR(
+      logger,
+      "Voxel size is too small for the input dataset. "
+      "Integer indices would overflow.");
+    output = *input;
+    return;
+  }
+
+  radix_sort(key_index_pairs_, sort_buffer_, max_key_bits, *worker_pool_);
+
+  reduce_runs(*input, output, transform_info);
+}
+
+void SortBasedVoxelGridDownsampleFilter::load_points(
+  const PointCloud2 & input, const size_t point_num)
+{
+  x_.resize(point_num);
+  y_.resize(point_num);
+  z_.resize(point_num);
+
+  const uint8_t * data = input.data.data();
+  for (size_t i = 0; i < point_num; ++i) {
+    const uint8_t * point = data + i * input.point_step;
+    std::memcpy(&x_[i], point + x_offset_, sizeof(float));
+    std::memcpy(&y_[i], point + y_offset_, sizeof(float));
+    std::memcpy(&z_[i], point + z_offset_, sizeof(float));
+  }
+}
+
+bool SortBasedVoxelGridDownsampleFilter::compute_keys(const size_t point_num, int & max_key_bits)
+{
+  // Compute the minimum and maximum point coordinates
+  float min_point[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+  float max_point[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+  for (size_t i = 0; i < point_num; ++i) {
+    if (std::isfinite(x_[i]) && std::isfinite(y_[i]) && std::isfinite(z_[i])) {
+      min_point[0] = std::min(min_point[0], x_[i]);
+      min_point[1] = std::min(min_point[1], y_[i]);
+      min_point[2] = std::min(min_point[2], z_[i]);
+      max_point[0] = std::max(max_point[0], x_[i]);
+      max_point[1] = std::max(max_point[1], y_[i]);
+      max_point[2] = std::max(max_point[2], z_[i]);
+    }
+  }
+
+  key_index_pairs_.clear();
+  max_key_bits = 0;
+  if (min_point[0] > max_point[0]) {
+    // no finite points
+    return true;
+  }
+
+  // Check that the voxel size is not too small, given the size of the data
+  int64_t min_voxel[3];
+  int64_t div[3];
+  for (int axis = 0; axis < 3; ++axis) {
+    min_voxel[axis] = static_cast<int64_t>(std::floor(min_point[axis] * inverse_voxel_size_[axis]));
+    const auto max_voxel =
+      static_cast<int64_t>(std::floor(max_point[axis] * inverse_voxel_size_[axis]));
+    div[axis] = max_voxel - min_voxel[axis] + 1;
+  }
+  const int64_t voxel_num = div[0] * div[1] * div[2];
+  if (voxel_num > static_cast<int64_t>(std::numeric_limits<std::int32_t>::max())) {
+    return false;
+  }
+  while ((int64_t{1} << max_key_bits) < voxel_num) {
+    ++max_key_bits;
+  }
+
+  const auto mul_y = static_cast<uint32_t>(div[0]);
+  const auto mul_z = static_cast<uint32_t>(div[0] * div[1]);
+  const float offset_x = static_cast<float>(min_voxel[0]);
+  const float offset_y = static_cast<float>(min_voxel[1]);
+  const float offset_z = static_cast<float>(min_voxel[2]);
+
+  // The keys of the non-finite points are not used, but they are computed from finite values
+  // so that the loop has no branch
+  key_index_pairs_.resize(point_num);
+  size_t valid_num = 0;
+  for (size_t i = 0; i < point_num; ++i) {
+    const bool is_finite = std::isfinite(x_[i]) && std::isfinite(y_[i]) && std::isfinite(z_[i]);
+    const float x = is_finite ? x_[i] : min_point[0];
+    const float y = is_finite ? y_[i] : min_point[1];
+    const float z = is_finite ? z_[i] : min_point[2];
+    const auto ijk0 = static_cast<uint32_t>(std::floor(x * inverse_voxel_size_[0]) - offset_x);
+    const auto ijk1 = static_cast<uint32_t>(std::floor(y * inverse_voxel_size_[1]) - offset_y);
+    const auto ijk2 = static_cast<uint32_t>(std::floor(z * inverse_voxel_size_[2]) - offset_z);
+    const uint64_t key = ijk0 + ijk1 * mul_y + ijk2 * mul_z;
+    key_index_pairs_[valid_num] = (key << key_shift) | static_cast<uint64_t>(i);
+    valid_num += is_finite;
+  }
+  key_index_pairs_.resize(valid_num);
+
+  return true;
+}
+
+void SortBasedVoxelGridDownsampleFilter::radix_sort(
+  std::vector<uint64_t> & key_index_pairs, std::vector<uint64_t> & buffer, const int max_key_bits,
+  autoware::worker_pool::WorkerPool & worker_pool)
+{
+  const size_t size = key_index_pairs.size();
+  const size_t range_num = get_range_num(worker_pool, size);
+  const int pass_num = (max_key_bits + radix_bits - 1) / radix_bits;
+
+  // the capacity is kept, so the buffer is allocated only while the clouds grow
+  buffer.resize(size);
+  std::vector<std::array<size_t, radix_size>> histograms(range_num);
+
+  for (int pass = 0; pass < pass_num; ++pass) {
+    const int shift = key_shift + pass * radix_bits;
+
+    // count the digits of each range
+    parallel_for(
+      worker_pool, range_num, size, [&](const size_t r, const size_t begin, const size_t end) {
+        std::array<size_t, radix_size> & histogram = histograms[r];
+        histogram.fill(0);
+        for (size_t i = begin; i < end; ++i) {
+          ++histogram[(key_index_pairs[i] >> shift) & (radix_size - 1)];
+        }
+      });
+
+    // the first position of each digit of each range, where the ranges are kept in order
+    size_t position = 0;
+    for (size_t digit = 0; digit < radix_size; ++digit) {
+      for (size_t r = 0; r < range_num; ++r) {
+        const size_t count = histograms[r][digit];
+        histograms[r][digit] = position;
+        position += count;
+      }
+    }
+
+    parallel_for(
+      worker_pool, range_num, size, [&](const size_t r, const size_t begin, const size_t end) {
+        std::array<size_t, radix_size> & positions = histograms[r];
+        for (size_t i = begin; i < end; ++i) {
+          const uint64_t pair = key_index_pairs[i];
+          buffer[positions[(pair >> shift) & (radix_size - 1)]++] = pair;
+        }
+      });
+
+    key_index_pairs.swap(buffer);
+  }
+}
+
+void SortBasedVoxelGridDownsampleFilter::reduce_runs(
+  const PointCloud2 & input, PointCloud2 & output, const TransformInfo & transform_info) const
+{
+  // Find the runs of the same keys
+  std::vector<uint32_t> run_begins;
+  run_begins.reserve(key_index_pairs_.size() / 2 + 1);
+  for (size_t i = 0; i < key_index_pairs_.size(); ++i) {
+    if (i == 0 || (key_index_pairs_[i] >> key_shift) != (key_index_pairs_[i - 1] >> key_shift)) {
+      run_begins.push_back(static_cast<uint32_t>(i));
+    }
+  }
+  const size_t voxel_num = run_begins.size();
+  run_begins.push_back(static_cast<uint32_t>(key_index_pairs_.size()));
+
+  // Initialize the output
+  output.row_step = voxel_num * input.point_step;
+  output.data.resize(output.row_step);
+  output.width = voxel_num;
+  output.fields = input.fields;
+  output.is_dense = true;  // we filter out invalid points
+  output.height = 1;
+  output.is_bigendian = input.is_bigendian;
+  output.point_step = input.point_step;
+  output.header = input.header;
+
+  const Eigen::Matrix4f & transform = transform_info.eigen_transform;
+
+  parallel_for(
+    *worker_pool_, get_range_num(*worker_pool_, key_index_pairs_.size()), voxel_num,
+    [&](const size_t, const size_t begin, const size_t end) {
+      for (size_t v = begin; v < end; ++v) {
+        double sum_x = 0.0;
+        double sum_y = 0.0;
+        double sum_z = 0.0;
+        double sum_intensity = 0.0;
+        for (size_t i = run_begins[v]; i < run_begins[v + 1]; ++i) {
+          const auto index = static_cast<uint32_t>(key_index_pairs_[i]);
+          sum_x += x_[index];
+          sum_y += y_[index];
+          sum_z += z_[index];
+          if (intensity_offset_ >= 0) {
+            sum_intensity += input.data[index * input.point_step + intensity_offset_];
+          }
+        }
+        const double count = run_begins[v + 1] - run_begins[v];
+        Eigen::Vector4f centroid(
+          static_cast<float>(sum_x / count), static_cast<float>(sum_y / count),
+          static_cast<float>(sum_z / count), 1.0f);
+        if (transform_info.need_transform) {
+          centroid = transform * centroid;
+        }
+
+        // The other fields are taken from the first point of the voxel
+        const auto first_index = static_cast<uint32_t>(key_index_pairs_[run_begins[v]]);
+        uint8_t * output_point = output.data.data() + v * output.point_step;
+        std::memcpy(
+          output_point, input.data.data() + first_index * input.point_step, input.point_step);
+        std::memcpy(output_point + x_offset_, &centroid[0], sizeof(float));
+        std::memcpy(output_point + y_offset_, &centroid[1], sizeof(float));
+        std::memcpy(output_point + z_offset_, &centroid[2], sizeof(float));
+        if (intensity_offset_ >= 0) {
+          output_point[intensity_offset_] = static_cast<uint8_t>(sum_intensity / count);
+        }
+      }
+    });
+}
+
+}  // namespace autoware::downsample_filters
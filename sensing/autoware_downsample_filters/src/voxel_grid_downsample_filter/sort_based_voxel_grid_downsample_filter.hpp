@@ -0,0 +1,87 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef VOXEL_GRID_DOWNSAMPLE_FILTER__SORT_BASED_VOXEL_GRID_DOWNSAMPLE_FILTER_HPP_
+#define VOXEL_GRID_DOWNSAMPLE_FILTER__SORT_BASED_VOXEL_GRID_DOWNSAMPLE_FILTER_HPP_
+
+#include "transform_info.hpp"
+
+#include <autoware/worker_pool/worker_pool.hpp>
+#include <rclcpp/logger.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace autoware::downsample_filters
+{
+
+/** \brief Voxel grid filter which sorts the points by their voxels instead of hashing them.
+ * The voxel keys are computed over arrays of coordinates, the (key, index) pairs are sorted by a
+ * parallel radix sort, and each run of equal keys is reduced to its centroid. The output points
+ * are ordered by their voxel keys, so the output does not depend on the number of threads.
+ * The fields other than xyz and intensity are passed through from the first point of each voxel.
+ */
+class SortBasedVoxelGridDownsampleFilter
+{
+  using PointCloud2 = sensor_msgs::msg::PointCloud2;
+  using PointCloud2ConstPtr = sensor_msgs::msg::PointCloud2::ConstSharedPtr;
+
+public:
+  SortBasedVoxelGridDownsampleFilter();
+  void set_voxel_size(float voxel_size_x, float voxel_size_y, float voxel_size_z);
+  void set_field_offsets(const PointCloud2ConstPtr & input, const rclcpp::Logger & logger);
+  void set_thread_num(int thread_num);
+  void filter(
+    const PointCloud2ConstPtr & input, PointCloud2 & output, const TransformInfo & transform_info,
+    const rclcpp::Logger & logger);
+
+  /** \brief Sort the pairs of the keys and the indices by the keys, keeping the order of the
+   * indices within the same key. The low max_key_bits bits of the keys are used. buffer is
+   * swapped with key_index_pairs during the sort. */
+  static void radix_sort(
+    std::vector<uint64_t> & key_index_pairs, std::vector<uint64_t> & buffer, int max_key_bits,
+    autoware::worker_pool::WorkerPool & worker_pool);
+
+private:
+  float inverse_voxel_size_[3];
+  int x_offset_;
+  int y_offset_;
+  int z_offset_;
+  int intensity_offset_;
+  bool offset_initialized_;
+  std::unique_ptr<autoware::worker_pool::WorkerPool> worker_pool_;
+
+  // Reused across the calls so that the buffers are allocated only while the clouds grow
+  std::vector<float> x_;
+  std::vector<float> y_;
+  std::vector<float> z_;
+  std::vector<uint64_t> key_index_pairs_;
+  std::vector<uint64_t> sort_buffer_;
+
+  void load_points(const PointCloud2 & input, size_t point_num);
+
+  bool compute_keys(size_t point_num, int & max_key_bits);
+
+  void reduce_runs(
+    const PointCloud2 & input, PointCloud2 & output, const TransformInfo & transform_info) const;
+};
+
+}  // namespace autoware::downsample_filters
+
+// clang-format off
+#endif  // VOXEL_GRID_DOWNSAMPLE_FILTER__SORT_BASED_VOXEL_GRID_DOWNSAMPLE_FILTER_HPP_  // NOLINT
+// clang-format on
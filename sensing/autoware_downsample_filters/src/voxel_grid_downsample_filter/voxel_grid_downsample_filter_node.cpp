@@ -16,6 +16,7 @@
 
 #include "faster_voxel_grid_downsample_filter.hpp"
 #include "memory.hpp"
+#include "sort_based_voxel_grid_downsample_filter.hpp"
 #include "transform_info.hpp"
 
 #include <pcl_ros/transforms.hpp>
@@ -27,6 +28,7 @@
 #include <pcl/segmentation/segment_differences.h>
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -40,8 +42,18 @@ VoxelGridDownsampleFilter::VoxelGridDownsampleFilter(const rclcpp::NodeOptions &
   voxel_size_z_(declare_parameter<float>("voxel_size_z")),
   tf_input_frame_(declare_parameter<std::string>("input_frame")),
   tf_output_frame_(declare_parameter<std::string>("output_frame")),
-  max_queue_size_(static_cast<std::size_t>(declare_parameter<int64_t>("max_queue_size")))
+  max_queue_size_(static_cast<std::size_t>(declare_parameter<int64_t>("max_queue_size"))),
+  filter_engine_(declare_parameter<std::string>("filter_engine")),
+  thread_num_(static_cast<int>(declare_parameter<int64_t>("thread_num")))
 {
+  if (filter_engine_ == "sort_based") {
+    sort_based_voxel_filter_ = std::make_unique<SortBasedVoxelGridDownsampleFilter>();
+    sort_based_voxel_filter_->set_thread_num(thread_num_);
+  } else if (filter_engine_ != "faster") {
+    throw std::invalid_argument(
+      "Unknown filter_engine: " + filter_engine_ + ". It must be \"faster\" or \"sort_based\".");
+  }
+
   // Set publishers
   {
     rclcpp::PublisherOptions pub_options;
@@ -213,6 +225,14 @@ void VoxelGridDownsampleFilter::filter(
   const PointCloud2ConstPtr & input, PointCloud2 & output, const TransformInfo & transform_info)
 {
   std::scoped_lock lock(mutex_);
+  if (sort_based_voxel_filter_) {
+    // The sort-based filter is kept across the calls to reuse its buffers
+    sort_based_voxel_filter_->set_voxel_size(voxel_size_x_, voxel_size_y_, voxel_size_z_);
+    sort_based_voxel_filter_->set_field_offsets(input, this->get_logger());
+    sort_based_voxel_filter_->filter(input, output, transform_info, this->get_logger());
+    return;
+  }
+
   FasterVoxelGridDownsampleFilter faster_voxel_filter;
   faster_voxel_filter.set_voxel_size(voxel_size_x_, voxel_size_y_, voxel_size_z_);
   faster_voxel_filter.set_field_offsets(input, this->get_logger());
@@ -15,6 +15,7 @@
 #ifndef VOXEL_GRID_DOWNSAMPLE_FILTER__VOXEL_GRID_DOWNSAMPLE_FILTER_NODE_HPP_  // NOLINT
 #define VOXEL_GRID_DOWNSAMPLE_FILTER__VOXEL_GRID_DOWNSAMPLE_FILTER_NODE_HPP_  // NOLINT
 
+#include "sort_based_voxel_grid_downsample_filter.hpp"
 #include "transform_info.hpp"
 
 #include <boost/thread/mutex.hpp>
@@ -91,6 +92,12 @@ private:
   std::mutex mutex_;
   /** \brief The maximum queue size (default: 3). */
   size_t max_queue_size_ = 3;
+  /** \brief The voxel grid filter implementation, "faster" or "sort_based". */
+  std::string filter_engine_;
+  /** \brief The number of threads used by the sort-based filter. */
+  int thread_num_;
+  /** \brief The sort-based filter, which is created only if it is selected. */
+  std::unique_ptr<SortBasedVoxelGridDownsampleFilter> sort_based_voxel_filter_;
 
   /** \brief check if point cloud is valid */
   /** \param cloud point cloud */
@@ -0,0 +1,272 @@
+// Copyright 2025 TIER IV, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "faster_voxel_grid_downsample_filter.hpp"
+#include "sort_based_voxel_grid_downsample_filter.hpp"
+#include "transform_info.hpp"
+
+#include <rclcpp/logging.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/msg/point_field.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using autoware::downsample_filters::FasterVoxelGridDownsampleFilter;
+using autoware::downsample_filters::SortBasedVoxelGridDownsampleFilter;
+using autoware::downsample_filters::TransformInfo;
+using sensor_msgs::msg::PointCloud2;
+using sensor_msgs::msg::PointField;
+
+namespace
+{
+// The layout of PointXYZIRC
+constexpr uint32_t point_step = 16;
+constexpr uint32_t channel_offset = 14;
+
+sensor_msgs::msg::PointField make_field(
+  const std::string & name, const uint32_t offset, const uint8_t datatype)
+{
+  PointField field;
+  field.name = name;
+  field.offset = offset;
+  field.datatype = datatype;
+  field.count = 1;
+  return field;
+}
+
+PointCloud2::ConstSharedPtr make_cloud(const size_t point_num, const uint32_t seed = 0)
+{
+  auto cloud = std::make_shared<PointCloud2>();
+  cloud->header.frame_id = "base_link";
+  cloud->height = 1;
+  cloud->width = point_num;
+  cloud->fields = {
+    make_field("x", 0, PointField::FLOAT32), make_field("y", 4, PointField::FLOAT32),
+    make_field("z", 8, PointField::FLOAT32), make_field("intensity", 12, PointField::UINT8),
+    make_field("return_type", 13, PointField::UINT8),
+    make_field("channel", channel_offset, PointField::UINT16)};
+  cloud->point_step = point_step;
+  cloud->row_step = point_num * point_step;
+  cloud->is_dense = false;
+  cloud->data.resize(cloud->row_step);
+
+  std::mt19937 engine(seed);
+  std::uniform_real_distribution<float> xy_dist(-50.0f, 50.0f);
+  std::uniform_real_distribution<float> z_dist(-2.0f, 3.0f);
+  for (size_t i = 0; i < point_num; ++i) {
+    uint8_t * point = &cloud->data[i * point_step];
+    float xyz[3] = {xy_dist(engine), xy_dist(engine), z_dist(engine)};
+    if (i % 101 == 0) {
+      xyz[i % 3] = std::numeric_limits<float>::quiet_NaN();
+    }
+    std::memcpy(point, xyz, sizeof(xyz));
+    point[12] = static_cast<uint8_t>(engine() % 256);
+    point[13] = 1;
+    const auto channel = static_cast<uint16_t>(i % 128);
+    std::memcpy(point + channel_offset, &channel, sizeof(channel));
+  }
+  return cloud;
+}
+
+struct OutputPoint
+{
+  std::array<float, 3> xyz;
+  uint8_t intensity;
+};
+
+std::vector<OutputPoint> to_sorted_points(const PointCloud2 & cloud)
+{
+  std::vector<OutputPoint> points(cloud.width * cloud.height);
+  for (size_t i = 0; i < points.size(); ++i) {
+    std::memcpy(points[i].xyz.data(), &cloud.data[i * cloud.point_step], sizeof(float) * 3);
+    points[i].intensity = cloud.data[i * cloud.point_step + 12];
+  }
+  std::sort(points.begin(), points.end(), [](const OutputPoint & a, const OutputPoint & b) {
+    return a.xyz < b.xyz;
+  });
+  return points;
+}
+}  // namespace
+
+TEST(SortBasedVoxelGridDownsampleFilter, RadixSortIsStable)  // NOLINT
+{
+  std::mt19937 engine(0);
+  for (const int max_key_bits : {1, 8, 13, 31}) {
+    for (const size_t thread_num : {1, 3}) {
+      autoware::worker_pool::WorkerPool worker_pool(thread_num);
+      std::vector<uint64_t> buffer;
+      std::vector<uint64_t> pairs(100000);
+      for (size_t i = 0; i < pairs.size(); ++i) {
+        const uint64_t key = engine() & ((uint64_t{1} << max_key_bits) - 1);
+        pairs[i] = (key << 32) | i;
+      }
+      std::vector<uint64_t> expected = pairs;
+      std::stable_sort(expected.begin(), expected.end(), [](const uint64_t a, const uint64_t b) {
+        return (a >> 32) < (b >> 32);
+      });
+
+      SortBasedVoxelGridDownsampleFilter::radix_sort(pairs, buffer, max_key_bits, worker_pool);
+      EXPECT_EQ(pairs, expected);
+    }
+  }
+}
+
+TEST(SortBasedVoxelGridDownsampleFilter, MatchesHashBasedFilter)  // NOLINT
+{
+  const auto input = make_cloud(50000);
+  const auto logger = rclcpp::get_logger("test");
+
+  // The hash-based filter only checks that z is finite, so it is given finite points only
+  auto finite_input = std::make_shared<PointCloud2>(*input);
+  finite_input->data.clear();
+  for (size_t i = 0; i < input->width; ++i) {
+    float xyz[3];
+    std::memcpy(xyz, &input->data[i * point_step], sizeof(xyz));
+    if (std::isfinite(xyz[0]) && std::isfinite(xyz[1]) && std::isfinite(xyz[2])) {
+      finite_input->data.insert(
+        finite_input->data.end(), input->data.begin() + i * point_step,
+        input->data.begin() + (i + 1) * point_step);
+    }
+  }
+  finite_input->width = finite_input->data.size() / point_step;
+  finite_input->row_step = finite_input->data.size();
+
+  FasterVoxelGridDownsampleFilter faster_filter;
+  faster_filter.set_voxel_size(1.5f, 1.5f, 1.5f);
+  faster_filter.set_field_offsets(finite_input, logger);
+  PointCloud2 expected_output;
+  faster_filter.filter(finite_input, expected_output, TransformInfo(), logger);
+
+  SortBasedVoxelGridDownsampleFilter sort_based_filter;
+  sort_based_filter.set_voxel_size(1.5f, 1.5f, 1.5f);
+  sort_based_filter.set_field_offsets(input, logger);
+  PointCloud2 output;
+  sort_based_filter.filter(input, output, TransformInfo(), logger);
+
+  const auto expected_points = to_sorted_points(expected_output);
+  const auto points = to_sorted_points(output);
+  ASSERT_EQ(points.size(), expected_points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (int axis = 0; axis < 3; ++axis) {
+      EXPECT_NEAR(points[i].xyz[axis], expected_points[i].xyz[axis], 1e-4f);
+    }
+    EXPECT_NEAR(points[i].intensity, expected_points[i].intensity, 1);
+  }
+}
+
+TEST(SortBasedVoxelGridDownsampleFilter, OutputDoesNotDependOnThreads)  // NOLINT
+{
+  const auto input = make_cloud(100000, 1);
+  const auto logger = rclcpp::get_logger("test");
+
+  TransformInfo transform_info;
+  transform_info.need_transform = true;
+  transform_info.eigen_transform(0, 3) = 1.0f;
+  transform_info.eigen_transform(2, 3) = -2.0f;
+
+  PointCloud2 expected_output;
+  for (const int thread_num : {1, 2, 4}) {
+    SortBasedVoxelGridDownsampleFilter filter;
+    filter.set_voxel_size(1.0f, 1.0f, 0.5f);
+    filter.set_thread_num(thread_num);
+    PointCloud2 output;
+    filter.filter(input, output, transform_info, logger);
+    if (thread_num == 1) {
+      expected_output = output;
+      EXPECT_TRUE(output.is_dense);
+      EXPECT_EQ(output.row_step, output.width * point_step);
+    } else {
+      EXPECT_EQ(output.data, expected_output.data);
+    }
+  }
+}
+
+TEST(SortBasedVoxelGridDownsampleFilter, PassesThroughOtherFields)  // NOLINT
+{
+  // two voxels, where the first point of each voxel sets the other fields
+  auto input = std::make_shared<PointCloud2>(*make_cloud(4));
+  const float xyz[4][3] = {
+    {0.1f, 0.1f, 0.1f}, {5.1f, 0.1f, 0.1f}, {0.3f, 0.3f, 0.3f}, {5.3f, 0.3f, 0.3f}};
+  for (size_t i = 0; i < 4; ++i) {
+    std::memcpy(&input->data[i * point_step], xyz[i], sizeof(xyz[i]));
+    input->data[i * point_step + 12] = static_cast<uint8_t>(10 * (i + 1));
+  }
+
+  SortBasedVoxelGridDownsampleFilter filter;
+  filter.set_voxel_size(1.0f, 1.0f, 1.0f);
+  PointCloud2 output;
+  filter.filter(input, output, TransformInfo(), rclcpp::get_logger("test"));
+
+  ASSERT_EQ(output.width, 2u);
+  for (size_t v = 0; v < 2; ++v) {
+    float centroid[3];
+    std::memcpy(centroid, &output.data[v * point_step], sizeof(centroid));
+    EXPECT_NEAR(centroid[0], xyz[v][0] + 0.1f, 1e-5f);
+    EXPECT_NEAR(centroid[1], 0.2f, 1e-5f);
+    EXPECT_NEAR(centroid[2], 0.2f, 1e-5f);
+    EXPECT_EQ(output.data[v * point_step + 12], 10 * (v + 1) + 10);
+    EXPECT_EQ(
+      std::memcmp(
+        &output.data[v * point_step + 13], &input->data[v * point_step + 13], point_step - 13),
+      0);
+  }
+}
+
+TEST(SortBasedVoxelGridDownsampleFilter, DISABLED_Benchmark)  // NOLINT
+{
+  constexpr int nb_iteration = 50;
+  const auto input = make_cloud(200000);
+  const auto logger = rclcpp::get_logger("test");
+
+  const auto measure = [&](const std::string & name, const auto & filter) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nb_iteration; ++i) {
+      filter();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::milli>(end - start).count() / nb_iteration
+              << " [ms]" << std::endl;
+  };
+
+  PointCloud2 output;
+  measure("hash-based filter", [&] {
+    FasterVoxelGridDownsampleFilter filter;
+    filter.set_voxel_size(0.3f, 0.3f, 0.1f);
+    filter.set_field_offsets(input, logger);
+    filter.filter(input, output, TransformInfo(), logger);
+  });
+  for (const int thread_num : {1, 2, 4}) {
+    SortBasedVoxelGridDownsampleFilter filter;
+    filter.set_voxel_size(0.3f, 0.3f, 0.1f);
+    filter.set_thread_num(thread_num);
+    measure("sort-based filter with " + std::to_string(thread_num) + " threads", [&] {
+      filter.set_field_offsets(input, logger);
+      filter.filter(input, output, TransformInfo(), logger);
+    });
+  }
+}